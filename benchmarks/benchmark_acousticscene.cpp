@@ -0,0 +1,248 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/AcousticProbeGrid.h"
+#include "../include/AcousticScene.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Orpheus;
+
+// =============================================================================
+// Acoustic Scene Benchmarks
+// =============================================================================
+
+namespace {
+
+struct MeshBuilder {
+  std::vector<Vector3> vertices;
+  std::vector<uint32_t> indices;
+
+  // Quad a-b-c-d split into n x n cells
+  void AddQuad(const Vector3 &a, const Vector3 &b, const Vector3 &d,
+               uint32_t n) {
+    const auto first = static_cast<uint32_t>(vertices.size());
+    for (uint32_t j = 0; j <= n; ++j) {
+      for (uint32_t i = 0; i <= n; ++i) {
+        const float u = static_cast<float>(i) / n;
+        const float v = static_cast<float>(j) / n;
+        vertices.push_back({a.x + (b.x - a.x) * u + (d.x - a.x) * v,
+                            a.y + (b.y - a.y) * u + (d.y - a.y) * v,
+                            a.z + (b.z - a.z) * u + (d.z - a.z) * v});
+      }
+    }
+    for (uint32_t j = 0; j < n; ++j) {
+      for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t k = first + j * (n + 1) + i;
+        indices.insert(indices.end(),
+                       {k, k + 1, k + n + 1, k + 1, k + n + 2, k + n + 1});
+      }
+    }
+  }
+
+  void AddBox(const Vector3 &min, const Vector3 &max, uint32_t n) {
+    const float x0 = min.x, y0 = min.y, z0 = min.z;
+    const float x1 = max.x, y1 = max.y, z1 = max.z;
+    AddQuad({x0, y0, z0}, {x1, y0, z0}, {x0, y1, z0}, n);
+    AddQuad({x0, y0, z1}, {x0, y1, z1}, {x1, y0, z1}, n);
+    AddQuad({x0, y0, z0}, {x0, y0, z1}, {x1, y0, z0}, n);
+    AddQuad({x0, y1, z0}, {x1, y1, z0}, {x0, y1, z1}, n);
+    AddQuad({x0, y0, z0}, {x0, y1, z0}, {x0, y0, z1}, n);
+    AddQuad({x1, y0, z0}, {x1, y0, z1}, {x1, y1, z0}, n);
+  }
+
+  void AddTo(AcousticScene &scene, AcousticMaterialID material,
+             float detailSize) const {
+    scene.AddMesh(vertices.data(), vertices.size(), indices.data(),
+                  indices.size(), material, detailSize);
+  }
+};
+
+struct TestScene {
+  std::shared_ptr<AcousticScene> scene = std::make_shared<AcousticScene>();
+  std::vector<AcousticVector> sources;
+  AcousticVector listener;
+};
+
+// 20 x 10 x 15 m room
+TestScene Shoebox(float) {
+  TestScene test;
+  MeshBuilder room;
+  room.AddBox({0, 0, 0}, {20, 10, 15}, 1);
+  room.AddTo(*test.scene, 1, 0.0f);
+  for (int i = 0; i < 32; ++i) {
+    test.sources.push_back(
+        {0.5f + 0.6f * i, 1.0f + (i % 8), 1.0f + (i % 13)});
+  }
+  test.listener = {10.0f, 2.0f, 7.0f};
+  return test;
+}
+
+// 80 x 30 m nave under a 48-segment barrel vault, two rows of pillars and
+// 80 pews; detail sizes above the pew size remove the pews
+TestScene Cathedral(float detailSize) {
+  TestScene test;
+  MeshBuilder shell;
+  shell.AddQuad({0, 0, 0}, {0, 0, 30}, {80, 0, 0}, 16);     // Floor
+  shell.AddQuad({0, 0, 0}, {80, 0, 0}, {0, 20, 0}, 16);     // South wall
+  shell.AddQuad({0, 0, 30}, {0, 20, 30}, {80, 0, 30}, 16);  // North wall
+  shell.AddQuad({0, 0, 0}, {0, 20, 0}, {0, 0, 30}, 8);      // West wall
+  shell.AddQuad({80, 0, 0}, {80, 0, 30}, {80, 20, 0}, 8);   // East wall
+  const uint32_t segments = 48, bays = 40;
+  for (uint32_t s = 0; s < segments; ++s) {
+    const float a0 = 3.14159265f * s / segments;
+    const float a1 = 3.14159265f * (s + 1) / segments;
+    for (uint32_t b = 0; b < bays; ++b) {
+      const float x0 = 80.0f * b / bays, x1 = 80.0f * (b + 1) / bays;
+      shell.AddQuad({x0, 20 + 15 * std::sin(a0), 15 - 15 * std::cos(a0)},
+                    {x0, 20 + 15 * std::sin(a1), 15 - 15 * std::cos(a1)},
+                    {x1, 20 + 15 * std::sin(a0), 15 - 15 * std::cos(a0)}, 1);
+    }
+  }
+  shell.AddTo(*test.scene, 0, detailSize);
+
+  MeshBuilder pillars;
+  for (int i = 0; i < 12; ++i) {
+    const float x = 6.0f + 6.0f * i;
+    pillars.AddBox({x, 0, 7}, {x + 1.2f, 20, 8.2f}, 2);
+    pillars.AddBox({x, 0, 21.8f}, {x + 1.2f, 20, 23}, 2);
+  }
+  pillars.AddTo(*test.scene, 0, detailSize);
+
+  MeshBuilder pews;
+  for (int i = 0; i < 40; ++i) {
+    const float x = 10.0f + 1.5f * i;
+    pews.AddBox({x, 0, 9.5f}, {x + 0.5f, 0.9f, 14}, 2);
+    pews.AddBox({x, 0, 16}, {x + 0.5f, 0.9f, 20.5f}, 2);
+  }
+  pews.AddTo(*test.scene, 1, detailSize);
+
+  for (int i = 0; i < 32; ++i) {
+    test.sources.push_back(
+        {2.0f + 2.4f * i, 1.5f + (i % 5) * 3.0f, 3.0f + (i % 7) * 4.0f});
+  }
+  test.listener = {40.0f, 1.7f, 15.0f};
+  return test;
+}
+
+// 8 x 8 blocks of buildings with 8 x 8 facade panels on a 200 m ground
+TestScene CityBlock(float detailSize) {
+  TestScene test;
+  MeshBuilder ground;
+  ground.AddQuad({0, 0, 0}, {0, 0, 200}, {200, 0, 0}, 20);
+  ground.AddTo(*test.scene, 0, detailSize);
+
+  MeshBuilder buildings;
+  for (int bz = 0; bz < 8; ++bz) {
+    for (int bx = 0; bx < 8; ++bx) {
+      const float x = 5.0f + 25.0f * bx, z = 5.0f + 25.0f * bz;
+      const float height = 10.0f + static_cast<float>((bx * 7 + bz * 13) % 50);
+      buildings.AddBox({x, 0, z}, {x + 16, height, z + 16}, 8);
+    }
+  }
+  buildings.AddTo(*test.scene, 3, detailSize);
+
+  for (int i = 0; i < 32; ++i) {
+    test.sources.push_back({2.5f + 25.0f * (i % 8), 1.5f + (i % 3),
+                            10.0f + 25.0f * (i / 8) + (i % 5)});
+  }
+  test.listener = {102.5f, 1.7f, 100.0f};
+  return test;
+}
+
+TestScene (*const kScenes[])(float) = {Shoebox, Cathedral, CityBlock};
+
+} // namespace
+
+// Trace 32 voices x 256 rays serially. Arguments: scene (0 = shoebox,
+// 1 = cathedral, 2 = city block) and detail size in decimetres (0 = full
+// detail)
+static void BM_AcousticScene_Trace(benchmark::State &state) {
+  TestScene test = kScenes[state.range(0)](state.range(1) * 0.1f);
+  test.scene->Commit();
+  AcousticRayTracer tracer;
+  tracer.SetGeometryPacketCallback(AcousticScene::MakeCallback(test.scene));
+  tracer.SetRayCount(256);
+  tracer.SetMaxDistance(300.0f);
+
+  std::vector<PropagationResult> results(test.sources.size());
+  for (auto _ : state) {
+    tracer.TraceBatch(test.sources.data(), test.sources.size(),
+                      test.listener, results.data());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 32 * 256);
+  state.counters["triangles"] =
+      static_cast<double>(test.scene->GetTriangleCount());
+}
+BENCHMARK(BM_AcousticScene_Trace)
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({1, 10})
+    ->Args({2, 0})
+    ->Args({2, 40})
+    ->Unit(benchmark::kMillisecond);
+
+// Full SAH rebuild of a scene
+static void BM_AcousticScene_Build(benchmark::State &state) {
+  for (auto _ : state) {
+    TestScene test = kScenes[state.range(0)](0.0f);
+    test.scene->Commit();
+    benchmark::DoNotOptimize(test.scene->GetBVH().GetNodeCount());
+  }
+}
+BENCHMARK(BM_AcousticScene_Build)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(benchmark::kMillisecond);
+
+// Refit after a 1 m door moves in the cathedral
+static void BM_AcousticScene_Refit(benchmark::State &state) {
+  TestScene test = Cathedral(0.0f);
+  MeshBuilder door;
+  door.AddQuad({0, 0, 13}, {0, 0, 17}, {0, 6, 13}, 4);
+  const AcousticMeshID mesh = test.scene->AddMesh(
+      door.vertices.data(), door.vertices.size(), door.indices.data(),
+      door.indices.size(), 1);
+  test.scene->Commit();
+
+  std::vector<Vector3> moved = door.vertices;
+  float offset = 0.0f;
+  for (auto _ : state) {
+    offset = offset > 0.5f ? 0.0f : offset + 0.01f;
+    for (size_t i = 0; i < moved.size(); ++i) {
+      moved[i].x = door.vertices[i].x + offset;
+    }
+    test.scene->UpdateMesh(mesh, moved.data(), moved.size());
+    test.scene->Commit();
+  }
+}
+BENCHMARK(BM_AcousticScene_Refit)->Unit(benchmark::kMicrosecond);
+
+// Baked probe lookups for the 32 cathedral voices, in place of
+// BM_AcousticScene_Trace/1/0. Argument: 0 = nearest, 1 = trilinear
+static void BM_AcousticProbeGrid_Sample(benchmark::State &state) {
+  TestScene test = Cathedral(0.0f);
+  test.scene->Commit();
+  AcousticRayTracer tracer;
+  tracer.SetGeometryPacketCallback(AcousticScene::MakeCallback(test.scene));
+  tracer.SetRayCount(64);
+  AcousticProbeGrid grid;
+  grid.LoadFromMemory(AcousticProbeGrid::BakeGrid(tracer, {0, 0, 0},
+                                                  {80, 35, 30}, 4.0f));
+  const ProbeInterpolation mode = state.range(0) == 0
+                                      ? ProbeInterpolation::Nearest
+                                      : ProbeInterpolation::Trilinear;
+
+  std::vector<AcousticProbeSample> samples(test.sources.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < test.sources.size(); ++i) {
+      const AcousticVector &s = test.sources[i];
+      samples[i] = grid.Sample({s.x, s.y, s.z}, mode);
+    }
+    benchmark::DoNotOptimize(samples.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 32);
+}
+BENCHMARK(BM_AcousticProbeGrid_Sample)->Arg(0)->Arg(1);
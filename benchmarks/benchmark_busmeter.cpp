@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/BusMeter.h"
+
+#include <random>
+#include <vector>
+
+using namespace Orpheus;
+
+// =============================================================================
+// Bus Meter Benchmarks
+// =============================================================================
+//
+// Each iteration meters one stereo mixer block. "x_realtime" is seconds of
+// audio metered per second of CPU (higher is better).
+
+static void BM_BusMeter_Process(benchmark::State &state) {
+  constexpr float kSampleRate = 48000.0f;
+  constexpr size_t kChannels = 2;
+  const size_t blockSize = static_cast<size_t>(state.range(0));
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+  std::vector<float> buffer(blockSize * kChannels);
+  for (auto &s : buffer) {
+    s = dist(rng);
+  }
+
+  BusMeter meter;
+  meter.SetEnabled(true);
+  for (auto _ : state) {
+    meter.Process(buffer.data(), blockSize, kChannels, blockSize,
+                  kSampleRate);
+    benchmark::ClobberMemory();
+  }
+
+  const double audioSeconds = static_cast<double>(state.iterations()) *
+                              static_cast<double>(blockSize) / kSampleRate;
+  state.counters["x_realtime"] =
+      benchmark::Counter(audioSeconds, benchmark::Counter::kIsRate);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(blockSize));
+}
+BENCHMARK(BM_BusMeter_Process)->Arg(256)->Arg(512);
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Compressor.h"
+
+#include <random>
+#include <vector>
+
+using namespace Orpheus;
+
+// =============================================================================
+// Bus Compressor Benchmarks
+// =============================================================================
+//
+// Each iteration processes one mixer block for every bus. The "x_realtime"
+// counter is seconds of audio processed per second of CPU for a single bus,
+// i.e. the real-time factor per bus (higher is better).
+
+namespace {
+
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kChannels = 2;
+
+std::vector<float> MakeNoise(size_t samples, float amplitude) {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> dist(-amplitude, amplitude);
+  std::vector<float> data(samples);
+  for (auto &s : data) {
+    s = dist(rng);
+  }
+  return data;
+}
+
+void RunBusCompressors(benchmark::State &state,
+                       const CompressorSettings &settings) {
+  const size_t blockSize = static_cast<size_t>(state.range(0));
+  const size_t busCount = static_cast<size_t>(state.range(1));
+
+  std::vector<Compressor> compressors(busCount, Compressor(kSampleRate));
+  for (auto &comp : compressors) {
+    comp.SetSettings(settings);
+    comp.SetEnabled(true);
+    comp.ReserveLookahead();
+  }
+
+  const std::vector<float> source = MakeNoise(blockSize * kChannels, 1.0f);
+  std::vector<float> buffer(source.size());
+
+  for (auto _ : state) {
+    for (auto &comp : compressors) {
+      buffer = source;
+      comp.ProcessBlock(buffer.data(), blockSize, kChannels, blockSize);
+    }
+    benchmark::DoNotOptimize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+
+  const double audioSeconds = static_cast<double>(state.iterations()) *
+                              static_cast<double>(blockSize) / kSampleRate;
+  // Audio seconds per CPU second, for one bus
+  state.counters["x_realtime"] = benchmark::Counter(
+      audioSeconds * static_cast<double>(busCount),
+      benchmark::Counter::kIsRate);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(blockSize * busCount));
+}
+
+} // namespace
+
+static void BM_Compressor_Bus(benchmark::State &state) {
+  CompressorSettings settings;
+  settings.threshold = -12.0f;
+  settings.ratio = 4.0f;
+  settings.attackMs = 5.0f;
+  settings.releaseMs = 80.0f;
+  RunBusCompressors(state, settings);
+}
+BENCHMARK(BM_Compressor_Bus)
+    ->Args({256, 1})
+    ->Args({512, 1})
+    ->Args({512, 16});
+
+static void BM_Compressor_LookaheadLimiter(benchmark::State &state) {
+  CompressorSettings settings;
+  settings.threshold = -1.0f;
+  settings.limiterMode = true;
+  settings.attackMs = 1.0f;
+  settings.releaseMs = 50.0f;
+  settings.lookaheadMs = 5.0f;
+  RunBusCompressors(state, settings);
+}
+BENCHMARK(BM_Compressor_LookaheadLimiter)
+    ->Args({256, 1})
+    ->Args({512, 1})
+    ->Args({512, 16});
@@ -0,0 +1,276 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/OcclusionProcessor.h"
+#include "../include/OcclusionScene.h"
+#include "../include/PortalGraph.h"
+#include "../include/PropagationField.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Orpheus;
+
+// =============================================================================
+// Occlusion Scheduling Benchmarks
+// =============================================================================
+
+// One frame of occlusion for N playing voices with a cheap fake query, so
+// the result is dominated by scheduling and smoothing. Reports queries per
+// frame alongside the time.
+static void BM_Occlusion_Update(benchmark::State &state) {
+  const size_t voiceCount = static_cast<size_t>(state.range(0));
+  std::vector<std::unique_ptr<Voice>> storage;
+  std::vector<Voice *> voices;
+  for (size_t i = 0; i < voiceCount; ++i) {
+    storage.push_back(std::make_unique<Voice>());
+    storage.back()->position = {static_cast<float>(i), 0.0f, 5.0f};
+    storage.back()->audibility = static_cast<float>(i % 10) / 9.0f;
+    voices.push_back(storage.back().get());
+  }
+
+  OcclusionProcessor processor;
+  processor.SetQueryCallback([](const Vector3 &, const Vector3 &) {
+    return std::vector<OcclusionHit>{{"Wood", 0.5f}};
+  });
+
+  uint64_t queries = 0;
+  for (auto _ : state) {
+    processor.Update(voices.data(), voices.size(), {0, 0, 0}, 1.0f / 60.0f);
+    queries += processor.GetLastQueryCount();
+  }
+
+  state.counters["queries/frame"] = benchmark::Counter(
+      static_cast<double>(queries), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * voiceCount);
+}
+BENCHMARK(BM_Occlusion_Update)->Arg(32)->Arg(200);
+
+// =============================================================================
+// Occlusion Scene Benchmarks
+// =============================================================================
+
+namespace {
+
+// Random boxes (12 triangles each) scattered over a 400 m square level
+OcclusionScene MakeBoxScene(size_t boxCount) {
+  OcclusionScene scene;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+  std::uniform_real_distribution<float> size(0.5f, 6.0f);
+  const uint32_t indices[] = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6,
+                              0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7,
+                              0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+  for (size_t i = 0; i < boxCount; ++i) {
+    const Vector3 min{pos(rng), pos(rng) * 0.05f, pos(rng)};
+    const Vector3 max{min.x + size(rng), min.y + size(rng),
+                      min.z + size(rng)};
+    Vector3 vertices[8];
+    for (int v = 0; v < 8; ++v) {
+      vertices[v] = {v & 1 ? max.x : min.x, v & 2 ? max.y : min.y,
+                     v & 4 ? max.z : min.z};
+    }
+    scene.AddMesh(vertices, 8, indices, 36, static_cast<uint32_t>(i % 4));
+  }
+  scene.Commit();
+  return scene;
+}
+
+} // namespace
+
+static void BM_OcclusionScene_Build(benchmark::State &state) {
+  const size_t boxCount = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    OcclusionScene scene = MakeBoxScene(boxCount);
+    benchmark::DoNotOptimize(scene.GetBVH().GetNodeCount());
+  }
+  state.counters["triangles"] = static_cast<double>(boxCount * 12);
+}
+BENCHMARK(BM_OcclusionScene_Build)
+    ->Arg(8192)
+    ->Arg(32768)
+    ->Unit(benchmark::kMillisecond);
+
+// 200 voice-to-listener segments per iteration, 10-100 m long
+static void BM_OcclusionScene_Raycast(benchmark::State &state) {
+  const size_t boxCount = static_cast<size_t>(state.range(0));
+  const OcclusionScene scene = MakeBoxScene(boxCount);
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+  std::vector<OcclusionRay> rays(200);
+  for (auto &ray : rays) {
+    ray.listener = {pos(rng), 1.7f, pos(rng)};
+    ray.source = {ray.listener.x + pos(rng), pos(rng) * 0.05f,
+                  ray.listener.z + pos(rng)};
+  }
+
+  std::vector<OcclusionRayHit> hits;
+  for (auto _ : state) {
+    hits.clear();
+    scene.Raycast(rays.data(), rays.size(), hits);
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.counters["hits/ray"] =
+      static_cast<double>(hits.size()) / static_cast<double>(rays.size());
+  state.counters["triangles"] = static_cast<double>(boxCount * 12);
+  state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_OcclusionScene_Raycast)
+    ->Arg(8192)
+    ->Arg(32768)
+    ->Unit(benchmark::kMicrosecond);
+
+// Refit after moving 1% of the meshes (doors)
+static void BM_OcclusionScene_Refit(benchmark::State &state) {
+  const size_t boxCount = static_cast<size_t>(state.range(0));
+  OcclusionScene scene = MakeBoxScene(boxCount);
+  Vector3 door[8];
+  for (int v = 0; v < 8; ++v) {
+    door[v] = {v & 1 ? 1.0f : 0.0f, v & 2 ? 2.0f : 0.0f, v & 4 ? 0.1f : 0.0f};
+  }
+  float offset = 0.0f;
+  for (auto _ : state) {
+    offset = offset > 1.0f ? 0.0f : offset + 0.01f;
+    for (size_t mesh = 0; mesh < boxCount; mesh += 100) {
+      door[0].x = offset;
+      scene.UpdateMesh(static_cast<OcclusionMeshID>(mesh), door, 8);
+    }
+    scene.Commit();
+  }
+  state.counters["triangles"] = static_cast<double>(boxCount * 12);
+}
+BENCHMARK(BM_OcclusionScene_Refit)
+    ->Arg(8192)
+    ->Arg(32768)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Propagation Field Benchmarks
+// =============================================================================
+
+namespace {
+
+// The 8192-box level voxelized at 2 m (200 x 10 x 200 cells)
+PropagationField MakeBoxField() {
+  PropagationField field;
+  field.Configure({-200, -10, -200}, {200, 10, 200}, 2.0f);
+  field.Voxelize(MakeBoxScene(8192), [](OcclusionMaterialID) { return 0.8f; });
+  return field;
+}
+
+} // namespace
+
+// Full flood after the listener changes cell
+static void BM_PropagationField_Flood(benchmark::State &state) {
+  PropagationField field = MakeBoxField();
+  field.SetMaxExpansions(UINT32_MAX);
+  bool flip = false;
+  for (auto _ : state) {
+    flip = !flip;
+    field.Update({flip ? 1.0f : 3.0f, 1.0f, 1.0f});
+  }
+  state.counters["cells"] = static_cast<double>(field.GetCellCount());
+}
+BENCHMARK(BM_PropagationField_Flood)->Unit(benchmark::kMillisecond);
+
+// One frame of occlusion for N voices answered from the field
+static void BM_PropagationField_Update(benchmark::State &state) {
+  const size_t voiceCount = static_cast<size_t>(state.range(0));
+  PropagationField field = MakeBoxField();
+  const Vector3 listener{1.0f, 1.0f, 1.0f};
+  field.Update(listener);
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<float> pos(-150.0f, 150.0f);
+  std::vector<std::unique_ptr<Voice>> storage;
+  std::vector<Voice *> voices;
+  for (size_t i = 0; i < voiceCount; ++i) {
+    storage.push_back(std::make_unique<Voice>());
+    storage.back()->position = {pos(rng), 1.0f, pos(rng)};
+    voices.push_back(storage.back().get());
+  }
+
+  OcclusionProcessor processor;
+  processor.SetPropagationField(&field);
+  for (auto _ : state) {
+    field.Update(listener);
+    processor.Update(voices.data(), voices.size(), listener, 1.0f / 60.0f);
+  }
+  state.SetItemsProcessed(state.iterations() * voiceCount);
+}
+BENCHMARK(BM_PropagationField_Update)->Arg(500)->Arg(2000);
+
+// =============================================================================
+// Portal Graph Benchmarks
+// =============================================================================
+
+namespace {
+
+// N x N grid of 10 m rooms with a door to each neighbour
+PortalGraph MakeRoomGrid(int n) {
+  PortalGraph graph;
+  for (int z = 0; z < n; ++z) {
+    for (int x = 0; x < n; ++x) {
+      const float x0 = static_cast<float>(x) * 10.0f;
+      const float z0 = static_cast<float>(z) * 10.0f;
+      graph.CreateRoom(
+          ZoneGeometry::Box({x0, 0, z0}, {x0 + 10.0f, 3, z0 + 10.0f}, 0));
+    }
+  }
+  for (int z = 0; z < n; ++z) {
+    for (int x = 0; x < n; ++x) {
+      const auto room = static_cast<RoomID>(z * n + x);
+      const float cx = static_cast<float>(x) * 10.0f + 5.0f;
+      const float cz = static_cast<float>(z) * 10.0f + 5.0f;
+      if (x + 1 < n) {
+        graph.AddPortal(room, room + 1, {cx + 5.0f, 1.5f, cz});
+      }
+      if (z + 1 < n) {
+        graph.AddPortal(room, room + static_cast<RoomID>(n),
+                        {cx, 1.5f, cz + 5.0f}, (x + z) % 3 ? 1.0f : 0.2f);
+      }
+    }
+  }
+  return graph;
+}
+
+} // namespace
+
+// Searches after the listener changes room
+static void BM_PortalGraph_Search(benchmark::State &state) {
+  PortalGraph graph = MakeRoomGrid(static_cast<int>(state.range(0)));
+  bool flip = false;
+  for (auto _ : state) {
+    flip = !flip;
+    graph.Update({flip ? 5.0f : 15.0f, 1.5f, 5.0f});
+  }
+  state.counters["portals"] = static_cast<double>(graph.GetPortalCount());
+}
+BENCHMARK(BM_PortalGraph_Search)->Arg(10)->Arg(30);
+
+// One frame of occlusion for 500 voices answered by portal paths
+static void BM_PortalGraph_Update(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  PortalGraph graph = MakeRoomGrid(n);
+  const Vector3 listener{5.0f, 1.5f, 5.0f};
+  graph.Update(listener);
+
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> pos(0.0f, n * 10.0f);
+  std::vector<std::unique_ptr<Voice>> storage;
+  std::vector<Voice *> voices;
+  for (size_t i = 0; i < 500; ++i) {
+    storage.push_back(std::make_unique<Voice>());
+    storage.back()->position = {pos(rng), 1.5f, pos(rng)};
+    voices.push_back(storage.back().get());
+  }
+
+  OcclusionProcessor processor;
+  processor.SetPortalGraph(&graph);
+  for (auto _ : state) {
+    graph.Update(listener);
+    processor.Update(voices.data(), voices.size(), listener, 1.0f / 60.0f);
+  }
+  state.SetItemsProcessed(state.iterations() * 500);
+}
+BENCHMARK(BM_PortalGraph_Update)->Arg(10)->Arg(30);
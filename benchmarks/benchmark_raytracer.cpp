@@ -0,0 +1,248 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/ImpulseResponseSynthesizer.h"
+#include "../include/PropagationCache.h"
+#include "../include/RaytracedAcoustics.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Orpheus;
+
+// =============================================================================
+// Acoustic Ray Tracer Benchmarks
+// =============================================================================
+
+namespace {
+
+// 20 x 10 x 15 m shoebox room
+RayHit ShoeboxHit(const AcousticVector &origin, const AcousticVector &dir,
+                  float maxDistance) {
+  static const float kMin[3] = {0.0f, 0.0f, 0.0f};
+  static const float kMax[3] = {20.0f, 10.0f, 15.0f};
+  const float o[3] = {origin.x, origin.y, origin.z};
+  const float d[3] = {dir.x, dir.y, dir.z};
+
+  RayHit hit;
+  float best = maxDistance;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (d[axis] == 0.0f) {
+      continue;
+    }
+    const float plane = d[axis] > 0.0f ? kMax[axis] : kMin[axis];
+    const float t = (plane - o[axis]) / d[axis];
+    if (t > 0.0f && t < best) {
+      best = t;
+      hit.hit = true;
+      hit.distance = t;
+      hit.normal = {0.0f, 0.0f, 0.0f};
+      (axis == 0 ? hit.normal.x : axis == 1 ? hit.normal.y : hit.normal.z) =
+          d[axis] > 0.0f ? -1.0f : 1.0f;
+    }
+  }
+  hit.point = origin + dir * hit.distance;
+  hit.material = AcousticMaterial::Wood();
+  return hit;
+}
+
+// The same room intersected a packet at a time, lane loops over SoA arrays
+void ShoeboxPacket(const AcousticRayPacket &rays, AcousticHitPacket &hits) {
+  static const float kMin[3] = {0.0f, 0.0f, 0.0f};
+  static const float kMax[3] = {20.0f, 10.0f, 15.0f};
+  const float *origin[3] = {rays.originX, rays.originY, rays.originZ};
+  const float *dir[3] = {rays.directionX, rays.directionY, rays.directionZ};
+  float *normal[3] = {hits.normalX, hits.normalY, hits.normalZ};
+
+  float best[AcousticRayPacket::kMaxRays];
+  int bestAxis[AcousticRayPacket::kMaxRays];
+  for (size_t lane = 0; lane < rays.count; ++lane) {
+    best[lane] = rays.maxDistance[lane];
+    bestAxis[lane] = -1;
+  }
+  for (int axis = 0; axis < 3; ++axis) {
+    for (size_t lane = 0; lane < rays.count; ++lane) {
+      const float d = dir[axis][lane];
+      const float plane = d > 0.0f ? kMax[axis] : kMin[axis];
+      const float t = d != 0.0f ? (plane - origin[axis][lane]) / d : -1.0f;
+      const bool closer = t > 0.0f && t < best[lane];
+      best[lane] = closer ? t : best[lane];
+      bestAxis[lane] = closer ? axis : bestAxis[lane];
+    }
+  }
+  for (size_t lane = 0; lane < rays.count; ++lane) {
+    const int axis = bestAxis[lane];
+    if (axis < 0) {
+      continue;
+    }
+    hits.hitMask |= 1u << lane;
+    hits.distance[lane] = best[lane];
+    hits.normalX[lane] = hits.normalY[lane] = hits.normalZ[lane] = 0.0f;
+    normal[axis][lane] = dir[axis][lane] > 0.0f ? -1.0f : 1.0f;
+    hits.material[lane] = 1; // Wood
+  }
+}
+
+std::vector<AcousticVector> BatchSources() {
+  std::vector<AcousticVector> sources;
+  for (int i = 0; i < 32; ++i) {
+    sources.push_back({0.5f + 0.6f * i, 1.0f + (i % 8), 1.0f + (i % 13)});
+  }
+  return sources;
+}
+
+} // namespace
+
+// 256 rays for each of 32 voices; the argument is the worker thread count
+// (0 = serial on the calling thread)
+static void BM_RayTracer_TraceBatch(benchmark::State &state) {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryCallback(ShoeboxHit);
+  tracer.SetRayCount(256);
+  tracer.SetThreadCount(static_cast<uint32_t>(state.range(0)));
+
+  const std::vector<AcousticVector> sources = BatchSources();
+  std::vector<PropagationResult> results(sources.size());
+  const AcousticVector listener{10.0f, 2.0f, 7.0f};
+
+  for (auto _ : state) {
+    tracer.TraceBatch(sources.data(), sources.size(), listener,
+                      results.data());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 32 * 256);
+}
+BENCHMARK(BM_RayTracer_TraceBatch)
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(7)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// The same batch serially through the packet callback; the argument is the
+// packet size
+static void BM_RayTracer_TraceBatchPacket(benchmark::State &state) {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryPacketCallback(ShoeboxPacket);
+  tracer.SetPacketSize(static_cast<size_t>(state.range(0)));
+  tracer.SetRayCount(256);
+
+  const std::vector<AcousticVector> sources = BatchSources();
+  std::vector<PropagationResult> results(sources.size());
+  const AcousticVector listener{10.0f, 2.0f, 7.0f};
+
+  for (auto _ : state) {
+    tracer.TraceBatch(sources.data(), sources.size(), listener,
+                      results.data());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 32 * 256);
+}
+BENCHMARK(BM_RayTracer_TraceBatchPacket)
+    ->Arg(8)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+
+// The batch with exact early reflections from a box image-source model:
+// planes only (0) or with the packet geometry testing visibility (1)
+static void BM_RayTracer_ImageSources(benchmark::State &state) {
+  AcousticRayTracer tracer;
+  if (state.range(0) != 0) {
+    tracer.SetGeometryPacketCallback(ShoeboxPacket);
+  }
+  tracer.SetRayCount(256);
+  tracer.SetImageSourceModel(
+      ImageSourceModel::Box({0, 0, 0}, {20, 10, 15}, {1, 1, 1, 1, 1, 1}));
+
+  const std::vector<AcousticVector> sources = BatchSources();
+  std::vector<PropagationResult> results(sources.size());
+  const AcousticVector listener{10.0f, 2.0f, 7.0f};
+
+  for (auto _ : state) {
+    tracer.TraceBatch(sources.data(), sources.size(), listener,
+                      results.data());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 32);
+}
+BENCHMARK(BM_RayTracer_ImageSources)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+// Converged incremental updates of the same batch: 1/8 of the rays per
+// update, blended into per-voice estimates
+static void BM_PropagationCache_Update(benchmark::State &state) {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryPacketCallback(ShoeboxPacket);
+  tracer.SetRayCount(256);
+
+  const std::vector<AcousticVector> sources = BatchSources();
+  std::vector<VoiceID> voices(sources.size());
+  for (size_t i = 0; i < voices.size(); ++i) {
+    voices[i] = static_cast<VoiceID>(i);
+  }
+  const AcousticVector listener{10.0f, 2.0f, 7.0f};
+  PropagationCache cache;
+  for (int i = 0; i < 2; ++i) {
+    cache.Update(voices.data(), sources.data(), sources.size(), listener,
+                 tracer);
+  }
+
+  for (auto _ : state) {
+    cache.Update(voices.data(), sources.data(), sources.size(), listener,
+                 tracer);
+  }
+  state.SetItemsProcessed(state.iterations() * 32);
+}
+BENCHMARK(BM_PropagationCache_Update)->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+// Impulse Response Synthesis Benchmarks
+// =============================================================================
+
+// One IR from a 1024-ray trace of the shoebox, as the updater's background
+// thread synthesizes it; the argument adds kernel preparation (1)
+static void BM_ImpulseResponse_Synthesize(benchmark::State &state) {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryPacketCallback(ShoeboxPacket);
+  tracer.SetRayCount(1024);
+  const PropagationResult result = tracer.Trace({5, 2, 5}, {15, 2, 10});
+  ImpulseResponseSynthesizer synthesizer;
+  ConvolutionReverb reverb;
+  std::vector<float> ir;
+
+  for (auto _ : state) {
+    synthesizer.Synthesize(result, ir);
+    if (state.range(0) != 0) {
+      benchmark::DoNotOptimize(reverb.PrepareKernel(ir.data(), ir.size()));
+    }
+    benchmark::DoNotOptimize(ir.data());
+  }
+  state.counters["ir_seconds"] = static_cast<double>(ir.size()) / 44100.0;
+}
+BENCHMARK(BM_ImpulseResponse_Synthesize)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+// Convolving one block with a 2 s IR, steady (0) or crossfading (1)
+static void BM_ConvolutionReverb_Block(benchmark::State &state) {
+  ConvolutionReverb reverb;
+  reverb.SetEnabled(true);
+  std::vector<float> ir(88200, 0.0f);
+  ir[0] = 1.0f;
+  const auto kernel = reverb.PrepareKernel(ir.data(), ir.size());
+  reverb.QueueKernel(kernel, 0.0f);
+  std::vector<float> block(ConvolutionReverb::BLOCK_SIZE, 0.25f);
+  reverb.Process(block.data(), block.size());
+
+  for (auto _ : state) {
+    if (state.range(0) != 0 && !reverb.IsCrossfading()) {
+      reverb.QueueKernel(kernel, 10.0f);
+    }
+    reverb.Process(block.data(), block.size());
+    benchmark::DoNotOptimize(block.data());
+  }
+  state.SetItemsProcessed(state.iterations() * block.size());
+}
+BENCHMARK(BM_ConvolutionReverb_Block)->Arg(0)->Arg(1);
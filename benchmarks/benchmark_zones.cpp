@@ -0,0 +1,256 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Types.h"
+#include "../include/ZoneGrid.h"
+#include "../include/ZonePool.h"
+#include "../include/ZoneShape.h"
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Orpheus;
+
+// =============================================================================
+// Zone Broadphase Benchmarks
+// =============================================================================
+//
+// Open-world layout: zones scattered over a 4 km x 4 km map with radii of
+// 10-60 m. Each iteration is one frame's listener query.
+
+namespace {
+
+struct ZoneSphere {
+  Vector3 center;
+  float radius;
+};
+
+std::vector<ZoneSphere> MakeZones(size_t count) {
+  std::mt19937 rng(99);
+  std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+  std::uniform_real_distribution<float> radius(10.0f, 60.0f);
+  std::vector<ZoneSphere> zones(count);
+  for (auto &z : zones) {
+    z.center = {pos(rng), 0.0f, pos(rng)};
+    z.radius = radius(rng);
+  }
+  return zones;
+}
+
+// Navmesh-style outline: a jagged ring of the given vertex count
+std::vector<Vector2> MakeOutline(size_t vertices) {
+  std::vector<Vector2> poly;
+  for (size_t i = 0; i < vertices; ++i) {
+    float a = 6.2831853f * static_cast<float>(i) / static_cast<float>(vertices);
+    float r = (i % 2 == 0) ? 200.0f : 180.0f + 15.0f * std::sin(a * 9.0f);
+    poly.push_back({r * std::cos(a), r * std::sin(a)});
+  }
+  return poly;
+}
+
+} // namespace
+
+static void BM_Zones_LinearScan(benchmark::State &state) {
+  auto zones = MakeZones(static_cast<size_t>(state.range(0)));
+  Vector3 listener{10.0f, 1.8f, -25.0f};
+  for (auto _ : state) {
+    int hits = 0;
+    for (const auto &z : zones) {
+      float dx = listener.x - z.center.x;
+      float dy = listener.y - z.center.y;
+      float dz = listener.z - z.center.z;
+      hits += (dx * dx + dy * dy + dz * dz) <= z.radius * z.radius;
+    }
+    benchmark::DoNotOptimize(hits);
+    listener.x += 0.5f;
+  }
+}
+BENCHMARK(BM_Zones_LinearScan)->Arg(1000)->Arg(15000);
+
+static void BM_Zones_GridQuery(benchmark::State &state) {
+  auto zones = MakeZones(static_cast<size_t>(state.range(0)));
+  ZoneGrid grid(64.0f);
+  for (uint32_t i = 0; i < zones.size(); ++i) {
+    const auto &z = zones[i];
+    grid.Insert({z.center.x - z.radius, z.center.y - z.radius,
+                 z.center.z - z.radius},
+                {z.center.x + z.radius, z.center.y + z.radius,
+                 z.center.z + z.radius},
+                ZoneLayer::Audio, i);
+  }
+  Vector3 listener{10.0f, 1.8f, -25.0f};
+  for (auto _ : state) {
+    int hits = 0;
+    grid.QueryPoint(listener, ZoneLayer::Audio,
+                    [&](uint32_t) { ++hits; });
+    benchmark::DoNotOptimize(hits);
+    listener.x += 0.5f;
+  }
+}
+BENCHMARK(BM_Zones_GridQuery)->Arg(1000)->Arg(15000);
+
+static void BM_Zones_GridMove(benchmark::State &state) {
+  auto zones = MakeZones(static_cast<size_t>(state.range(0)));
+  ZoneGrid grid(64.0f);
+  std::vector<uint32_t> proxies;
+  for (uint32_t i = 0; i < zones.size(); ++i) {
+    const auto &z = zones[i];
+    proxies.push_back(grid.Insert(
+        {z.center.x - z.radius, -z.radius, z.center.z - z.radius},
+        {z.center.x + z.radius, z.radius, z.center.z + z.radius},
+        ZoneLayer::Audio, i));
+  }
+  // Move 100 zones per frame by 1 m
+  size_t next = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < 100; ++i) {
+      auto &z = zones[next];
+      z.center.x += 1.0f;
+      grid.Update(proxies[next],
+                  {z.center.x - z.radius, -z.radius, z.center.z - z.radius},
+                  {z.center.x + z.radius, z.radius, z.center.z + z.radius});
+      next = (next + 1) % zones.size();
+    }
+  }
+}
+BENCHMARK(BM_Zones_GridMove)->Arg(15000);
+
+// =============================================================================
+// Polygon Zone Benchmarks
+// =============================================================================
+//
+// Listener walking across a large polygon zone; each iteration evaluates
+// the zone volume once.
+
+static void BM_PolygonZone_NaiveEdges(benchmark::State &state) {
+  auto poly = MakeOutline(static_cast<size_t>(state.range(0)));
+  Vector3 listener{-250.0f, 1.0f, 3.0f};
+  for (auto _ : state) {
+    // Ray-cast against every edge, as the unpreprocessed shape did
+    bool inside = false;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+      if ((poly[i].y > listener.z) != (poly[j].y > listener.z) &&
+          listener.x < (poly[j].x - poly[i].x) * (listener.z - poly[i].y) /
+                               (poly[j].y - poly[i].y) +
+                           poly[i].x) {
+        inside = !inside;
+      }
+    }
+    benchmark::DoNotOptimize(inside);
+    listener.x = listener.x > 250.0f ? -250.0f : listener.x + 0.37f;
+  }
+}
+BENCHMARK(BM_PolygonZone_NaiveEdges)->Arg(64)->Arg(2000);
+
+static void BM_PolygonZone_Geometry(benchmark::State &state) {
+  auto zone = ZoneGeometry::Polygon(
+      MakeOutline(static_cast<size_t>(state.range(0))), 0.0f, 10.0f, 5.0f);
+  Vector3 listener{-250.0f, 1.0f, 3.0f};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(zone.ComputeVolume(listener));
+    listener.x = listener.x > 250.0f ? -250.0f : listener.x + 0.37f;
+  }
+}
+BENCHMARK(BM_PolygonZone_Geometry)->Arg(64)->Arg(2000);
+
+// =============================================================================
+// Zone Update Benchmarks
+// =============================================================================
+//
+// Dense town square: every zone is audible, so each iteration runs the full
+// per-frame volume pass. The callback variant mirrors the old per-zone
+// objects with std::function engine hooks.
+
+namespace {
+
+struct NullBackend {
+  AudioHandle Play(const std::string &) { return 1; }
+  bool IsValid(AudioHandle) { return true; }
+  void SetVolume(AudioHandle h, float v) { benchmark::DoNotOptimize(h + v); }
+  void Stop(AudioHandle) {}
+  void ApplySnapshot(const std::string &, float) {}
+  void RevertSnapshot(float) {}
+  void SetResident(const std::string &, bool) {}
+};
+
+struct CallbackZone {
+  std::string eventName;
+  ZoneGeometry geometry;
+  std::function<AudioHandle(const std::string &)> play;
+  std::function<void(AudioHandle, float)> setVolume;
+  std::function<void(AudioHandle)> stop;
+  std::function<bool(AudioHandle)> isValid;
+  AudioHandle handle = 0;
+  bool active = false;
+};
+
+std::vector<ZoneGeometry> MakeClusteredZones(size_t count) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+  std::vector<ZoneGeometry> zones;
+  for (size_t i = 0; i < count; ++i) {
+    zones.push_back(ZoneGeometry::Sphere({pos(rng), 0.0f, pos(rng)}, 5.0f,
+                                         60.0f));
+  }
+  return zones;
+}
+
+} // namespace
+
+static void BM_ZoneUpdate_Callbacks(benchmark::State &state) {
+  std::vector<std::shared_ptr<CallbackZone>> zones;
+  for (const auto &geometry : MakeClusteredZones(state.range(0))) {
+    auto zone = std::make_shared<CallbackZone>();
+    zone->eventName = "amb_" + std::to_string(zones.size());
+    zone->geometry = geometry;
+    zone->play = [](const std::string &) { return AudioHandle{1}; };
+    zone->setVolume = [](AudioHandle h, float v) {
+      benchmark::DoNotOptimize(h + v);
+    };
+    zone->stop = [](AudioHandle) {};
+    zone->isValid = [](AudioHandle) { return true; };
+    zones.push_back(std::move(zone));
+  }
+  Vector3 listener{0.0f, 0.0f, 0.0f};
+  std::vector<float> volumes(zones.size());
+  for (auto _ : state) {
+    float total = 0.0f;
+    for (size_t i = 0; i < zones.size(); ++i) {
+      volumes[i] = zones[i]->geometry.ComputeVolume(listener);
+      total += volumes[i];
+    }
+    const float scale = total > 1.0f ? 1.0f / total : 1.0f;
+    for (size_t i = 0; i < zones.size(); ++i) {
+      CallbackZone &zone = *zones[i];
+      if (zone.handle == 0 || !zone.isValid(zone.handle)) {
+        zone.handle = zone.play(zone.eventName);
+      }
+      zone.active = true;
+      zone.setVolume(zone.handle, volumes[i] * scale);
+    }
+    listener.x = listener.x > 10.0f ? -10.0f : listener.x + 0.01f;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZoneUpdate_Callbacks)->Arg(256)->Arg(4096);
+
+static void BM_ZoneUpdate_Pool(benchmark::State &state) {
+  ZonePool pool;
+  std::vector<uint32_t> candidates;
+  for (const auto &geometry : MakeClusteredZones(state.range(0))) {
+    candidates.push_back(
+        pool.Add("amb_" + std::to_string(candidates.size()), geometry));
+  }
+  NullBackend backend;
+  std::vector<uint32_t> live;
+  Vector3 listener{0.0f, 0.0f, 0.0f};
+  for (auto _ : state) {
+    pool.Update(candidates, &listener, 1, true, backend, live);
+    listener.x = listener.x > 10.0f ? -10.0f : listener.x + 0.01f;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZoneUpdate_Pool)->Arg(256)->Arg(4096);
@@ -0,0 +1,228 @@
+/**
+ * @file AcousticProbeGrid.h
+ * @brief Baked acoustic probes with runtime interpolation.
+ *
+ * Provides the AcousticProbeGrid class: propagation traced offline at
+ * probe positions and stored in a memory-mappable file, so a runtime
+ * query is a few memory reads instead of a ray trace.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Error.h"
+#include "RaytracedAcoustics.h"
+#include "Types.h"
+
+namespace Orpheus {
+
+/// How AcousticProbeGrid::Sample() combines probes.
+enum class ProbeInterpolation {
+  Nearest,  ///< Probe of the closest lattice point
+  Trilinear ///< Weighted blend over the 8 surrounding lattice points
+};
+
+/**
+ * @brief Baked propagation at a point.
+ *
+ * Probes are traced with the source and listener both at the probe, so a
+ * sample describes how the surroundings respond to a sound played there.
+ */
+struct AcousticProbeSample {
+  bool valid = false; ///< Inside the baked volume with a probe nearby
+
+  float reflectionGainLow = 0.0f; ///< Summed reflected gain per band (0-1)
+  float reflectionGainMid = 0.0f;
+  float reflectionGainHigh = 0.0f;
+  float earlyReflectionGain = 0.0f;  ///< As in PropagationResult (0-1)
+  float earlyReflectionDelay = 0.0f; ///< Seconds (0 if no reflections)
+  float lateReverbTime = 0.0f;       ///< RT60 in seconds (0 if unknown)
+};
+
+/**
+ * @brief One probe as stored in a probe file (12 bytes).
+ */
+struct PackedAcousticProbe {
+  uint16_t gainLow;              ///< Reflected gain, unorm16
+  uint16_t gainMid;              ///< Reflected gain, unorm16
+  uint16_t gainHigh;             ///< Reflected gain, unorm16
+  uint16_t earlyReflectionGain;  ///< unorm16
+  uint16_t earlyReflectionDelay; ///< 10 microsecond units
+  uint16_t lateReverbTime;       ///< Milliseconds
+};
+
+/**
+ * @brief Baked acoustic probes on a regular lattice.
+ *
+ * Probes are baked offline with BakeGrid() (one probe per lattice point)
+ * or BakeProbes() (probes placed in the scene; each lattice point refers
+ * to its nearest probe). The result is a flat little-endian file image:
+ * a Header, the packed probes, and for placed probes the lattice-to-probe
+ * table and the probe positions. Load() maps such a file read-only, so
+ * large bakes cost no load time and share pages between processes.
+ *
+ * Sample() reads the probes of the closest lattice point (Nearest) or
+ * blends the 8 lattice points around a position (Trilinear). Points more
+ * than half a spacing outside the lattice are not covered. Placed probes
+ * are matched by straight-line distance, so place them on both sides of
+ * thin walls.
+ *
+ * @par Example Usage:
+ * @code
+ * // Offline (see the orpheus_bake tool)
+ * AcousticProbeGrid baked;
+ * baked.LoadFromMemory(
+ *     AcousticProbeGrid::BakeGrid(tracer, {0, 0, 0}, {80, 20, 30}, 2.0f));
+ * baked.Save("cathedral.probes");
+ *
+ * // Runtime
+ * auto probes = std::make_shared<AcousticProbeGrid>();
+ * if (probes->Load("cathedral.probes").IsOk()) {
+ *   audio.SetAcousticProbes(probes);
+ * }
+ * AcousticProbeSample s = audio.SampleAcousticProbes(sourcePosition);
+ * @endcode
+ */
+class AcousticProbeGrid {
+public:
+  /// File identifier, "OAPG".
+  static constexpr uint32_t kMagic = 0x4750414Fu;
+  /// Current file format version.
+  static constexpr uint32_t kFormatVersion = 1;
+  /// Lattice points a bake may hold.
+  static constexpr size_t kMaxPoints = size_t{1} << 24;
+  /// Lattice-to-probe table entry for points without a probe.
+  static constexpr uint32_t kNoProbe = UINT32_MAX;
+
+  /**
+   * @brief Probe file header, at offset 0.
+   */
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    float originX, originY, originZ; ///< First lattice point
+    float spacing;                   ///< Lattice spacing
+    uint32_t dimX, dimY, dimZ;       ///< Lattice points per axis
+    uint32_t probeCount;
+    uint32_t rayCount;       ///< Rays traced per probe
+    uint32_t probeOffset;    ///< PackedAcousticProbe[probeCount]
+    uint32_t indexOffset;    ///< uint32_t per lattice point, 0 for grids
+    uint32_t positionOffset; ///< 3 floats per probe, 0 for grids
+    uint32_t reserved[2];
+  };
+
+  /// Called with (probes baked, probe count) while baking.
+  using BakeProgress = std::function<void(size_t, size_t)>;
+
+  AcousticProbeGrid() = default;
+  ~AcousticProbeGrid();
+  AcousticProbeGrid(const AcousticProbeGrid &) = delete;
+  AcousticProbeGrid &operator=(const AcousticProbeGrid &) = delete;
+
+  /**
+   * @brief Bake one probe per lattice point in a box.
+   * @param tracer Tracer with geometry, ray count and seed set up.
+   * @param min Minimum corner (first lattice point).
+   * @param max Maximum corner.
+   * @param spacing Lattice spacing in world units.
+   * @param progress Optional progress callback.
+   * @return File image, or empty if the lattice is empty or exceeds
+   *         kMaxPoints.
+   */
+  static std::vector<uint8_t> BakeGrid(const AcousticRayTracer &tracer,
+                                       const Vector3 &min, const Vector3 &max,
+                                       float spacing,
+                                       const BakeProgress &progress = nullptr);
+
+  /**
+   * @brief Bake probes at placed positions.
+   *
+   * Each lattice point of the box refers to its nearest probe.
+   * @param tracer Tracer with geometry, ray count and seed set up.
+   * @param positions Probe positions.
+   * @param count Number of probes.
+   * @param min Minimum corner of the lookup lattice.
+   * @param max Maximum corner of the lookup lattice.
+   * @param spacing Lookup lattice spacing.
+   * @param progress Optional progress callback.
+   * @return File image, or empty if there are no probes or the lattice is
+   *         empty or exceeds kMaxPoints.
+   */
+  static std::vector<uint8_t>
+  BakeProbes(const AcousticRayTracer &tracer, const Vector3 *positions,
+             size_t count, const Vector3 &min, const Vector3 &max,
+             float spacing, const BakeProgress &progress = nullptr);
+
+  /**
+   * @brief Map a probe file read-only.
+   * @return FileNotFound if the file cannot be opened, InvalidFormat if it
+   *         is not a valid probe file. The grid is empty on failure.
+   */
+  Status Load(const std::string &path);
+
+  /**
+   * @brief Use a file image held in memory (e.g. from BakeGrid()).
+   * @return InvalidFormat if the image is not valid.
+   */
+  Status LoadFromMemory(std::vector<uint8_t> image);
+
+  /**
+   * @brief Write the loaded file image.
+   */
+  Status Save(const std::string &path) const;
+
+  /**
+   * @brief Release the probes.
+   */
+  void Unload();
+
+  /**
+   * @brief Look up baked propagation at a position.
+   */
+  [[nodiscard]] AcousticProbeSample
+  Sample(const Vector3 &position,
+         ProbeInterpolation mode = ProbeInterpolation::Trilinear) const;
+
+  [[nodiscard]] bool IsLoaded() const { return m_Data != nullptr; }
+
+  /**
+   * @brief Whether the probes are read from a mapped file.
+   */
+  [[nodiscard]] bool IsMapped() const { return m_Mapping != nullptr; }
+
+  [[nodiscard]] const Header &GetHeader() const { return m_Header; }
+  [[nodiscard]] size_t GetProbeCount() const { return m_Header.probeCount; }
+
+  /**
+   * @brief Decoded probe, without interpolation.
+   */
+  [[nodiscard]] AcousticProbeSample GetProbe(uint32_t probe) const;
+
+  /**
+   * @brief Position a probe was baked at.
+   */
+  [[nodiscard]] Vector3 GetProbePosition(uint32_t probe) const;
+
+private:
+  static std::vector<uint8_t> Bake(const AcousticRayTracer &tracer,
+                                   const Vector3 *positions, size_t count,
+                                   const Header &lattice, bool placed,
+                                   const BakeProgress &progress);
+  Status Validate();
+  [[nodiscard]] uint32_t ProbeAt(uint32_t x, uint32_t y, uint32_t z) const;
+
+  const uint8_t *m_Data = nullptr;
+  size_t m_Size = 0;
+  std::vector<uint8_t> m_Image; ///< Owned image from LoadFromMemory()
+  void *m_Mapping = nullptr;    ///< Mapped view from Load()
+  Header m_Header{};
+  const PackedAcousticProbe *m_Probes = nullptr;
+  const uint32_t *m_Index = nullptr; ///< Null if probes are the lattice
+  const float *m_Positions = nullptr;
+};
+
+} // namespace Orpheus
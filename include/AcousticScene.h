@@ -0,0 +1,160 @@
+/**
+ * @file AcousticScene.h
+ * @brief Built-in acoustic geometry for ray-traced propagation.
+ *
+ * Provides the AcousticScene class, a set of triangle meshes tagged with
+ * acoustic material ids that answers the ray tracer's packet queries
+ * through a TriangleBVH.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "RaytracedAcoustics.h"
+#include "TriangleBVH.h"
+#include "Types.h"
+
+namespace Orpheus {
+
+/// Identifies a mesh in an AcousticScene.
+using AcousticMeshID = uint32_t;
+
+/**
+ * @brief Triangle meshes answering acoustic rays without a game callback.
+ *
+ * Each mesh carries an acoustic material id (see
+ * AcousticRayTracer::RegisterMaterial()). Surfaces are two-sided: the
+ * reported normal always faces the incoming ray.
+ *
+ * Acoustic rays do not need render detail, so a mesh can be simplified
+ * when added: with a detail size, vertices are clustered on a grid of
+ * that spacing and triangles that collapse are dropped, so features
+ * smaller than the detail size (mouldings, railings, clutter) disappear
+ * while walls keep their shape. The clustering is chosen from the
+ * vertices passed to AddMesh() and kept when the mesh moves.
+ *
+ * Adding or removing meshes marks the scene for a full SAH rebuild;
+ * moving a mesh's vertices only refits the tree. Both happen in Commit(),
+ * which must be called before querying after changes. Queries are const
+ * and may run concurrently. Edits and Commit() may run while another
+ * thread queries (the voice propagation worker, for one): each query
+ * packet holds a shared lock and each edit an exclusive one, so an edit
+ * waits for at most one packet.
+ *
+ * @par Example Usage:
+ * @code
+ * auto scene = std::make_shared<AcousticScene>();
+ * AcousticRayTracer &tracer = audio.GetRayTracer();
+ * scene->AddMesh(verts, vertCount, indices, indexCount,
+ *                tracer.GetMaterialID("Concrete"), 0.5f);
+ * audio.SetAcousticScene(scene);
+ * @endcode
+ */
+class AcousticScene {
+public:
+  /// Returned for meshes that do not exist.
+  static constexpr AcousticMeshID kInvalidMesh = UINT32_MAX;
+
+  /**
+   * @brief Add a triangle mesh.
+   * @param vertices Vertex positions (copied).
+   * @param vertexCount Number of vertices.
+   * @param indices Three indices per triangle (copied).
+   * @param indexCount Number of indices (a multiple of 3).
+   * @param material Acoustic material id.
+   * @param detailSize Clustering grid spacing for simplification (world
+   *                   units); 0 keeps every triangle.
+   * @return Mesh ID, or kInvalidMesh if an index is out of range.
+   */
+  AcousticMeshID AddMesh(const Vector3 *vertices, size_t vertexCount,
+                         const uint32_t *indices, size_t indexCount,
+                         AcousticMaterialID material, float detailSize = 0.0f);
+
+  /**
+   * @brief Move a mesh's vertices (refit, no rebuild).
+   * @param mesh Mesh to update.
+   * @param vertices New positions.
+   * @param vertexCount Must match the count passed to AddMesh().
+   * @return false if the mesh does not exist or the count differs.
+   */
+  bool UpdateMesh(AcousticMeshID mesh, const Vector3 *vertices,
+                  size_t vertexCount);
+
+  /**
+   * @brief Change a mesh's material.
+   */
+  void SetMeshMaterial(AcousticMeshID mesh, AcousticMaterialID material);
+
+  /**
+   * @brief Remove a mesh.
+   */
+  void RemoveMesh(AcousticMeshID mesh);
+
+  /**
+   * @brief Apply pending changes (rebuild or refit the BVH).
+   */
+  void Commit();
+
+  /**
+   * @brief Intersect a packet of rays, as a GeometryPacketCallback does.
+   */
+  void Intersect(const AcousticRayPacket &rays, AcousticHitPacket &hits) const;
+
+  /**
+   * @brief Make a packet callback tracing against a scene.
+   *
+   * The callback keeps the scene alive. Commit() the scene before
+   * tracing; it is not committed by the callback.
+   */
+  static GeometryPacketCallback
+  MakeCallback(std::shared_ptr<const AcousticScene> scene);
+
+  /**
+   * @brief Incremented whenever query results may have changed (commits
+   *        and material changes).
+   */
+  [[nodiscard]] uint32_t GetVersion() const { return m_Version; }
+
+  [[nodiscard]] size_t GetMeshCount() const;
+
+  /**
+   * @brief Committed triangles, after simplification.
+   */
+  [[nodiscard]] size_t GetTriangleCount() const {
+    return m_TriangleMesh.size();
+  }
+  [[nodiscard]] const TriangleBVH &GetBVH() const { return m_BVH; }
+
+private:
+  struct Mesh {
+    std::vector<Vector3> vertices;     ///< As passed in
+    std::vector<uint32_t> cluster;     ///< Per vertex; empty if unsimplified
+    std::vector<uint32_t> clusterSize; ///< Vertices per cluster
+    std::vector<uint32_t> indices;     ///< Into the clusters, mesh-local
+    uint32_t firstVertex;              ///< In m_Vertices after a rebuild
+    AcousticMaterialID material;
+    bool alive;
+  };
+
+  static void Simplify(Mesh &mesh, const uint32_t *indices,
+                       size_t indexCount, float detailSize);
+  void WriteVertices(const Mesh &mesh);
+  void ComputeNormals();
+
+  std::vector<Mesh> m_Meshes; ///< By ID
+  std::vector<Vector3> m_Vertices;
+  std::vector<uint32_t> m_Indices; ///< Global, three per triangle
+  std::vector<AcousticMeshID> m_TriangleMesh; ///< Per triangle
+  std::vector<Vector3> m_Normals;             ///< Per triangle, unit
+  TriangleBVH m_BVH;
+  bool m_NeedsRebuild = false;
+  bool m_NeedsRefit = false;
+  uint32_t m_Version = 0;
+  mutable std::shared_mutex m_Mutex; ///< Shared by queries
+};
+
+} // namespace Orpheus
@@ -0,0 +1,115 @@
+/**
+ * @file AssetCache.h
+ * @brief Reference-counted background loading of audio assets.
+ *
+ * Provides the AssetCache class, which loads assets on a worker thread
+ * ahead of playback so starting a voice does not block on file I/O.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Orpheus {
+
+/**
+ * @brief Loads one asset on the loader thread.
+ *
+ * @param path Asset path.
+ * @param stream true if the asset will be streamed from disk.
+ * @return The loaded asset, or nullptr on failure.
+ */
+using AssetLoadFunction =
+    std::function<std::shared_ptr<void>(const std::string &path, bool stream)>;
+
+// Forward declaration for PIMPL
+struct AssetCacheImpl;
+
+/**
+ * @brief Keeps prefetched assets resident while they are referenced.
+ *
+ * Prefetch() queues a load on a single background thread and Release()
+ * drops the reference again; an asset is evicted when its last reference
+ * goes away. Find() never waits for a load: it returns the asset only if
+ * it is already resident, so callers fall back to loading synchronously.
+ *
+ * Evicting an asset only drops the cache's reference, so voices that hold
+ * their own reference keep playing.
+ *
+ * @par Example Usage:
+ * @code
+ * AssetCache cache([](const std::string &path, bool stream) {
+ *   return LoadSource(path, stream);
+ * });
+ * cache.Prefetch("ambience/forest.ogg", true);
+ * ...
+ * if (auto asset = cache.Find("ambience/forest.ogg")) { ... }
+ * cache.Release("ambience/forest.ogg");
+ * @endcode
+ */
+class AssetCache {
+public:
+  /**
+   * @brief Create a cache. The loader thread starts on the first Prefetch().
+   * @param load Function run on the loader thread for each asset.
+   */
+  explicit AssetCache(AssetLoadFunction load);
+
+  /**
+   * @brief Stop the loader thread. Pending loads are abandoned.
+   */
+  ~AssetCache();
+
+  AssetCache(const AssetCache &) = delete;
+  AssetCache &operator=(const AssetCache &) = delete;
+
+  /**
+   * @brief Add a reference to an asset, loading it in the background.
+   * @param path Asset path.
+   * @param stream true if the asset will be streamed from disk.
+   */
+  void Prefetch(const std::string &path, bool stream);
+
+  /**
+   * @brief Drop a reference added by Prefetch(). Evicts at zero.
+   * @param path Asset path.
+   */
+  void Release(const std::string &path);
+
+  /**
+   * @brief Get a resident asset without waiting.
+   * @param path Asset path.
+   * @return The asset, or nullptr if it is not loaded (yet).
+   */
+  [[nodiscard]] std::shared_ptr<void> Find(const std::string &path) const;
+
+  /**
+   * @brief Check if an asset is loaded and referenced.
+   */
+  [[nodiscard]] bool IsResident(const std::string &path) const;
+
+  /**
+   * @brief Number of loaded, referenced assets.
+   */
+  [[nodiscard]] size_t GetResidentCount() const;
+
+  /**
+   * @brief Number of assets queued or loading.
+   */
+  [[nodiscard]] size_t GetPendingCount() const;
+
+  /**
+   * @brief Block until no loads are queued or running.
+   * @param timeout Maximum time to wait.
+   * @return true if the loader is idle.
+   */
+  bool WaitIdle(std::chrono::milliseconds timeout);
+
+private:
+  std::unique_ptr<AssetCacheImpl> m_Impl;
+};
+
+} // namespace Orpheus
@@ -11,21 +11,31 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "AcousticProbeGrid.h"
+#include "AcousticScene.h"
 #include "AudioCodec.h"
 #include "AudioZone.h"
+#include "Bus.h"
+#include "BusMeter.h"
 #include "Compressor.h"
 #include "ConvolutionReverb.h"
 #include "Error.h"
 #include "HDRAudio.h"
+#include "ImpulseResponseSynthesizer.h"
 #include "Listener.h"
 #include "MusicManager.h"
 #include "OcclusionMaterial.h"
 #include "OcclusionQuery.h"
+#include "OcclusionScene.h"
 #include "Parameter.h"
+#include "PortalGraph.h"
 #include "Profiler.h"
+#include "PropagationField.h"
+#include "PropagationProcessor.h"
 #include "RTPCCurve.h"
 #include "RaytracedAcoustics.h"
 #include "ReverbBus.h"
@@ -38,7 +48,6 @@
 namespace Orpheus {
 
 // Forward declarations for types used in API
-class Bus;
 class Parameter;
 
 /**
@@ -255,6 +264,9 @@ public:
    * @param min Minimum corner of the box.
    * @param max Maximum corner of the box.
    * @param fadeDistance Distance for volume fade at edges.
+   *
+   * Full volume inside the box, fading linearly to silence
+   * fadeDistance outside its faces.
    */
   void AddBoxZone(const std::string &eventName, const Vector3 &min,
                   const Vector3 &max, float fadeDistance = 5.0f);
@@ -266,6 +278,10 @@ public:
    * @param minY Minimum height.
    * @param maxY Maximum height.
    * @param fadeDistance Distance for volume fade at edges.
+   *
+   * Full volume inside the extruded polygon, fading linearly to silence
+   * fadeDistance outside it. Large polygons (thousands of vertices) are
+   * preprocessed once so per-frame tests stay cheap.
    */
   void AddPolygonZone(const std::string &eventName,
                       const std::vector<Vector2> &points, float minY,
@@ -288,11 +304,17 @@ public:
   [[nodiscard]] bool IsZoneCrossfadeEnabled() const;
 
   /**
-   * @brief Get a zone by event name for direct manipulation.
+   * @brief Get a read-only view of a zone by event name.
+   *
+   * Change zones through SetZonePosition(), SetZoneRadii() and
+   * SetZonePrefetchRadius(). The view stays valid for the lifetime of the
+   * manager.
+   *
    * @param eventName Event name used when creating the zone.
-   * @return Pointer to the zone, or nullptr if not found.
+   * @return The zone, or std::nullopt if not found.
    */
-  [[nodiscard]] AudioZone *GetZone(const std::string &eventName);
+  [[nodiscard]] std::optional<AudioZone>
+  GetZone(const std::string &eventName) const;
 
   /**
    * @brief Set the position of a zone.
@@ -309,6 +331,32 @@ public:
    */
   void SetZoneRadii(const std::string &eventName, float inner, float outer);
 
+  /**
+   * @brief Set how far beyond its outer radius a zone preloads its event.
+   *
+   * Inside this distance the zone's sounds are loaded in the background
+   * (streams are opened and their first block read ahead), so entering
+   * the zone only starts a voice. The assets are released once every
+   * listener is 25% further away than the prefetch radius.
+   *
+   * @param eventName Event name of the zone.
+   * @param radius Prefetch distance in world units (0 disables).
+   */
+  void SetZonePrefetchRadius(const std::string &eventName, float radius);
+
+  /**
+   * @brief Set the prefetch radius given to zones created afterwards.
+   * @param radius Prefetch distance in world units (default: 20).
+   */
+  void SetDefaultZonePrefetchRadius(float radius);
+
+  /**
+   * @brief Check if an event's sounds are loaded and ready to start.
+   * @param eventName Name of the registered event.
+   * @return true if playing the event will not load from disk.
+   */
+  [[nodiscard]] bool IsEventResident(const std::string &eventName) const;
+
   /// @}
 
   /// @name Listener Management
@@ -364,10 +412,18 @@ public:
   /// @{
 
   /**
-   * @brief Create a new audio bus.
+   * @brief Create a new audio bus mixed into a parent bus.
+   *
+   * Buses form a tree rooted at "Master", e.g. Master -> SFX -> Weapons.
+   * Voices on a bus are mixed by that bus, so its volume, fades and effects
+   * also apply to every child bus.
+   *
    * @param name Unique bus name.
+   * @param parent Parent bus name (empty creates a root bus).
+   * @return Status indicating success or error.
    */
-  void CreateBus(const std::string &name);
+  Status CreateBus(const std::string &name,
+                   const std::string &parent = "Master");
 
   /**
    * @brief Get a bus by name.
@@ -376,6 +432,13 @@ public:
    */
   [[nodiscard]] Result<std::shared_ptr<Bus>> GetBus(const std::string &name);
 
+  /**
+   * @brief Get the dense id of a bus (same as Bus::GetIndex()).
+   * @param name Bus name.
+   * @return Result containing the bus id or error.
+   */
+  [[nodiscard]] Result<BusID> GetBusID(const std::string &name) const;
+
   /**
    * @brief Set compressor settings for a bus.
    * @param busName Bus name.
@@ -393,11 +456,35 @@ public:
 
   /**
    * @brief Set a hard limiter on a bus.
+   *
+   * Uses a 5 ms lookahead brickwall limiter, so the bus output is delayed
+   * by roughly that amount.
+   *
    * @param busName Bus name.
    * @param thresholdDb Limiting threshold in dB.
    */
   void SetBusLimiter(const std::string &busName, float thresholdDb);
 
+  /**
+   * @brief Enable/disable peak, RMS and loudness metering on a bus.
+   * @param busName Bus name.
+   * @param enabled true to start metering.
+   * @return Error if the bus does not exist.
+   */
+  Status SetBusMeteringEnabled(const std::string &busName, bool enabled);
+
+  /**
+   * @brief Get the latest meter values of a bus.
+   *
+   * Safe to call from any thread. Returns default (silent) values until the
+   * first 100 ms block has been measured.
+   *
+   * @param busName Bus name.
+   * @return Meter reading, or error if the bus does not exist.
+   */
+  [[nodiscard]] Result<BusMeterReading>
+  GetBusMeter(const std::string &busName) const;
+
   /// @}
 
   /// @name Convolution Reverb
@@ -434,6 +521,28 @@ public:
   [[nodiscard]] ConvolutionReverb *
   GetConvolutionReverb(const std::string &name);
 
+  /**
+   * @brief Update a convolution reverb's IR from traced propagation.
+   *
+   * The IR is synthesized on a background thread and crossfaded in by the
+   * reverb (see ImpulseResponseUpdater). Submissions are throttled.
+   * @param name Reverb name.
+   * @param result Propagation traced to the listener.
+   * @return false if the reverb does not exist or the submission was
+   *         throttled.
+   */
+  bool SubmitConvolutionReverbPropagation(const std::string &name,
+                                          const PropagationResult &result);
+
+  /**
+   * @brief Get the IR updater of a convolution reverb, to tune its
+   *        throttle and crossfade.
+   * @param name Reverb name.
+   * @return Pointer to the updater, or nullptr if not found.
+   */
+  [[nodiscard]] ImpulseResponseUpdater *
+  GetImpulseResponseUpdater(const std::string &name);
+
   /// @}
 
   /// @name HDR Audio
@@ -530,15 +639,113 @@ public:
 
   /**
    * @brief Set geometry intersection callback for ray tracing.
+   *
+   * Voice propagation calls it on its background thread while the main
+   * thread runs; the old callback is no longer called once this returns.
    * @param callback Function that tests ray-scene intersections.
    */
   void SetGeometryCallback(GeometryCallback callback);
 
+  /**
+   * @brief Set packet geometry callback for ray tracing.
+   *
+   * Used instead of the per-ray callback while set. Hit materials are ids
+   * from GetRayTracer().RegisterMaterial(). Called on the voice
+   * propagation thread, like SetGeometryCallback().
+   * @param callback Function that intersects packets of rays.
+   */
+  void SetGeometryPacketCallback(GeometryPacketCallback callback);
+
   /**
    * @brief Get the ray tracer instance.
+   *
+   * Background propagation traces with a copy taken when each batch
+   * starts, so the tracer can be reconfigured at any time; changes apply
+   * from the next batch. Callbacks set directly on it may still be called
+   * by the running batch after they are replaced.
    */
   [[nodiscard]] AcousticRayTracer &GetRayTracer();
 
+  /**
+   * @brief Trace acoustic rays against built-in geometry.
+   *
+   * Installs a packet callback tracing against the scene, which is
+   * committed on each Update() (and now) unless voice propagation is
+   * being traced. The scene may be edited at any time: queries and edits
+   * lock it (see AcousticScene). Replaced by a later
+   * SetGeometryPacketCallback(); pass nullptr to remove it.
+   * @param scene Triangle meshes with acoustic material ids.
+   */
+  void SetAcousticScene(std::shared_ptr<AcousticScene> scene);
+
+  /**
+   * @brief Get the scene set with SetAcousticScene() (may be null).
+   */
+  [[nodiscard]] std::shared_ptr<AcousticScene> GetAcousticScene() const;
+
+  /**
+   * @brief Use baked probes instead of live tracing.
+   *
+   * Probes are baked offline (see the orpheus_bake tool) and looked up
+   * with SampleAcousticProbes(). Pass nullptr to remove them.
+   * @param probes Loaded probe grid.
+   */
+  void SetAcousticProbes(std::shared_ptr<const AcousticProbeGrid> probes);
+
+  /**
+   * @brief Get the probes set with SetAcousticProbes() (may be null).
+   */
+  [[nodiscard]] std::shared_ptr<const AcousticProbeGrid>
+  GetAcousticProbes() const;
+
+  /**
+   * @brief Look up baked propagation at a position.
+   * @param position World position, typically a voice's.
+   * @param mode Nearest probe or trilinear blend.
+   * @return Invalid sample if no probes are set or none cover the point.
+   */
+  [[nodiscard]] AcousticProbeSample SampleAcousticProbes(
+      const Vector3 &position,
+      ProbeInterpolation mode = ProbeInterpolation::Trilinear) const;
+
+  /**
+   * @brief Set the rays traced per frame for voice propagation.
+   *
+   * While ray tracing is enabled, Update() traces real voices in priority
+   * order within this budget on a background thread and applies the
+   * results to voice volume and low-pass on the following update (see
+   * PropagationProcessor). Voices covered by baked probes cost no rays.
+   * @param raysPerFrame Ray budget (default 8192).
+   */
+  void SetPropagationRayBudget(uint32_t raysPerFrame);
+
+  /**
+   * @brief Set how often audible voices are re-traced (default 4 Hz).
+   */
+  void SetPropagationUpdateRate(float hz);
+
+  /**
+   * @brief Set the smoothing time of propagation changes (default 0.2 s).
+   */
+  void SetPropagationSmoothingTime(float seconds);
+
+  /**
+   * @brief Get the propagation currently applied to a voice.
+   *
+   * The reverb send is not applied by the mixer; games can use it to
+   * drive their own reverb levels.
+   * @param id Voice ID.
+   * @return Smoothed volume, low-pass cutoff and reverb send (neutral
+   *         until traced), or an error if the voice does not exist.
+   */
+  [[nodiscard]] Result<PropagationEffect>
+  GetVoicePropagation(VoiceID id) const;
+
+  /**
+   * @brief Get the processor tracing voice propagation.
+   */
+  [[nodiscard]] PropagationProcessor &GetPropagationProcessor();
+
   /// @}
 
   /// @name Audio Codec
@@ -666,6 +873,19 @@ public:
                   uint8_t priority = 128, float fadeIn = 0.5f,
                   float fadeOut = 0.5f);
 
+  /**
+   * @brief Add a mix zone with a box or polygon shape.
+   * @param name Unique zone name.
+   * @param snapshotName Snapshot to apply.
+   * @param geometry Zone shape (see ZoneGeometry).
+   * @param priority Zone priority.
+   * @param fadeIn Fade-in time.
+   * @param fadeOut Fade-out time.
+   */
+  void AddMixZone(const std::string &name, const std::string &snapshotName,
+                  const ZoneGeometry &geometry, uint8_t priority = 128,
+                  float fadeIn = 0.5f, float fadeOut = 0.5f);
+
   /**
    * @brief Remove a mix zone.
    * @param name Zone name.
@@ -724,6 +944,14 @@ public:
   [[nodiscard]] Result<std::shared_ptr<ReverbBus>>
   GetReverbBus(const std::string &name);
 
+  /**
+   * @brief Get the dense id of a reverb bus (same as ReverbBus::GetIndex()).
+   * @param name Reverb bus name.
+   * @return Result containing the reverb bus id or error.
+   */
+  [[nodiscard]] Result<ReverbBusID>
+  GetReverbBusID(const std::string &name) const;
+
   /**
    * @brief Set reverb parameters with optional fade.
    * @param name Reverb bus name.
@@ -748,6 +976,16 @@ public:
                      const Vector3 &pos, float inner, float outer,
                      uint8_t priority = 128);
 
+  /**
+   * @brief Add a reverb zone with a box or polygon shape.
+   * @param name Unique zone name.
+   * @param reverbBusName Target reverb bus.
+   * @param geometry Zone shape (see ZoneGeometry).
+   * @param priority Zone priority.
+   */
+  void AddReverbZone(const std::string &name, const std::string &reverbBusName,
+                     const ZoneGeometry &geometry, uint8_t priority = 128);
+
   /**
    * @brief Remove a reverb zone.
    * @param name Zone name.
@@ -786,11 +1024,114 @@ public:
    */
   void SetOcclusionQueryCallback(OcclusionQueryCallback callback);
 
+  /**
+   * @brief Set callback for batched, asynchronous occlusion queries.
+   *
+   * Each Update() submits all voices due for a refresh as one array of
+   * rays; complete it with CompleteOcclusionBatch(), e.g. from a physics
+   * job on a later frame. Takes precedence over the per-voice callback
+   * while set; pass an empty function to clear it.
+   * @param callback Batch query function.
+   */
+  void SetOcclusionBatchCallback(OcclusionBatchCallback callback);
+
+  /**
+   * @brief Answer occlusion queries from built-in geometry.
+   *
+   * Installs a batch callback that traces each frame's rays against the
+   * scene (committing pending scene changes first). Replaced by a later
+   * SetOcclusionBatchCallback(); pass nullptr to remove it.
+   * @param scene Triangle meshes with occlusion material ids.
+   */
+  void SetOcclusionScene(std::shared_ptr<OcclusionScene> scene);
+
+  /**
+   * @brief Get the scene set with SetOcclusionScene() (may be null).
+   */
+  [[nodiscard]] std::shared_ptr<OcclusionScene> GetOcclusionScene() const;
+
+  /**
+   * @brief Answer occlusion from a grid propagation field.
+   *
+   * The field is flooded from the listener during Update() (only when the
+   * listener changes cell or the grid changes) and every voice inside it
+   * reads its obstruction and diffracted path with one lookup instead of
+   * a query. Voices outside the field still use the callbacks or scene.
+   * Pass nullptr to remove it.
+   * @param field Configured and voxelized field.
+   */
+  void SetOcclusionField(std::shared_ptr<PropagationField> field);
+
+  /**
+   * @brief Get the field set with SetOcclusionField() (may be null).
+   */
+  [[nodiscard]] std::shared_ptr<PropagationField> GetOcclusionField() const;
+
+  /**
+   * @brief Add a room for portal-based occlusion.
+   *
+   * While the listener is inside a room, voices inside rooms take their
+   * occlusion and apparent position from the shortest path through the
+   * portals instead of raycasts. Paths are re-searched only when the
+   * listener changes room or a portal changes.
+   * @param shape Room volume (the fade band is ignored).
+   * @return Room ID.
+   */
+  RoomID CreateRoom(const ZoneGeometry &shape);
+
+  /**
+   * @brief Connect two rooms with a door or window.
+   * @param a First room.
+   * @param b Second room.
+   * @param position Portal centre.
+   * @param openness 0 (closed) to 1 (open).
+   * @return Portal ID, or an error if a room does not exist or a == b.
+   */
+  Result<PortalID> AddPortal(RoomID a, RoomID b, const Vector3 &position,
+                             float openness = 1.0f);
+
+  /**
+   * @brief Open or close a portal.
+   * @param portal Portal ID.
+   * @param openness 0 (closed) to 1 (open).
+   */
+  void SetPortalOpenness(PortalID portal, float openness);
+
+  /**
+   * @brief Get the position a voice is heard from.
+   *
+   * The end of its portal path when routed through rooms, otherwise its
+   * own position.
+   * @param id Voice ID.
+   * @return Position, or an error if the voice does not exist.
+   */
+  [[nodiscard]] Result<Vector3> GetVoiceApparentPosition(VoiceID id) const;
+
+  /**
+   * @brief Deliver the results of a batched occlusion query.
+   *
+   * Thread-safe; results are applied on the next Update().
+   * @param batch Batch id passed to the batch callback.
+   * @param hits Hits of all rays in the batch.
+   * @param count Number of hits.
+   */
+  void CompleteOcclusionBatch(OcclusionBatchID batch,
+                              const OcclusionRayHit *hits, size_t count);
+
   /**
    * @brief Register a custom occlusion material.
    * @param mat Material to register.
+   * @return Material id for batched query hits.
    */
-  void RegisterOcclusionMaterial(const OcclusionMaterial &mat);
+  OcclusionMaterialID RegisterOcclusionMaterial(const OcclusionMaterial &mat);
+
+  /**
+   * @brief Get the id of a registered occlusion material.
+   * @param name Material name (built-in or registered).
+   * @return Material id, or an error if the name is not registered.
+   */
+  [[nodiscard]] Result<OcclusionMaterialID>
+  GetOcclusionMaterialID(const std::string &name) const;
 
   /**
    * @brief Enable or disable occlusion.
@@ -812,10 +1153,56 @@ public:
 
   /**
    * @brief Set occlusion update rate.
+   *
+   * Per-voice refresh rate for fully audible voices; quiet voices are
+   * refreshed up to four times less often.
    * @param hz Updates per second.
    */
   void SetOcclusionUpdateRate(float hz);
 
+  /**
+   * @brief Cap the number of occlusion queries issued per Update().
+   *
+   * Voices due for a refresh beyond the budget wait for a later frame,
+   * stalest first.
+   * @param maxQueriesPerFrame Maximum queries per frame (default: 32).
+   */
+  void SetOcclusionQueryBudget(uint32_t maxQueriesPerFrame);
+
+  /**
+   * @brief Set the occlusion result cache cell size.
+   *
+   * Voices whose source and listener fall into the same pair of cells
+   * share one occlusion result.
+   * @param size Cell edge length in world units (default: 0.5, 0 disables
+   *             the cache).
+   */
+  void SetOcclusionCacheCellSize(float size);
+
+  /**
+   * @brief Set how long cached occlusion results stay valid.
+   *
+   * Use 0 (never expire by time) together with
+   * SetOcclusionGeometryVersion() so static emitters heard from a still
+   * listener stop querying entirely.
+   * @param seconds Lifetime (default: 1.0).
+   */
+  void SetOcclusionCacheLifetime(float seconds);
+
+  /**
+   * @brief Report that occlusion geometry changed.
+   *
+   * Cached results are dropped whenever the version changes. Tracked
+   * automatically while an occlusion scene is set.
+   * @param version Any value that changes with the geometry.
+   */
+  void SetOcclusionGeometryVersion(uint32_t version);
+
+  /**
+   * @brief Drop all cached occlusion results.
+   */
+  void InvalidateOcclusionCache();
+
   /**
    * @brief Set lowpass filter range for occlusion.
    * @param minFreq Minimum frequency at full occlusion.
@@ -843,8 +1230,9 @@ public:
   /**
    * @brief Add a ducking rule for automatic volume control.
    *
-   * When audio plays on the sidechain bus, the target bus volume
-   * is automatically reduced.
+   * While voices on the sidechain bus are audible above the threshold,
+   * the target bus is attenuated inside the mixer with sample-accurate
+   * gain ramps.
    *
    * @param targetBus Bus to duck (e.g., "Music").
    * @param sidechainBus Bus that triggers ducking (e.g., "Dialogue").
@@ -852,11 +1240,17 @@ public:
    * @param attackTime Fade down time in seconds (default: 0.1).
    * @param releaseTime Fade up time in seconds (default: 0.5).
    * @param holdTime Hold ducked level after sidechain stops (default: 0.1).
+   * @param threshold Sidechain level in dB that triggers ducking
+   *                  (default: -50).
+   * @return OutOfRange if either bus exists beyond the first
+   *         Ducker::kMaxBuses buses, which cannot take part in ducking.
+   *         Rules naming buses not created yet are kept and bind later.
    */
-  void AddDuckingRule(const std::string &targetBus,
-                      const std::string &sidechainBus, float duckLevel = 0.3f,
-                      float attackTime = 0.1f, float releaseTime = 0.5f,
-                      float holdTime = 0.1f);
+  Status AddDuckingRule(const std::string &targetBus,
+                        const std::string &sidechainBus,
+                        float duckLevel = 0.3f, float attackTime = 0.1f,
+                        float releaseTime = 0.5f, float holdTime = 0.1f,
+                        float threshold = -50.0f);
 
   /**
    * @brief Remove a ducking rule.
@@ -971,6 +1365,13 @@ public:
   /// @}
 
 private:
+  struct ZoneBackend;
+
+  void UpdateAudioZones();
+  void AddShapedZone(const std::string &eventName,
+                     const ZoneGeometry &geometry,
+                     const std::string &snapshotName, float fadeIn,
+                     float fadeOut);
   void UpdateMixZones(const Vector3 &listenerPos);
   void UpdateReverbZones(const Vector3 &listenerPos);
 
@@ -2,57 +2,32 @@
  * @file AudioZone.h
  * @brief Spatial audio zones for positional sound playback.
  *
- * Provides AudioZone class for playing sounds that attenuate with
- * distance and optionally trigger snapshots.
+ * Provides the AudioZone class, a read-only view of one zone stored in an
+ * AudioManager's zone pool.
  */
 #pragma once
 
-#include <cmath>
-#include <functional>
+#include <cstdint>
 #include <string>
 
 #include "Types.h"
+#include "ZonePool.h"
+#include "ZoneShape.h"
 
 namespace Orpheus {
 
 /**
- * @brief Callback to play an event and return its handle.
- */
-using PlayEventCallback = std::function<AudioHandle(const std::string &)>;
-
-/**
- * @brief Callback to set volume on an audio handle.
- */
-using SetVolumeCallback = std::function<void(AudioHandle, float)>;
-
-/**
- * @brief Callback to stop an audio handle.
- */
-using StopCallback = std::function<void(AudioHandle)>;
-
-/**
- * @brief Callback to check if an audio handle is valid.
- */
-using IsValidCallback = std::function<bool(AudioHandle)>;
-
-/**
- * @brief Callback to apply a snapshot with fade.
- */
-using AudioZoneApplySnapshotCallback =
-    std::function<void(const std::string &, float)>;
-
-/**
- * @brief Callback to revert from a snapshot with fade.
- */
-using AudioZoneRevertSnapshotCallback = std::function<void(float)>;
-
-/**
- * @brief Spatial audio zone for positional ambient sounds.
+ * @brief View of a spatial audio zone for positional ambient sounds.
  *
- * AudioZone represents a spherical region that plays an audio event
- * when the listener enters. Volume is attenuated based on distance
- * with configurable inner/outer radii. Can optionally trigger a
- * snapshot when active.
+ * An audio zone is a region (sphere, box or polygon, see ZoneGeometry)
+ * that plays an audio event while the listener is inside it. Volume is
+ * attenuated based on distance with configurable inner/outer radii or a
+ * fade band around the shape. It can optionally trigger a snapshot when
+ * active.
+ *
+ * Zones live in AudioManager's ZonePool; AudioZone is a small handle into
+ * it returned by AudioManager::GetZone(). Use the AudioManager setters
+ * (SetZonePosition(), SetZoneRadii(), ...) to change a zone.
  *
  * @par Example:
  * A waterfall zone where sound gets louder as you approach and the
@@ -61,50 +36,11 @@ using AudioZoneRevertSnapshotCallback = std::function<void(float)>;
 class AudioZone {
 public:
   /**
-   * @brief Create an audio zone without snapshot.
-   * @param eventName Name of the event to play.
-   * @param position Center position in world space.
-   * @param innerRadius Full volume within this distance.
-   * @param outerRadius Sound fades to zero at this distance.
-   * @param playEvent Callback to play the event.
-   * @param setVolume Callback to set handle volume.
-   * @param stop Callback to stop the handle.
-   * @param isValid Callback to check handle validity.
-   */
-  AudioZone(const std::string &eventName, const Vector3 &position,
-            float innerRadius, float outerRadius, PlayEventCallback playEvent,
-            SetVolumeCallback setVolume, StopCallback stop,
-            IsValidCallback isValid);
-
-  /**
-   * @brief Create an audio zone with snapshot support.
-   * @param eventName Name of the event to play.
-   * @param position Center position in world space.
-   * @param innerRadius Full volume within this distance.
-   * @param outerRadius Sound fades to zero at this distance.
-   * @param playEvent Callback to play the event.
-   * @param setVolume Callback to set handle volume.
-   * @param stop Callback to stop the handle.
-   * @param isValid Callback to check handle validity.
-   * @param snapshotName Snapshot to apply when zone is active.
-   * @param applySnapshot Callback to apply the snapshot.
-   * @param revertSnapshot Callback to revert from snapshot.
-   * @param fadeIn Fade-in time for snapshot (seconds).
-   * @param fadeOut Fade-out time for snapshot (seconds).
-   */
-  AudioZone(const std::string &eventName, const Vector3 &position,
-            float innerRadius, float outerRadius, PlayEventCallback playEvent,
-            SetVolumeCallback setVolume, StopCallback stop,
-            IsValidCallback isValid, const std::string &snapshotName,
-            AudioZoneApplySnapshotCallback applySnapshot,
-            AudioZoneRevertSnapshotCallback revertSnapshot, float fadeIn = 0.5f,
-            float fadeOut = 0.5f);
-
-  /**
-   * @brief Update the zone based on listener position.
-   * @param listenerPos Current listener position.
+   * @brief Create a view of a pooled zone.
+   * @param pool Pool holding the zone.
+   * @param index Zone index in the pool.
    */
-  void Update(const Vector3 &listenerPos);
+  AudioZone(const ZonePool &pool, uint32_t index);
 
   /**
    * @brief Check if the zone is currently active.
@@ -131,78 +67,51 @@ public:
   [[nodiscard]] const std::string &GetEventName() const;
 
   /**
-   * @brief Get the zone position.
+   * @brief Get the zone position (center of the shape).
    * @return Reference to the position.
    */
   [[nodiscard]] const Vector3 &GetPosition() const;
 
   /**
-   * @brief Set the zone position (for dynamic zones).
-   * @param pos New center position.
-   */
-  void SetPosition(const Vector3 &pos);
-
-  /**
-   * @brief Get the inner radius.
+   * @brief Get the inner radius (0 for box and polygon zones).
    */
   [[nodiscard]] float GetInnerRadius() const;
 
   /**
-   * @brief Get the outer radius.
+   * @brief Get the outer radius (fade distance for box and polygon zones).
    */
   [[nodiscard]] float GetOuterRadius() const;
 
   /**
-   * @brief Set the zone radii (for dynamic zones).
-   * @param inner Inner radius (full volume).
-   * @param outer Outer radius (zero volume).
+   * @brief Get the zone shape.
    */
-  void SetRadii(float inner, float outer);
+  [[nodiscard]] const ZoneGeometry &GetGeometry() const;
 
   /**
-   * @brief Compute volume based on listener position without applying.
-   * @param listenerPos Current listener position.
+   * @brief Compute volume based on listener position.
+   * @param listenerPos Listener position.
    * @return Computed volume (0.0 - 1.0).
    */
   [[nodiscard]] float GetComputedVolume(const Vector3 &listenerPos) const;
 
   /**
-   * @brief Apply a normalized volume to the zone.
-   * @param volume Normalized volume to apply.
+   * @brief Get the prefetch distance beyond the outer radius.
    */
-  void ApplyVolume(float volume);
+  [[nodiscard]] float GetPrefetchRadius() const;
 
   /**
-   * @brief Ensure the zone is playing (start if not already).
+   * @brief Check if the zone currently holds its assets resident.
    */
-  void EnsurePlaying();
+  [[nodiscard]] bool IsPrefetched() const;
 
   /**
-   * @brief Stop the zone playback.
+   * @brief Get the handle of the zone's voice (0 if not playing).
    */
-  void StopPlaying();
+  [[nodiscard]] AudioHandle GetHandle() const;
 
 private:
-  float Distance(const Vector3 &a, const Vector3 &b) const;
-  float ComputeVolume(float dist);
-  float ComputeVolumeFromDist(float dist) const;
-
-  std::string m_EventName;
-  Vector3 m_Position;
-  float m_InnerRadius;
-  float m_OuterRadius;
-  PlayEventCallback m_PlayEvent;
-  SetVolumeCallback m_SetVolume;
-  StopCallback m_Stop;
-  IsValidCallback m_IsValid;
-  AudioHandle m_Handle;
-
-  std::string m_SnapshotName;
-  AudioZoneApplySnapshotCallback m_ApplySnapshot;
-  AudioZoneRevertSnapshotCallback m_RevertSnapshot;
-  bool m_WasActive;
-  float m_FadeInTime;
-  float m_FadeOutTime;
+  const ZonePool *m_Pool;
+  uint32_t m_Index;
 };
 
 } // namespace Orpheus
@@ -7,9 +7,12 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "BusMeter.h"
 #include "Compressor.h"
 #include "OpaqueHandles.h"
 #include "Types.h"
@@ -18,6 +21,10 @@ namespace Orpheus {
 
 // Forward declaration for PIMPL
 struct BusImpl;
+class Ducker;
+
+/// Dense bus identifier (see Bus::GetIndex()).
+using BusID = uint32_t;
 
 /**
  * @brief Audio bus for grouping and processing sounds.
@@ -26,11 +33,17 @@ struct BusImpl;
  * processing. Common uses include Music, SFX, and Ambient buses with
  * independent volume control.
  *
+ * Each bus is a node in a mixing tree: voices are played into the bus's
+ * native mixer, and the bus itself plays into its parent (the root plays
+ * directly into the engine). Volume, fades and effects are therefore
+ * applied once per bus rather than once per voice.
+ *
  * @par Example Usage:
  * @code
- * // Create buses
+ * // Create buses (parented to Master by default)
  * audio.CreateBus("Music");
  * audio.CreateBus("SFX");
+ * audio.CreateBus("Weapons", "SFX");
  *
  * // Set volumes
  * auto music = audio.GetBus("Music");
@@ -42,8 +55,9 @@ public:
   /**
    * @brief Construct a named bus.
    * @param name Unique name for this bus.
+   * @param index Dense index of this bus (used for ducking).
    */
-  Bus(const std::string &name);
+  Bus(const std::string &name, uint32_t index = 0);
 
   /**
    * @brief Destructor.
@@ -57,14 +71,44 @@ public:
   Bus &operator=(Bus &&) noexcept;
 
   /**
-   * @brief Route an audio handle through this bus.
+   * @brief Start the bus in the mixing graph.
+   *
+   * Plays this bus into its parent's native bus, or straight into the
+   * engine when it has no parent. Must be called once before voices are
+   * routed through the bus.
+   *
+   * @param engine Native engine handle.
+   * @param parent Parent bus, or nullptr for a root bus.
+   * @param ducker Ducker that processes this bus in the mixer, or nullptr.
+   * @return true if the bus is mixing.
+   */
+  [[nodiscard]] bool Init(NativeEngineHandle engine, Bus *parent = nullptr,
+                          Ducker *ducker = nullptr);
+
+  /**
+   * @brief Route an already playing audio handle through this bus.
+   *
+   * Moves the voice into this bus's mixer. Voices started through
+   * AudioEvent are played into their bus directly and only need
+   * TrackHandle().
+   *
    * @param engine Native engine handle.
    * @param h Audio handle to route.
    */
   void AddHandle(NativeEngineHandle engine, AudioHandle h);
 
   /**
-   * @brief Update bus state (volume fading).
+   * @brief Record a voice that was played into this bus's mixer.
+   *
+   * Counts the voice as activity on this bus and every ancestor until it
+   * finishes.
+   *
+   * @param h Audio handle of the voice.
+   */
+  void TrackHandle(AudioHandle h);
+
+  /**
+   * @brief Update bus state (volume fade bookkeeping, finished voices).
    * @param dt Delta time in seconds.
    */
   void Update(float dt);
@@ -94,12 +138,45 @@ public:
    */
   [[nodiscard]] float GetTargetVolume() const;
 
+  /**
+   * @brief Get the volume after all parent buses are applied.
+   * @return Product of this bus's volume and every ancestor's volume.
+   */
+  [[nodiscard]] float GetEffectiveVolume() const;
+
   /**
    * @brief Get the bus name.
    * @return Reference to the bus name.
    */
   [[nodiscard]] const std::string &GetName() const;
 
+  /**
+   * @brief Get the dense index of this bus.
+   */
+  [[nodiscard]] BusID GetIndex() const;
+
+  /**
+   * @brief Get the number of voices playing on this bus and its children.
+   */
+  [[nodiscard]] uint32_t GetActiveVoiceCount() const;
+
+  /**
+   * @brief Get the parent bus.
+   * @return Parent bus, or nullptr for the root bus.
+   */
+  [[nodiscard]] Bus *GetParent() const;
+
+  /**
+   * @brief Get the buses mixed into this one.
+   */
+  [[nodiscard]] const std::vector<Bus *> &GetChildren() const;
+
+  /**
+   * @brief Get the handle of this bus's voice in the engine.
+   * @return Bus voice handle, or 0 if the bus is not mixing.
+   */
+  [[nodiscard]] AudioHandle GetHandle() const;
+
   /**
    * @brief Get native bus handle for advanced usage.
    * @return Opaque handle to the underlying native bus.
@@ -134,6 +211,34 @@ public:
    */
   [[nodiscard]] float GetCompressorGainReduction() const;
 
+  /**
+   * @brief Enable/disable the peak, RMS and loudness meter.
+   *
+   * The meter runs in the mixer on the bus signal after its effects and
+   * before the bus volume. Disabled meters cost nothing.
+   *
+   * @param enabled true to start metering (restarts the measurement).
+   */
+  void SetMeteringEnabled(bool enabled);
+
+  /**
+   * @brief Check if metering is enabled.
+   */
+  [[nodiscard]] bool IsMeteringEnabled() const;
+
+  /**
+   * @brief Get the latest meter values.
+   *
+   * Safe to call from any thread; never blocks the mixer. Values refresh
+   * every 100 ms while metering is enabled.
+   */
+  [[nodiscard]] BusMeterReading GetMeter() const;
+
+  /**
+   * @brief Restart the meter's measurement windows.
+   */
+  void ResetMeter();
+
 private:
   std::unique_ptr<BusImpl> m_Impl;
   std::string m_Name;
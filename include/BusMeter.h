@@ -0,0 +1,248 @@
+/**
+ * @file BusMeter.h
+ * @brief Lock-free per-bus level and loudness metering.
+ *
+ * Provides the BusMeter class, which measures peak, RMS and BS.1770
+ * loudness of a bus in the mixer and publishes the results for readers
+ * on any thread.
+ */
+#pragma once
+
+#include "DSPMath.h"
+#include "HDRAudio.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace Orpheus {
+
+/**
+ * @brief One published set of bus meter values.
+ */
+struct BusMeterReading {
+  float peakDb = kMinDb;        ///< Sample peak over the last 400 ms
+  float rmsDb = kMinDb;         ///< Unweighted RMS over the last 400 ms
+  float momentaryLUFS = -70.0f; ///< K-weighted loudness, 400 ms window
+  float shortTermLUFS = -70.0f; ///< K-weighted loudness, 3 s window
+  uint64_t blocks = 0;          ///< 100 ms blocks measured since reset
+};
+
+/**
+ * @brief Block-rate bus meter with a seqlock-published reading.
+ *
+ * Process() runs on the audio thread and accumulates 100 ms measurement
+ * blocks; a new reading is published when each block closes. Read() never
+ * blocks the audio thread: it retries if it overlapped a publish.
+ *
+ * While disabled the mixer skips the meter entirely. All channels are
+ * weighted equally in the loudness sum.
+ *
+ * @par Example Usage:
+ * @code
+ * bus->SetMeteringEnabled(true);
+ * BusMeterReading m = bus->GetMeter();
+ * if (m.shortTermLUFS > -16.0f) { ... }
+ * @endcode
+ */
+class BusMeter {
+public:
+  static constexpr size_t kMaxChannels = 8;
+  static constexpr float kBlockSeconds = 0.1f;
+  static constexpr size_t kMomentaryBlocks = 4;  // 400 ms
+  static constexpr size_t kShortTermBlocks = 30; // 3 s
+
+  BusMeter() = default;
+
+  BusMeter(const BusMeter &) = delete;
+  BusMeter &operator=(const BusMeter &) = delete;
+
+  /**
+   * @brief Enable or disable metering. Enabling restarts the measurement.
+   */
+  void SetEnabled(bool enabled) {
+    if (enabled && !m_Enabled.load(std::memory_order_relaxed)) {
+      m_ResetRequested.store(true, std::memory_order_relaxed);
+    }
+    m_Enabled.store(enabled, std::memory_order_release);
+  }
+
+  [[nodiscard]] bool IsEnabled() const {
+    return m_Enabled.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Request a measurement restart (applied on the next block).
+   */
+  void Reset() { m_ResetRequested.store(true, std::memory_order_relaxed); }
+
+  /**
+   * @brief Measure one mixer block (audio thread only).
+   * @param buffer Planar samples, channel c at buffer + c * stride.
+   * @param samples Samples per channel.
+   * @param channels Channel count.
+   * @param stride Distance between channel starts.
+   * @param sampleRate Mixer sample rate.
+   */
+  void Process(const float *buffer, size_t samples, size_t channels,
+               size_t stride, float sampleRate) {
+    if (samples == 0 || sampleRate <= 0.0f) {
+      return;
+    }
+    if (sampleRate != m_SampleRate ||
+        m_ResetRequested.exchange(false, std::memory_order_relaxed)) {
+      Restart(sampleRate);
+    }
+    channels = (std::min)(channels, kMaxChannels);
+
+    size_t offset = 0;
+    while (offset < samples) {
+      const size_t count =
+          (std::min)(samples - offset, m_BlockSamples - m_BlockFill);
+      for (size_t c = 0; c < channels; ++c) {
+        const float *data = buffer + c * stride + offset;
+        m_Block.peak = (std::max)(m_Block.peak, PeakAbs(data, count));
+        m_Block.squares += SumOfSquares(data, count);
+        m_Block.weighted += m_Filters[c].ProcessEnergy(data, count);
+      }
+      m_BlockFill += count;
+      offset += count;
+      if (m_BlockFill == m_BlockSamples) {
+        CloseBlock(channels);
+      }
+    }
+  }
+
+  /**
+   * @brief Read the latest published values (any thread, never blocks).
+   */
+  [[nodiscard]] BusMeterReading Read() const {
+    BusMeterReading reading;
+    uint32_t before = 0;
+    uint32_t after = 0;
+    do {
+      before = m_Sequence.load(std::memory_order_acquire);
+      reading.peakDb = m_PeakDb.load(std::memory_order_relaxed);
+      reading.rmsDb = m_RmsDb.load(std::memory_order_relaxed);
+      reading.momentaryLUFS = m_Momentary.load(std::memory_order_relaxed);
+      reading.shortTermLUFS = m_ShortTerm.load(std::memory_order_relaxed);
+      reading.blocks = m_Blocks.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = m_Sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0 || before != after);
+    return reading;
+  }
+
+private:
+  struct BlockStats {
+    float peak = 0.0f;
+    float squares = 0.0f;  ///< Sum of squares, all channels
+    float weighted = 0.0f; ///< K-weighted sum of squares, all channels
+  };
+
+  void Restart(float sampleRate) {
+    m_SampleRate = sampleRate;
+    m_BlockSamples = (std::max)(
+        size_t{1}, static_cast<size_t>(sampleRate * kBlockSeconds + 0.5f));
+    for (auto &filter : m_Filters) {
+      filter.SetSampleRate(sampleRate);
+    }
+    m_Block = BlockStats{};
+    m_BlockFill = 0;
+    m_History.fill(BlockStats{});
+    m_HistoryIndex = 0;
+    m_HistoryCount = 0;
+    Publish(BusMeterReading{});
+  }
+
+  void CloseBlock(size_t channels) {
+    m_History[m_HistoryIndex] = m_Block;
+    m_HistoryIndex = (m_HistoryIndex + 1) % kShortTermBlocks;
+    m_HistoryCount = (std::min)(m_HistoryCount + 1, kShortTermBlocks);
+    m_Block = BlockStats{};
+    m_BlockFill = 0;
+
+    // Sum the newest blocks; momentary values are a subset of short-term
+    float peak = 0.0f;
+    float squares = 0.0f;
+    float momentary = 0.0f;
+    float shortTerm = 0.0f;
+    for (size_t i = 0; i < m_HistoryCount; ++i) {
+      const BlockStats &b =
+          m_History[(m_HistoryIndex + kShortTermBlocks - 1 - i) %
+                    kShortTermBlocks];
+      if (i < kMomentaryBlocks) {
+        peak = (std::max)(peak, b.peak);
+        squares += b.squares;
+        momentary += b.weighted;
+      }
+      shortTerm += b.weighted;
+    }
+
+    const float blockSamples = static_cast<float>(m_BlockSamples);
+    const float momentaryCount =
+        blockSamples *
+        static_cast<float>((std::min)(m_HistoryCount, kMomentaryBlocks));
+    const float shortTermCount =
+        blockSamples * static_cast<float>(m_HistoryCount);
+    const float channelCount =
+        static_cast<float>((std::max)(channels, size_t{1}));
+
+    // Published at 10 Hz, so use exact logs rather than the fast ones
+    BusMeterReading reading;
+    reading.peakDb = peak > 0.0f ? 20.0f * std::log10(peak) : kMinDb;
+    const float meanSquare = squares / (momentaryCount * channelCount);
+    reading.rmsDb =
+        meanSquare > 0.0f ? 10.0f * std::log10(meanSquare) : kMinDb;
+    reading.momentaryLUFS = ToLUFS(momentary / momentaryCount);
+    reading.shortTermLUFS = ToLUFS(shortTerm / shortTermCount);
+    reading.blocks = m_Blocks.load(std::memory_order_relaxed) + 1;
+    Publish(reading);
+  }
+
+  static float ToLUFS(float meanSquare) {
+    if (meanSquare <= 1e-10f) {
+      return -70.0f;
+    }
+    return (std::max)(-70.0f, -0.691f + 10.0f * std::log10(meanSquare));
+  }
+
+  // Seqlock writer: odd sequence while the values are being replaced
+  void Publish(const BusMeterReading &reading) {
+    const uint32_t seq = m_Sequence.load(std::memory_order_relaxed);
+    m_Sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_PeakDb.store(reading.peakDb, std::memory_order_relaxed);
+    m_RmsDb.store(reading.rmsDb, std::memory_order_relaxed);
+    m_Momentary.store(reading.momentaryLUFS, std::memory_order_relaxed);
+    m_ShortTerm.store(reading.shortTermLUFS, std::memory_order_relaxed);
+    m_Blocks.store(reading.blocks, std::memory_order_relaxed);
+    m_Sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  std::atomic<bool> m_Enabled{false};
+  std::atomic<bool> m_ResetRequested{false};
+
+  // Audio-thread state
+  float m_SampleRate = 0.0f;
+  size_t m_BlockSamples = 1;
+  size_t m_BlockFill = 0;
+  BlockStats m_Block;
+  std::array<KWeightingFilter, kMaxChannels> m_Filters;
+  std::array<BlockStats, kShortTermBlocks> m_History{};
+  size_t m_HistoryIndex = 0;
+  size_t m_HistoryCount = 0;
+
+  // Published reading
+  std::atomic<uint32_t> m_Sequence{0};
+  std::atomic<float> m_PeakDb{kMinDb};
+  std::atomic<float> m_RmsDb{kMinDb};
+  std::atomic<float> m_Momentary{-70.0f};
+  std::atomic<float> m_ShortTerm{-70.0f};
+  std::atomic<uint64_t> m_Blocks{0};
+};
+
+} // namespace Orpheus
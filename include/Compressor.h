@@ -8,7 +8,12 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "DSPMath.h"
 
 namespace Orpheus {
 
@@ -22,6 +27,7 @@ struct CompressorSettings {
   float releaseMs = 100.0f; ///< Release time in milliseconds
   float makeupGain = 0.0f;  ///< Makeup gain in dB
   bool limiterMode = false; ///< true = hard limiter (infinite ratio)
+  float lookaheadMs = 0.0f; ///< Limiter lookahead (0 = off, adds latency)
 };
 
 /**
@@ -31,6 +37,16 @@ struct CompressorSettings {
  * exceed a threshold. Can be configured as a soft compressor or
  * hard limiter.
  *
+ * Processing is block based: the detector takes the peak of every
+ * channel (stereo-linked) over a short control block, gain is computed
+ * once per control block with fast log2/exp2 approximations, and the
+ * resulting gain ramp is applied to the samples with SIMD.
+ *
+ * With limiterMode and a non-zero lookaheadMs the limiter is a true
+ * brickwall: the output is delayed by the lookahead so gain reaches its
+ * target before a peak arrives, and no output sample exceeds
+ * threshold + makeupGain.
+ *
  * @par Example Usage:
  * @code
  * CompressorSettings settings;
@@ -41,17 +57,27 @@ struct CompressorSettings {
  *
  * Compressor comp(44100);
  * comp.SetSettings(settings);
- * comp.Process(samples, numSamples);
+ * comp.ProcessBlock(planar, numSamples, 2, stride);
  * @endcode
  */
 class Compressor {
 public:
+  /// Samples per control block (gain is recomputed at this rate).
+  static constexpr size_t kControlBlock = 32;
+
+  /// Longest supported lookahead, in control blocks.
+  static constexpr size_t kMaxLookaheadBlocks = 64;
+
+  /// Most channels processed by one compressor.
+  static constexpr size_t kMaxChannels = 8;
+
   /**
    * @brief Create a compressor with given sample rate.
    * @param sampleRate Audio sample rate (e.g., 44100).
    */
   explicit Compressor(float sampleRate = 44100.0f) : m_SampleRate(sampleRate) {
     UpdateCoefficients();
+    Reset();
   }
 
   /**
@@ -70,6 +96,21 @@ public:
     return m_Settings;
   }
 
+  /**
+   * @brief Change the sample rate (may reset the lookahead state).
+   */
+  void SetSampleRate(float sampleRate) {
+    if (sampleRate > 0.0f && sampleRate != m_SampleRate) {
+      m_SampleRate = sampleRate;
+      UpdateCoefficients();
+    }
+  }
+
+  /**
+   * @brief Get the sample rate used for time constants.
+   */
+  [[nodiscard]] float GetSampleRate() const { return m_SampleRate; }
+
   /**
    * @brief Enable/disable the compressor.
    */
@@ -81,89 +122,233 @@ public:
   [[nodiscard]] bool IsEnabled() const { return m_Enabled; }
 
   /**
-   * @brief Process audio samples in-place.
+   * @brief Processing latency in samples (non-zero only with lookahead).
+   */
+  [[nodiscard]] size_t GetLatency() const {
+    return m_LookaheadBlocks > 0 ? (m_LookaheadBlocks + 1) * kControlBlock
+                                 : 0;
+  }
+
+  /**
+   * @brief Process mono audio samples in-place.
    * @param samples Pointer to audio sample buffer.
    * @param numSamples Number of samples to process.
    */
   void Process(float *samples, size_t numSamples) {
-    if (!m_Enabled || samples == nullptr || numSamples == 0) {
+    ProcessBlock(samples, numSamples, 1, numSamples);
+  }
+
+  /**
+   * @brief Process a planar multi-channel block in-place.
+   * @param buffer Channel c starts at buffer + c * channelStride.
+   * @param numSamples Samples per channel.
+   * @param numChannels Number of channels (linked detection).
+   * @param channelStride Distance between channel starts, in samples.
+   */
+  void ProcessBlock(float *buffer, size_t numSamples, size_t numChannels,
+                    size_t channelStride) {
+    if (!m_Enabled || buffer == nullptr || numSamples == 0 ||
+        numChannels == 0) {
       return;
     }
+    numChannels = (std::min)(numChannels, kMaxChannels);
 
-    for (size_t i = 0; i < numSamples; ++i) {
-      float input = samples[i];
-      float inputLevel = std::abs(input);
-
-      // Convert to dB
-      float inputDb = LinearToDb(inputLevel);
-
-      // Calculate gain reduction
-      float gainReductionDb = 0.0f;
-      if (inputDb > m_Settings.threshold) {
-        if (m_Settings.limiterMode) {
-          // Hard limiter: reduce everything above threshold
-          gainReductionDb = m_Settings.threshold - inputDb;
-        } else {
-          // Compressor: apply ratio
-          float excess = inputDb - m_Settings.threshold;
-          float compressed = excess / m_Settings.ratio;
-          gainReductionDb = compressed - excess;
-        }
-      }
-
-      // Apply envelope (attack/release smoothing)
-      if (gainReductionDb < m_Envelope) {
-        // Attack (getting louder, need more reduction)
-        m_Envelope =
-            m_AttackCoeff * (m_Envelope - gainReductionDb) + gainReductionDb;
-      } else {
-        // Release (getting quieter, less reduction needed)
-        m_Envelope =
-            m_ReleaseCoeff * (m_Envelope - gainReductionDb) + gainReductionDb;
-      }
+    if (m_LookaheadBlocks > 0) {
+      ProcessLookahead(buffer, numSamples, numChannels, channelStride);
+    } else {
+      ProcessDirect(buffer, numSamples, numChannels, channelStride);
+    }
+  }
 
-      // Apply gain reduction + makeup gain
-      float outputGain = DbToLinear(m_Envelope + m_Settings.makeupGain);
-      samples[i] = input * outputGain;
+  /**
+   * @brief Allocate the lookahead delay line up front.
+   *
+   * Otherwise it is allocated on the first lookahead block; call this
+   * before handing the compressor to the audio thread.
+   */
+  void ReserveLookahead() {
+    if (m_Delay.size() != kMaxChannels * kDelayBlocks * kControlBlock) {
+      m_Delay.assign(kMaxChannels * kDelayBlocks * kControlBlock, 0.0f);
     }
   }
 
   /**
    * @brief Get the current gain reduction in dB.
    */
-  [[nodiscard]] float GetGainReduction() const { return -m_Envelope; }
+  [[nodiscard]] float GetGainReduction() const { return m_GainReductionDb; }
 
   /**
    * @brief Reset the compressor state.
    */
-  void Reset() { m_Envelope = 0.0f; }
+  void Reset() {
+    m_EnvelopeDb = 0.0f;
+    m_Gain = 1.0f;
+    m_LimiterGain = 1.0f;
+    m_GainReductionDb = 0.0f;
+    // Start one ring length in so the delayed read index never underflows
+    m_WriteIndex = kDelayBlocks * kControlBlock;
+    m_BlockPeak = 0.0f;
+    std::fill(m_RequiredGain.begin(), m_RequiredGain.end(), 1.0f);
+    std::fill(m_Delay.begin(), m_Delay.end(), 0.0f);
+  }
 
 private:
+  static constexpr size_t kGainRingSize = kMaxLookaheadBlocks + 2;
+  static constexpr size_t kDelayBlocks = kMaxLookaheadBlocks + 2;
+
   void UpdateCoefficients() {
-    // Convert ms to samples, then to coefficient
-    float attackSamples = (m_Settings.attackMs / 1000.0f) * m_SampleRate;
-    float releaseSamples = (m_Settings.releaseMs / 1000.0f) * m_SampleRate;
+    // Envelope runs once per control block, so time constants are
+    // expressed in control blocks rather than samples
+    const float blocksPerSecond =
+        m_SampleRate / static_cast<float>(kControlBlock);
+    const float attackBlocks = (m_Settings.attackMs / 1000.0f) * blocksPerSecond;
+    const float releaseBlocks =
+        (m_Settings.releaseMs / 1000.0f) * blocksPerSecond;
 
-    m_AttackCoeff = std::exp(-1.0f / (std::max)(1.0f, attackSamples));
-    m_ReleaseCoeff = std::exp(-1.0f / (std::max)(1.0f, releaseSamples));
+    m_AttackCoeff = attackBlocks > 0.0f ? std::exp(-1.0f / attackBlocks) : 0.0f;
+    m_ReleaseCoeff =
+        releaseBlocks > 0.0f ? std::exp(-1.0f / releaseBlocks) : 0.0f;
+    m_Slope = m_Settings.limiterMode
+                  ? 1.0f
+                  : 1.0f - 1.0f / (std::max)(1.0f, m_Settings.ratio);
+    m_Makeup = FastDbToLinear(m_Settings.makeupGain);
+    m_ThresholdLinear = FastDbToLinear(m_Settings.threshold);
+
+    size_t lookahead = 0;
+    if (m_Settings.limiterMode && m_Settings.lookaheadMs > 0.0f) {
+      const float samples = (m_Settings.lookaheadMs / 1000.0f) * m_SampleRate;
+      lookahead = static_cast<size_t>(
+          std::ceil(samples / static_cast<float>(kControlBlock)));
+      lookahead = std::clamp<size_t>(lookahead, 1, kMaxLookaheadBlocks);
+    }
+    if (lookahead != m_LookaheadBlocks) {
+      m_LookaheadBlocks = lookahead;
+      Reset();
+    }
   }
 
-  static float LinearToDb(float linear) {
-    const float minDb = -96.0f;
-    if (linear <= 0.0f) {
-      return minDb;
+  // Gain computer + envelope for one control block; returns linear gain
+  float ComputeGain(float peak) {
+    const float levelDb = FastLinearToDb(peak);
+    const float over = levelDb - m_Settings.threshold;
+    const float targetDb = over > 0.0f ? -over * m_Slope : 0.0f;
+
+    const float coeff = targetDb < m_EnvelopeDb ? m_AttackCoeff : m_ReleaseCoeff;
+    m_EnvelopeDb = targetDb + coeff * (m_EnvelopeDb - targetDb);
+    m_GainReductionDb = -m_EnvelopeDb;
+    return FastDbToLinear(m_EnvelopeDb) * m_Makeup;
+  }
+
+  void ProcessDirect(float *buffer, size_t numSamples, size_t numChannels,
+                     size_t channelStride) {
+    for (size_t offset = 0; offset < numSamples; offset += kControlBlock) {
+      const size_t count = (std::min)(kControlBlock, numSamples - offset);
+
+      float peak = 0.0f;
+      for (size_t c = 0; c < numChannels; ++c) {
+        peak = (std::max)(peak,
+                          PeakAbs(buffer + c * channelStride + offset, count));
+      }
+
+      const float target = ComputeGain(peak);
+      const float step = (target - m_Gain) / static_cast<float>(count);
+      for (size_t c = 0; c < numChannels; ++c) {
+        ApplyGainRamp(buffer + c * channelStride + offset, count,
+                      m_Gain + step, step);
+      }
+      m_Gain = target;
     }
-    return (std::max)(minDb, 20.0f * std::log10(linear));
   }
 
-  static float DbToLinear(float db) { return std::pow(10.0f, db / 20.0f); }
+  // Brickwall limiter: audio is delayed by (lookahead + 1) control blocks.
+  // The gain reaching the end of output block c is the minimum gain any
+  // block in [c, c + lookahead] requires, so the per-block linear ramp
+  // never exceeds what the loudest sample in the block allows.
+  void ProcessLookahead(float *buffer, size_t numSamples, size_t numChannels,
+                        size_t channelStride) {
+    ReserveLookahead();
+    const size_t ringSamples = kDelayBlocks * kControlBlock;
+    const size_t latency = GetLatency();
+
+    size_t offset = 0;
+    while (offset < numSamples) {
+      const size_t inBlock = static_cast<size_t>(m_WriteIndex % kControlBlock);
+      const size_t count =
+          (std::min)(kControlBlock - inBlock, numSamples - offset);
+      const uint64_t readIndex = m_WriteIndex - latency;
+      const size_t writePos = static_cast<size_t>(m_WriteIndex % ringSamples);
+      const size_t readPos = static_cast<size_t>(readIndex % ringSamples);
+
+      // A new output block starts: settle the gain it must end on
+      if (inBlock == 0) {
+        const uint64_t block = readIndex / kControlBlock;
+        float required = 1.0f;
+        for (size_t k = 0; k <= m_LookaheadBlocks; ++k) {
+          required =
+              (std::min)(required, m_RequiredGain[(block + k) % kGainRingSize]);
+        }
+        m_BlockStartGain = m_LimiterGain;
+        if (required < m_LimiterGain) {
+          m_LimiterGain = required;
+        } else {
+          m_LimiterGain = required + m_ReleaseCoeff * (m_LimiterGain - required);
+        }
+        m_GainReductionDb = -FastLinearToDb(m_LimiterGain);
+      }
+
+      const float step = (m_LimiterGain - m_BlockStartGain) /
+                         static_cast<float>(kControlBlock);
+      const float start =
+          (m_BlockStartGain + step * static_cast<float>(inBlock + 1)) *
+          m_Makeup;
+
+      for (size_t c = 0; c < numChannels; ++c) {
+        float *io = buffer + c * channelStride + offset;
+        float *ring = m_Delay.data() + c * ringSamples;
+        m_BlockPeak = (std::max)(m_BlockPeak, PeakAbs(io, count));
+        // Swap the new input into the ring and the delayed output out of it
+        for (size_t i = 0; i < count; ++i) {
+          const float in = io[i];
+          io[i] = ring[readPos + i];
+          ring[writePos + i] = in;
+        }
+        ApplyGainRamp(io, count, start, step * m_Makeup);
+      }
+
+      m_WriteIndex += count;
+      offset += count;
+
+      // Input block complete: record the gain it will need on output
+      if (m_WriteIndex % kControlBlock == 0) {
+        const uint64_t block = m_WriteIndex / kControlBlock - 1;
+        m_RequiredGain[block % kGainRingSize] =
+            m_BlockPeak > m_ThresholdLinear ? m_ThresholdLinear / m_BlockPeak
+                                            : 1.0f;
+        m_BlockPeak = 0.0f;
+      }
+    }
+  }
 
   CompressorSettings m_Settings;
   float m_SampleRate;
   float m_AttackCoeff = 0.0f;
   float m_ReleaseCoeff = 0.0f;
-  float m_Envelope = 0.0f;
+  float m_Slope = 0.75f;
+  float m_Makeup = 1.0f;
+  float m_ThresholdLinear = 1.0f;
+  float m_EnvelopeDb = 0.0f;
+  float m_Gain = 1.0f;
+  float m_GainReductionDb = 0.0f;
   bool m_Enabled = false;
+
+  // Lookahead limiter state
+  size_t m_LookaheadBlocks = 0;
+  uint64_t m_WriteIndex = 0;
+  float m_BlockPeak = 0.0f;
+  float m_LimiterGain = 1.0f;
+  float m_BlockStartGain = 1.0f;
+  std::array<float, kGainRingSize> m_RequiredGain{};
+  std::vector<float> m_Delay;
 };
 
 } // namespace Orpheus
@@ -9,7 +9,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -33,6 +37,13 @@ constexpr float PI = 3.14159265358979323846f;
  *    - Multiply with each IR partition FFT
  *    - Accumulate results using overlap-add
  *
+ * Impulse responses can be replaced while processing: SetImpulseResponse()
+ * partitions and transforms the new IR on the calling thread and queues
+ * it. The audio thread picks it up at the next block and crossfades from
+ * the old IR, convolving the input with both for the length of the fade.
+ * The frequency-domain delay line holds the input spectra, so it is
+ * shared by both IRs and the new one starts with a full history.
+ *
  * @par Example Usage:
  * @code
  * ConvolutionReverb reverb;
@@ -47,12 +58,26 @@ public:
   static constexpr size_t FFT_SIZE = 2048;
   static constexpr size_t BLOCK_SIZE = FFT_SIZE / 2;
 
+  /**
+   * @brief An impulse response partitioned and transformed for convolution.
+   */
+  struct Kernel {
+    std::vector<std::vector<float>> partitionsReal;
+    std::vector<std::vector<float>> partitionsImag;
+    size_t length = 0; ///< IR length in samples
+  };
+
   /**
    * @brief Create a convolution reverb with optional sample rate.
    * @param sampleRate Audio sample rate (default 44100).
+   * @param maxImpulseSeconds Longest IR accepted; longer IRs are truncated.
    */
-  explicit ConvolutionReverb(float sampleRate = 44100.0f)
-      : m_SampleRate(sampleRate) {
+  explicit ConvolutionReverb(float sampleRate = 44100.0f,
+                             float maxImpulseSeconds = 4.0f)
+      : m_SampleRate(sampleRate),
+        m_MaxPartitions((std::max)(
+            size_t{1}, static_cast<size_t>(std::ceil(
+                           sampleRate * maxImpulseSeconds / BLOCK_SIZE)))) {
     // Pre-compute twiddle factors for FFT
     m_TwiddleReal.resize(FFT_SIZE);
     m_TwiddleImag.resize(FFT_SIZE);
@@ -110,10 +135,25 @@ public:
       irSamples[i] = early + diffuse;
     }
 
-    // Partition IR into blocks and compute FFT of each
-    size_t numPartitions = (irLength + BLOCK_SIZE - 1) / BLOCK_SIZE;
-    m_IrPartitionsReal.resize(numPartitions);
-    m_IrPartitionsImag.resize(numPartitions);
+    SetImpulseResponse(irSamples.data(), irSamples.size(), 0.0f);
+    return true;
+  }
+
+  /**
+   * @brief Partition and transform an impulse response.
+   *
+   * Thread-safe; the expensive half of SetImpulseResponse().
+   * @param samples IR samples at the reverb's sample rate.
+   * @param length Number of samples (truncated to the maximum IR length).
+   */
+  [[nodiscard]] std::shared_ptr<const Kernel>
+  PrepareKernel(const float *samples, size_t length) const {
+    auto kernel = std::make_shared<Kernel>();
+    kernel->length = (std::min)(length, m_MaxPartitions * BLOCK_SIZE);
+    const size_t numPartitions =
+        (std::max)(size_t{1}, (kernel->length + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    kernel->partitionsReal.resize(numPartitions);
+    kernel->partitionsImag.resize(numPartitions);
 
     std::vector<float> paddedBlock(FFT_SIZE, 0.0f);
     std::vector<float> blockImag(FFT_SIZE, 0.0f);
@@ -121,38 +161,109 @@ public:
     for (size_t p = 0; p < numPartitions; ++p) {
       // Zero-pad block
       std::fill(paddedBlock.begin(), paddedBlock.end(), 0.0f);
-      std::fill(blockImag.begin(), blockImag.end(), 0.0f);
 
-      size_t start = p * BLOCK_SIZE;
-      size_t count = (std::min)(BLOCK_SIZE, irLength - start);
+      const size_t start = p * BLOCK_SIZE;
+      const size_t count =
+          start < kernel->length
+              ? (std::min)(BLOCK_SIZE, kernel->length - start)
+              : 0;
       for (size_t i = 0; i < count; ++i) {
-        paddedBlock[i] = irSamples[start + i];
+        paddedBlock[i] = samples[start + i];
       }
 
       // Compute FFT
-      m_IrPartitionsReal[p].resize(FFT_SIZE);
-      m_IrPartitionsImag[p].resize(FFT_SIZE);
-      FFT(paddedBlock, blockImag, m_IrPartitionsReal[p], m_IrPartitionsImag[p]);
+      kernel->partitionsReal[p].resize(FFT_SIZE);
+      kernel->partitionsImag[p].resize(FFT_SIZE);
+      FFT(paddedBlock, blockImag, kernel->partitionsReal[p],
+          kernel->partitionsImag[p]);
     }
+    return kernel;
+  }
 
-    // Initialize buffers
-    m_InputBuffer.resize(BLOCK_SIZE, 0.0f);
-    m_OutputBuffer.resize(FFT_SIZE, 0.0f);
-    m_OverlapBuffer.resize(BLOCK_SIZE, 0.0f);
-    m_FdlReal.resize(numPartitions, std::vector<float>(FFT_SIZE, 0.0f));
-    m_FdlImag.resize(numPartitions, std::vector<float>(FFT_SIZE, 0.0f));
-    m_InputPos = 0;
-    m_FdlPos = 0;
-    m_Loaded = true;
+  /**
+   * @brief Replace the impulse response, crossfading from the current one.
+   *
+   * Safe to call from any thread while another thread calls Process(). The
+   * IR is transformed on the calling thread, then swapped in by Process()
+   * at its next block. If a crossfade is still running, the swap waits
+   * for it; a newer IR queued meanwhile replaces the waiting one.
+   * @param samples IR samples at the reverb's sample rate.
+   * @param length Number of samples (truncated to the maximum IR length).
+   * @param crossfadeSeconds Crossfade time (0 swaps at once).
+   */
+  void SetImpulseResponse(const float *samples, size_t length,
+                          float crossfadeSeconds = 0.1f) {
+    QueueKernel(PrepareKernel(samples, length), crossfadeSeconds);
+  }
 
-    return true;
+  /**
+   * @brief Queue a kernel from PrepareKernel() for the next block.
+   * @param kernel Kernel made by this reverb (or one with its FFT size).
+   * @param crossfadeSeconds Crossfade time (0 swaps at once).
+   */
+  void QueueKernel(std::shared_ptr<const Kernel> kernel,
+                   float crossfadeSeconds = 0.1f) {
+    if (!kernel) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_PendingMutex);
+
+    // The delay line is sized once, before the audio thread can use it
+    if (m_FdlReal.empty()) {
+      m_InputBuffer.assign(BLOCK_SIZE, 0.0f);
+      m_OutputBuffer.assign(FFT_SIZE, 0.0f);
+      m_OverlapBuffer.assign(BLOCK_SIZE, 0.0f);
+      m_FadeTail.assign(BLOCK_SIZE, 0.0f);
+      m_FdlReal.assign(m_MaxPartitions, std::vector<float>(FFT_SIZE, 0.0f));
+      m_FdlImag.assign(m_MaxPartitions, std::vector<float>(FFT_SIZE, 0.0f));
+      for (auto *scratch : {&m_ScratchReal, &m_ScratchImag, &m_SpectrumImag,
+                            &m_AccumReal, &m_AccumImag, &m_BlockReal,
+                            &m_BlockImag, &m_FadeBlock}) {
+        scratch->assign(FFT_SIZE, 0.0f);
+      }
+    }
+
+    // Kernels are freed here once the audio thread has let go of them, so
+    // Process() never releases the last reference
+    m_Kernels.erase(std::remove_if(m_Kernels.begin(), m_Kernels.end(),
+                                   [](const auto &owned) {
+                                     return owned.use_count() == 1;
+                                   }),
+                    m_Kernels.end());
+    if (std::find(m_Kernels.begin(), m_Kernels.end(), kernel) ==
+        m_Kernels.end()) {
+      m_Kernels.push_back(kernel);
+    }
+    m_Pending = std::move(kernel);
+    m_PendingFadeSamples =
+        static_cast<size_t>((std::max)(crossfadeSeconds, 0.0f) * m_SampleRate);
+    m_Loaded = true;
   }
 
   /**
-   * @brief Check if an impulse response is loaded.
+   * @brief Check if an impulse response is loaded or queued.
    */
   [[nodiscard]] bool IsLoaded() const { return m_Loaded; }
 
+  /**
+   * @brief Check if the reverb is crossfading between two IRs.
+   */
+  [[nodiscard]] bool IsCrossfading() const { return m_Crossfading; }
+
+  /**
+   * @brief Number of IRs swapped in by Process() so far.
+   */
+  [[nodiscard]] uint64_t GetSwapCount() const { return m_SwapCount; }
+
+  [[nodiscard]] float GetSampleRate() const { return m_SampleRate; }
+
+  /**
+   * @brief Longest IR accepted, in samples.
+   */
+  [[nodiscard]] size_t GetMaxImpulseLength() const {
+    return m_MaxPartitions * BLOCK_SIZE;
+  }
+
   /**
    * @brief Get the loaded IR path.
    */
@@ -188,6 +299,9 @@ public:
     if (!m_Enabled || !m_Loaded || samples == nullptr || numSamples == 0) {
       return;
     }
+    if (!m_Kernel && !AdoptPendingKernel()) {
+      return;
+    }
 
     const float dry = 1.0f - m_Wet;
 
@@ -230,64 +344,111 @@ public:
   }
 
 private:
-  // Process one block using partitioned FFT convolution
-  void ProcessBlock() {
-    // Zero-pad input block to FFT size
-    std::vector<float> paddedInput(FFT_SIZE, 0.0f);
-    std::vector<float> inputImag(FFT_SIZE, 0.0f);
-    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
-      paddedInput[i] = m_InputBuffer[i];
+  // Take a queued kernel without blocking; starts a crossfade if an IR is
+  // already playing. Returns true if a kernel is active afterwards.
+  bool AdoptPendingKernel() {
+    std::unique_lock<std::mutex> lock(m_PendingMutex, std::try_to_lock);
+    if (!lock.owns_lock() || !m_Pending) {
+      return m_Kernel != nullptr;
     }
+    if (m_Kernel && m_PendingFadeSamples > 0) {
+      m_FadeFrom = std::move(m_Kernel);
+      m_FadeLength = m_PendingFadeSamples;
+      m_FadePos = 0;
+      // Both IRs continue from the old IR's overlap tail
+      std::copy(m_OutputBuffer.begin() + BLOCK_SIZE, m_OutputBuffer.end(),
+                m_FadeTail.begin());
+      m_Crossfading = true;
+    }
+    m_Kernel = std::move(m_Pending);
+    ++m_SwapCount;
+    return true;
+  }
 
-    // Compute FFT of input block
-    std::vector<float> inputFftReal(FFT_SIZE);
-    std::vector<float> inputFftImag(FFT_SIZE);
-    FFT(paddedInput, inputImag, inputFftReal, inputFftImag);
-
-    // Store in frequency-domain delay line
-    m_FdlReal[m_FdlPos] = inputFftReal;
-    m_FdlImag[m_FdlPos] = inputFftImag;
-
-    // Accumulate convolution result
-    std::vector<float> accumReal(FFT_SIZE, 0.0f);
-    std::vector<float> accumImag(FFT_SIZE, 0.0f);
+  // Sum the delay line's spectra times a kernel's partitions into
+  // m_AccumReal/Imag, then transform back into `block`
+  void Convolve(const Kernel &kernel, std::vector<float> &block) {
+    std::fill(m_AccumReal.begin(), m_AccumReal.end(), 0.0f);
+    std::fill(m_AccumImag.begin(), m_AccumImag.end(), 0.0f);
 
-    size_t numPartitions = m_IrPartitionsReal.size();
+    const size_t capacity = m_FdlReal.size();
+    const size_t numPartitions = kernel.partitionsReal.size();
     for (size_t p = 0; p < numPartitions; ++p) {
-      size_t fdlIdx = (m_FdlPos + numPartitions - p) % numPartitions;
+      size_t fdlIdx = (m_FdlPos + capacity - p) % capacity;
+      const float *fdlReal = m_FdlReal[fdlIdx].data();
+      const float *fdlImag = m_FdlImag[fdlIdx].data();
+      const float *irReal = kernel.partitionsReal[p].data();
+      const float *irImag = kernel.partitionsImag[p].data();
 
       // Complex multiply
       for (size_t k = 0; k < FFT_SIZE; ++k) {
-        float a = m_FdlReal[fdlIdx][k];
-        float b = m_FdlImag[fdlIdx][k];
-        float c = m_IrPartitionsReal[p][k];
-        float d = m_IrPartitionsImag[p][k];
+        float a = fdlReal[k];
+        float b = fdlImag[k];
+        float c = irReal[k];
+        float d = irImag[k];
 
-        accumReal[k] += a * c - b * d;
-        accumImag[k] += a * d + b * c;
+        m_AccumReal[k] += a * c - b * d;
+        m_AccumImag[k] += a * d + b * c;
       }
     }
 
     // Inverse FFT
-    std::vector<float> outputReal(FFT_SIZE);
-    std::vector<float> outputImag(FFT_SIZE);
-    IFFT(accumReal, accumImag, outputReal, outputImag);
+    IFFT(m_AccumReal, m_AccumImag, block, m_BlockImag);
+  }
+
+  // Process one block using partitioned FFT convolution
+  void ProcessBlock() {
+    // Swap in a queued IR between blocks
+    if (!m_Crossfading) {
+      AdoptPendingKernel();
+    }
+
+    // Zero-pad input block to FFT size
+    std::fill(m_ScratchReal.begin(), m_ScratchReal.end(), 0.0f);
+    std::fill(m_ScratchImag.begin(), m_ScratchImag.end(), 0.0f);
+    std::copy(m_InputBuffer.begin(), m_InputBuffer.end(),
+              m_ScratchReal.begin());
+
+    // Compute FFT of input block into the frequency-domain delay line
+    FFT(m_ScratchReal, m_ScratchImag, m_FdlReal[m_FdlPos],
+        m_FdlImag[m_FdlPos]);
+
+    // Accumulate convolution result
+    Convolve(*m_Kernel, m_BlockReal);
 
     // Overlap-add
     for (size_t i = 0; i < BLOCK_SIZE; ++i) {
-      m_OverlapBuffer[i] = m_OutputBuffer[i + BLOCK_SIZE] + outputReal[i];
+      m_OverlapBuffer[i] = m_OutputBuffer[i + BLOCK_SIZE] + m_BlockReal[i];
     }
     for (size_t i = 0; i < BLOCK_SIZE; ++i) {
-      m_OutputBuffer[i + BLOCK_SIZE] = outputReal[i + BLOCK_SIZE];
+      m_OutputBuffer[i + BLOCK_SIZE] = m_BlockReal[i + BLOCK_SIZE];
+    }
+
+    // Blend in the old IR's output, fading out linearly
+    if (m_Crossfading) {
+      Convolve(*m_FadeFrom, m_FadeBlock);
+      const float step = 1.0f / static_cast<float>(m_FadeLength);
+      for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        const float old = m_FadeTail[i] + m_FadeBlock[i];
+        const float fadeIn =
+            (std::min)(static_cast<float>(m_FadePos + i) * step, 1.0f);
+        m_OverlapBuffer[i] = old + (m_OverlapBuffer[i] - old) * fadeIn;
+        m_FadeTail[i] = m_FadeBlock[i + BLOCK_SIZE];
+      }
+      m_FadePos += BLOCK_SIZE;
+      if (m_FadePos >= m_FadeLength) {
+        m_FadeFrom.reset();
+        m_Crossfading = false;
+      }
     }
 
     // Advance FDL position
-    m_FdlPos = (m_FdlPos + 1) % numPartitions;
+    m_FdlPos = (m_FdlPos + 1) % m_FdlReal.size();
   }
 
   // Radix-2 Cooley-Tukey FFT
   void FFT(const std::vector<float> &inReal, const std::vector<float> &inImag,
-           std::vector<float> &outReal, std::vector<float> &outImag) {
+           std::vector<float> &outReal, std::vector<float> &outImag) const {
     size_t n = FFT_SIZE;
     outReal = inReal;
     outImag = inImag;
@@ -339,14 +500,12 @@ private:
     size_t n = FFT_SIZE;
 
     // Conjugate input
-    std::vector<float> conjReal = inReal;
-    std::vector<float> conjImag(n);
     for (size_t i = 0; i < n; ++i) {
-      conjImag[i] = -inImag[i];
+      m_SpectrumImag[i] = -inImag[i];
     }
 
     // Forward FFT
-    FFT(conjReal, conjImag, outReal, outImag);
+    FFT(inReal, m_SpectrumImag, outReal, outImag);
 
     // Conjugate and scale
     float scale = 1.0f / static_cast<float>(n);
@@ -358,24 +517,46 @@ private:
 
   std::string m_IrPath;
   float m_SampleRate;
+  size_t m_MaxPartitions; ///< Delay line length in blocks
   float m_Wet = 0.5f;
   bool m_Enabled = false;
-  bool m_Loaded = false;
+  std::atomic<bool> m_Loaded{false};
 
   // Twiddle factors (pre-computed for FFT)
   std::vector<float> m_TwiddleReal;
   std::vector<float> m_TwiddleImag;
 
-  // IR partitions in frequency domain
-  std::vector<std::vector<float>> m_IrPartitionsReal;
-  std::vector<std::vector<float>> m_IrPartitionsImag;
+  // IR hand-off; m_Kernels keeps every kernel the audio thread may hold
+  std::mutex m_PendingMutex;
+  std::shared_ptr<const Kernel> m_Pending;
+  size_t m_PendingFadeSamples = 0;
+  std::vector<std::shared_ptr<const Kernel>> m_Kernels;
+
+  // Audio thread state: active IR and the IR being faded out
+  std::shared_ptr<const Kernel> m_Kernel;
+  std::shared_ptr<const Kernel> m_FadeFrom;
+  size_t m_FadeLength = 0;
+  size_t m_FadePos = 0;
+  std::atomic<bool> m_Crossfading{false};
+  std::atomic<uint64_t> m_SwapCount{0};
 
   // Processing buffers
   std::vector<float> m_InputBuffer;
   std::vector<float> m_OutputBuffer;
   std::vector<float> m_OverlapBuffer;
+  std::vector<float> m_FadeTail; ///< Overlap tail of the old IR
   size_t m_InputPos = 0;
 
+  // Per-block scratch, allocated with the delay line
+  std::vector<float> m_ScratchReal;
+  std::vector<float> m_ScratchImag;
+  std::vector<float> m_SpectrumImag;
+  std::vector<float> m_AccumReal;
+  std::vector<float> m_AccumImag;
+  std::vector<float> m_BlockReal;
+  std::vector<float> m_BlockImag;
+  std::vector<float> m_FadeBlock;
+
   // Frequency-domain delay line (FDL)
   std::vector<std::vector<float>> m_FdlReal;
   std::vector<std::vector<float>> m_FdlImag;
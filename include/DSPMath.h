@@ -0,0 +1,186 @@
+/**
+ * @file DSPMath.h
+ * @brief Fast math approximations and SIMD block helpers for audio DSP.
+ *
+ * Shared by the bus processors that run inside the mixer (compressor,
+ * ducker, meters). Everything here is allocation-free and safe to call
+ * from the audio thread.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ORPHEUS_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ORPHEUS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Orpheus {
+
+/// 20 * log10(2): converts log2 amplitude to decibels.
+constexpr float kDbPerLog2 = 6.0205999f;
+
+/// Lowest level reported by the fast dB helpers.
+constexpr float kMinDb = -144.0f;
+
+/**
+ * @brief Fast log2 approximation (max error ~0.005, i.e. ~0.03 dB).
+ * @param x Positive input value.
+ */
+inline float FastLog2(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  const float exponent = static_cast<float>(static_cast<int>(bits >> 23) - 128);
+  bits = (bits & 0x007FFFFFu) | 0x3F800000u; // mantissa in [1, 2)
+  float m;
+  std::memcpy(&m, &bits, sizeof(m));
+  return exponent + (-0.34484843f * m + 2.02466578f) * m - 0.67487759f;
+}
+
+/**
+ * @brief Fast exp2 approximation (relative error < 1e-4).
+ * @param x Exponent, clamped to the normal float range.
+ */
+inline float FastExp2(float x) {
+  if (x < -126.0f)
+    x = -126.0f;
+  if (x > 126.0f)
+    x = 126.0f;
+  const float whole = std::floor(x);
+  const float f = x - whole;
+  const float p =
+      1.0f + f * (0.69606564f + f * (0.22449434f + f * 0.07944024f));
+  const uint32_t bits = static_cast<uint32_t>(static_cast<int>(whole) + 127)
+                        << 23;
+  float scale;
+  std::memcpy(&scale, &bits, sizeof(scale));
+  return scale * p;
+}
+
+/**
+ * @brief Convert a linear amplitude to decibels using FastLog2.
+ */
+inline float FastLinearToDb(float linear) {
+  if (linear <= 1e-7f)
+    return kMinDb;
+  return kDbPerLog2 * FastLog2(linear);
+}
+
+/**
+ * @brief Convert decibels to a linear amplitude using FastExp2.
+ */
+inline float FastDbToLinear(float db) { return FastExp2(db / kDbPerLog2); }
+
+/**
+ * @brief Largest absolute sample value in a block.
+ */
+inline float PeakAbs(const float *data, size_t count) {
+  size_t i = 0;
+  float peak = 0.0f;
+#if defined(ORPHEUS_SIMD_SSE2)
+  const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  __m128 vmax = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4) {
+    vmax = _mm_max_ps(vmax, _mm_and_ps(_mm_loadu_ps(data + i), signMask));
+  }
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, vmax);
+  peak = (std::fmax)((std::fmax)(lanes[0], lanes[1]),
+                     (std::fmax)(lanes[2], lanes[3]));
+#elif defined(ORPHEUS_SIMD_NEON)
+  float32x4_t vmax = vdupq_n_f32(0.0f);
+  for (; i + 4 <= count; i += 4) {
+    vmax = vmaxq_f32(vmax, vabsq_f32(vld1q_f32(data + i)));
+  }
+  float lanes[4];
+  vst1q_f32(lanes, vmax);
+  peak = (std::fmax)((std::fmax)(lanes[0], lanes[1]),
+                     (std::fmax)(lanes[2], lanes[3]));
+#endif
+  for (; i < count; ++i) {
+    peak = (std::fmax)(peak, std::fabs(data[i]));
+  }
+  return peak;
+}
+
+/**
+ * @brief Sum of squared samples in a block.
+ */
+inline float SumOfSquares(const float *data, size_t count) {
+  size_t i = 0;
+  float sum = 0.0f;
+#if defined(ORPHEUS_SIMD_SSE2)
+  __m128 acc = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4) {
+    __m128 v = _mm_loadu_ps(data + i);
+    acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+  }
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, acc);
+  sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(ORPHEUS_SIMD_NEON)
+  float32x4_t acc = vdupq_n_f32(0.0f);
+  for (; i + 4 <= count; i += 4) {
+    float32x4_t v = vld1q_f32(data + i);
+    acc = vmlaq_f32(acc, v, v);
+  }
+  float lanes[4];
+  vst1q_f32(lanes, acc);
+  sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+  for (; i < count; ++i) {
+    sum += data[i] * data[i];
+  }
+  return sum;
+}
+
+/**
+ * @brief Multiply a block by a linearly changing gain.
+ *
+ * Sample i is scaled by (start + step * i).
+ *
+ * @param data Samples to scale in place.
+ * @param count Number of samples.
+ * @param start Gain applied to the first sample.
+ * @param step Gain increment per sample.
+ */
+inline void ApplyGainRamp(float *data, size_t count, float start, float step) {
+  size_t i = 0;
+#if defined(ORPHEUS_SIMD_SSE2)
+  __m128 gain = _mm_setr_ps(start, start + step, start + 2.0f * step,
+                            start + 3.0f * step);
+  const __m128 gainStep = _mm_set1_ps(4.0f * step);
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), gain));
+    gain = _mm_add_ps(gain, gainStep);
+  }
+#elif defined(ORPHEUS_SIMD_NEON)
+  const float init[4] = {start, start + step, start + 2.0f * step,
+                         start + 3.0f * step};
+  float32x4_t gain = vld1q_f32(init);
+  const float32x4_t gainStep = vdupq_n_f32(4.0f * step);
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), gain));
+    gain = vaddq_f32(gain, gainStep);
+  }
+#endif
+  for (; i < count; ++i) {
+    data[i] *= start + step * static_cast<float>(i);
+  }
+}
+
+/**
+ * @brief Multiply a block by a constant gain.
+ */
+inline void ApplyGain(float *data, size_t count, float gain) {
+  ApplyGainRamp(data, count, gain, 0.0f);
+}
+
+} // namespace Orpheus
@@ -7,14 +7,17 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace Orpheus {
 
-class Bus;
-
 /**
  * @brief Configuration for a ducking rule.
  *
@@ -27,6 +30,7 @@ struct DuckingRule {
   float attackTime = 0.1f;  ///< Fade down time in seconds
   float releaseTime = 0.5f; ///< Fade up time in seconds
   float holdTime = 0.1f;    ///< Hold ducked level after sidechain stops
+  float threshold = -50.0f; ///< Sidechain level (dB) that counts as active
 };
 
 /**
@@ -38,26 +42,93 @@ struct DuckingState {
   float holdTimer = 0.0f;    ///< Time remaining in hold phase
 };
 
+/**
+ * @brief Live activity of one bus, shared between game and audio threads.
+ *
+ * Voice counts are maintained incrementally as voices start and finish
+ * (including voices on child buses); the envelope and duck gain are
+ * written by the bus's own processor in the mixer.
+ */
+struct BusActivity {
+  std::atomic<uint32_t> voiceCount{0}; ///< Voices playing on this subtree
+  std::atomic<float> envelope{0.0f};   ///< Peak follower of the bus output
+  std::atomic<float> duckGain{1.0f};   ///< Gain currently applied by ducking
+  std::atomic<bool> ducking{false};    ///< Any rule on this bus is engaged
+};
+
+/**
+ * @brief A ducking rule resolved to bus indices.
+ */
+struct CompiledDuckingRule {
+  uint32_t targetBus = 0;
+  uint32_t sidechainBus = 0;
+  float duckLevel = 0.3f;
+  float attackRate = 10.0f; ///< Level change per second while ducking
+  float releaseRate = 2.0f; ///< Level change per second while releasing
+  float holdTime = 0.1f;
+  float threshold = 0.003f; ///< Linear sidechain level
+};
+
+/**
+ * @brief Immutable compiled rule set read by the mixer.
+ *
+ * Rules are sorted by target; rules for bus b are
+ * rules[targetBegin[b] .. targetBegin[b + 1]).
+ */
+struct DuckingTable {
+  std::vector<CompiledDuckingRule> rules;
+  std::vector<uint32_t> targetBegin;
+  uint64_t sidechainMask = 0; ///< Bit b set if bus b feeds any rule
+  uint64_t generation = 0;    ///< Increments on every recompile
+};
+
+/**
+ * @brief Audio-thread state of one bus's ducking processor.
+ *
+ * Owned by the bus's mixer filter; carries rule levels across rule-set
+ * recompiles.
+ */
+struct DuckerBusState {
+  static constexpr size_t kMaxRulesPerBus = 8;
+
+  uint64_t generation = 0; ///< Table generation the rules are bound to
+  std::array<DuckingState, kMaxRulesPerBus> rules{};
+  std::array<uint32_t, kMaxRulesPerBus> sidechains{};
+  size_t ruleCount = 0;
+  float gain = 1.0f;
+};
+
 /**
  * @brief Manages automatic volume ducking between buses.
  *
- * The Ducker monitors voice activity on sidechain buses and fades
- * the volume of target buses accordingly.
+ * Rules are compiled into bus-index arrays on the game thread whenever
+ * they or the bus set change. Each bus runs ProcessBlock() from its mixer
+ * filter: sidechain buses update their envelope follower, and target
+ * buses apply the gain reduction to their own signal at block rate.
  *
  * @par Example Usage:
  * @code
  * // Duck music when dialogue plays
- * audio.AddDuckingRule({
- *   .targetBus = "Music",
- *   .sidechainBus = "Dialogue",
- *   .duckLevel = 0.3f,
- *   .attackTime = 0.1f,
- *   .releaseTime = 0.5f
- * });
+ * audio.AddDuckingRule("Music", "Dialogue", 0.3f, 0.1f, 0.5f);
  * @endcode
  */
 class Ducker {
 public:
+  /// Maximum number of buses that can take part in ducking.
+  static constexpr uint32_t kMaxBuses = 64;
+
+  /// Returned by a bus resolver for unknown bus names.
+  static constexpr uint32_t kInvalidBus = UINT32_MAX;
+
+  /// Maps a bus name to its index (or kInvalidBus).
+  using BusResolver = std::function<uint32_t(const std::string &)>;
+
+  Ducker() = default;
+  ~Ducker();
+
+  Ducker(const Ducker &) = delete;
+  Ducker &operator=(const Ducker &) = delete;
+
   /**
    * @brief Add a ducking rule.
    * @param rule The ducking configuration.
@@ -78,15 +149,73 @@ public:
   void ClearRules();
 
   /**
-   * @brief Update ducking state and apply volume changes.
-   * @param dt Delta time in seconds.
-   * @param buses Map of bus names to Bus pointers.
-   * @param getSidechainActive Function to check if sidechain bus has active
-   * voices.
+   * @brief Request a recompile (e.g. after a bus was created).
+   */
+  void Invalidate() { m_Dirty = true; }
+
+  /**
+   * @brief Recompile rules if needed and free retired rule tables.
+   *
+   * Call once per frame from the game thread. A replaced table is freed
+   * on the first update that finds no mixer block in ProcessBlock(), so
+   * no block can still hold it however slow the audio thread runs.
+   *
+   * @param resolve Maps bus names to indices.
+   */
+  void Update(const BusResolver &resolve);
+
+  /**
+   * @brief Live activity slot of a bus.
+   * @param busIndex Bus index (< kMaxBuses).
+   */
+  [[nodiscard]] BusActivity &GetActivity(uint32_t busIndex) {
+    return m_Activity[busIndex];
+  }
+
+  /**
+   * @brief Keeps rule tables alive while the mixer reads them.
+   *
+   * ProcessBlock() holds one for the duration of a block; retired tables
+   * are not freed while any scope is open.
+   */
+  class ReadScope {
+  public:
+    explicit ReadScope(const Ducker &ducker) : m_Readers(ducker.m_Readers) {
+      m_Readers.fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~ReadScope() { m_Readers.fetch_sub(1, std::memory_order_seq_cst); }
+
+    ReadScope(const ReadScope &) = delete;
+    ReadScope &operator=(const ReadScope &) = delete;
+
+  private:
+    std::atomic<uint32_t> &m_Readers;
+  };
+
+  /**
+   * @brief Number of replaced rule tables not freed yet.
    */
-  void Update(float dt,
-              std::unordered_map<std::string, std::shared_ptr<Bus>> &buses,
-              std::function<bool(const std::string &)> getSidechainActive);
+  [[nodiscard]] size_t GetRetiredTableCount() const {
+    return m_Retired.size();
+  }
+
+  /**
+   * @brief Process one mixer block for a bus (audio thread).
+   *
+   * Updates the envelope if the bus feeds a sidechain, and applies the
+   * ducking gain ramp if the bus is a ducking target.
+   *
+   * @param busIndex Index of the bus being mixed.
+   * @param state The bus processor's ducking state.
+   * @param buffer Planar samples, channel c at buffer + c * stride.
+   * @param samples Samples per channel.
+   * @param channels Channel count.
+   * @param stride Distance between channel starts.
+   * @param sampleRate Mixer sample rate.
+   */
+  void ProcessBlock(uint32_t busIndex, DuckerBusState &state, float *buffer,
+                    size_t samples, size_t channels, size_t stride,
+                    float sampleRate);
 
   /**
    * @brief Check if a target bus is currently being ducked.
@@ -103,12 +232,24 @@ public:
   [[nodiscard]] float GetDuckLevel(const std::string &targetBus) const;
 
 private:
+  void Compile(const BusResolver &resolve);
+  static void Rebind(DuckerBusState &state, const DuckingTable *table,
+                     uint32_t busIndex);
+
   std::vector<DuckingRule> m_Rules;
-  std::unordered_map<std::string, DuckingState>
-      m_States; // Key: "target:sidechain"
+  bool m_Dirty = false;
+
+  std::array<BusActivity, kMaxBuses> m_Activity;
+  std::unordered_map<std::string, uint32_t> m_TargetIndices;
 
-  static std::string MakeKey(const std::string &target,
-                             const std::string &sidechain);
+  // Published table plus tables the mixer may still be reading. Readers
+  // count blocks inside ProcessBlock(); a retired table is unreachable
+  // once the count is seen at zero after it was replaced.
+  std::atomic<const DuckingTable *> m_Table{nullptr};
+  std::unique_ptr<DuckingTable> m_Current;
+  std::vector<std::unique_ptr<DuckingTable>> m_Retired;
+  mutable std::atomic<uint32_t> m_Readers{0};
+  uint64_t m_Generation = 0;
 };
 
 } // namespace Orpheus
@@ -19,14 +19,15 @@ namespace Orpheus {
 
 // Forward declaration for PIMPL
 struct AudioEventImpl;
+class Bus;
 
 /**
- * @brief Callback type for routing audio handles to buses.
+ * @brief Callback type for resolving a bus name to the bus voices play into.
  *
- * @param handle The audio handle to route.
  * @param busName The name of the target bus.
+ * @return The bus, or nullptr to play straight into the engine.
  */
-using BusRouterCallback = std::function<void(AudioHandle, const std::string &)>;
+using BusResolverCallback = std::function<Bus *(const std::string &)>;
 
 /**
  * @brief Handles playback of audio events.
@@ -55,19 +56,20 @@ public:
   AudioEvent &operator=(AudioEvent &&) noexcept;
 
   /**
-   * @brief Set the callback used to route audio handles to buses.
-   * @param router Callback function for bus routing.
+   * @brief Set the callback used to find the bus a voice is played into.
+   * @param resolver Callback function for bus lookup.
    */
-  void SetBusRouter(BusRouterCallback router);
+  void SetBusResolver(BusResolverCallback resolver);
 
   /**
    * @brief Play an audio event.
    * @param eventName Name of the registered event.
-   * @param busName Name of the bus to route to (default: "Master").
+   * @param busName Name of the bus to play into (default: the event's bus,
+   *                or "Master" if the event has none).
    * @return Handle to the playing audio, or 0 on failure.
    */
   [[nodiscard]] AudioHandle Play(const std::string &eventName,
-                                 const std::string &busName = "Master");
+                                 const std::string &busName = "");
 
   /**
    * @brief Play a specific sound file using settings from an event descriptor.
@@ -78,6 +80,29 @@ public:
   [[nodiscard]] AudioHandle PlayFromEvent(const std::string &path,
                                           const EventDescriptor &ed);
 
+  /**
+   * @brief Start loading an event's sounds in the background.
+   *
+   * Adds a reference to each sound of the event. While referenced and
+   * loaded, Play() only starts the voice instead of loading the file.
+   *
+   * @param eventName Name of the registered event.
+   */
+  void Prefetch(const std::string &eventName);
+
+  /**
+   * @brief Drop a reference added by Prefetch().
+   * @param eventName Name of the registered event.
+   */
+  void ReleasePrefetch(const std::string &eventName);
+
+  /**
+   * @brief Check if all of an event's sounds are loaded.
+   * @param eventName Name of the registered event.
+   * @return true if Play() will not touch the disk.
+   */
+  [[nodiscard]] bool IsResident(const std::string &eventName) const;
+
   /**
    * @brief Get native occlusion filter handle for advanced usage.
    * @return Opaque handle to the underlying filter.
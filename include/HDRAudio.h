@@ -8,7 +8,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
 #include <deque>
 
 namespace Orpheus {
@@ -23,22 +25,50 @@ namespace Orpheus {
 class KWeightingFilter {
 public:
   explicit KWeightingFilter(float sampleRate = 44100.0f) {
-    // Pre-computed coefficients for 44.1kHz (simplified)
-    // Stage 1: High-shelf +4dB @ 1500Hz
-    m_A1[0] = 1.0f;
-    m_A1[1] = -1.69065929318241f;
-    m_A1[2] = 0.73248077421585f;
-    m_B1[0] = 1.53512485958697f;
-    m_B1[1] = -2.69169618940638f;
-    m_B1[2] = 1.19839281085285f;
+    SetSampleRate(sampleRate);
+  }
+
+  /**
+   * @brief Recompute the filter coefficients for a sample rate.
+   *
+   * Uses the analog prototypes from BS.1770 so the response matches the
+   * standard at any rate (the published tables are for 48 kHz only).
+   * Clears the filter state.
+   */
+  void SetSampleRate(float sampleRate) {
+    constexpr double kPi = 3.14159265358979323846;
+    const double fs = sampleRate > 0.0f ? sampleRate : 48000.0;
+
+    // Stage 1: High-shelf +4dB @ ~1682Hz
+    {
+      const double f0 = 1681.974450955533;
+      const double gainDb = 3.999843853973347;
+      const double q = 0.7071752369554196;
+      const double k = std::tan(kPi * f0 / fs);
+      const double vh = std::pow(10.0, gainDb / 20.0);
+      const double vb = std::pow(vh, 0.4996667741545416);
+      const double a0 = 1.0 + k / q + k * k;
+      m_A1[0] = 1.0f;
+      m_A1[1] = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+      m_A1[2] = static_cast<float>((1.0 - k / q + k * k) / a0);
+      m_B1[0] = static_cast<float>((vh + vb * k / q + k * k) / a0);
+      m_B1[1] = static_cast<float>(2.0 * (k * k - vh) / a0);
+      m_B1[2] = static_cast<float>((vh - vb * k / q + k * k) / a0);
+    }
 
     // Stage 2: High-pass ~38Hz
-    m_A2[0] = 1.0f;
-    m_A2[1] = -1.99004745483398f;
-    m_A2[2] = 0.99007225036621f;
-    m_B2[0] = 1.0f;
-    m_B2[1] = -2.0f;
-    m_B2[2] = 1.0f;
+    {
+      const double f0 = 38.13547087602444;
+      const double q = 0.5003270373238773;
+      const double k = std::tan(kPi * f0 / fs);
+      const double a0 = 1.0 + k / q + k * k;
+      m_A2[0] = 1.0f;
+      m_A2[1] = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+      m_A2[2] = static_cast<float>((1.0 - k / q + k * k) / a0);
+      m_B2[0] = 1.0f;
+      m_B2[1] = -2.0f;
+      m_B2[2] = 1.0f;
+    }
 
     Reset();
   }
@@ -63,6 +93,50 @@ public:
     return y2;
   }
 
+  /**
+   * @brief Filter a block and return the sum of squared outputs.
+   *
+   * Equivalent to calling Process() per sample, but keeps the filter state
+   * in registers for the whole block.
+   */
+  float ProcessEnergy(const float *samples, size_t count) {
+    float x10 = m_X1[0], x11 = m_X1[1], y10 = m_Y1[0], y11 = m_Y1[1];
+    float x20 = m_X2[0], x21 = m_X2[1], y20 = m_Y2[0], y21 = m_Y2[1];
+    const float b10 = m_B1[0], b11 = m_B1[1], b12 = m_B1[2];
+    const float a11 = m_A1[1], a12 = m_A1[2];
+    const float b20 = m_B2[0], b21 = m_B2[1], b22 = m_B2[2];
+    const float a21 = m_A2[1], a22 = m_A2[2];
+
+    // The most recent output is folded in last: the recursion is the
+    // latency-critical path, the feed-forward terms are not
+    float energy = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+      const float x = samples[i];
+      const float y1 = b10 * x + b11 * x10 + b12 * x11 - a12 * y11 - a11 * y10;
+      x11 = x10;
+      x10 = x;
+      y11 = y10;
+      y10 = y1;
+      const float y2 =
+          b20 * y1 + b21 * x20 + b22 * x21 - a22 * y21 - a21 * y20;
+      x21 = x20;
+      x20 = y1;
+      y21 = y20;
+      y20 = y2;
+      energy += y2 * y2;
+    }
+
+    m_X1[0] = x10;
+    m_X1[1] = x11;
+    m_Y1[0] = y10;
+    m_Y1[1] = y11;
+    m_X2[0] = x20;
+    m_X2[1] = x21;
+    m_Y2[0] = y20;
+    m_Y2[1] = y21;
+    return energy;
+  }
+
   void Reset() {
     m_X1[0] = m_X1[1] = 0.0f;
     m_Y1[0] = m_Y1[1] = 0.0f;
@@ -218,29 +292,39 @@ public:
    * Common targets: -14 (streaming), -23 (broadcast EBU R128)
    */
   void SetTargetLoudness(float lufs) {
-    m_TargetLUFS = std::clamp(lufs, -70.0f, 0.0f);
+    m_TargetLUFS.store(std::clamp(lufs, -70.0f, 0.0f),
+                       std::memory_order_relaxed);
   }
 
-  [[nodiscard]] float GetTargetLoudness() const { return m_TargetLUFS; }
+  [[nodiscard]] float GetTargetLoudness() const {
+    return m_TargetLUFS.load(std::memory_order_relaxed);
+  }
 
   /**
    * @brief Enable/disable HDR processing.
    */
-  void SetEnabled(bool enabled) { m_Enabled = enabled; }
-  [[nodiscard]] bool IsEnabled() const { return m_Enabled; }
+  void SetEnabled(bool enabled) {
+    m_Enabled.store(enabled, std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool IsEnabled() const {
+    return m_Enabled.load(std::memory_order_relaxed);
+  }
 
   /**
    * @brief Set maximum gain adjustment in dB.
    */
-  void SetMaxGain(float db) { m_MaxGainDB = std::abs(db); }
+  void SetMaxGain(float db) {
+    m_MaxGainDB.store(std::abs(db), std::memory_order_relaxed);
+  }
 
   /**
    * @brief Process samples with loudness normalization.
    */
   void Process(float *samples, size_t numSamples) {
     m_Analyzer.Process(samples, numSamples);
+    Publish();
 
-    if (!m_Enabled)
+    if (!m_Enabled.load(std::memory_order_relaxed))
       return;
 
     float currentLUFS = m_Analyzer.GetShortTermLUFS();
@@ -248,13 +332,17 @@ public:
       return; // Too quiet to measure
 
     // Calculate needed gain adjustment
-    float targetGain = m_TargetLUFS - currentLUFS;
-    targetGain = std::clamp(targetGain, -m_MaxGainDB, m_MaxGainDB);
+    const float maxGainDB = m_MaxGainDB.load(std::memory_order_relaxed);
+    float targetGain =
+        m_TargetLUFS.load(std::memory_order_relaxed) - currentLUFS;
+    targetGain = std::clamp(targetGain, -maxGainDB, maxGainDB);
 
     // Smooth gain changes
     float alpha = 1.0f - std::exp(-1.0f / (m_SampleRate * 0.1f)); // 100ms
     m_CurrentGainDB = m_CurrentGainDB + alpha * (targetGain - m_CurrentGainDB);
 
+    m_PublishedGainDB.store(m_CurrentGainDB, std::memory_order_relaxed);
+
     // Apply gain
     float linearGain = std::pow(10.0f, m_CurrentGainDB / 20.0f);
     for (size_t i = 0; i < numSamples; ++i) {
@@ -271,37 +359,65 @@ public:
 
   /**
    * @brief Get current loudness measurements.
+   *
+   * Safe to call from any thread; values are published by Process() on the
+   * audio thread.
    */
   [[nodiscard]] float GetMomentaryLUFS() const {
-    return m_Analyzer.GetMomentaryLUFS();
+    return m_PublishedMomentary.load(std::memory_order_relaxed);
   }
 
   [[nodiscard]] float GetShortTermLUFS() const {
-    return m_Analyzer.GetShortTermLUFS();
+    return m_PublishedShortTerm.load(std::memory_order_relaxed);
   }
 
   [[nodiscard]] float GetIntegratedLUFS() const {
-    return m_Analyzer.GetIntegratedLUFS();
+    return m_PublishedIntegrated.load(std::memory_order_relaxed);
   }
 
   [[nodiscard]] float GetTruePeakDB() const {
-    return m_Analyzer.GetTruePeakDB();
+    return m_PublishedTruePeak.load(std::memory_order_relaxed);
   }
 
-  [[nodiscard]] float GetCurrentGainDB() const { return m_CurrentGainDB; }
+  [[nodiscard]] float GetCurrentGainDB() const {
+    return m_PublishedGainDB.load(std::memory_order_relaxed);
+  }
 
+  /**
+   * @brief Reset measurements (call from the thread that runs Process()).
+   */
   void Reset() {
     m_Analyzer.Reset();
     m_CurrentGainDB = 0.0f;
+    m_PublishedGainDB.store(0.0f, std::memory_order_relaxed);
+    Publish();
   }
 
 private:
   LoudnessAnalyzer m_Analyzer;
   float m_SampleRate;
-  float m_TargetLUFS = -14.0f; // Spotify/YouTube standard
-  float m_MaxGainDB = 12.0f;   // Max ±12dB adjustment
+  std::atomic<float> m_TargetLUFS{-14.0f}; // Spotify/YouTube standard
+  std::atomic<float> m_MaxGainDB{12.0f};   // Max ±12dB adjustment
   float m_CurrentGainDB = 0.0f;
-  bool m_Enabled = false;
+  std::atomic<bool> m_Enabled{false};
+
+  void Publish() {
+    m_PublishedMomentary.store(m_Analyzer.GetMomentaryLUFS(),
+                               std::memory_order_relaxed);
+    m_PublishedShortTerm.store(m_Analyzer.GetShortTermLUFS(),
+                               std::memory_order_relaxed);
+    m_PublishedIntegrated.store(m_Analyzer.GetIntegratedLUFS(),
+                                std::memory_order_relaxed);
+    m_PublishedTruePeak.store(m_Analyzer.GetTruePeakDB(),
+                              std::memory_order_relaxed);
+  }
+
+  // Snapshot of the analyzer for readers on other threads
+  std::atomic<float> m_PublishedMomentary{-70.0f};
+  std::atomic<float> m_PublishedShortTerm{-70.0f};
+  std::atomic<float> m_PublishedIntegrated{-70.0f};
+  std::atomic<float> m_PublishedTruePeak{-70.0f};
+  std::atomic<float> m_PublishedGainDB{0.0f};
 };
 
 } // namespace Orpheus
@@ -0,0 +1,186 @@
+/**
+ * @file ImpulseResponseSynthesizer.h
+ * @brief Impulse responses synthesized from ray-traced propagation.
+ *
+ * Provides the ImpulseResponseSynthesizer class, which turns the paths of
+ * a PropagationResult into a multi-band impulse response, and the
+ * ImpulseResponseUpdater class, which feeds synthesized IRs to a
+ * ConvolutionReverb from a background thread.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ConvolutionReverb.h"
+#include "RaytracedAcoustics.h"
+
+namespace Orpheus {
+
+/**
+ * @brief Settings for impulse response synthesis.
+ */
+struct ImpulseResponseSettings {
+  float sampleRate = 44100.0f;
+  float maxLength = 3.0f;     ///< Longest IR in seconds
+  float earlyTime = 0.08f;    ///< Paths before this are discrete taps (s)
+  float binWidth = 0.002f;    ///< Energy histogram resolution (s)
+  float crossoverLow = 500.0f;   ///< Low/mid band edge (Hz)
+  float crossoverHigh = 2000.0f; ///< Mid/high band edge (Hz)
+  bool normalize = true;      ///< Scale the IR to unit energy
+  uint32_t seed = 1;          ///< Seed of the late reverb noise
+};
+
+/**
+ * @brief Reflected energy per time bin and band.
+ *
+ * Bin i holds the energy arriving in [i * binWidth, (i + 1) * binWidth).
+ */
+struct EnergyHistogram {
+  float binWidth = 0.0f;
+  std::vector<float> low;
+  std::vector<float> mid;
+  std::vector<float> high;
+
+  [[nodiscard]] size_t GetBinCount() const { return mid.size(); }
+};
+
+/**
+ * @brief Builds impulse responses from ray-traced paths.
+ *
+ * Path gains are band energies, as the tracer computes them. Each band
+ * is synthesized separately and band-limited with Linkwitz-Riley filters
+ * at the crossover frequencies (matching the material absorption bands),
+ * then the bands are summed:
+ * - Paths arriving before the early time become discrete taps with the
+ *   square root of their energy as amplitude, keeping the timing of the
+ *   early reflections.
+ * - Later paths are binned into an energy histogram. Each bin becomes
+ *   noise with the bin's energy, so the dense tail follows the traced
+ *   decay and its spectral tilt.
+ * - After the last traced bin the tail continues with the result's
+ *   lateReverbTime until it has decayed by 60 dB or reached maxLength.
+ *
+ * Paths arriving after maxLength are dropped; the rest of the IR is kept.
+ * The direct path is left out; it is the dry signal. With normalize set
+ * (the default) the IR has unit energy, so the level is set by the
+ * reverb's wet mix or send and does not depend on the ray count.
+ *
+ * Synthesis is deterministic for a given seed and thread-safe.
+ *
+ * @par Example Usage:
+ * @code
+ * ImpulseResponseSynthesizer synthesizer;
+ * std::vector<float> ir;
+ * synthesizer.Synthesize(tracer.Trace(source, listener), ir);
+ * reverb.SetImpulseResponse(ir.data(), ir.size(), 0.25f);
+ * @endcode
+ */
+class ImpulseResponseSynthesizer {
+public:
+  explicit ImpulseResponseSynthesizer(ImpulseResponseSettings settings = {});
+
+  /**
+   * @brief Bin the energy of reflected paths by arrival time.
+   * @param result Traced propagation.
+   * @param startTime Paths before this time (s) are left out.
+   */
+  [[nodiscard]] EnergyHistogram
+  BuildHistogram(const PropagationResult &result, float startTime = 0.0f) const;
+
+  /**
+   * @brief Synthesize an impulse response.
+   * @param result Traced propagation.
+   * @param ir Receives the IR at the settings' sample rate; empty if the
+   *           result has no reflected paths.
+   */
+  void Synthesize(const PropagationResult &result,
+                  std::vector<float> &ir) const;
+
+  [[nodiscard]] const ImpulseResponseSettings &GetSettings() const {
+    return m_Settings;
+  }
+
+private:
+  ImpulseResponseSettings m_Settings;
+};
+
+// Forward declaration for PIMPL
+struct ImpulseResponseUpdaterImpl;
+
+/**
+ * @brief Keeps a convolution reverb's IR in step with traced propagation.
+ *
+ * Submit() hands a PropagationResult to a background thread that
+ * synthesizes the IR, partitions and transforms it, and queues it on the
+ * reverb, which crossfades to it on the audio thread. Updates are
+ * throttled: submissions within the minimum interval of the last accepted
+ * one are dropped, and a result submitted while the thread is busy
+ * replaces any result still waiting, so the thread only works on the
+ * latest propagation.
+ *
+ * The thread starts on the first accepted Submit(). The reverb must
+ * outlive the updater.
+ *
+ * @par Example Usage:
+ * @code
+ * ImpulseResponseUpdater updater(reverb);
+ * // Every frame, or whenever propagation was traced
+ * updater.Submit(tracer.Trace(emitter, listener));
+ * @endcode
+ */
+class ImpulseResponseUpdater {
+public:
+  /**
+   * @brief Create an updater for a reverb.
+   * @param reverb Reverb to feed; settings take its sample rate.
+   * @param settings Synthesis settings.
+   */
+  explicit ImpulseResponseUpdater(ConvolutionReverb &reverb,
+                                  ImpulseResponseSettings settings = {});
+
+  /**
+   * @brief Stop the thread. A waiting result is dropped.
+   */
+  ~ImpulseResponseUpdater();
+
+  ImpulseResponseUpdater(const ImpulseResponseUpdater &) = delete;
+  ImpulseResponseUpdater &operator=(const ImpulseResponseUpdater &) = delete;
+
+  /**
+   * @brief Submit propagation for a new IR.
+   * @return false if dropped by the throttle.
+   */
+  bool Submit(const PropagationResult &result);
+
+  /**
+   * @brief Set the minimum time between accepted submissions
+   *        (default 250 ms).
+   */
+  void SetMinInterval(std::chrono::milliseconds interval);
+
+  /**
+   * @brief Set the crossfade time of IR swaps (default 0.25 s).
+   */
+  void SetCrossfadeTime(float seconds);
+
+  /**
+   * @brief Number of IRs synthesized and queued on the reverb.
+   */
+  [[nodiscard]] uint64_t GetUpdateCount() const;
+
+  /**
+   * @brief Block until no result is waiting or being synthesized.
+   * @param timeout Maximum time to wait.
+   * @return true if the thread is idle.
+   */
+  bool WaitIdle(std::chrono::milliseconds timeout);
+
+private:
+  std::unique_ptr<ImpulseResponseUpdaterImpl> m_Impl;
+};
+
+} // namespace Orpheus
@@ -12,13 +12,15 @@
 #include <string>
 
 #include "Types.h"
+#include "ZoneShape.h"
 
 namespace Orpheus {
 
 /**
  * @brief Spatial zone that triggers mix snapshot blending.
  *
- * MixZone represents a spherical region that applies a snapshot when
+ * MixZone represents a region (sphere, box or polygon, see ZoneGeometry)
+ * that applies a snapshot when
  * the listener enters. The blend factor is calculated based on distance,
  * allowing smooth transitions between mix states (e.g., indoor/outdoor,
  * calm/combat areas).
@@ -45,6 +47,19 @@ public:
           uint8_t priority = 128, float fadeInTime = 0.5f,
           float fadeOutTime = 0.5f);
 
+  /**
+   * @brief Create a mix zone with an arbitrary shape.
+   * @param name Unique name for this zone.
+   * @param snapshotName Snapshot to apply when active.
+   * @param geometry Zone shape.
+   * @param priority Higher priority zones take precedence (default: 128).
+   * @param fadeInTime Snapshot fade-in duration in seconds.
+   * @param fadeOutTime Snapshot fade-out duration in seconds.
+   */
+  MixZone(const std::string &name, const std::string &snapshotName,
+          const ZoneGeometry &geometry, uint8_t priority = 128,
+          float fadeInTime = 0.5f, float fadeOutTime = 0.5f);
+
   /**
    * @brief Update the zone based on listener position.
    * @param listenerPos Current listener position.
@@ -113,15 +128,15 @@ public:
    */
   [[nodiscard]] float GetDistance(const Vector3 &listenerPos) const;
 
-private:
-  float Distance(const Vector3 &a, const Vector3 &b) const;
-  float ComputeBlend(float dist) const;
+  /**
+   * @brief Get the zone shape.
+   */
+  [[nodiscard]] const ZoneGeometry &GetGeometry() const;
 
+private:
   std::string m_Name;
   std::string m_SnapshotName;
-  Vector3 m_Position;
-  float m_InnerRadius;
-  float m_OuterRadius;
+  ZoneGeometry m_Geometry;
   uint8_t m_Priority;
   float m_FadeInTime;
   float m_FadeOutTime;
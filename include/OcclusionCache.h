@@ -0,0 +1,143 @@
+/**
+ * @file OcclusionCache.h
+ * @brief Reuse of occlusion results between nearby source/listener pairs.
+ *
+ * Provides the OcclusionCache class used by OcclusionProcessor to answer
+ * repeated occlusion queries without calling the game.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Types.h"
+
+namespace Orpheus {
+
+/**
+ * @brief Occlusion results keyed by quantized source and listener cells.
+ *
+ * Positions are snapped to a uniform grid of cellSize; queries whose
+ * source and listener fall into the same pair of cells share one result.
+ * Entries expire after a lifetime (for geometry the engine cannot track)
+ * and are all dropped when the geometry version changes.
+ *
+ * With a lifetime of 0 entries only expire through the geometry version,
+ * so static emitters heard from a still listener stop querying entirely.
+ *
+ * @par Example Usage:
+ * @code
+ * OcclusionCache cache;
+ * cache.SetGeometryVersion(scene.GetVersion());
+ * if (const auto *entry = cache.Find(source, listener, now)) {
+ *   use(entry->obstruction, entry->occlusionBias);
+ * } else {
+ *   cache.Store(source, listener, obstruction, bias, now);
+ * }
+ * @endcode
+ */
+class OcclusionCache {
+public:
+  /// Default cell edge length in world units.
+  static constexpr float kDefaultCellSize = 0.5f;
+
+  /// Default entry lifetime in seconds.
+  static constexpr float kDefaultLifetime = 1.0f;
+
+  /// Entries kept before expired ones are swept (or all are dropped).
+  static constexpr size_t kMaxEntries = 4096;
+
+  /**
+   * @brief Cached query result (material sums before thresholding).
+   */
+  struct Entry {
+    float obstruction;   ///< Summed obstruction of all hits
+    float occlusionBias; ///< Summed occlusion bias of all hits
+    float time;          ///< Time the result was stored
+  };
+
+  /**
+   * @brief Quantized source and listener cells.
+   */
+  struct Key {
+    int32_t cells[6];
+
+    bool operator==(const Key &other) const {
+      for (int i = 0; i < 6; ++i) {
+        if (cells[i] != other.cells[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  /**
+   * @brief Hash for Key.
+   */
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      uint64_t h = 1469598103934665603ull;
+      for (int32_t cell : key.cells) {
+        h = (h ^ static_cast<uint32_t>(cell)) * 1099511628211ull;
+      }
+      return static_cast<size_t>(h);
+    }
+  };
+
+  /**
+   * @brief Set the cell size; 0 disables the cache. Clears all entries.
+   */
+  void SetCellSize(float size);
+
+  /**
+   * @brief Set the entry lifetime in seconds; 0 never expires by time.
+   */
+  void SetLifetime(float seconds);
+
+  /**
+   * @brief Drop all entries if the version differs from the current one.
+   */
+  void SetGeometryVersion(uint32_t version);
+
+  /**
+   * @brief Drop all entries.
+   */
+  void Clear();
+
+  [[nodiscard]] bool IsEnabled() const { return m_CellSize > 0.0f; }
+  [[nodiscard]] float GetCellSize() const { return m_CellSize; }
+  [[nodiscard]] float GetLifetime() const { return m_Lifetime; }
+  [[nodiscard]] uint32_t GetGeometryVersion() const { return m_Version; }
+  [[nodiscard]] size_t GetSize() const { return m_Entries.size(); }
+
+  /**
+   * @brief Quantize a source/listener pair (cache must be enabled).
+   */
+  [[nodiscard]] Key MakeKey(const Vector3 &source,
+                            const Vector3 &listener) const;
+
+  /**
+   * @brief Look up a live entry.
+   * @param now Current time in seconds.
+   * @return Entry, or nullptr if missing, expired or disabled.
+   */
+  [[nodiscard]] const Entry *Find(const Key &key, float now) const;
+
+  /**
+   * @brief Store a result (no-op when disabled).
+   */
+  void Store(const Key &key, float obstruction, float occlusionBias,
+             float now);
+
+private:
+  [[nodiscard]] bool Expired(const Entry &entry, float now) const;
+
+  std::unordered_map<Key, Entry, KeyHash> m_Entries;
+  float m_CellSize = kDefaultCellSize;
+  float m_Lifetime = kDefaultLifetime;
+  uint32_t m_Version = 0;
+};
+
+} // namespace Orpheus
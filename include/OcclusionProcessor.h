@@ -9,12 +9,20 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "OcclusionCache.h"
 #include "OcclusionMaterial.h"
 #include "OcclusionQuery.h"
 #include "OpaqueHandles.h"
+#include "PortalGraph.h"
+#include "PropagationField.h"
 #include "Voice.h"
 
 namespace Orpheus {
@@ -27,8 +35,32 @@ namespace Orpheus {
  * filtering and volume reduction to simulate sound propagation
  * through materials.
  *
+ * @par Scheduling:
+ * Each voice has its own query timer. Its refresh interval is 1 / update
+ * rate for fully audible voices, stretching to kQuietIntervalScale times
+ * that for inaudible ones, so louder and closer voices stay fresher. A
+ * voice is due once its timer passes its interval; when more voices are
+ * due than the per-frame query budget allows, the stalest (relative to
+ * their interval) are queried first and the rest wait, which staggers
+ * queries round-robin across frames. Voices never queried go first.
+ *
+ * @par Result Cache:
+ * Results are cached by quantized source and listener cells
+ * (OcclusionCache). Voices due for a refresh whose cells already have a
+ * live entry are answered from the cache without a query and without
+ * using the budget, including voices sharing cells with one queried in
+ * the same frame.
+ *
+ * @par Batched Queries:
+ * With a batch callback set, the voices due in a frame are submitted as
+ * one array of rays instead of one synchronous call per voice. The game
+ * completes the batch later (CompleteBatch(), from any thread) with a flat
+ * array of hits that reference materials by integer id; completed batches
+ * are applied on the next Update(). Voices count as refreshed when their
+ * ray is submitted, so a slow batch does not cause duplicate requests.
+ *
  * @par Features:
- * - Configurable update rate for performance tuning
+ * - Configurable update rate and per-frame query budget
  * - Smooth value interpolation to avoid audio artifacts
  * - Lowpass filtering and volume reduction based on material properties
  * - Support for custom material definitions
@@ -48,11 +80,63 @@ public:
    */
   void SetQueryCallback(OcclusionQueryCallback callback);
 
+  /**
+   * @brief Set the callback for batched, asynchronous occlusion queries.
+   *
+   * Takes precedence over the synchronous query callback while set.
+   * @param callback Function that receives each frame's rays.
+   */
+  void SetBatchCallback(OcclusionBatchCallback callback);
+
+  /**
+   * @brief Answer voices from a propagation field instead of queries.
+   *
+   * Voices inside a computed field are looked up every frame without
+   * using the query budget; voices outside it (or before the first flood
+   * completes) fall back to the callbacks. The field must outlive its use.
+   * @param field Field to sample, or nullptr to stop using one.
+   */
+  void SetPropagationField(const PropagationField *field);
+
+  /**
+   * @brief Answer voices from room and portal paths instead of queries.
+   *
+   * While the listener and a voice are both inside rooms, the voice's
+   * occlusion and apparent position come from its portal path every frame
+   * without using the query budget; otherwise the propagation field or
+   * callbacks are used. The graph must be updated for the listener before
+   * Update() and outlive its use.
+   * @param graph Graph to search, or nullptr to stop using one.
+   */
+  void SetPortalGraph(const PortalGraph *graph);
+
+  /**
+   * @brief Deliver the hits of a batch submitted to the batch callback.
+   *
+   * Thread-safe. Unknown or expired batch ids are ignored.
+   * @param batch Batch id passed to the callback.
+   * @param hits Hits of all rays in the batch (any order).
+   * @param count Number of hits.
+   */
+  void CompleteBatch(OcclusionBatchID batch, const OcclusionRayHit *hits,
+                     size_t count);
+
   /**
    * @brief Register a custom occlusion material.
+   *
+   * Registering a name again replaces its properties and keeps its id.
    * @param mat The material to register.
+   * @return Id to use in OcclusionRayHit::material.
    */
-  void RegisterMaterial(const OcclusionMaterial &mat);
+  OcclusionMaterialID RegisterMaterial(const OcclusionMaterial &mat);
+
+  /**
+   * @brief Get the id of a registered material.
+   * @param name Material name.
+   * @return Material id, or kInvalidMaterial if not registered.
+   */
+  [[nodiscard]] OcclusionMaterialID
+  GetMaterialID(const std::string &name) const;
 
   /// @name Configuration
   /// @{
@@ -74,11 +158,20 @@ public:
   /**
    * @brief Set the occlusion update rate.
    *
-   * Lower rates improve performance but reduce accuracy.
+   * Per-voice refresh rate for fully audible voices; quieter voices are
+   * refreshed less often. Lower rates improve performance but reduce
+   * accuracy.
    * @param hz Updates per second (default: 10 Hz).
    */
   void SetUpdateRate(float hz);
 
+  /**
+   * @brief Cap the number of occlusion queries issued per frame.
+   * @param count Maximum queries per Update() call (at least 1,
+   *              default: kDefaultMaxQueriesPerFrame).
+   */
+  void SetMaxQueriesPerFrame(uint32_t count);
+
   /**
    * @brief Enable or disable occlusion processing.
    * @param enabled true to enable.
@@ -105,10 +198,35 @@ public:
 
   /// @}
 
+  /// Default per-frame query budget (200 voices at 10 Hz and 60 fps).
+  static constexpr uint32_t kDefaultMaxQueriesPerFrame = 32;
+
+  /// Refresh interval multiplier for inaudible voices.
+  static constexpr float kQuietIntervalScale = 4.0f;
+
+  /// Returned by GetMaterialID() for unknown names.
+  static constexpr OcclusionMaterialID kInvalidMaterial = UINT32_MAX;
+
+  /// Batches awaiting completion; older ones are dropped.
+  static constexpr size_t kMaxPendingBatches = 8;
+
   /**
-   * @brief Update occlusion for a voice.
+   * @brief Update occlusion for all playing voices.
    *
-   * Queries occlusion and updates the voice's occlusion state.
+   * Advances every voice's query timer, queries the voices that are due
+   * (within the per-frame budget) and smooths all of them.
+   * @param voices Voices to update (real voices with a handle).
+   * @param count Number of voices.
+   * @param listenerPos Current listener position.
+   * @param dt Delta time in seconds.
+   */
+  void Update(Voice *const *voices, size_t count, const Vector3 &listenerPos,
+              float dt);
+
+  /**
+   * @brief Update occlusion for a single voice.
+   *
+   * Equivalent to the batch Update() with one voice.
    * @param voice The voice to update.
    * @param listenerPos Current listener position.
    * @param dt Delta time in seconds.
@@ -118,7 +236,10 @@ public:
   /**
    * @brief Apply DSP effects to a playing voice.
    *
-   * Sets filter and volume based on calculated occlusion.
+   * Sets filter and volume based on calculated occlusion, combined with
+   * the voice's ray-traced propagation if it has any (see
+   * PropagationProcessor). Voices with propagation are updated even while
+   * occlusion is disabled.
    * @param engine Native engine handle.
    * @param voice The voice to apply effects to.
    */
@@ -139,15 +260,79 @@ public:
    */
   [[nodiscard]] float GetOcclusionThreshold() const;
 
+  /**
+   * @brief Get the number of queries issued by the last Update().
+   */
+  [[nodiscard]] uint32_t GetLastQueryCount() const;
+
+  /**
+   * @brief Get the number of due voices answered from the cache by the
+   *        last Update().
+   */
+  [[nodiscard]] uint32_t GetLastCacheHitCount() const;
+
+  /**
+   * @brief Get the number of voices answered by the propagation field in
+   *        the last Update().
+   */
+  [[nodiscard]] uint32_t GetLastFieldSampleCount() const;
+
+  /**
+   * @brief Get the number of voices answered by the portal graph in the
+   *        last Update().
+   */
+  [[nodiscard]] uint32_t GetLastPortalPathCount() const;
+
+  /**
+   * @brief Result cache (cell size, lifetime, geometry version).
+   */
+  [[nodiscard]] OcclusionCache &GetCache() { return m_Cache; }
+  [[nodiscard]] const OcclusionCache &GetCache() const { return m_Cache; }
+
+  /**
+   * @brief Get the refresh interval a voice is scheduled at.
+   * @param voice Voice (uses its audibility).
+   * @return Interval in seconds.
+   */
+  [[nodiscard]] float GetRefreshInterval(const Voice &voice) const;
+
+  /**
+   * @brief Number of submitted batches not yet applied.
+   */
+  [[nodiscard]] size_t GetPendingBatchCount() const;
+
   /// @}
 
 private:
   void RegisterDefaultMaterials();
+  struct PendingBatch {
+    OcclusionBatchID id;
+    uint32_t geometryVersion; ///< Cache version at submission
+    std::vector<OcclusionRay> rays;
+    std::vector<std::pair<uint32_t, VoiceID>> voices; ///< (ray, voice)
+  };
+
+  struct CompletedBatch {
+    OcclusionBatchID id;
+    std::vector<OcclusionRayHit> hits;
+  };
+
   const OcclusionMaterial &GetMaterial(const std::string &name) const;
+  const OcclusionMaterial &GetMaterial(OcclusionMaterialID id) const;
   void SmoothValues(Voice &voice, float dt);
+  void Query(Voice &voice, const Vector3 &listenerPos);
+  bool ApplyCached(Voice &voice, const Vector3 &listenerPos);
+  void Submit(const Vector3 &listenerPos);
+  void ApplyCompleted(Voice *const *voices, size_t count);
+  void ApplyTotals(Voice &voice, float obstruction, float occlusionBias) const;
+  void ClearOcclusion(Voice &voice) const;
 
   OcclusionQueryCallback m_QueryCallback;
-  std::unordered_map<std::string, OcclusionMaterial> m_Materials;
+  OcclusionBatchCallback m_BatchCallback;
+  const PropagationField *m_Field = nullptr;
+  const PortalGraph *m_Portals = nullptr;
+  std::vector<OcclusionMaterial> m_Materials; ///< By id
+  std::unordered_map<std::string, OcclusionMaterialID> m_MaterialIDs;
 
   bool m_Enabled = true;
   float m_OcclusionThreshold = 0.7f;
@@ -158,7 +343,26 @@ private:
   float m_MaxLowPassFreq = 22000.0f;
   float m_MaxVolumeReduction = 0.5f;
 
-  float m_TimeSinceLastUpdate = 0.0f;
+  uint32_t m_MaxQueriesPerFrame = kDefaultMaxQueriesPerFrame;
+  uint32_t m_LastQueryCount = 0;
+  uint32_t m_LastCacheHitCount = 0;
+  uint32_t m_LastFieldSampleCount = 0;
+  uint32_t m_LastPortalPathCount = 0;
+  float m_Time = 0.0f; ///< Seconds of Update() time, for cache expiry
+  OcclusionCache m_Cache;
+  std::vector<std::pair<float, Voice *>> m_Due; ///< Scratch: staleness
+
+  OcclusionBatchID m_NextBatchID = 1;
+  std::vector<PendingBatch> m_Pending; ///< Oldest first
+  std::unordered_map<OcclusionCache::Key, uint32_t, OcclusionCache::KeyHash>
+      m_BatchRays; ///< Scratch: ray per cell pair in the batch
+
+  mutable std::mutex m_CompletedMutex;
+  std::vector<CompletedBatch> m_Completed; ///< Guarded by m_CompletedMutex
+  std::vector<CompletedBatch> m_Applying;  ///< Swapped out of m_Completed
+  std::unordered_map<VoiceID, Voice *> m_VoiceByID; ///< Scratch
+  std::vector<float> m_RayObstruction;              ///< Scratch, per ray
+  std::vector<float> m_RayBias;                     ///< Scratch, per ray
 };
 
 } // namespace Orpheus
@@ -2,11 +2,14 @@
  * @file OcclusionQuery.h
  * @brief Occlusion query interface for game engine integration.
  *
- * Defines the callback type for occlusion raycasts that the game
- * engine must provide.
+ * Defines the callback types for occlusion raycasts that the game
+ * engine must provide: a synchronous per-voice callback, or a batch
+ * callback fulfilled asynchronously.
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -66,4 +69,57 @@ struct OcclusionHit {
 using OcclusionQueryCallback = std::function<std::vector<OcclusionHit>(
     const Vector3 &source, const Vector3 &listener)>;
 
+/// Index of a registered occlusion material (see RegisterMaterial()).
+using OcclusionMaterialID = uint32_t;
+
+/// Identifies a batch submitted through an OcclusionBatchCallback.
+using OcclusionBatchID = uint64_t;
+
+/**
+ * @brief One source/listener pair to raycast in a batch.
+ */
+struct OcclusionRay {
+  Vector3 source;   ///< Position of the sound source
+  Vector3 listener; ///< Position of the listener
+};
+
+/**
+ * @brief One hit of a batched occlusion query.
+ *
+ * Hits of a batch are reported as one flat array; rays without hits are
+ * unobstructed.
+ */
+struct OcclusionRayHit {
+  uint32_t ray = 0;                 ///< Index of the ray in its batch
+  OcclusionMaterialID material = 0; ///< Registered material id
+  float thickness = 1.0f;           ///< Estimated thickness in world units
+};
+
+/**
+ * @brief Callback type for batched occlusion queries.
+ *
+ * Called at most once per frame with every ray due that frame. The rays
+ * are only valid during the call; copy them and complete the batch later
+ * (e.g. from a physics job, possibly on a later frame) with
+ * AudioManager::CompleteOcclusionBatch(). Results of a batch that is never
+ * completed are dropped and its voices are queried again.
+ *
+ * @param batch Id to pass back when completing the batch.
+ * @param rays Source/listener pairs to raycast.
+ * @param count Number of rays.
+ *
+ * @par Example Implementation:
+ * @code
+ * audio.SetOcclusionBatchCallback(
+ *     [&](OcclusionBatchID batch, const OcclusionRay *rays, size_t count) {
+ *       jobs.Schedule([&, batch, work = std::vector(rays, rays + count)] {
+ *         std::vector<OcclusionRayHit> hits = physics.RaycastAll(work);
+ *         audio.CompleteOcclusionBatch(batch, hits.data(), hits.size());
+ *       });
+ *     });
+ * @endcode
+ */
+using OcclusionBatchCallback = std::function<void(
+    OcclusionBatchID batch, const OcclusionRay *rays, size_t count)>;
+
 } // namespace Orpheus
@@ -0,0 +1,162 @@
+/**
+ * @file OcclusionScene.h
+ * @brief Built-in occlusion geometry for games without a physics query layer.
+ *
+ * Provides the OcclusionScene class, a set of triangle meshes tagged with
+ * occlusion material ids that answers occlusion rays through a TriangleBVH.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OcclusionQuery.h"
+#include "TriangleBVH.h"
+#include "Types.h"
+
+namespace Orpheus {
+
+/// Identifies a mesh in an OcclusionScene.
+using OcclusionMeshID = uint32_t;
+
+/**
+ * @brief Triangle meshes answering occlusion queries without a game callback.
+ *
+ * Each mesh carries an occlusion material id (see
+ * OcclusionProcessor::RegisterMaterial()) and is either:
+ * - **solid** (shellThickness 0): a closed mesh whose thickness along a
+ *   ray is the distance between where the ray enters and leaves it, or
+ * - **shell** (shellThickness > 0): open surfaces such as doors or panes,
+ *   where every crossing counts as shellThickness.
+ *
+ * Adding or removing meshes marks the scene for a full SAH rebuild;
+ * moving a mesh's vertices only refits the tree. Both happen in Commit(),
+ * which must be called before querying after changes. Queries are const
+ * and may run concurrently.
+ *
+ * @par Example Usage:
+ * @code
+ * auto scene = std::make_shared<OcclusionScene>();
+ * OcclusionMeshID walls = scene->AddMesh(verts, vertCount, indices,
+ *                                        indexCount, concreteID);
+ * OcclusionMeshID door = scene->AddMesh(doorVerts, 4, doorIndices, 6,
+ *                                       woodID, 0.05f);
+ * audio.SetOcclusionScene(scene);
+ * // When the door swings:
+ * scene->UpdateMesh(door, movedDoorVerts, 4);
+ * @endcode
+ */
+class OcclusionScene {
+public:
+  /// Returned for meshes that do not exist.
+  static constexpr OcclusionMeshID kInvalidMesh = UINT32_MAX;
+
+  /**
+   * @brief Add a triangle mesh.
+   * @param vertices Vertex positions (copied).
+   * @param vertexCount Number of vertices.
+   * @param indices Three indices per triangle, counter-clockwise front
+   *                faces pointing out of solid meshes (copied).
+   * @param indexCount Number of indices (a multiple of 3).
+   * @param material Occlusion material id.
+   * @param shellThickness 0 for solid meshes, otherwise the thickness
+   *                       reported per crossing (world units).
+   * @return Mesh ID, or kInvalidMesh if an index is out of range.
+   */
+  OcclusionMeshID AddMesh(const Vector3 *vertices, size_t vertexCount,
+                          const uint32_t *indices, size_t indexCount,
+                          OcclusionMaterialID material,
+                          float shellThickness = 0.0f);
+
+  /**
+   * @brief Move a mesh's vertices (refit, no rebuild).
+   * @param mesh Mesh to update.
+   * @param vertices New positions.
+   * @param vertexCount Must match the count passed to AddMesh().
+   * @return false if the mesh does not exist or the count differs.
+   */
+  bool UpdateMesh(OcclusionMeshID mesh, const Vector3 *vertices,
+                  size_t vertexCount);
+
+  /**
+   * @brief Change a mesh's material.
+   */
+  void SetMeshMaterial(OcclusionMeshID mesh, OcclusionMaterialID material);
+
+  /**
+   * @brief Remove a mesh.
+   */
+  void RemoveMesh(OcclusionMeshID mesh);
+
+  /**
+   * @brief Apply pending changes (rebuild or refit the BVH).
+   */
+  void Commit();
+
+  /**
+   * @brief Trace one source/listener segment.
+   *
+   * Appends one hit per mesh crossing with its material and thickness.
+   * @param source Sound source position.
+   * @param listener Listener position.
+   * @param hits Output, appended to.
+   * @param ray Value stored in OcclusionRayHit::ray.
+   * @return Number of hits appended.
+   */
+  size_t Raycast(const Vector3 &source, const Vector3 &listener,
+                 std::vector<OcclusionRayHit> &hits, uint32_t ray = 0) const;
+
+  /**
+   * @brief Trace a batch of rays, e.g. from an OcclusionBatchCallback.
+   * @param rays Source/listener pairs.
+   * @param count Number of rays.
+   * @param hits Output, appended to; OcclusionRayHit::ray is the index.
+   */
+  void Raycast(const OcclusionRay *rays, size_t count,
+               std::vector<OcclusionRayHit> &hits) const;
+
+  /**
+   * @brief Incremented whenever query results may have changed (commits
+   *        and material changes).
+   */
+  [[nodiscard]] uint32_t GetVersion() const { return m_Version; }
+
+  [[nodiscard]] size_t GetMeshCount() const;
+  [[nodiscard]] size_t GetTriangleCount() const {
+    return m_TriangleMesh.size();
+  }
+  [[nodiscard]] const TriangleBVH &GetBVH() const { return m_BVH; }
+
+  /**
+   * @brief Get a committed triangle's corners and material.
+   * @param triangle Index below GetTriangleCount().
+   */
+  void GetTriangle(size_t triangle, Vector3 &a, Vector3 &b, Vector3 &c,
+                   OcclusionMaterialID &material) const;
+
+private:
+  struct Mesh {
+    std::vector<Vector3> vertices;
+    std::vector<uint32_t> indices; ///< Mesh-local
+    uint32_t firstVertex;          ///< In m_Vertices after a rebuild
+    OcclusionMaterialID material;
+    float shellThickness;
+    bool alive;
+  };
+
+  size_t Resolve(const Vector3 &source, const Vector3 &listener,
+                 uint32_t ray, std::vector<BVHHit> &scratch,
+                 std::vector<OcclusionRayHit> &hits) const;
+
+  std::vector<Mesh> m_Meshes; ///< By ID
+  std::vector<Vector3> m_Vertices;
+  std::vector<uint32_t> m_Indices; ///< Global, three per triangle
+  std::vector<OcclusionMeshID> m_TriangleMesh; ///< Per triangle
+  TriangleBVH m_BVH;
+  bool m_NeedsRebuild = false;
+  bool m_NeedsRefit = false;
+  uint32_t m_Version = 0;
+};
+
+} // namespace Orpheus
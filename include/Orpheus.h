@@ -10,18 +10,27 @@
 #pragma once
 
 // Orpheus library headers
+#include "AcousticProbeGrid.h"
+#include "AcousticScene.h"
 #include "AudioManager.h"
 #include "Bus.h"
 #include "DSPFilters.h"
 #include "Error.h"
 #include "Event.h"
+#include "ImpulseResponseSynthesizer.h"
 #include "Log.h"
 #include "OcclusionMaterial.h"
 #include "OcclusionProcessor.h"
 #include "OcclusionQuery.h"
+#include "OcclusionScene.h"
 #include "Parameter.h"
+#include "PortalGraph.h"
+#include "PropagationCache.h"
+#include "PropagationField.h"
+#include "PropagationProcessor.h"
 #include "ReverbBus.h"
 #include "ReverbZone.h"
 #include "SoundBank.h"
 #include "Types.h"
 #include "VirtualVoiceManager.h"
+#include "WorkerPool.h"
@@ -0,0 +1,186 @@
+/**
+ * @file PortalGraph.h
+ * @brief Room and portal propagation for indoor occlusion.
+ *
+ * Provides the PortalGraph class, which routes sound from a source to the
+ * listener through the doors and windows connecting rooms.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Types.h"
+#include "ZoneShape.h"
+
+namespace Orpheus {
+
+/// Identifies a room in a PortalGraph.
+using RoomID = uint32_t;
+
+/// Identifies a portal in a PortalGraph.
+using PortalID = uint32_t;
+
+/**
+ * @brief Shortest portal path from a source to the listener.
+ */
+struct PortalPath {
+  bool valid = false;       ///< Source and listener are both inside rooms
+  bool reachable = false;   ///< A portal path connects their rooms
+  float obstruction = 0.0f; ///< Closed portals plus detour (0-1)
+  float pathLength = 0.0f;  ///< Length of the path through the portals
+  uint32_t portalCount = 0; ///< Portals crossed
+  Vector3 virtualPosition{0.0f, 0.0f, 0.0f}; ///< Apparent source position
+};
+
+/**
+ * @brief Rooms connected by portals, searched from the listener's room.
+ *
+ * Rooms are zone shapes; a point belongs to the first created room that
+ * contains it, or keeps its previous room (the lookup hint) while it is
+ * still inside, so sources standing in a doorway do not flicker.
+ *
+ * Portals connect two rooms at a point and have an openness from 0
+ * (closed) to 1 (open). Crossing a portal costs its distance plus
+ * closedPenalty * (1 - openness) metres, so sound takes an open detour
+ * over a closed door when it is short enough.
+ *
+ * Update() runs one graph search per portal of the listener's room, only
+ * when the listener changes room or a portal changes. A source's path is
+ * then the cheapest combination of listener portal, cached table entry
+ * and source-room portal, a handful of lookups per voice.
+ *
+ * The path's obstruction is the summed closedness of its portals plus
+ * detour / diffractionScale, where the detour is how much longer the path
+ * is than the straight line. The virtual position is the path length
+ * away from the listener in the direction of the first portal, where the
+ * sound appears to come from.
+ *
+ * @par Example Usage:
+ * @code
+ * PortalGraph graph;
+ * RoomID hall = graph.CreateRoom(ZoneGeometry::Box({0, 0, 0},
+ *                                                  {10, 3, 10}, 0));
+ * RoomID kitchen = graph.CreateRoom(ZoneGeometry::Box({10, 0, 0},
+ *                                                     {20, 3, 10}, 0));
+ * PortalID door = graph.AddPortal(hall, kitchen, {10, 1, 5});
+ * graph.SetPortalOpenness(door, 0.0f);
+ * graph.Update(listener);
+ * PortalPath path = graph.FindPath(source, listener,
+ *                                  graph.FindRoom(source));
+ * @endcode
+ */
+class PortalGraph {
+public:
+  /// Returned for points outside every room and unknown rooms.
+  static constexpr RoomID kInvalidRoom = UINT32_MAX;
+
+  /// Returned when a portal cannot be added.
+  static constexpr PortalID kInvalidPortal = UINT32_MAX;
+
+  /**
+   * @brief Add a room.
+   * @param shape Room volume (the fade band is ignored).
+   */
+  RoomID CreateRoom(const ZoneGeometry &shape);
+
+  /**
+   * @brief Connect two rooms.
+   * @param a First room.
+   * @param b Second room.
+   * @param position Portal centre.
+   * @param openness 0 (closed) to 1 (open).
+   * @return Portal ID, or kInvalidPortal if a room is unknown or a == b.
+   */
+  PortalID AddPortal(RoomID a, RoomID b, const Vector3 &position,
+                     float openness = 1.0f);
+
+  /**
+   * @brief Open or close a portal (re-searches on the next Update()).
+   */
+  void SetPortalOpenness(PortalID portal, float openness);
+
+  /**
+   * @brief Extra path cost in metres for a fully closed portal
+   *        (default: 20).
+   */
+  void SetClosedPenalty(float metres);
+
+  /**
+   * @brief Detour length that counts as full obstruction (default: 10).
+   */
+  void SetDiffractionScale(float metres);
+
+  /**
+   * @brief Find the room containing a point.
+   * @param point Position to locate.
+   * @param hint Room kept if it still contains the point (e.g. the
+   *             point's previous room).
+   * @return Room, or kInvalidRoom.
+   */
+  [[nodiscard]] RoomID FindRoom(const Vector3 &point,
+                                RoomID hint = kInvalidRoom) const;
+
+  /**
+   * @brief Locate the listener and refresh the path tables if needed.
+   */
+  void Update(const Vector3 &listener);
+
+  /**
+   * @brief Path from a source to the listener passed to Update().
+   * @param source Source position.
+   * @param listener Listener position (within the room given to Update()).
+   * @param sourceRoom Room of the source (see FindRoom()).
+   */
+  [[nodiscard]] PortalPath FindPath(const Vector3 &source,
+                                    const Vector3 &listener,
+                                    RoomID sourceRoom) const;
+
+  [[nodiscard]] RoomID GetListenerRoom() const { return m_ListenerRoom; }
+  [[nodiscard]] size_t GetRoomCount() const { return m_Rooms.size(); }
+  [[nodiscard]] size_t GetPortalCount() const { return m_Portals.size(); }
+  [[nodiscard]] float GetPortalOpenness(PortalID portal) const;
+
+  /**
+   * @brief Number of graph searches run so far.
+   */
+  [[nodiscard]] uint32_t GetSearchCount() const { return m_SearchCount; }
+
+private:
+  struct Room {
+    ZoneGeometry shape;
+    Vector3 min; ///< Bounds for a quick rejection
+    Vector3 max;
+    std::vector<PortalID> portals;
+  };
+
+  struct Portal {
+    RoomID rooms[2];
+    Vector3 position;
+    float openness;
+  };
+
+  /// Cheapest path from a listener-room portal to a portal.
+  struct TableEntry {
+    float cost;
+    float length;
+    float closedness; ///< Summed 1 - openness
+    uint32_t hops;
+  };
+
+  [[nodiscard]] bool Contains(const Room &room, const Vector3 &point) const;
+  void Search(PortalID start, TableEntry *table);
+
+  std::vector<Room> m_Rooms;
+  std::vector<Portal> m_Portals;
+  float m_ClosedPenalty = 20.0f;
+  float m_DiffractionScale = 10.0f;
+
+  RoomID m_ListenerRoom = kInvalidRoom;
+  bool m_Dirty = true;
+  std::vector<TableEntry> m_Tables; ///< One row per listener-room portal
+  uint32_t m_SearchCount = 0;
+};
+
+} // namespace Orpheus
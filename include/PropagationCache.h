@@ -0,0 +1,183 @@
+/**
+ * @file PropagationCache.h
+ * @brief Per-voice running estimates of ray-traced propagation.
+ *
+ * Provides the PropagationCache class, which spreads each voice's ray set
+ * over several updates and blends the partial traces into a running
+ * estimate.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "RaytracedAcoustics.h"
+#include "Voice.h"
+
+namespace Orpheus {
+
+/**
+ * @brief Running estimate of a voice's propagation.
+ *
+ * Holds the sums PropagationEffect::FromResult() and the early reflection
+ * parameters are computed from, averaged over partial traces. The direct
+ * path is exact as of the last update.
+ */
+struct PropagationEstimate {
+  bool hasDirectPath = false;
+  float directDistance = 0.0f;
+  PropagationPath directPath; ///< Valid if hasDirectPath
+
+  float indirectGainLow = 0.0f;  ///< Summed gains of non-direct paths
+  float indirectGainMid = 0.0f;
+  float indirectGainHigh = 0.0f;
+  float indirectPaths = 0.0f;     ///< Non-direct paths in a full ray set
+  float indirectHighRatio = 0.0f; ///< Summed gainHigh / mean gain
+  float reflectionGain = 0.0f;    ///< Summed mean gain of reflected paths
+  float earlyReflectionDelay = 0.0f; ///< Seconds (0 if none found yet)
+
+  /// Full ray sets traced since the last reset; 1 or more is converged.
+  float coverage = 0.0f;
+
+  [[nodiscard]] bool IsConverged() const { return coverage >= 1.0f; }
+
+  /**
+   * @brief Early reflection gain as in PropagationResult (0-1).
+   */
+  [[nodiscard]] float GetEarlyReflectionGain() const;
+
+  /**
+   * @brief Effect parameters, as PropagationEffect::FromResult() computes
+   *        them from a full trace.
+   */
+  [[nodiscard]] PropagationEffect ToEffect() const;
+};
+
+/**
+ * @brief Incremental per-voice ray tracing with temporal averaging.
+ *
+ * Each update traces only a slice of a voice's ray set (see
+ * AcousticRaySlice), walking through the whole set over successive
+ * updates, and blends the slice into the voice's estimate:
+ * - After a reset the estimate is the plain mean of the slices so far,
+ *   traced with the converging fraction of the rays (default: 1/2), until
+ *   one full ray set has been covered.
+ * - Converged voices trace the converged fraction (default: 1/8) and blend
+ *   it in with exponential averaging over about one ray set.
+ * - A source or listener jump larger than the reconverge distance between
+ *   two updates, or a change of the tracer's ray count, resets the
+ *   estimate.
+ *
+ * Slices change the scattering random streams on every pass through the
+ * ray set, so averaging also smooths scattering noise.
+ *
+ * @par Example Usage:
+ * @code
+ * PropagationCache cache;
+ * // Every frame
+ * cache.Update(voiceIDs.data(), sources.data(), voiceIDs.size(), listener,
+ *              tracer);
+ * PropagationEffect effect = cache.Find(voiceID)->ToEffect();
+ * // When a voice stops
+ * cache.Remove(voiceID);
+ * @endcode
+ */
+class PropagationCache {
+public:
+  /// Default jump distance that resets an estimate, in world units.
+  static constexpr float kDefaultReconvergeDistance = 1.0f;
+
+  /**
+   * @brief Set the fractions of the ray set traced per update.
+   * @param converging While converging (default: 0.5).
+   * @param converged Once converged (default: 0.125).
+   */
+  void SetUpdateFractions(float converging, float converged);
+
+  /**
+   * @brief Set the jump distance that resets an estimate.
+   */
+  void SetReconvergeDistance(float distance);
+
+  /**
+   * @brief Trace and blend one slice for each voice.
+   *
+   * All slices are traced in one AcousticRayTracer::TraceBatch() call.
+   * Voices seen for the first time start converging.
+   * @param voices Voice IDs.
+   * @param sources Source position of each voice.
+   * @param count Number of voices.
+   * @param listener Listener position.
+   * @param tracer Tracer to trace with.
+   */
+  void Update(const VoiceID *voices, const AcousticVector *sources,
+              size_t count, const AcousticVector &listener,
+              const AcousticRayTracer &tracer);
+
+  /**
+   * @brief Trace and blend one slice for a single voice.
+   */
+  const PropagationEstimate &Update(VoiceID voice,
+                                    const AcousticVector &source,
+                                    const AcousticVector &listener,
+                                    const AcousticRayTracer &tracer);
+
+  /**
+   * @brief Rays the next update of a voice will trace.
+   *
+   * A converging slice for voices not seen yet. Jumps that reset an
+   * estimate are not anticipated.
+   */
+  [[nodiscard]] int GetNextSliceRays(VoiceID voice,
+                                     const AcousticRayTracer &tracer) const;
+
+  /**
+   * @brief Get a voice's estimate, or nullptr if never updated.
+   */
+  [[nodiscard]] const PropagationEstimate *Find(VoiceID voice) const;
+
+  /**
+   * @brief Drop a voice's estimate.
+   */
+  void Remove(VoiceID voice);
+
+  /**
+   * @brief Drop every estimate.
+   */
+  void Clear();
+
+  [[nodiscard]] size_t GetEntryCount() const { return m_Entries.size(); }
+
+  /**
+   * @brief Rays traced so far (direct paths excluded).
+   */
+  [[nodiscard]] uint64_t GetRaysTraced() const { return m_RaysTraced; }
+
+private:
+  struct Entry {
+    PropagationEstimate estimate;
+    AcousticVector source;
+    AcousticVector listener;
+    int rayCount = 0; ///< Tracer ray count the estimate was built with
+    uint32_t nextChunk = 0;
+    uint32_t pass = 0;
+  };
+
+  void Blend(Entry &entry, const PropagationResult &result, int sliceRays,
+             int rayCount);
+
+  std::unordered_map<VoiceID, Entry> m_Entries;
+  float m_ConvergingFraction = 0.5f;
+  float m_ConvergedFraction = 0.125f;
+  float m_ReconvergeDistance = kDefaultReconvergeDistance;
+  uint64_t m_RaysTraced = 0;
+
+  // Scratch, reused between updates
+  std::vector<Entry *> m_Batch;
+  std::vector<AcousticRaySlice> m_Slices;
+  std::vector<PropagationResult> m_Results;
+};
+
+} // namespace Orpheus
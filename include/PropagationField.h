@@ -0,0 +1,222 @@
+/**
+ * @file PropagationField.h
+ * @brief Grid-based sound propagation for whole-scene occlusion.
+ *
+ * Provides the PropagationField class, a voxel grid flooded from the
+ * listener so every source's occlusion and diffracted path length is a
+ * single cell lookup instead of a raycast.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "OcclusionQuery.h"
+#include "Types.h"
+
+namespace Orpheus {
+
+class OcclusionScene;
+
+/**
+ * @brief Propagation result for one source position.
+ */
+struct PropagationSample {
+  bool valid = false;        ///< Source inside the grid and field current
+  float obstruction = 0.0f;  ///< Combined transmission and detour (0-1)
+  float transmission = 0.0f; ///< Summed obstruction of cells passed through
+  float pathLength = 0.0f;   ///< Shortest (diffracted) path length
+};
+
+/**
+ * @brief Voxelized acoustic scene flooded from the listener.
+ *
+ * Each cell stores how much it obstructs sound (0 = air). A Dijkstra
+ * flood from the listener's cell finds, for every cell, the cheapest path
+ * where air costs its length and entering an obstructing cell adds
+ * wallPenalty * obstruction metres. Diagonal steps never cut the corners
+ * of obstructing cells, and only axis-aligned steps enter them.
+ *
+ * Every step costs at least one cell length, so the flood uses a ring of
+ * cost buckets one cell wide instead of a binary heap: all cells in a
+ * bucket are final when it is reached, which keeps the search exact.
+ *
+ * A sample reports the path length, the obstruction summed along the
+ * path (transmission), and a combined obstruction of transmission plus
+ * detour / diffractionScale, where the detour is how much longer the path
+ * is than the straight line.
+ *
+ * The flood is only rerun when the listener changes cell or the grid
+ * changes, and it is time-sliced: Update() expands at most maxExpansions
+ * cells and samples keep reading the previous completed field until the
+ * new one is done. A listener moving to another cell does not interrupt a
+ * running flood; the next one starts from the listener's cell once it
+ * completes, so a moving listener still gets fields. While the completed
+ * field's origin is more than the maximum listener drift from the
+ * listener's cell, samples are invalid so callers fall back to direct
+ * queries. Cells the flood never reached report full obstruction.
+ *
+ * @par Example Usage:
+ * @code
+ * PropagationField field;
+ * field.Configure({-100, -5, -100}, {100, 20, 100}, 1.0f);
+ * field.Voxelize(scene, [&](OcclusionMaterialID id) { return obs[id]; });
+ * field.Update(listener);
+ * PropagationSample s = field.Sample(source, listener);
+ * @endcode
+ */
+class PropagationField {
+public:
+  /// Cells a grid may hold.
+  static constexpr size_t kMaxCells = size_t{1} << 24;
+
+  /// Default cell expansions per Update().
+  static constexpr uint32_t kDefaultMaxExpansions = 1u << 14;
+
+  /// Default cells the listener may move from a field's origin.
+  static constexpr uint32_t kDefaultMaxListenerDrift = 2;
+
+  /**
+   * @brief Allocate an empty (all air) grid.
+   * @param min Minimum corner in world units.
+   * @param max Maximum corner in world units.
+   * @param cellSize Cell edge length.
+   * @return false if the grid would exceed kMaxCells or is empty.
+   */
+  bool Configure(const Vector3 &min, const Vector3 &max, float cellSize);
+
+  /**
+   * @brief Mark the cells touched by an occlusion scene's triangles.
+   *
+   * Cells keep the highest obstruction of the triangles touching them.
+   * @param scene Committed occlusion scene.
+   * @param obstructionOf Obstruction (0-1) of a material id.
+   */
+  void Voxelize(const OcclusionScene &scene,
+                const std::function<float(OcclusionMaterialID)> &obstructionOf);
+
+  /**
+   * @brief Set the obstruction of every cell overlapping a box.
+   */
+  void FillBox(const Vector3 &min, const Vector3 &max, float obstruction);
+
+  /**
+   * @brief Reset every cell to air.
+   */
+  void ClearCells();
+
+  /**
+   * @brief Extra path cost in metres for entering a fully obstructing
+   *        cell (default: 20).
+   */
+  void SetWallPenalty(float metres);
+
+  /**
+   * @brief Detour length that counts as full obstruction (default: 10).
+   */
+  void SetDiffractionScale(float metres);
+
+  /**
+   * @brief Limit cell expansions per Update() (at least 1).
+   */
+  void SetMaxExpansions(uint32_t count);
+
+  /**
+   * @brief Limit how many cells (per axis) the listener may be from the
+   *        completed field's origin before samples are invalid.
+   */
+  void SetMaxListenerDrift(uint32_t cells);
+
+  /**
+   * @brief Advance the flood for the listener position.
+   *
+   * Restarts the flood if the grid changed, or starts one from the
+   * listener's cell if none is running and the completed field is from
+   * another cell, then expands up to the configured number of cells.
+   */
+  void Update(const Vector3 &listener);
+
+  /**
+   * @brief Look up propagation from a source to the listener.
+   * @param source Source position.
+   * @param listener Listener position (for the straight-line distance).
+   */
+  [[nodiscard]] PropagationSample Sample(const Vector3 &source,
+                                         const Vector3 &listener) const;
+
+  /**
+   * @brief Whether a flood is in progress.
+   */
+  [[nodiscard]] bool IsComputing() const { return m_Queued > 0; }
+
+  /**
+   * @brief Number of floods completed.
+   */
+  [[nodiscard]] uint32_t GetFloodCount() const { return m_FloodCount; }
+
+  [[nodiscard]] float GetCellSize() const { return m_CellSize; }
+  [[nodiscard]] size_t GetCellCount() const { return m_Obstruction.size(); }
+
+  /**
+   * @brief Obstruction of the cell containing a point (0 outside).
+   */
+  [[nodiscard]] float GetCellObstruction(const Vector3 &point) const;
+
+private:
+  using QueueEntry = std::pair<float, uint32_t>; ///< (cost, cell)
+
+  /// Flood step to one of the 26 neighbours.
+  struct Step {
+    int32_t offset;     ///< Linear cell offset
+    int8_t dx, dy, dz;  ///< Grid offset
+    uint8_t cornerCount;
+    float length;       ///< Step length in world units
+    int32_t corners[6]; ///< Cells that must be open for a diagonal step
+  };
+
+  [[nodiscard]] bool CellOf(const Vector3 &point, int32_t &x, int32_t &y,
+                            int32_t &z) const;
+  [[nodiscard]] uint32_t Index(int32_t x, int32_t y, int32_t z) const {
+    return static_cast<uint32_t>((z * m_DimY + y) * m_DimX + x);
+  }
+  void MarkPoint(const Vector3 &point, uint8_t obstruction);
+  void StartFlood(uint32_t origin);
+  void Expand(uint32_t budget);
+  void Push(float cost, uint32_t cell);
+  void ClearQueue();
+
+  Vector3 m_Min{0.0f, 0.0f, 0.0f};
+  float m_CellSize = 1.0f;
+  int32_t m_DimX = 0;
+  int32_t m_DimY = 0;
+  int32_t m_DimZ = 0;
+  std::vector<uint8_t> m_Obstruction; ///< Per cell, 0-255
+  Step m_Steps[26] = {};
+
+  float m_WallPenalty = 20.0f;
+  float m_DiffractionScale = 10.0f;
+  uint32_t m_MaxExpansions = kDefaultMaxExpansions;
+  uint32_t m_MaxListenerDrift = kDefaultMaxListenerDrift;
+
+  // Completed field, read by Sample()
+  std::vector<float> m_PathLength;
+  std::vector<float> m_Transmission;
+  bool m_HasField = false;
+  uint32_t m_FieldOrigin = UINT32_MAX; ///< Listener cell of the field
+
+  // Flood in progress
+  std::vector<float> m_Cost;
+  std::vector<float> m_NextLength;
+  std::vector<float> m_NextTransmission;
+  std::vector<std::vector<QueueEntry>> m_Buckets; ///< Ring by cost
+  size_t m_Bucket = 0; ///< Absolute index of the bucket being expanded
+  size_t m_Queued = 0; ///< Entries in all buckets
+  uint32_t m_FloodOrigin = UINT32_MAX;
+  bool m_GridChanged = true;
+  uint32_t m_FloodCount = 0;
+};
+
+} // namespace Orpheus
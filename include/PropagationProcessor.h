@@ -0,0 +1,153 @@
+/**
+ * @file PropagationProcessor.h
+ * @brief Applies ray-traced propagation to playing voices.
+ *
+ * Provides the PropagationProcessor class, which schedules per-voice
+ * acoustic tracing within a ray budget, runs it on a background thread and
+ * stages the resulting volume, low-pass and reverb send on each voice.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "AcousticProbeGrid.h"
+#include "RaytracedAcoustics.h"
+#include "Voice.h"
+
+namespace Orpheus {
+
+// Forward declaration for PIMPL
+struct PropagationProcessorImpl;
+
+/**
+ * @brief Budgeted, asynchronous ray-traced propagation for voices.
+ *
+ * @par Scheduling:
+ * Like occlusion queries, each voice has its own timer. Its refresh
+ * interval is 1 / update rate for fully audible voices, stretching to
+ * kQuietIntervalScale times that for inaudible ones. Due voices are
+ * ordered by priority, then by staleness relative to their interval, and
+ * taken in that order while their rays fit the per-frame ray budget (the
+ * first voice is always taken). Voices never traced go first within their
+ * priority.
+ *
+ * @par Tracing:
+ * Voices are traced incrementally through a PropagationCache, so a
+ * converged voice costs only a slice of the ray set per update. The batch
+ * is traced on a background thread between Update() calls and its effects
+ * are written to a back buffer; the next Update() after the batch
+ * finished swaps buffers and stages the effects on the voices. A new
+ * batch starts only once the previous one has been applied.
+ *
+ * With baked probes, voices inside the probe volume take their reverb
+ * send from the probes instead of being traced and cost no rays.
+ *
+ * @par Staging:
+ * Targets are smoothed every Update() into the voice's
+ * propagation*Smoothed fields, which OcclusionProcessor::ApplyDSP()
+ * combines with occlusion: volumes multiply and the lower cutoff wins.
+ * Voices glide back to neutral when tracing is disabled.
+ *
+ * Each batch traces with a copy of the tracer taken when it starts, so
+ * the tracer may be reconfigured while a batch runs. The geometry
+ * callbacks are called on the background thread and must be safe to run
+ * while the main thread changes the geometry (AcousticScene is); a
+ * replaced callback may still be called until Wait() returns.
+ *
+ * @par Example Usage:
+ * @code
+ * PropagationProcessor propagation;
+ * propagation.SetRayBudget(8192);
+ * // Every frame, after the voices moved
+ * propagation.Update(voices.data(), voices.size(), listener, tracer,
+ *                    nullptr, dt);
+ * @endcode
+ */
+class PropagationProcessor {
+public:
+  /// Default rays traced per frame over all voices.
+  static constexpr uint32_t kDefaultRayBudget = 8192;
+
+  /// Refresh interval multiplier for inaudible voices.
+  static constexpr float kQuietIntervalScale = 4.0f;
+
+  PropagationProcessor();
+
+  /**
+   * @brief Stop the tracing thread, waiting for a running batch.
+   */
+  ~PropagationProcessor();
+
+  PropagationProcessor(const PropagationProcessor &) = delete;
+  PropagationProcessor &operator=(const PropagationProcessor &) = delete;
+
+  /**
+   * @brief Set the rays traced per frame over all voices.
+   */
+  void SetRayBudget(uint32_t raysPerFrame);
+
+  /**
+   * @brief Set how often fully audible voices are traced (default 4 Hz).
+   */
+  void SetUpdateRate(float hz);
+
+  /**
+   * @brief Set the smoothing time of staged parameters (default 0.2 s).
+   */
+  void SetSmoothingTime(float seconds);
+
+  /**
+   * @brief Apply finished results, schedule voices and smooth them.
+   * @param voices Real voices with a handle.
+   * @param count Number of voices.
+   * @param listenerPos Listener position.
+   * @param tracer Tracer to trace with; disabled tracers trace nothing.
+   * @param probes Optional baked probes.
+   * @param dt Delta time in seconds.
+   */
+  void Update(Voice *const *voices, size_t count, const Vector3 &listenerPos,
+              const AcousticRayTracer &tracer, const AcousticProbeGrid *probes,
+              float dt);
+
+  /**
+   * @brief Block until no batch is running.
+   */
+  void Wait();
+
+  /**
+   * @brief Check if a batch is being traced.
+   */
+  [[nodiscard]] bool IsBusy() const;
+
+  /**
+   * @brief Drop all estimates, e.g. after a level change. Waits first.
+   */
+  void Reset();
+
+  /**
+   * @brief Get the refresh interval a voice is scheduled at.
+   */
+  [[nodiscard]] float GetRefreshInterval(const Voice &voice) const;
+
+  /**
+   * @brief Voices submitted for tracing by the last Update().
+   */
+  [[nodiscard]] uint32_t GetLastTracedVoiceCount() const;
+
+  /**
+   * @brief Rays submitted by the last Update().
+   */
+  [[nodiscard]] uint32_t GetLastRayCount() const;
+
+  /**
+   * @brief Voices answered by baked probes in the last Update().
+   */
+  [[nodiscard]] uint32_t GetLastProbeSampleCount() const;
+
+private:
+  std::unique_ptr<PropagationProcessorImpl> m_Impl;
+};
+
+} // namespace Orpheus
@@ -11,10 +11,19 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
+#include "WorkerPool.h"
+
 namespace Orpheus {
 
 /**
@@ -131,17 +140,65 @@ using GeometryCallback =
     std::function<RayHit(const AcousticVector &origin,
                          const AcousticVector &direction, float maxDistance)>;
 
+/// Index of a material registered with AcousticRayTracer::RegisterMaterial().
+using AcousticMaterialID = uint32_t;
+
+/**
+ * @brief Batch of rays in structure-of-arrays layout.
+ *
+ * Lanes from count up to the tracer's packet size repeat the last ray, so
+ * a SIMD raycast can always process full packets; their hits are ignored.
+ */
+struct AcousticRayPacket {
+  static constexpr size_t kMaxRays = 16;
+
+  size_t count = 0; ///< Rays in use
+  float originX[kMaxRays];
+  float originY[kMaxRays];
+  float originZ[kMaxRays];
+  float directionX[kMaxRays]; ///< Normalized direction
+  float directionY[kMaxRays];
+  float directionZ[kMaxRays];
+  float maxDistance[kMaxRays];
+};
+
+/**
+ * @brief Hits of an AcousticRayPacket, filled in by the packet callback.
+ *
+ * The tracer clears hitMask before each call; only lanes with their bit
+ * set need distance, normal and material.
+ */
+struct AcousticHitPacket {
+  uint32_t hitMask = 0; ///< Bit i is set if ray i hit
+  float distance[AcousticRayPacket::kMaxRays];
+  float normalX[AcousticRayPacket::kMaxRays];
+  float normalY[AcousticRayPacket::kMaxRays];
+  float normalZ[AcousticRayPacket::kMaxRays];
+  AcousticMaterialID material[AcousticRayPacket::kMaxRays];
+};
+
+/**
+ * @brief Callback intersecting a packet of rays with scene geometry.
+ *
+ * Replaces one GeometryCallback call per ray with one call per packet, and
+ * reports materials as indices into the tracer's material table instead of
+ * copies.
+ */
+using GeometryPacketCallback =
+    std::function<void(const AcousticRayPacket &rays, AcousticHitPacket &hits)>;
+
 /**
  * @brief Single propagation path from source to listener.
  */
 struct PropagationPath {
-  float delay = 0.0f;    // Time delay in seconds
-  float gainLow = 1.0f;  // Gain for low frequencies
-  float gainMid = 1.0f;  // Gain for mid frequencies
-  float gainHigh = 1.0f; // Gain for high frequencies
-  int reflections = 0;   // Number of bounces
-  float distance = 0.0f; // Total path length
-  bool isDirect = false; // Is this the direct path?
+  float delay = 0.0f;         // Time delay in seconds
+  float gainLow = 1.0f;       // Gain for low frequencies
+  float gainMid = 1.0f;       // Gain for mid frequencies
+  float gainHigh = 1.0f;      // Gain for high frequencies
+  int reflections = 0;        // Number of bounces
+  float distance = 0.0f;      // Total path length
+  bool isDirect = false;      // Is this the direct path?
+  bool isImageSource = false; // Is this an image-source reflection?
 };
 
 /**
@@ -179,27 +236,435 @@ struct PropagationResult {
   }
 };
 
+/**
+ * @brief PCG32 random generator with selectable streams.
+ *
+ * Each chunk of rays gets its own stream, so scattering is reproducible
+ * for a seed no matter which thread traces the chunk.
+ */
+class AcousticRandom {
+public:
+  AcousticRandom(uint64_t seed, uint64_t stream)
+      : m_Increment((stream << 1u) | 1u) {
+    Next();
+    m_State += seed;
+    Next();
+  }
+
+  uint32_t Next() {
+    const uint64_t old = m_State;
+    m_State = old * 6364136223846793005ull + m_Increment;
+    const auto shifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+    const auto rotation = static_cast<uint32_t>(old >> 59u);
+    return (shifted >> rotation) | (shifted << ((32u - rotation) & 31u));
+  }
+
+  /// Uniform float in [0, 1).
+  float NextFloat() {
+    return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+private:
+  uint64_t m_State = 0;
+  uint64_t m_Increment;
+};
+
+/**
+ * @brief Reflecting plane for the image-source model.
+ *
+ * Holds the points x with normal.Dot(x) == distance. The unit normal
+ * faces the side sound reflects on, i.e. into the room.
+ */
+struct AcousticPlane {
+  AcousticVector normal;
+  float distance = 0.0f;
+  AcousticMaterialID material = 0;
+
+  /// Signed distance of a point, positive on the normal's side.
+  [[nodiscard]] float SignedDistance(const AcousticVector &p) const {
+    return normal.Dot(p) - distance;
+  }
+
+  /// Mirror image of a point.
+  [[nodiscard]] AcousticVector Mirror(const AcousticVector &p) const {
+    return p - normal * (2.0f * SignedDistance(p));
+  }
+};
+
+/**
+ * @brief Image sources of a room made of planes, for exact early
+ *        reflections.
+ *
+ * Mirrors a source in every plane it lies in front of, then mirrors the
+ * images again, up to the maximum order (1 to kMaxOrder). Each image keeps
+ * its parent, so the tracer can walk the reflection points back from the
+ * listener and drop paths that miss a plane.
+ *
+ * Planes are unbounded, which is exact for convex rooms such as boxes.
+ * With other plane sets, reflection points may fall outside the real
+ * walls; the tracer's visibility test only rejects paths that geometry
+ * blocks.
+ *
+ * Image sets are cached per source position in a small direct-mapped
+ * cache, so they are only recomputed when a source moves. All methods are
+ * thread-safe.
+ *
+ * @par Example Usage:
+ * @code
+ * tracer.SetImageSourceModel(ImageSourceModel::Box(
+ *     {0, 0, 0}, {20, 10, 15}, {0, 0, 2, 0, 1, 1}));
+ * PropagationResult result = tracer.Trace(source, listener);
+ * @endcode
+ */
+class ImageSourceModel {
+public:
+  static constexpr int kMaxOrder = 3;
+  static constexpr size_t kCacheSlots = 64;
+
+  /// A source mirrored in one or more planes.
+  struct Image {
+    AcousticVector position;
+    int32_t parent; ///< Image mirrored to get this one, -1 for the source
+    uint32_t plane; ///< Plane mirrored in
+    uint32_t order; ///< Reflections along the path
+  };
+  using ImageSet = std::vector<Image>;
+
+  /**
+   * @brief Create a model from planes.
+   * @param planes Reflecting planes; normals are normalized.
+   * @param maxOrder Highest reflection order (clamped to 1-kMaxOrder).
+   */
+  explicit ImageSourceModel(std::vector<AcousticPlane> planes,
+                            int maxOrder = kMaxOrder)
+      : m_Planes(std::move(planes)),
+        m_MaxOrder(std::clamp(maxOrder, 1, kMaxOrder)) {
+    for (AcousticPlane &plane : m_Planes) {
+      const float length = plane.normal.Length();
+      if (length > 0.0f) {
+        plane.normal = plane.normal * (1.0f / length);
+        plane.distance /= length;
+      }
+    }
+  }
+
+  /**
+   * @brief Create the model of an axis-aligned box room.
+   * @param min Minimum corner.
+   * @param max Maximum corner.
+   * @param materials Materials of the -x, +x, -y, +y, -z and +z walls.
+   * @param maxOrder Highest reflection order.
+   */
+  static std::shared_ptr<ImageSourceModel>
+  Box(const AcousticVector &min, const AcousticVector &max,
+      const std::array<AcousticMaterialID, 6> &materials,
+      int maxOrder = kMaxOrder) {
+    std::vector<AcousticPlane> planes = {
+        {{1.0f, 0.0f, 0.0f}, min.x, materials[0]},
+        {{-1.0f, 0.0f, 0.0f}, -max.x, materials[1]},
+        {{0.0f, 1.0f, 0.0f}, min.y, materials[2]},
+        {{0.0f, -1.0f, 0.0f}, -max.y, materials[3]},
+        {{0.0f, 0.0f, 1.0f}, min.z, materials[4]},
+        {{0.0f, 0.0f, -1.0f}, -max.z, materials[5]}};
+    return std::make_shared<ImageSourceModel>(std::move(planes), maxOrder);
+  }
+
+  /**
+   * @brief Get the image sources of a source position.
+   *
+   * Returns the cached set if the position has not changed since it was
+   * computed.
+   */
+  [[nodiscard]] std::shared_ptr<const ImageSet>
+  GetImages(const AcousticVector &source) const {
+    Slot &slot = m_Slots[SlotOf(source)];
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (slot.images && slot.source.x == source.x &&
+          slot.source.y == source.y && slot.source.z == source.z) {
+        ++m_Hits;
+        return slot.images;
+      }
+      ++m_Misses;
+    }
+
+    auto images = std::make_shared<ImageSet>();
+    for (uint32_t p = 0; p < m_Planes.size(); ++p) {
+      if (m_Planes[p].SignedDistance(source) > 0.0f) {
+        images->push_back({m_Planes[p].Mirror(source), -1, p, 1});
+      }
+    }
+    // Mirror each order's images again, never twice in a row in one plane
+    size_t first = 0;
+    for (int order = 2; order <= m_MaxOrder; ++order) {
+      const size_t last = images->size();
+      for (size_t i = first; i < last; ++i) {
+        const Image parent = (*images)[i]; // Copied; push_back reallocates
+        for (uint32_t p = 0; p < m_Planes.size(); ++p) {
+          if (p != parent.plane &&
+              m_Planes[p].SignedDistance(parent.position) > 0.0f) {
+            images->push_back({m_Planes[p].Mirror(parent.position),
+                               static_cast<int32_t>(i), p,
+                               static_cast<uint32_t>(order)});
+          }
+        }
+      }
+      first = last;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    slot.source = source;
+    slot.images = images;
+    return images;
+  }
+
+  [[nodiscard]] const std::vector<AcousticPlane> &GetPlanes() const {
+    return m_Planes;
+  }
+  [[nodiscard]] int GetMaxOrder() const { return m_MaxOrder; }
+
+  /**
+   * @brief Image set lookups answered from the cache.
+   */
+  [[nodiscard]] uint64_t GetCacheHits() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Hits;
+  }
+
+  /**
+   * @brief Image set lookups that had to mirror the source.
+   */
+  [[nodiscard]] uint64_t GetCacheMisses() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Misses;
+  }
+
+private:
+  struct Slot {
+    AcousticVector source;
+    std::shared_ptr<const ImageSet> images;
+  };
+
+  static size_t SlotOf(const AcousticVector &p) {
+    uint32_t bits[3];
+    std::memcpy(bits, &p.x, sizeof(float));
+    std::memcpy(bits + 1, &p.y, sizeof(float));
+    std::memcpy(bits + 2, &p.z, sizeof(float));
+    const uint32_t hash =
+        (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    return (hash ^ (hash >> 16)) % kCacheSlots;
+  }
+
+  std::vector<AcousticPlane> m_Planes;
+  int m_MaxOrder;
+  mutable std::mutex m_Mutex;
+  mutable std::array<Slot, kCacheSlots> m_Slots;
+  mutable uint64_t m_Hits = 0;
+  mutable uint64_t m_Misses = 0;
+};
+
+/**
+ * @brief Part of the ray set to trace for one source (incremental tracing).
+ *
+ * Selects chunkCount chunks starting at firstChunk, wrapping around the
+ * tracer's chunk count. Successive slices of one voice can walk the whole
+ * ray set over several frames; pass changes the scattering random streams
+ * so repeated slices do not scatter identically.
+ */
+struct AcousticRaySlice {
+  uint32_t firstChunk = 0;
+  uint32_t chunkCount = 0; ///< 0 traces every chunk
+  uint32_t pass = 0;
+};
+
 /**
  * @brief Acoustic ray tracer for sound propagation simulation.
+ *
+ * Reflection rays are traced in chunks of kRaysPerChunk. With a worker
+ * pool the chunks of one or several voices (TraceBatch()) run in
+ * parallel, each with its own random stream and path buffer; buffers are
+ * merged in chunk order, so results for a given seed are identical for
+ * any thread count. Trace() and TraceBatch() do not modify the tracer and
+ * may be called from several threads at once, provided the geometry
+ * callback is thread-safe.
+ *
+ * Within a chunk, every live ray advances one bounce per pass, and the
+ * rays of a pass are intersected in packets of up to the packet size.
+ * With a packet callback each packet is one call reporting material ids;
+ * a per-ray GeometryCallback is called once per ray instead.
  */
 class AcousticRayTracer {
 public:
   static constexpr float kSpeedOfSound = 343.0f; // m/s at 20°C
   static constexpr float kMinEnergy = 0.001f;    // Energy cutoff
   static constexpr int kMaxBounces = 8;          // Max reflections
+  static constexpr int kRaysPerChunk = 32;       // Rays per parallel task
+
+  /// Returned by GetMaterialID() for unknown names.
+  static constexpr AcousticMaterialID kInvalidMaterial = UINT32_MAX;
+
+  /**
+   * @brief Create a tracer with the preset materials registered.
+   *
+   * Concrete, Wood, Carpet, Glass and Curtain get ids 0 to 4.
+   */
+  AcousticRayTracer() {
+    for (const auto &material :
+         {AcousticMaterial::Concrete(), AcousticMaterial::Wood(),
+          AcousticMaterial::Carpet(), AcousticMaterial::Glass(),
+          AcousticMaterial::Curtain()}) {
+      RegisterMaterial(material);
+    }
+  }
 
   /**
    * @brief Set geometry intersection callback.
+   *
+   * Called concurrently when tracing with worker threads. Unused while a
+   * packet callback is set.
    */
   void SetGeometryCallback(GeometryCallback callback) {
     m_GeometryCallback = std::move(callback);
   }
 
+  /**
+   * @brief Set packet geometry intersection callback.
+   *
+   * Takes precedence over the per-ray callback; pass nullptr to go back
+   * to it. Called concurrently when tracing with worker threads.
+   */
+  void SetGeometryPacketCallback(GeometryPacketCallback callback) {
+    m_PacketCallback = std::move(callback);
+  }
+
+  /**
+   * @brief Set the rays per packet (1 to AcousticRayPacket::kMaxRays,
+   *        default: 16).
+   */
+  void SetPacketSize(size_t rays) {
+    m_PacketSize = std::clamp<size_t>(rays, 1, AcousticRayPacket::kMaxRays);
+  }
+
+  [[nodiscard]] size_t GetPacketSize() const { return m_PacketSize; }
+
+  /**
+   * @brief Register a material for packet hits.
+   *
+   * Registering a name again replaces its properties and keeps its id.
+   * Not thread-safe with tracing.
+   * @param material The material to register.
+   * @return Id to use in AcousticHitPacket::material.
+   */
+  AcousticMaterialID RegisterMaterial(const AcousticMaterial &material) {
+    const AcousticMaterialID existing = GetMaterialID(material.name);
+    if (existing != kInvalidMaterial) {
+      m_Materials[existing] = material;
+      return existing;
+    }
+    m_Materials.push_back(material);
+    return static_cast<AcousticMaterialID>(m_Materials.size() - 1);
+  }
+
+  /**
+   * @brief Get the id of a registered material.
+   * @return Material id, or kInvalidMaterial if not registered.
+   */
+  [[nodiscard]] AcousticMaterialID
+  GetMaterialID(const std::string &name) const {
+    for (size_t i = 0; i < m_Materials.size(); ++i) {
+      if (m_Materials[i].name == name) {
+        return static_cast<AcousticMaterialID>(i);
+      }
+    }
+    return kInvalidMaterial;
+  }
+
+  /**
+   * @brief Get a registered material.
+   *
+   * Unknown ids return a default-constructed material.
+   */
+  [[nodiscard]] const AcousticMaterial &
+  GetMaterial(AcousticMaterialID id) const {
+    return id < m_Materials.size() ? m_Materials[id] : m_FallbackMaterial;
+  }
+
+  /**
+   * @brief Trace ray chunks on a worker pool (nullptr traces serially).
+   *
+   * The pool may be shared with other systems.
+   */
+  void SetWorkerPool(std::shared_ptr<WorkerPool> pool) {
+    m_Pool = std::move(pool);
+  }
+
+  /**
+   * @brief Create a private worker pool.
+   * @param threads Worker threads; 0 traces on the calling thread only.
+   */
+  void SetThreadCount(uint32_t threads) {
+    m_Pool = threads > 0 ? std::make_shared<WorkerPool>(threads) : nullptr;
+  }
+
+  [[nodiscard]] const std::shared_ptr<WorkerPool> &GetWorkerPool() const {
+    return m_Pool;
+  }
+
+  /**
+   * @brief Set the seed of the scattering random streams.
+   */
+  void SetSeed(uint32_t seed) { m_Seed = seed; }
+
   /**
    * @brief Set number of rays to cast.
    */
   void SetRayCount(int count) { m_RayCount = std::clamp(count, 8, 1024); }
 
+  [[nodiscard]] int GetRayCount() const { return m_RayCount; }
+
+  /**
+   * @brief Number of ray chunks in the ray set (for slicing).
+   */
+  [[nodiscard]] uint32_t GetChunkCount() const {
+    return static_cast<uint32_t>((m_RayCount + kRaysPerChunk - 1) /
+                                 kRaysPerChunk);
+  }
+
+  /**
+   * @brief Number of rays a slice traces.
+   */
+  [[nodiscard]] int GetSliceRayCount(const AcousticRaySlice &slice) const {
+    const uint32_t chunks = GetChunkCount();
+    if (slice.chunkCount == 0 || slice.chunkCount >= chunks) {
+      return m_RayCount;
+    }
+    int rays = 0;
+    for (uint32_t i = 0; i < slice.chunkCount; ++i) {
+      rays += ChunkRays((slice.firstChunk + i) % chunks);
+    }
+    return rays;
+  }
+
+  /**
+   * @brief Add exact specular paths from an image-source model.
+   *
+   * For rooms known to be a box or a set of planes. Paths up to the
+   * model's order are found by mirroring the source instead of by rays:
+   * ray paths with 1 to that many reflections are dropped and the image
+   * paths added instead, each with the gain a ray along it would have.
+   * The segments of candidate paths are tested against the geometry in
+   * packets; without a geometry callback the planes are the whole scene.
+   * Pass nullptr to trace early reflections with rays again.
+   */
+  void SetImageSourceModel(std::shared_ptr<const ImageSourceModel> model) {
+    m_ImageSources = std::move(model);
+  }
+
+  [[nodiscard]] const std::shared_ptr<const ImageSourceModel> &
+  GetImageSourceModel() const {
+    return m_ImageSources;
+  }
+
   /**
    * @brief Set maximum trace distance.
    */
@@ -211,25 +676,223 @@ public:
    * @brief Trace sound propagation from source to listener.
    */
   PropagationResult Trace(const AcousticVector &source,
-                          const AcousticVector &listener) {
+                          const AcousticVector &listener) const {
     PropagationResult result;
+    TraceBatch(&source, 1, listener, &result);
+    return result;
+  }
+
+  /**
+   * @brief Trace several sources to one listener in parallel.
+   *
+   * All voices' ray chunks are spread across the pool together, and their
+   * direct paths are tested in shared packets. Without slices each result
+   * equals what Trace() returns for that source.
+   *
+   * With slices only the selected chunks of each voice are traced, and
+   * reflection gains are scaled by the full ray count over the rays
+   * traced, so summed gains estimate those of a full trace.
+   * @param sources Source positions.
+   * @param count Number of sources.
+   * @param listener Listener position.
+   * @param results Output, one per source.
+   * @param slices Chunks to trace per source, or nullptr for all.
+   */
+  void TraceBatch(const AcousticVector *sources, size_t count,
+                  const AcousticVector &listener, PropagationResult *results,
+                  const AcousticRaySlice *slices = nullptr) const {
+    TraceDirect(sources, count, listener, results);
+
+    // Cast rays for reflections, one path buffer per chunk
+    if (HasGeometry() && count > 0) {
+      const uint32_t chunks = GetChunkCount();
+      std::vector<uint32_t> firstTask(count + 1, 0);
+      for (size_t voice = 0; voice < count; ++voice) {
+        firstTask[voice + 1] = firstTask[voice] + SliceChunks(slices, voice);
+      }
+      auto chunkOf = [&](size_t voice, size_t task) {
+        const auto offset = static_cast<uint32_t>(task - firstTask[voice]);
+        return slices ? (slices[voice].firstChunk + offset) % chunks : offset;
+      };
+      std::vector<std::vector<PropagationPath>> buffers(firstTask[count]);
+      auto traceChunk = [&](size_t task) {
+        const size_t voice =
+            std::upper_bound(firstTask.begin(), firstTask.end(), task) -
+            firstTask.begin() - 1;
+        const uint32_t chunk = chunkOf(voice, task);
+        const uint64_t stream =
+            chunk + (slices ? uint64_t{slices[voice].pass} * chunks : 0);
+        CastReflectionRays(sources[voice], listener, chunk, stream,
+                           buffers[task]);
+      };
+      if (m_Pool) {
+        m_Pool->ParallelFor(buffers.size(), traceChunk);
+      } else {
+        for (size_t task = 0; task < buffers.size(); ++task) {
+          traceChunk(task);
+        }
+      }
+
+      for (size_t voice = 0; voice < count; ++voice) {
+        auto &paths = results[voice].paths;
+        const size_t direct = paths.size();
+        for (uint32_t task = firstTask[voice]; task < firstTask[voice + 1];
+             ++task) {
+          const auto &buffer = buffers[task];
+          paths.insert(paths.end(), buffer.begin(), buffer.end());
+        }
+
+        // Weight a partial ray set up to the full one
+        const int rays = slices ? GetSliceRayCount(slices[voice]) : m_RayCount;
+        if (rays < m_RayCount) {
+          const float weight = static_cast<float>(m_RayCount) / rays;
+          for (size_t i = direct; i < paths.size(); ++i) {
+            paths[i].gainLow *= weight;
+            paths[i].gainMid *= weight;
+            paths[i].gainHigh *= weight;
+          }
+        }
+      }
+    }
+
+    // Exact specular paths in place of the rays' low-order reflections
+    if (m_ImageSources) {
+      auto addImagePaths = [&](size_t voice) {
+        AddImageSourcePaths(sources[voice], listener, results[voice]);
+      };
+      if (m_Pool && count > 1) {
+        m_Pool->ParallelFor(count, addImagePaths);
+      } else {
+        for (size_t voice = 0; voice < count; ++voice) {
+          addImagePaths(voice);
+        }
+      }
+    }
+
+    // Compute early reflection parameters
+    for (size_t i = 0; i < count; ++i) {
+      ComputeEarlyReflections(results[i]);
+    }
+  }
+
+  /**
+   * @brief Enable/disable ray tracing.
+   */
+  void SetEnabled(bool enabled) { m_Enabled = enabled; }
+  bool IsEnabled() const { return m_Enabled; }
+
+private:
+  /// Absorption and scattering of a hit surface.
+  struct Surface {
+    float absorptionLow;
+    float absorptionMid;
+    float absorptionHigh;
+    float scattering;
+  };
+
+  static Surface ToSurface(const AcousticMaterial &material) {
+    return {material.absorptionLow, material.absorptionMid,
+            material.absorptionHigh, material.scattering};
+  }
+
+  bool HasGeometry() const {
+    return m_PacketCallback || m_GeometryCallback;
+  }
+
+  uint32_t SliceChunks(const AcousticRaySlice *slices, size_t voice) const {
+    const uint32_t chunks = GetChunkCount();
+    if (!slices || slices[voice].chunkCount == 0) {
+      return chunks;
+    }
+    return (std::min)(slices[voice].chunkCount, chunks);
+  }
+
+  int ChunkRays(uint32_t chunk) const {
+    const int first = static_cast<int>(chunk) * kRaysPerChunk;
+    return (std::min)(first + kRaysPerChunk, m_RayCount) - first;
+  }
 
-    // Calculate direct path
-    AcousticVector toListener = listener - source;
-    float directDistance = toListener.Length();
-    result.directDistance = directDistance;
+  // Pad the packet to the packet size with copies of its last ray
+  void PadPacket(AcousticRayPacket &packet) const {
+    const size_t last = packet.count - 1;
+    for (size_t lane = packet.count; lane < m_PacketSize; ++lane) {
+      packet.originX[lane] = packet.originX[last];
+      packet.originY[lane] = packet.originY[last];
+      packet.originZ[lane] = packet.originZ[last];
+      packet.directionX[lane] = packet.directionX[last];
+      packet.directionY[lane] = packet.directionY[last];
+      packet.directionZ[lane] = packet.directionZ[last];
+      packet.maxDistance[lane] = packet.maxDistance[last];
+    }
+  }
+
+  // Intersect a packet, through the per-ray callback if no packet callback
+  // is set (hit materials are then left unset)
+  void Intersect(const AcousticRayPacket &rays, AcousticHitPacket &hits) const {
+    hits.hitMask = 0;
+    if (m_PacketCallback) {
+      m_PacketCallback(rays, hits);
+      return;
+    }
+    for (size_t lane = 0; lane < rays.count; ++lane) {
+      const RayHit hit = m_GeometryCallback(
+          {rays.originX[lane], rays.originY[lane], rays.originZ[lane]},
+          {rays.directionX[lane], rays.directionY[lane],
+           rays.directionZ[lane]},
+          rays.maxDistance[lane]);
+      if (hit.hit) {
+        hits.hitMask |= 1u << lane;
+        hits.distance[lane] = hit.distance;
+        hits.normalX[lane] = hit.normal.x;
+        hits.normalY[lane] = hit.normal.y;
+        hits.normalZ[lane] = hit.normal.z;
+      }
+    }
+  }
 
-    // Check if direct path is occluded
-    if (m_GeometryCallback) {
-      RayHit hit =
-          m_GeometryCallback(source, toListener.Normalized(), directDistance);
-      result.hasDirectPath = !hit.hit || hit.distance >= directDistance;
-    } else {
-      result.hasDirectPath = true;
+  void TraceDirect(const AcousticVector *sources, size_t count,
+                   const AcousticVector &listener,
+                   PropagationResult *results) const {
+    for (size_t i = 0; i < count; ++i) {
+      results[i] = PropagationResult{};
+      results[i].directDistance = (listener - sources[i]).Length();
+      results[i].hasDirectPath = true;
+    }
+
+    // Check if direct paths are occluded, a packet of voices at a time
+    if (HasGeometry()) {
+      AcousticRayPacket packet;
+      AcousticHitPacket hits;
+      for (size_t start = 0; start < count; start += m_PacketSize) {
+        packet.count = (std::min)(m_PacketSize, count - start);
+        for (size_t lane = 0; lane < packet.count; ++lane) {
+          const AcousticVector &source = sources[start + lane];
+          const AcousticVector dir = (listener - source).Normalized();
+          packet.originX[lane] = source.x;
+          packet.originY[lane] = source.y;
+          packet.originZ[lane] = source.z;
+          packet.directionX[lane] = dir.x;
+          packet.directionY[lane] = dir.y;
+          packet.directionZ[lane] = dir.z;
+          packet.maxDistance[lane] = results[start + lane].directDistance;
+        }
+        PadPacket(packet);
+        Intersect(packet, hits);
+        for (size_t lane = 0; lane < packet.count; ++lane) {
+          PropagationResult &result = results[start + lane];
+          result.hasDirectPath = (hits.hitMask & (1u << lane)) == 0 ||
+                                 hits.distance[lane] >= result.directDistance;
+        }
+      }
     }
 
     // Add direct path if not occluded
-    if (result.hasDirectPath) {
+    for (size_t i = 0; i < count; ++i) {
+      PropagationResult &result = results[i];
+      if (!result.hasDirectPath) {
+        continue;
+      }
+      const float directDistance = result.directDistance;
       PropagationPath directPath;
       directPath.isDirect = true;
       directPath.distance = directDistance;
@@ -244,106 +907,259 @@ public:
 
       result.paths.push_back(directPath);
     }
-
-    // Cast rays for reflections
-    if (m_GeometryCallback) {
-      CastReflectionRays(source, listener, result);
-    }
-
-    // Compute early reflection parameters
-    ComputeEarlyReflections(result);
-
-    return result;
   }
 
-  /**
-   * @brief Enable/disable ray tracing.
-   */
-  void SetEnabled(bool enabled) { m_Enabled = enabled; }
-  bool IsEnabled() const { return m_Enabled; }
-
-private:
   void CastReflectionRays(const AcousticVector &source,
-                          const AcousticVector &listener,
-                          PropagationResult &result) {
+                          const AcousticVector &listener, uint32_t chunk,
+                          uint64_t stream,
+                          std::vector<PropagationPath> &paths) const {
     float listenerRadius = 1.0f; // Listener capture radius
-
-    for (int i = 0; i < m_RayCount; ++i) {
+    AcousticRandom random(m_Seed, stream);
+
+    const int first = static_cast<int>(chunk) * kRaysPerChunk;
+    const int last = (std::min)(first + kRaysPerChunk, m_RayCount);
+    AcousticRay rays[kRaysPerChunk];
+    size_t live[kRaysPerChunk];
+    size_t liveCount = 0;
+    for (int i = first; i < last; ++i) {
       // Generate ray in hemisphere (Fibonacci sphere distribution)
       float phi = std::acos(1.0f - 2.0f * (i + 0.5f) / m_RayCount);
       float theta = 3.14159265f * (1.0f + std::sqrt(5.0f)) * i;
 
-      AcousticRay ray;
+      AcousticRay &ray = rays[liveCount];
       ray.origin = source;
       ray.direction = {std::sin(phi) * std::cos(theta),
                        std::sin(phi) * std::sin(theta), std::cos(phi)};
+      live[liveCount] = liveCount;
+      ++liveCount;
+    }
 
-      // Trace this ray
-      TraceRay(ray, listener, listenerRadius, result);
+    // Advance every live ray one bounce per pass; rays still alive are
+    // compacted to the front of the list
+    AcousticRayPacket packet;
+    AcousticHitPacket hits;
+    while (liveCount > 0) {
+      size_t kept = 0;
+      if (!m_PacketCallback) {
+        for (size_t i = 0; i < liveCount; ++i) {
+          AcousticRay &ray = rays[live[i]];
+          const RayHit hit = m_GeometryCallback(ray.origin, ray.direction,
+                                                m_MaxDistance - ray.distance);
+          if (hit.hit && Reflect(ray, hit.distance, hit.normal,
+                                 ToSurface(hit.material), listener,
+                                 listenerRadius, random, paths)) {
+            live[kept++] = live[i];
+          }
+        }
+        liveCount = kept;
+        continue;
+      }
+
+      for (size_t start = 0; start < liveCount; start += m_PacketSize) {
+        packet.count = (std::min)(m_PacketSize, liveCount - start);
+        for (size_t lane = 0; lane < packet.count; ++lane) {
+          const AcousticRay &ray = rays[live[start + lane]];
+          packet.originX[lane] = ray.origin.x;
+          packet.originY[lane] = ray.origin.y;
+          packet.originZ[lane] = ray.origin.z;
+          packet.directionX[lane] = ray.direction.x;
+          packet.directionY[lane] = ray.direction.y;
+          packet.directionZ[lane] = ray.direction.z;
+          packet.maxDistance[lane] = m_MaxDistance - ray.distance;
+        }
+        PadPacket(packet);
+        Intersect(packet, hits);
+
+        for (size_t lane = 0; lane < packet.count; ++lane) {
+          if ((hits.hitMask & (1u << lane)) == 0) {
+            continue; // Ray escaped scene
+          }
+          const size_t index = live[start + lane];
+          const AcousticVector normal{hits.normalX[lane], hits.normalY[lane],
+                                      hits.normalZ[lane]};
+          if (Reflect(rays[index], hits.distance[lane], normal,
+                      ToSurface(GetMaterial(hits.material[lane])), listener,
+                      listenerRadius, random, paths)) {
+            live[kept++] = index;
+          }
+        }
+      }
+      liveCount = kept;
     }
   }
 
-  void TraceRay(AcousticRay ray, const AcousticVector &listener,
-                float listenerRadius, PropagationResult &result) {
-    while (ray.bounces < kMaxBounces && ray.energy > kMinEnergy &&
-           ray.distance < m_MaxDistance) {
+  // Record the ray if it passes the listener, then bounce it off the hit.
+  // Returns false once the ray is spent.
+  bool Reflect(AcousticRay &ray, float hitDistance,
+               const AcousticVector &normal, const Surface &surface,
+               const AcousticVector &listener, float listenerRadius,
+               AcousticRandom &random,
+               std::vector<PropagationPath> &paths) const {
+    // Check if ray passes near listener before hitting surface
+    AcousticVector toListener = listener - ray.origin;
+    float projLength = toListener.Dot(ray.direction);
+
+    if (projLength > 0 && projLength < hitDistance) {
+      AcousticVector closestPoint = ray.origin + ray.direction * projLength;
+      float distToListener = (listener - closestPoint).Length();
+
+      if (distToListener < listenerRadius) {
+        // Ray reaches listener
+        PropagationPath path;
+        path.distance = ray.distance + projLength;
+        path.delay = path.distance / kSpeedOfSound;
+        path.reflections = ray.bounces;
+        path.gainLow = ray.energyLow * DistanceAttenuation(path.distance);
+        path.gainMid = ray.energyMid * DistanceAttenuation(path.distance);
+        path.gainHigh =
+            ray.energyHigh * DistanceAttenuation(path.distance) * 0.8f;
+
+        paths.push_back(path);
+      }
+    }
+
+    // Update ray after reflection
+    const AcousticVector point = ray.origin + ray.direction * hitDistance;
+    ray.distance += hitDistance;
+    ray.origin = point + normal * 0.001f; // Offset to avoid self-intersection
+    ray.direction = ray.direction.Reflect(normal).Normalized();
+    ray.bounces++;
+
+    // Apply material absorption
+    ray.energyLow *= (1.0f - surface.absorptionLow);
+    ray.energyMid *= (1.0f - surface.absorptionMid);
+    ray.energyHigh *= (1.0f - surface.absorptionHigh);
+    ray.energy = (ray.energyLow + ray.energyMid + ray.energyHigh) / 3.0f;
+
+    // Apply scattering (randomize direction slightly)
+    if (surface.scattering > 0.0f) {
+      // Simplified scattering - blend toward random direction
+      float scatter = surface.scattering * 0.3f;
+      ray.direction.x += (random.NextFloat() - 0.5f) * scatter;
+      ray.direction.y += (random.NextFloat() - 0.5f) * scatter;
+      ray.direction.z += (random.NextFloat() - 0.5f) * scatter;
+      ray.direction = ray.direction.Normalized();
+    }
 
-      RayHit hit = m_GeometryCallback(ray.origin, ray.direction,
-                                      m_MaxDistance - ray.distance);
+    return ray.bounces < kMaxBounces && ray.energy > kMinEnergy &&
+           ray.distance < m_MaxDistance;
+  }
 
-      if (!hit.hit) {
-        break; // Ray escaped scene
+  void AddImageSourcePaths(const AcousticVector &source,
+                           const AcousticVector &listener,
+                           PropagationResult &result) const {
+    const ImageSourceModel &model = *m_ImageSources;
+    const int maxOrder = model.GetMaxOrder();
+    auto &paths = result.paths;
+    paths.erase(std::remove_if(paths.begin(), paths.end(),
+                               [maxOrder](const PropagationPath &path) {
+                                 return !path.isDirect &&
+                                        path.reflections >= 1 &&
+                                        path.reflections <= maxOrder;
+                               }),
+                paths.end());
+
+    // Walk each image's reflection points back from the listener; a path
+    // exists if every segment crosses the plane it is mirrored in
+    const auto images = model.GetImages(source);
+    const auto &planes = model.GetPlanes();
+    const bool testVisibility = HasGeometry();
+    std::vector<PropagationPath> candidates;
+    std::vector<AcousticVector> segments; // Start and end per segment
+    std::vector<uint32_t> segmentPath;
+    for (size_t i = 0; i < images->size(); ++i) {
+      AcousticVector point = listener;
+      const size_t firstSegment = segments.size();
+      float length = 0.0f;
+      float energyLow = 1.0f, energyMid = 1.0f, energyHigh = 1.0f;
+      bool valid = true;
+      for (auto k = static_cast<int32_t>(i); k >= 0;
+           k = (*images)[k].parent) {
+        const ImageSourceModel::Image &image = (*images)[k];
+        const AcousticPlane &plane = planes[image.plane];
+        const float from = plane.SignedDistance(point);
+        const float to = plane.SignedDistance(image.position);
+        if (!(from > 0.0f && to < 0.0f)) {
+          valid = false;
+          break;
+        }
+        const AcousticVector reflection =
+            point + (image.position - point) * (from / (from - to));
+        length += (reflection - point).Length();
+        segments.push_back(point);
+        segments.push_back(reflection);
+        point = reflection;
+
+        const AcousticMaterial &material = GetMaterial(plane.material);
+        energyLow *= 1.0f - material.absorptionLow;
+        energyMid *= 1.0f - material.absorptionMid;
+        energyHigh *= 1.0f - material.absorptionHigh;
+      }
+      length += (source - point).Length();
+      if (!valid || length > m_MaxDistance) {
+        segments.resize(firstSegment);
+        continue;
       }
+      segments.push_back(point);
+      segments.push_back(source);
+      segmentPath.resize(segments.size() / 2,
+                         static_cast<uint32_t>(candidates.size()));
+
+      PropagationPath path;
+      path.distance = length;
+      path.delay = length / kSpeedOfSound;
+      path.reflections = static_cast<int>((*images)[i].order);
+      path.isImageSource = true;
+      const float attenuation = DistanceAttenuation(length);
+      path.gainLow = energyLow * attenuation;
+      path.gainMid = energyMid * attenuation;
+      path.gainHigh = energyHigh * attenuation * 0.8f;
+      candidates.push_back(path);
+    }
 
-      // Check if ray passes near listener before hitting surface
-      AcousticVector toListener = listener - ray.origin;
-      float projLength = toListener.Dot(ray.direction);
-
-      if (projLength > 0 && projLength < hit.distance) {
-        AcousticVector closestPoint = ray.origin + ray.direction * projLength;
-        float distToListener = (listener - closestPoint).Length();
-
-        if (distToListener < listenerRadius) {
-          // Ray reaches listener
-          PropagationPath path;
-          path.distance = ray.distance + projLength;
-          path.delay = path.distance / kSpeedOfSound;
-          path.reflections = ray.bounces;
-          path.gainLow = ray.energyLow * DistanceAttenuation(path.distance);
-          path.gainMid = ray.energyMid * DistanceAttenuation(path.distance);
-          path.gainHigh =
-              ray.energyHigh * DistanceAttenuation(path.distance) * 0.8f;
-
-          result.paths.push_back(path);
+    // Test every segment against the geometry, a packet at a time; the
+    // ends are pulled in so the walls reflected off do not count
+    std::vector<uint8_t> blocked(candidates.size(), 0);
+    if (testVisibility) {
+      constexpr float kEndOffset = 0.01f;
+      const size_t segmentCount = segments.size() / 2;
+      AcousticRayPacket packet;
+      AcousticHitPacket hits;
+      for (size_t start = 0; start < segmentCount; start += m_PacketSize) {
+        packet.count = (std::min)(m_PacketSize, segmentCount - start);
+        for (size_t lane = 0; lane < packet.count; ++lane) {
+          const AcousticVector &a = segments[(start + lane) * 2];
+          const AcousticVector &b = segments[(start + lane) * 2 + 1];
+          const float distance = (b - a).Length();
+          const AcousticVector dir = (b - a).Normalized();
+          const AcousticVector origin = a + dir * kEndOffset;
+          packet.originX[lane] = origin.x;
+          packet.originY[lane] = origin.y;
+          packet.originZ[lane] = origin.z;
+          packet.directionX[lane] = dir.x;
+          packet.directionY[lane] = dir.y;
+          packet.directionZ[lane] = dir.z;
+          packet.maxDistance[lane] =
+              (std::max)(distance - 2.0f * kEndOffset, 0.0f);
+        }
+        PadPacket(packet);
+        Intersect(packet, hits);
+        for (size_t lane = 0; lane < packet.count; ++lane) {
+          if ((hits.hitMask & (1u << lane)) != 0 &&
+              hits.distance[lane] < packet.maxDistance[lane]) {
+            blocked[segmentPath[start + lane]] = 1;
+          }
         }
       }
-
-      // Update ray after reflection
-      ray.distance += hit.distance;
-      ray.origin =
-          hit.point + hit.normal * 0.001f; // Offset to avoid self-intersection
-      ray.direction = ray.direction.Reflect(hit.normal).Normalized();
-      ray.bounces++;
-
-      // Apply material absorption
-      ray.energyLow *= (1.0f - hit.material.absorptionLow);
-      ray.energyMid *= (1.0f - hit.material.absorptionMid);
-      ray.energyHigh *= (1.0f - hit.material.absorptionHigh);
-      ray.energy = (ray.energyLow + ray.energyMid + ray.energyHigh) / 3.0f;
-
-      // Apply scattering (randomize direction slightly)
-      if (hit.material.scattering > 0.0f) {
-        // Simplified scattering - blend toward random direction
-        float scatter = hit.material.scattering * 0.3f;
-        ray.direction.x += (RandomFloat() - 0.5f) * scatter;
-        ray.direction.y += (RandomFloat() - 0.5f) * scatter;
-        ray.direction.z += (RandomFloat() - 0.5f) * scatter;
-        ray.direction = ray.direction.Normalized();
+    }
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      if (!blocked[i]) {
+        paths.push_back(candidates[i]);
       }
     }
   }
 
-  void ComputeEarlyReflections(PropagationResult &result) {
+  void ComputeEarlyReflections(PropagationResult &result) const {
     if (result.paths.size() <= 1) {
       return;
     }
@@ -365,22 +1181,47 @@ private:
       result.earlyReflectionGain = (std::min)(totalReflectionGain, 1.0f);
     }
 
-    // Estimate late reverb time based on average absorption
-    result.lateReverbTime = 0.5f; // Simplified estimate
+    // Late reverb time from the decay of reflected energy: fit the log of
+    // each path's mid-band energy before distance attenuation against its
+    // delay, and extrapolate to -60 dB
+    result.lateReverbTime = 0.5f; // Fallback if there is no decay to fit
+    double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    for (const auto &path : result.paths) {
+      if (path.isDirect || path.reflections == 0 || path.gainMid <= 0.0f) {
+        continue;
+      }
+      const double x = path.delay;
+      const double y =
+          std::log(path.gainMid / DistanceAttenuation(path.distance));
+      n += 1.0;
+      sx += x;
+      sy += y;
+      sxx += x * x;
+      sxy += x * y;
+    }
+    const double spread = n * sxx - sx * sx;
+    if (n >= 2.0 && spread > 1e-12) {
+      const double slope = (n * sxy - sx * sy) / spread;
+      if (slope < 0.0) {
+        const double kDecay60 = -13.8155; // ln(1e-6)
+        result.lateReverbTime =
+            static_cast<float>((std::min)(kDecay60 / slope, 30.0));
+      }
+    }
   }
 
   float DistanceAttenuation(float distance) const {
     return 1.0f / (1.0f + distance * distance * 0.01f);
   }
 
-  float RandomFloat() const {
-    // Simple LCG random
-    static uint32_t seed = 12345;
-    seed = seed * 1103515245 + 12345;
-    return static_cast<float>(seed & 0x7FFFFFFF) / 2147483647.0f;
-  }
-
   GeometryCallback m_GeometryCallback;
+  GeometryPacketCallback m_PacketCallback;
+  size_t m_PacketSize = AcousticRayPacket::kMaxRays;
+  std::vector<AcousticMaterial> m_Materials;
+  AcousticMaterial m_FallbackMaterial;
+  std::shared_ptr<WorkerPool> m_Pool;
+  std::shared_ptr<const ImageSourceModel> m_ImageSources;
+  uint32_t m_Seed = 12345;
   int m_RayCount = 64;
   float m_MaxDistance = 100.0f;
   bool m_Enabled = false;
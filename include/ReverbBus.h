@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -18,6 +19,9 @@ namespace Orpheus {
 // Forward declaration for PIMPL
 struct ReverbBusImpl;
 
+/// Dense reverb bus identifier (see ReverbBus::GetIndex()).
+using ReverbBusID = uint32_t;
+
 /**
  * @brief Preset reverb configurations.
  */
@@ -50,8 +54,9 @@ public:
   /**
    * @brief Construct a named reverb bus.
    * @param name Unique name for this reverb bus.
+   * @param index Dense index of this reverb bus (used by snapshots).
    */
-  ReverbBus(const std::string &name);
+  ReverbBus(const std::string &name, uint32_t index = 0);
 
   /**
    * @brief Destructor.
@@ -129,6 +134,7 @@ public:
   [[nodiscard]] bool IsFreeze() const;
   [[nodiscard]] bool IsActive() const;
   [[nodiscard]] const std::string &GetName() const;
+  [[nodiscard]] ReverbBusID GetIndex() const;
   /// @}
 
   /**
@@ -8,17 +8,21 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "Types.h"
+#include "ZoneShape.h"
 
 namespace Orpheus {
 
 /**
  * @brief Spatial zone that controls reverb bus influence.
  *
- * ReverbZone represents a spherical region that modulates the send
+ * ReverbZone represents a region (sphere, box or polygon, see
+ * ZoneGeometry) that modulates the send
  * level to a reverb bus based on listener distance. This allows
  * automatic environment-aware reverb without per-sound configuration.
  *
@@ -28,6 +32,9 @@ namespace Orpheus {
  */
 class ReverbZone {
 public:
+  /// Reverb bus id of zones whose bus has not been created.
+  static constexpr uint32_t kNoReverbBus = UINT32_MAX;
+
   /**
    * @brief Create a reverb zone.
    * @param name Unique name for this zone.
@@ -41,6 +48,16 @@ public:
              const Vector3 &position, float innerRadius, float outerRadius,
              uint8_t priority = 128);
 
+  /**
+   * @brief Create a reverb zone with an arbitrary shape.
+   * @param name Unique name for this zone.
+   * @param reverbBusName Name of the reverb bus to modulate.
+   * @param geometry Zone shape.
+   * @param priority Higher priority zones take precedence (default: 128).
+   */
+  ReverbZone(const std::string &name, const std::string &reverbBusName,
+             const ZoneGeometry &geometry, uint8_t priority = 128);
+
   /**
    * @brief Update the zone based on listener position.
    * @param listenerPos Current listener position.
@@ -73,19 +90,30 @@ public:
   [[nodiscard]] const std::string &GetReverbBusName() const;
 
   /**
-   * @brief Get the zone position.
+   * @brief Get the id of the reverb bus, or kNoReverbBus if it does not
+   * exist yet.
+   */
+  [[nodiscard]] uint32_t GetReverbBusID() const;
+
+  /**
+   * @brief Bind the zone to a reverb bus id (done by AudioManager).
+   */
+  void SetReverbBusID(uint32_t id);
+
+  /**
+   * @brief Get the zone position (center of the shape).
    * @return Reference to the position.
    */
   [[nodiscard]] const Vector3 &GetPosition() const;
 
   /**
-   * @brief Get the inner radius.
+   * @brief Get the inner radius (0 for box and polygon zones).
    * @return Inner radius in world units.
    */
   [[nodiscard]] float GetInnerRadius() const;
 
   /**
-   * @brief Get the outer radius.
+   * @brief Get the outer radius (fade distance for box and polygon zones).
    * @return Outer radius in world units.
    */
   [[nodiscard]] float GetOuterRadius() const;
@@ -103,17 +131,74 @@ public:
    */
   [[nodiscard]] float GetDistance(const Vector3 &listenerPos) const;
 
-private:
-  float Distance(const Vector3 &a, const Vector3 &b) const;
-  float ComputeInfluence(float dist) const;
+  /**
+   * @brief Get the zone shape.
+   */
+  [[nodiscard]] const ZoneGeometry &GetGeometry() const;
 
+private:
   std::string m_Name;
   std::string m_ReverbBusName;
-  Vector3 m_Position;
-  float m_InnerRadius;
-  float m_OuterRadius;
+  ZoneGeometry m_Geometry;
+  uint32_t m_ReverbBusID = kNoReverbBus;
   uint8_t m_Priority;
   float m_CurrentInfluence = 0.0f;
 };
 
+/**
+ * @brief Per-frame accumulator of reverb zone influence per reverb bus.
+ *
+ * Zones are composited from highest to lowest priority. Zones sharing a
+ * priority take the maximum influence per bus (as before), and together
+ * cover the levels below by their strongest influence:
+ * @code
+ * remaining = 1;
+ * for (level : priorities, high to low) {
+ *   influence[bus] += remaining * levelMax[bus];
+ *   remaining *= 1 - max(levelMax);
+ * }
+ * @endcode
+ * A room fully inside a lower priority cave therefore silences the cave
+ * reverb, and the two crossfade across the room's fade band.
+ *
+ * Storage is reused between frames; steady use does not allocate.
+ */
+class ReverbInfluence {
+public:
+  /**
+   * @brief Start a frame.
+   * @param busCount Number of reverb bus ids.
+   */
+  void Reset(size_t busCount);
+
+  /**
+   * @brief Add an active zone.
+   * @param bus Reverb bus id (< busCount).
+   * @param influence Zone influence (0-1).
+   * @param priority Zone priority.
+   */
+  void Add(uint32_t bus, float influence, uint8_t priority);
+
+  /**
+   * @brief Composite the zones added since Reset().
+   */
+  void Resolve();
+
+  /**
+   * @brief Resolved influence on a reverb bus (0-1).
+   */
+  [[nodiscard]] float Get(uint32_t bus) const { return m_Influence[bus]; }
+
+private:
+  struct Entry {
+    uint8_t priority;
+    uint32_t bus;
+    float influence;
+  };
+
+  std::vector<Entry> m_Entries;
+  std::vector<float> m_Influence; ///< Per bus id
+  std::vector<float> m_Level;     ///< Per bus id, current priority level
+};
+
 } // namespace Orpheus
@@ -3,12 +3,15 @@
  * @brief Audio mix snapshots for state-based mixing.
  *
  * Provides Snapshot class for storing and applying bus and reverb
- * parameter presets.
+ * parameter presets, and CompiledSnapshot, its dense id-indexed form.
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Orpheus {
 
@@ -100,4 +103,82 @@ private:
   std::unordered_map<std::string, ReverbBusState> reverbStates;
 };
 
+/**
+ * @brief Snapshot resolved to dense arrays indexed by bus id.
+ *
+ * Names are looked up once in Compile(); afterwards applying or blending
+ * the snapshot is a loop over float arrays. Every bus and reverb bus id
+ * below the compiled counts has a slot. Slots the snapshot does not set
+ * hold the default value and a mask of 0, so a blend can be written
+ * without branches:
+ * @code
+ * value[i] += (volume[i] - value[i]) * weight * volumeMask[i];
+ * @endcode
+ *
+ * A compiled snapshot does not track later edits or new buses; compile it
+ * again after either.
+ */
+struct CompiledSnapshot {
+  std::vector<float> volume;     ///< Bus volume per bus id
+  std::vector<float> volumeMask; ///< 1 where the snapshot sets the bus
+
+  std::vector<float> wet;        ///< Reverb wet level per reverb bus id
+  std::vector<float> roomSize;   ///< Reverb room size per reverb bus id
+  std::vector<float> damp;       ///< Reverb damping per reverb bus id
+  std::vector<float> width;      ///< Reverb width per reverb bus id
+  std::vector<float> reverbMask; ///< 1 where the snapshot sets the reverb
+
+  /// Returned by lookups for names that have no id.
+  static constexpr uint32_t kInvalidID = UINT32_MAX;
+
+  /**
+   * @brief Compile a snapshot.
+   * @param snapshot Snapshot to compile.
+   * @param busCount Number of bus ids.
+   * @param busID Callable mapping a bus name to its id or kInvalidID.
+   * @param reverbCount Number of reverb bus ids.
+   * @param reverbID Callable mapping a reverb bus name to its id or
+   *                 kInvalidID.
+   */
+  template <typename BusLookup, typename ReverbLookup>
+  static CompiledSnapshot Compile(const Snapshot &snapshot, size_t busCount,
+                                  BusLookup &&busID, size_t reverbCount,
+                                  ReverbLookup &&reverbID) {
+    CompiledSnapshot out;
+    out.volume.assign(busCount, BusState{}.volume);
+    out.volumeMask.assign(busCount, 0.0f);
+    for (const auto &[name, state] : snapshot.GetStates()) {
+      const uint32_t id = busID(name);
+      if (id < busCount) {
+        out.volume[id] = state.volume;
+        out.volumeMask[id] = 1.0f;
+      }
+    }
+
+    const ReverbBusState defaults;
+    out.wet.assign(reverbCount, defaults.wet);
+    out.roomSize.assign(reverbCount, defaults.roomSize);
+    out.damp.assign(reverbCount, defaults.damp);
+    out.width.assign(reverbCount, defaults.width);
+    out.reverbMask.assign(reverbCount, 0.0f);
+    for (const auto &[name, state] : snapshot.GetReverbStates()) {
+      const uint32_t id = reverbID(name);
+      if (id < reverbCount) {
+        out.wet[id] = state.wet;
+        out.roomSize[id] = state.roomSize;
+        out.damp[id] = state.damp;
+        out.width[id] = state.width;
+        out.reverbMask[id] = 1.0f;
+      }
+    }
+    return out;
+  }
+
+  /// Number of bus slots.
+  [[nodiscard]] size_t GetBusCount() const { return volume.size(); }
+
+  /// Number of reverb bus slots.
+  [[nodiscard]] size_t GetReverbCount() const { return reverbMask.size(); }
+};
+
 } // namespace Orpheus
@@ -0,0 +1,190 @@
+/**
+ * @file SnapshotBlender.h
+ * @brief Weighted blending of several active mix snapshots.
+ *
+ * Provides the SnapshotBlender class, which combines the bus volumes and
+ * reverb parameters of overlapping snapshot layers (e.g. one per active
+ * mix zone) and reports only the targets that actually changed.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Snapshot.h"
+
+namespace Orpheus {
+
+/**
+ * @brief Weighted stack of compiled snapshots resolved to per-bus targets.
+ *
+ * Each layer holds a CompiledSnapshot, a weight in [0, 1] and a priority.
+ * Layers are applied from lowest to highest priority (insertion order
+ * within a priority), each moving every value it sets from the result
+ * below it towards its own by its weight:
+ * @code
+ * volume = kDefaultVolume;
+ * for (layer : layers) volume += (layer.volume - volume) * layer.weight;
+ * @endcode
+ * A fully weighted high priority layer therefore overrides the layers
+ * below it, while partially weighted layers blend smoothly. Reverb
+ * parameters blend the same way, starting from each reverb bus's base
+ * state (SetReverbBase()).
+ *
+ * Resolve() only runs when a weight or layer changed since the last call,
+ * and reports a bus only when its blended target moved by more than
+ * kChangeThreshold. The blend itself is a dense loop over the compiled
+ * arrays.
+ *
+ * @par Example Usage:
+ * @code
+ * SnapshotBlender blender;
+ * blender.SetLayer(&zone, compiled, 128, 0.5f, 1.0f);
+ * blender.SetWeight(&zone, zone.GetBlendFactor());
+ * if (blender.Resolve()) {
+ *   for (const auto &change : blender.GetBusChanges()) {
+ *     buses[change.bus]->SetTargetVolume(change.volume, change.fadeSeconds);
+ *   }
+ * }
+ * @endcode
+ */
+class SnapshotBlender {
+public:
+  /// Identifies the owner of a layer (e.g. a mix zone).
+  using LayerKey = const void *;
+
+  /// Volume of buses no layer affects.
+  static constexpr float kDefaultVolume = 1.0f;
+
+  /// Smallest change of a target that is reported.
+  static constexpr float kChangeThreshold = 1e-4f;
+
+  /**
+   * @brief New blended volume for a bus.
+   */
+  struct BusChange {
+    uint32_t bus;      ///< Bus id
+    float volume;      ///< Blended target volume
+    float fadeSeconds; ///< Fade of the slowest layer that moved the bus
+  };
+
+  /**
+   * @brief New blended parameters for a reverb bus.
+   */
+  struct ReverbChange {
+    uint32_t reverb;      ///< Reverb bus id
+    ReverbBusState state; ///< Blended target parameters
+    float fadeSeconds;    ///< Fade of the slowest layer that moved the bus
+  };
+
+  /**
+   * @brief Add a layer, or replace the snapshot of an existing one.
+   *
+   * New layers start with weight 0. Replacing the snapshot keeps the
+   * weight.
+   *
+   * @param key Layer owner.
+   * @param snapshot Compiled snapshot.
+   * @param priority Higher priority layers are applied on top.
+   * @param fadeIn Fade used when the layer's weight rises (seconds).
+   * @param fadeOut Fade used when the layer's weight falls (seconds).
+   */
+  void SetLayer(LayerKey key, std::shared_ptr<const CompiledSnapshot> snapshot,
+                uint8_t priority = 128, float fadeIn = 0.5f,
+                float fadeOut = 0.5f);
+
+  /**
+   * @brief Set a layer's weight (clamped to [0, 1]).
+   */
+  void SetWeight(LayerKey key, float weight);
+
+  /**
+   * @brief Remove a layer; its buses fade back using its fade-out time.
+   */
+  void RemoveLayer(LayerKey key);
+
+  /**
+   * @brief Check if a layer exists.
+   */
+  [[nodiscard]] bool HasLayer(LayerKey key) const;
+
+  /**
+   * @brief Number of layers.
+   */
+  [[nodiscard]] size_t GetLayerCount() const { return m_Layers.size(); }
+
+  /**
+   * @brief Set the parameters a reverb bus has when no layer affects it.
+   *
+   * The reverb bus is assumed to currently be at this state.
+   */
+  void SetReverbBase(uint32_t reverb, const ReverbBusState &state);
+
+  /**
+   * @brief Last reported volume of a bus (kDefaultVolume if never set).
+   */
+  [[nodiscard]] float GetTarget(uint32_t bus) const;
+
+  /**
+   * @brief Last reported parameters of a reverb bus.
+   */
+  [[nodiscard]] ReverbBusState GetReverbTarget(uint32_t reverb) const;
+
+  /**
+   * @brief Recompute the blend if anything changed.
+   * @return true if GetBusChanges() or GetReverbChanges() is non-empty.
+   */
+  bool Resolve();
+
+  /**
+   * @brief Buses whose target changed in the last Resolve().
+   */
+  [[nodiscard]] const std::vector<BusChange> &GetBusChanges() const {
+    return m_BusChanges;
+  }
+
+  /**
+   * @brief Reverb buses whose target changed in the last Resolve().
+   */
+  [[nodiscard]] const std::vector<ReverbChange> &GetReverbChanges() const {
+    return m_ReverbChanges;
+  }
+
+private:
+  struct Layer {
+    LayerKey key;
+    std::shared_ptr<const CompiledSnapshot> snapshot;
+    uint8_t priority;
+    float weight;
+    float fadeIn;
+    float fadeOut;
+  };
+
+  [[nodiscard]] Layer *FindLayer(LayerKey key);
+  void Reserve(size_t busCount, size_t reverbCount);
+  void Touch(const CompiledSnapshot &snapshot, float fadeSeconds);
+
+  std::vector<Layer> m_Layers; ///< Sorted by priority, stable
+  bool m_Dirty = false;
+
+  // Per bus id
+  std::vector<float> m_Volume;
+  std::vector<float> m_IssuedVolume;
+  std::vector<float> m_BusFade;
+
+  // Per reverb bus id
+  std::vector<float> m_Wet;
+  std::vector<float> m_RoomSize;
+  std::vector<float> m_Damp;
+  std::vector<float> m_Width;
+  std::vector<ReverbBusState> m_ReverbBase;
+  std::vector<ReverbBusState> m_IssuedReverb;
+  std::vector<float> m_ReverbFade;
+
+  std::vector<BusChange> m_BusChanges;
+  std::vector<ReverbChange> m_ReverbChanges;
+};
+
+} // namespace Orpheus
@@ -112,6 +112,21 @@ struct Voice {
   float targetLowPassFreq = 22000.0f;  ///< Target filter cutoff Hz
   float currentLowPassFreq = 22000.0f; ///< Current (smoothed) cutoff Hz
   float occlusionVolume = 1.0f;        ///< Volume modifier from occlusion
+  float occlusionAge = -1.0f;          ///< Seconds since query (< 0: never)
+  uint32_t occlusionRoom = UINT32_MAX; ///< Last portal graph room (hint)
+  Vector3 apparentPosition{0, 0, 0};   ///< Heard from (portal paths)
+  /// @}
+
+  /// @name Ray-traced Propagation
+  /// @{
+  bool hasPropagation = false;             ///< Propagation applied to DSP
+  float propagationVolume = 1.0f;          ///< Target volume modifier
+  float propagationLowPassFreq = 22000.0f; ///< Target filter cutoff Hz
+  float propagationReverbSend = 0.0f;      ///< Target reverb send (0-1)
+  float propagationVolumeSmoothed = 1.0f;
+  float propagationLowPassSmoothed = 22000.0f;
+  float propagationReverbSendSmoothed = 0.0f;
+  float propagationAge = -1.0f; ///< Seconds since traced (< 0: never)
   /// @}
 
   /// @name Markers
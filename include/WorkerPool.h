@@ -0,0 +1,67 @@
+/**
+ * @file WorkerPool.h
+ * @brief Fixed pool of worker threads for data-parallel loops.
+ *
+ * Provides the WorkerPool class used to spread acoustic ray tracing and
+ * other per-item work across cores.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Orpheus {
+
+// Forward declaration for PIMPL
+struct WorkerPoolImpl;
+
+/**
+ * @brief Worker threads running ParallelFor() loops.
+ *
+ * ParallelFor() splits a loop into indices claimed one at a time by the
+ * workers and by the calling thread, and returns when every index has
+ * run. Several threads may call ParallelFor() concurrently; their loops
+ * are served in submission order and each caller helps with its own.
+ *
+ * @par Example Usage:
+ * @code
+ * WorkerPool pool;
+ * pool.ParallelFor(chunks, [&](size_t chunk) { Process(chunk); });
+ * @endcode
+ */
+class WorkerPool {
+public:
+  /**
+   * @brief Start the worker threads.
+   * @param threadCount Workers besides the calling thread; 0 uses one
+   *                    less than the hardware concurrency.
+   */
+  explicit WorkerPool(uint32_t threadCount = 0);
+
+  /**
+   * @brief Stop the workers after the loops in progress complete.
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /**
+   * @brief Run fn(i) for every i in [0, count) and wait for completion.
+   * @param count Number of indices.
+   * @param fn Function called once per index, from any thread.
+   */
+  void ParallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+  /**
+   * @brief Number of worker threads (excluding callers).
+   */
+  [[nodiscard]] uint32_t GetThreadCount() const;
+
+private:
+  std::unique_ptr<WorkerPoolImpl> m_Impl;
+};
+
+} // namespace Orpheus
@@ -0,0 +1,155 @@
+/**
+ * @file ZoneGrid.h
+ * @brief Spatial broadphase for zones.
+ *
+ * Provides the ZoneGrid class, a hashed uniform grid over the ground
+ * (x, z) plane that audio, mix and reverb zones register their bounds
+ * with, so per-frame updates only touch zones near the listener.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Types.h"
+
+namespace Orpheus {
+
+/**
+ * @brief Zone categories sharing one broadphase.
+ */
+enum class ZoneLayer : uint8_t { Audio, Mix, Reverb };
+
+/**
+ * @brief Hashed uniform grid of axis-aligned zone bounds.
+ *
+ * Each proxy is referenced from every cell its bounds overlap on the x/z
+ * plane, so a point query visits a single cell and never reports a proxy
+ * twice. Proxies that would cover too many cells (huge zones) are kept in
+ * a separate list that every query scans.
+ *
+ * Moving a proxy only touches the cell lists when its cell range changes.
+ *
+ * @par Example Usage:
+ * @code
+ * ZoneGrid grid(64.0f);
+ * uint32_t proxy = grid.Insert(min, max, ZoneLayer::Audio, zoneIndex);
+ * grid.QueryPoint(listener, ZoneLayer::Audio,
+ *                 [&](uint32_t index) { candidates.push_back(index); });
+ * @endcode
+ */
+class ZoneGrid {
+public:
+  /// Returned for proxies that do not exist.
+  static constexpr uint32_t kInvalidProxy = UINT32_MAX;
+
+  /// Proxies spanning more cells than this go to the oversized list.
+  static constexpr int32_t kMaxCellsPerProxy = 256;
+
+  /**
+   * @brief Create a grid.
+   * @param cellSize Cell edge length in world units; should be close to
+   *                 the typical zone diameter.
+   */
+  explicit ZoneGrid(float cellSize = 64.0f);
+
+  /**
+   * @brief Register zone bounds.
+   * @param min Minimum corner.
+   * @param max Maximum corner.
+   * @param layer Zone category.
+   * @param userData Value passed back by queries (e.g. a zone index).
+   * @return Proxy ID for later updates.
+   */
+  uint32_t Insert(const Vector3 &min, const Vector3 &max, ZoneLayer layer,
+                  uint32_t userData);
+
+  /**
+   * @brief Move or resize a proxy.
+   */
+  void Update(uint32_t proxy, const Vector3 &min, const Vector3 &max);
+
+  /**
+   * @brief Unregister a proxy. Its ID may be reused.
+   */
+  void Remove(uint32_t proxy);
+
+  /**
+   * @brief Change the value reported for a proxy.
+   */
+  void SetUserData(uint32_t proxy, uint32_t userData);
+
+  /**
+   * @brief Remove all proxies.
+   */
+  void Clear();
+
+  /**
+   * @brief Number of live proxies.
+   */
+  [[nodiscard]] size_t GetProxyCount() const {
+    return m_Proxies.size() - m_FreeList.size();
+  }
+
+  /**
+   * @brief Visit every proxy of a layer whose bounds contain a point.
+   * @param point Query position.
+   * @param layer Zone category to report.
+   * @param visit Called with the proxy's user data.
+   */
+  template <typename Visitor>
+  void QueryPoint(const Vector3 &point, ZoneLayer layer,
+                  Visitor &&visit) const {
+    auto test = [&](uint32_t id) {
+      const Proxy &p = m_Proxies[id];
+      if (p.layer == layer && point.x >= p.min.x && point.x <= p.max.x &&
+          point.y >= p.min.y && point.y <= p.max.y && point.z >= p.min.z &&
+          point.z <= p.max.z) {
+        visit(p.userData);
+      }
+    };
+
+    auto it = m_Cells.find(Key(CellCoord(point.x), CellCoord(point.z)));
+    if (it != m_Cells.end()) {
+      for (uint32_t id : it->second) {
+        test(id);
+      }
+    }
+    for (uint32_t id : m_Oversized) {
+      test(id);
+    }
+  }
+
+private:
+  struct Proxy {
+    Vector3 min;
+    Vector3 max;
+    ZoneLayer layer = ZoneLayer::Audio;
+    uint32_t userData = 0;
+    int32_t x0 = 0, z0 = 0, x1 = -1, z1 = -1; ///< Cell range (inclusive)
+    bool oversized = false;
+    bool alive = false;
+  };
+
+  [[nodiscard]] int32_t CellCoord(float v) const {
+    return static_cast<int32_t>(std::floor(v * m_InvCellSize));
+  }
+
+  static uint64_t Key(int32_t x, int32_t z) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+           static_cast<uint32_t>(z);
+  }
+
+  void Link(uint32_t id);
+  void Unlink(uint32_t id);
+
+  float m_InvCellSize;
+  std::vector<Proxy> m_Proxies;
+  std::vector<uint32_t> m_FreeList;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+  std::vector<uint32_t> m_Oversized;
+};
+
+} // namespace Orpheus
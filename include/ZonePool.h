@@ -0,0 +1,268 @@
+/**
+ * @file ZonePool.h
+ * @brief Contiguous storage and per-frame evaluation of audio zones.
+ *
+ * Provides the ZonePool class, which keeps all audio zones of a manager in
+ * parallel arrays and drives their playback through a caller-supplied
+ * backend instead of per-zone callbacks.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Types.h"
+#include "ZoneShape.h"
+
+namespace Orpheus {
+
+/**
+ * @brief Structure-of-arrays store for audio zones.
+ *
+ * Per-frame data (shape, voice handle, state flags, prefetch radius) lives
+ * in tightly packed arrays; names, snapshots and fade times are kept apart
+ * since they are only read on transitions. Event and snapshot names are
+ * interned, so each zone stores 32-bit indices instead of strings.
+ *
+ * Update() is a template over the backend that plays and stops voices, so
+ * engine calls are direct and inlinable. A backend provides:
+ * @code
+ * struct Backend {
+ *   AudioHandle Play(const std::string &eventName);
+ *   bool IsValid(AudioHandle handle);
+ *   void SetVolume(AudioHandle handle, float volume);
+ *   void Stop(AudioHandle handle);
+ *   void ApplySnapshot(const std::string &snapshotName, float fadeTime);
+ *   void RevertSnapshot(float fadeTime);
+ *   void SetResident(const std::string &eventName, bool resident);
+ * };
+ * @endcode
+ *
+ * Zone indices are stable; zones are never removed.
+ */
+class ZonePool {
+public:
+  /// Returned by Find() when no zone plays the event.
+  static constexpr uint32_t kInvalidZone = UINT32_MAX;
+
+  /// Release distance, as a fraction of the prefetch radius added on top.
+  static constexpr float kPrefetchHysteresis = 0.25f;
+
+  /// Prefetch distance AudioManager gives new zones.
+  static constexpr float kDefaultPrefetchRadius = 20.0f;
+
+  /**
+   * @brief Add a zone.
+   * @param eventName Event played while the zone is audible.
+   * @param geometry Zone shape.
+   * @param prefetchRadius Distance beyond the audible region at which the
+   *                       event's assets are made resident (0 disables).
+   * @param snapshotName Snapshot applied while active (empty for none).
+   * @param fadeIn Snapshot fade-in time (seconds).
+   * @param fadeOut Snapshot fade-out time (seconds).
+   * @return Index of the new zone.
+   */
+  uint32_t Add(const std::string &eventName, const ZoneGeometry &geometry,
+               float prefetchRadius = 0.0f,
+               const std::string &snapshotName = "", float fadeIn = 0.5f,
+               float fadeOut = 0.5f);
+
+  /**
+   * @brief Number of zones.
+   */
+  [[nodiscard]] size_t GetCount() const { return m_Geometry.size(); }
+
+  /**
+   * @brief First zone playing an event.
+   * @return Zone index, or kInvalidZone.
+   */
+  [[nodiscard]] uint32_t Find(const std::string &eventName) const;
+
+  [[nodiscard]] const std::string &GetEventName(uint32_t zone) const {
+    return m_Names[m_Event[zone]];
+  }
+  [[nodiscard]] const ZoneGeometry &GetGeometry(uint32_t zone) const {
+    return m_Geometry[zone];
+  }
+  [[nodiscard]] AudioHandle GetHandle(uint32_t zone) const {
+    return m_Handle[zone];
+  }
+  [[nodiscard]] bool IsActive(uint32_t zone) const {
+    return (m_Flags[zone] & kActive) != 0;
+  }
+  [[nodiscard]] bool IsPrefetched(uint32_t zone) const {
+    return (m_Flags[zone] & kPrefetched) != 0;
+  }
+  [[nodiscard]] bool HasSnapshot(uint32_t zone) const {
+    return m_Snapshot[zone] != kNoName;
+  }
+
+  /**
+   * @brief Snapshot name of a zone (empty if none).
+   */
+  [[nodiscard]] const std::string &GetSnapshotName(uint32_t zone) const;
+
+  [[nodiscard]] float GetPrefetchRadius(uint32_t zone) const {
+    return m_PrefetchRadius[zone];
+  }
+
+  /**
+   * @brief Distance beyond the audible region at which residency ends.
+   */
+  [[nodiscard]] float GetPrefetchReleaseRadius(uint32_t zone) const {
+    return m_PrefetchRadius[zone] * (1.0f + kPrefetchHysteresis);
+  }
+
+  /**
+   * @brief Bounds covering the audible region plus the release radius.
+   */
+  void GetBounds(uint32_t zone, Vector3 &min, Vector3 &max) const;
+
+  void SetPosition(uint32_t zone, const Vector3 &pos) {
+    m_Geometry[zone].SetCenter(pos);
+  }
+  void SetRadii(uint32_t zone, float inner, float outer) {
+    m_Geometry[zone].SetRadii(inner, outer);
+  }
+
+  /**
+   * @brief Change a zone's prefetch radius, dropping current residency.
+   */
+  template <typename Backend>
+  void SetPrefetchRadius(uint32_t zone, float radius, Backend &backend) {
+    if (IsPrefetched(zone)) {
+      m_Flags[zone] &= static_cast<uint8_t>(~kPrefetched);
+      backend.SetResident(GetEventName(zone), false);
+    }
+    m_PrefetchRadius[zone] = radius > 0.0f ? radius : 0.0f;
+  }
+
+  /**
+   * @brief Evaluate zones near the listeners and drive their voices.
+   *
+   * Zones are heard at the volume of the loudest listener. With crossfade
+   * enabled, volumes are scaled down together if they sum above 1. Zones
+   * that fall silent are stopped before new ones start, so an entering
+   * zone's snapshot is not reverted by an exiting one in the same frame.
+   *
+   * @param candidates Sorted, unique zone indices to evaluate.
+   * @param listeners Listener positions.
+   * @param listenerCount Number of listeners.
+   * @param crossfade Normalize overlapping zone volumes.
+   * @param backend Engine interface (see class description).
+   * @param live Receives zones that are playing or resident; these must
+   *             be evaluated again next frame.
+   */
+  template <typename Backend>
+  void Update(const std::vector<uint32_t> &candidates,
+              const Vector3 *listeners, size_t listenerCount, bool crossfade,
+              Backend &backend, std::vector<uint32_t> &live);
+
+private:
+  static constexpr uint32_t kNoName = UINT32_MAX;
+  static constexpr uint8_t kActive = 1u << 0;
+  static constexpr uint8_t kPrefetched = 1u << 1;
+
+  uint32_t Intern(const std::string &name);
+  [[nodiscard]] bool InPrefetchRange(uint32_t zone, const Vector3 *listeners,
+                                     size_t listenerCount) const;
+  [[nodiscard]] float LoudestVolume(uint32_t zone, const Vector3 *listeners,
+                                    size_t listenerCount) const {
+    float best = m_Geometry[zone].ComputeVolume(listeners[0]);
+    for (size_t i = 1; i < listenerCount; ++i) {
+      const float volume = m_Geometry[zone].ComputeVolume(listeners[i]);
+      best = volume > best ? volume : best;
+    }
+    return best;
+  }
+
+  // Per-frame data
+  std::vector<ZoneGeometry> m_Geometry;
+  std::vector<AudioHandle> m_Handle;
+  std::vector<uint8_t> m_Flags;
+  std::vector<float> m_PrefetchRadius;
+
+  // Read on transitions only
+  std::vector<uint32_t> m_Event;
+  std::vector<uint32_t> m_Snapshot;
+  std::vector<float> m_FadeIn;
+  std::vector<float> m_FadeOut;
+  std::vector<std::string> m_Names;
+  std::unordered_map<std::string, uint32_t> m_NameIndex;
+
+  std::vector<float> m_Volumes; ///< Scratch, parallel to candidates
+};
+
+template <typename Backend>
+void ZonePool::Update(const std::vector<uint32_t> &candidates,
+                      const Vector3 *listeners, size_t listenerCount,
+                      bool crossfade, Backend &backend,
+                      std::vector<uint32_t> &live) {
+  live.clear();
+  if (listenerCount == 0) {
+    live.assign(candidates.begin(), candidates.end());
+    return;
+  }
+
+  // One pass for residency, volumes and exits, so every exit is handled
+  // before any entry below. Assets are requested first, so a zone first
+  // seen inside its outer radius still queues its load as early as possible
+  m_Volumes.resize(candidates.size());
+  float total = 0.0f;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const uint32_t zone = candidates[i];
+    if (m_PrefetchRadius[zone] > 0.0f) {
+      const bool inRange = InPrefetchRange(zone, listeners, listenerCount);
+      if (inRange != IsPrefetched(zone)) {
+        m_Flags[zone] ^= kPrefetched;
+        backend.SetResident(GetEventName(zone), inRange);
+      }
+    }
+
+    const float volume = LoudestVolume(zone, listeners, listenerCount);
+    m_Volumes[i] = volume;
+    total += volume;
+    if (volume > 0.0f) {
+      continue;
+    }
+    if (m_Handle[zone] != 0 && backend.IsValid(m_Handle[zone])) {
+      backend.Stop(m_Handle[zone]);
+    }
+    m_Handle[zone] = 0;
+    if (IsActive(zone) && HasSnapshot(zone)) {
+      backend.RevertSnapshot(m_FadeOut[zone]);
+    }
+    m_Flags[zone] &= static_cast<uint8_t>(~kActive);
+    // Resident zones stay live so their release is seen even after the
+    // broadphase stops reporting them
+    if (IsPrefetched(zone)) {
+      live.push_back(zone);
+    }
+  }
+  const float scale = (crossfade && total > 1.0f) ? 1.0f / total : 1.0f;
+
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const uint32_t zone = candidates[i];
+    if (m_Volumes[i] <= 0.0f) {
+      continue;
+    }
+    // Restart one-shot ambiences that finished
+    AudioHandle &handle = m_Handle[zone];
+    if (handle == 0 || !backend.IsValid(handle)) {
+      handle = backend.Play(GetEventName(zone));
+    }
+    if (!IsActive(zone) && HasSnapshot(zone)) {
+      backend.ApplySnapshot(m_Names[m_Snapshot[zone]], m_FadeIn[zone]);
+    }
+    m_Flags[zone] |= kActive;
+    if (handle != 0) {
+      backend.SetVolume(handle, m_Volumes[i] * scale);
+    }
+    live.push_back(zone);
+  }
+}
+
+} // namespace Orpheus
@@ -8,6 +8,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #include "Types.h"
@@ -27,6 +30,161 @@ struct Vector2 {
  */
 enum class ZoneShapeType { Sphere, Box, Polygon };
 
+/**
+ * @brief Immutable, preprocessed 2D polygon (x, z plane).
+ *
+ * Edges are stored with their bounds and slope precomputed, and bucketed
+ * into horizontal bands along z. Containment only tests the edges of the
+ * band holding the query point, and distance queries only visit bands
+ * within the search radius, so large polygons (navmesh outlines with
+ * thousands of vertices) cost roughly O(sqrt(n)) per query.
+ */
+class PolygonData {
+public:
+  /**
+   * @brief Preprocess a polygon.
+   * @param points Vertices in order (x, z); the polygon is closed
+   *               implicitly.
+   */
+  explicit PolygonData(const std::vector<Vector2> &points);
+
+  /**
+   * @brief Point-in-polygon test (even-odd rule).
+   */
+  [[nodiscard]] bool Contains(float x, float z) const;
+
+  /**
+   * @brief Distance from a point to the polygon.
+   * @param x Point x.
+   * @param z Point z.
+   * @param maxDistance Search radius.
+   * @return 0 inside, the distance to the nearest edge if it is within
+   *         maxDistance, otherwise FLT_MAX.
+   */
+  [[nodiscard]] float Distance(float x, float z, float maxDistance) const;
+
+  [[nodiscard]] const Vector2 &GetMin() const { return m_Min; }
+  [[nodiscard]] const Vector2 &GetMax() const { return m_Max; }
+  [[nodiscard]] size_t GetEdgeCount() const { return m_Edges.size(); }
+  [[nodiscard]] size_t GetBandCount() const { return m_BandCount; }
+
+private:
+  struct Edge {
+    float x0, z0;       ///< Start point
+    float x1, z1;       ///< End point
+    float dx, dz;       ///< End - start
+    float invLengthSq;  ///< 1 / |d|^2 (0 for degenerate edges)
+    float xPerZ;        ///< dx / dz (0 for horizontal edges)
+    float minX, maxX;
+    float minZ, maxZ;
+  };
+
+  [[nodiscard]] uint32_t Band(float z) const;
+
+  std::vector<Edge> m_Edges;
+  std::vector<uint32_t> m_BandBegin; ///< CSR offsets into m_BandEdges
+  std::vector<uint32_t> m_BandEdges;
+  Vector2 m_Min;
+  Vector2 m_Max;
+  float m_InvBandHeight = 0.0f;
+  uint32_t m_BandCount = 1;
+};
+
+/**
+ * @brief Shape of a zone as a plain value, dispatched by type.
+ *
+ * Used by AudioZone, MixZone and ReverbZone instead of the virtual
+ * ZoneShape classes, so evaluating thousands of zones is a switch and a
+ * few flops each rather than an indirect call.
+ *
+ * Volume is 1 inside the shape's core region (the inner radius of a
+ * sphere, the box, or the polygon prism) and falls linearly to 0 over the
+ * fade distance (the outer radius for spheres). Polygon vertices are kept
+ * relative to the zone center, so moving a polygon zone is O(1).
+ */
+class ZoneGeometry {
+public:
+  /// Sphere with full volume inside @p inner and silence beyond @p outer.
+  static ZoneGeometry Sphere(const Vector3 &center, float inner, float outer);
+
+  /// Axis-aligned box with a fade band around it.
+  static ZoneGeometry Box(const Vector3 &min, const Vector3 &max,
+                          float fadeDistance);
+
+  /// Polygon on the x/z plane (Vector2::y is z), extruded from minY to maxY.
+  static ZoneGeometry Polygon(const std::vector<Vector2> &points, float minY,
+                              float maxY, float fadeDistance);
+
+  [[nodiscard]] ZoneShapeType GetType() const { return m_Type; }
+
+  /**
+   * @brief Volume/blend factor for a listener position (0.0-1.0).
+   */
+  [[nodiscard]] float ComputeVolume(const Vector3 &point) const;
+
+  /**
+   * @brief Distance from a point to the shape's core region.
+   * @return 0 inside. Polygon distances beyond the fade band are FLT_MAX.
+   */
+  [[nodiscard]] float GetDistance(const Vector3 &point) const;
+
+  /**
+   * @brief Check if a point is within a margin of the audible region.
+   * @param point Query position.
+   * @param margin Distance beyond the outer radius / fade band.
+   */
+  [[nodiscard]] bool IsWithin(const Vector3 &point, float margin) const;
+
+  /**
+   * @brief Bounds of the audible region (core plus fade).
+   */
+  void GetBounds(Vector3 &min, Vector3 &max) const;
+
+  /**
+   * @brief Center of the shape (box/polygon: center of the bounds).
+   */
+  [[nodiscard]] const Vector3 &GetCenter() const { return m_Center; }
+
+  /**
+   * @brief Move the shape so its center is at @p center.
+   */
+  void SetCenter(const Vector3 &center) { m_Center = center; }
+
+  /**
+   * @brief Change the fade range.
+   *
+   * Spheres take both radii. Boxes and polygons use outer - inner as
+   * their fade distance.
+   */
+  void SetRadii(float inner, float outer);
+
+  /// Sphere inner radius (0 for other shapes).
+  [[nodiscard]] float GetInnerRadius() const {
+    return m_Type == ZoneShapeType::Sphere ? m_Inner : 0.0f;
+  }
+
+  /// Sphere outer radius, or the fade distance of other shapes.
+  [[nodiscard]] float GetOuterRadius() const { return m_Outer; }
+
+  /// Half size of a box, or of a polygon's bounds.
+  [[nodiscard]] const Vector3 &GetHalfExtents() const { return m_HalfExtents; }
+
+  /// Preprocessed polygon in center-relative coordinates (or nullptr).
+  [[nodiscard]] const PolygonData *GetPolygon() const {
+    return m_Polygon.get();
+  }
+
+private:
+  [[nodiscard]] float Fade(float distance) const;
+
+  ZoneShapeType m_Type = ZoneShapeType::Sphere;
+  Vector3 m_Center;
+  Vector3 m_HalfExtents;
+  float m_Inner = 0.0f; ///< Sphere inner radius
+  float m_Outer = 0.0f; ///< Sphere outer radius, or fade distance
+  std::shared_ptr<const PolygonData> m_Polygon;
+};
+
 /**
  * @brief Base class for zone shapes.
  */
@@ -171,8 +329,8 @@ public:
    */
   PolygonShape(const std::vector<Vector2> &points, float minY, float maxY,
                float fadeDistance = 5.0f)
-      : m_Points(points), m_MinY(minY), m_MaxY(maxY),
-        m_FadeDistance(fadeDistance) {}
+      : m_Data(std::make_shared<const PolygonData>(points)), m_MinY(minY),
+        m_MaxY(maxY), m_FadeDistance(fadeDistance) {}
 
   [[nodiscard]] bool Contains(const Vector3 &point) const override {
     // Check height
@@ -182,7 +340,7 @@ public:
     }
 
     // Check 2D polygon containment with fade distance
-    float dist2D = PointToPolygonDistance(point.x, point.z);
+    float dist2D = m_Data->Distance(point.x, point.z, m_FadeDistance);
     return dist2D <= m_FadeDistance;
   }
 
@@ -194,9 +352,15 @@ public:
     } else if (point.y > m_MaxY) {
       heightDist = point.y - m_MaxY;
     }
+    if (heightDist >= m_FadeDistance) {
+      return 1.0f;
+    }
 
     // 2D polygon distance
-    float polyDist = PointToPolygonDistance(point.x, point.z);
+    float polyDist = m_Data->Distance(point.x, point.z, m_FadeDistance);
+    if (polyDist >= m_FadeDistance) {
+      return 1.0f;
+    }
 
     // Combine distances
     float totalDist = std::sqrt(heightDist * heightDist + polyDist * polyDist);
@@ -214,66 +378,10 @@ public:
     return ZoneShapeType::Polygon;
   }
 
-private:
-  // Point-in-polygon test using ray casting
-  [[nodiscard]] bool PointInPolygon(float x, float z) const {
-    bool inside = false;
-    size_t n = m_Points.size();
-    for (size_t i = 0, j = n - 1; i < n; j = i++) {
-      if (((m_Points[i].y > z) != (m_Points[j].y > z)) &&
-          (x < (m_Points[j].x - m_Points[i].x) * (z - m_Points[i].y) /
-                       (m_Points[j].y - m_Points[i].y) +
-                   m_Points[i].x)) {
-        inside = !inside;
-      }
-    }
-    return inside;
-  }
-
-  // Distance from point to polygon boundary
-  [[nodiscard]] float PointToPolygonDistance(float x, float z) const {
-    if (PointInPolygon(x, z)) {
-      return 0.0f; // Inside polygon
-    }
+  [[nodiscard]] const PolygonData &GetData() const { return *m_Data; }
 
-    // Find minimum distance to any edge
-    float minDist = (std::numeric_limits<float>::max)();
-    size_t n = m_Points.size();
-    for (size_t i = 0; i < n; ++i) {
-      size_t j = (i + 1) % n;
-      float dist = PointToSegmentDistance(x, z, m_Points[i].x, m_Points[i].y,
-                                          m_Points[j].x, m_Points[j].y);
-      minDist = (std::min)(minDist, dist);
-    }
-    return minDist;
-  }
-
-  // Distance from point to line segment
-  static float PointToSegmentDistance(float px, float pz, float x1, float z1,
-                                      float x2, float z2) {
-    float dx = x2 - x1;
-    float dz = z2 - z1;
-    float lengthSq = dx * dx + dz * dz;
-
-    if (lengthSq == 0.0f) {
-      // Segment is a point
-      float ddx = px - x1;
-      float ddz = pz - z1;
-      return std::sqrt(ddx * ddx + ddz * ddz);
-    }
-
-    // Project point onto segment
-    float t = (std::max)(
-        0.0f, (std::min)(1.0f, ((px - x1) * dx + (pz - z1) * dz) / lengthSq));
-    float projX = x1 + t * dx;
-    float projZ = z1 + t * dz;
-
-    float ddx = px - projX;
-    float ddz = pz - projZ;
-    return std::sqrt(ddx * ddx + ddz * ddz);
-  }
-
-  std::vector<Vector2> m_Points;
+private:
+  std::shared_ptr<const PolygonData> m_Data;
   float m_MinY;
   float m_MaxY;
   float m_FadeDistance;
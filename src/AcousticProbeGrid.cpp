@@ -0,0 +1,497 @@
+#include "../include/AcousticProbeGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Orpheus {
+
+namespace {
+
+constexpr float kDelayUnit = 1.0e-5f;     // Seconds per delay step
+constexpr float kReverbTimeUnit = 1.0e-3f; // Seconds per reverb time step
+
+uint16_t Quantize(float value, float unit) {
+  const float steps = std::clamp(value / unit, 0.0f, 65535.0f);
+  return static_cast<uint16_t>(std::lround(steps));
+}
+
+float Dequantize(uint16_t value, float unit) {
+  return static_cast<float>(value) * unit;
+}
+
+PackedAcousticProbe Pack(const AcousticProbeSample &sample) {
+  constexpr float kUnorm = 1.0f / 65535.0f;
+  PackedAcousticProbe probe;
+  probe.gainLow = Quantize(sample.reflectionGainLow, kUnorm);
+  probe.gainMid = Quantize(sample.reflectionGainMid, kUnorm);
+  probe.gainHigh = Quantize(sample.reflectionGainHigh, kUnorm);
+  probe.earlyReflectionGain = Quantize(sample.earlyReflectionGain, kUnorm);
+  probe.earlyReflectionDelay =
+      Quantize(sample.earlyReflectionDelay, kDelayUnit);
+  probe.lateReverbTime = Quantize(sample.lateReverbTime, kReverbTimeUnit);
+  return probe;
+}
+
+// Source and listener both at the probe
+AcousticProbeSample TraceProbe(const AcousticRayTracer &tracer,
+                               const Vector3 &position) {
+  const AcousticVector at(position.x, position.y, position.z);
+  const PropagationResult result = tracer.Trace(at, at);
+
+  AcousticProbeSample sample;
+  sample.valid = true;
+  for (const PropagationPath &path : result.paths) {
+    if (!path.isDirect) {
+      sample.reflectionGainLow += path.gainLow;
+      sample.reflectionGainMid += path.gainMid;
+      sample.reflectionGainHigh += path.gainHigh;
+    }
+  }
+  sample.reflectionGainLow = std::min(sample.reflectionGainLow, 1.0f);
+  sample.reflectionGainMid = std::min(sample.reflectionGainMid, 1.0f);
+  sample.reflectionGainHigh = std::min(sample.reflectionGainHigh, 1.0f);
+  sample.earlyReflectionGain = result.earlyReflectionGain;
+  sample.earlyReflectionDelay = result.earlyReflectionDelay;
+  sample.lateReverbTime = result.lateReverbTime;
+  return sample;
+}
+
+// Lattice covering a box, or false if empty or too large
+bool MakeLattice(const Vector3 &min, const Vector3 &max, float spacing,
+                 AcousticProbeGrid::Header &header) {
+  if (!(spacing > 0.0f) || !(max.x >= min.x) || !(max.y >= min.y) ||
+      !(max.z >= min.z)) {
+    return false;
+  }
+  auto points = [spacing](float extent) {
+    return static_cast<uint64_t>(std::floor(extent / spacing + 1e-4f)) + 1;
+  };
+  const uint64_t dimX = points(max.x - min.x);
+  const uint64_t dimY = points(max.y - min.y);
+  const uint64_t dimZ = points(max.z - min.z);
+  if (dimX * dimY * dimZ > AcousticProbeGrid::kMaxPoints) {
+    return false;
+  }
+  header.originX = min.x;
+  header.originY = min.y;
+  header.originZ = min.z;
+  header.spacing = spacing;
+  header.dimX = static_cast<uint32_t>(dimX);
+  header.dimY = static_cast<uint32_t>(dimY);
+  header.dimZ = static_cast<uint32_t>(dimZ);
+  return true;
+}
+
+size_t PointCount(const AcousticProbeGrid::Header &header) {
+  return size_t{header.dimX} * header.dimY * header.dimZ;
+}
+
+Vector3 PointPosition(const AcousticProbeGrid::Header &header, size_t x,
+                      size_t y, size_t z) {
+  return {header.originX + header.spacing * static_cast<float>(x),
+          header.originY + header.spacing * static_cast<float>(y),
+          header.originZ + header.spacing * static_cast<float>(z)};
+}
+
+// Whether [offset, offset + bytes) lies in an image of the given size
+bool InImage(uint64_t offset, uint64_t bytes, size_t size) {
+  return offset <= size && bytes <= size - offset;
+}
+
+} // namespace
+
+AcousticProbeGrid::~AcousticProbeGrid() { Unload(); }
+
+std::vector<uint8_t>
+AcousticProbeGrid::BakeGrid(const AcousticRayTracer &tracer,
+                            const Vector3 &min, const Vector3 &max,
+                            float spacing, const BakeProgress &progress) {
+  Header lattice{};
+  if (!MakeLattice(min, max, spacing, lattice)) {
+    return {};
+  }
+  std::vector<Vector3> positions;
+  positions.reserve(PointCount(lattice));
+  for (uint32_t z = 0; z < lattice.dimZ; ++z) {
+    for (uint32_t y = 0; y < lattice.dimY; ++y) {
+      for (uint32_t x = 0; x < lattice.dimX; ++x) {
+        positions.push_back(PointPosition(lattice, x, y, z));
+      }
+    }
+  }
+  return Bake(tracer, positions.data(), positions.size(), lattice, false,
+              progress);
+}
+
+std::vector<uint8_t>
+AcousticProbeGrid::BakeProbes(const AcousticRayTracer &tracer,
+                              const Vector3 *positions, size_t count,
+                              const Vector3 &min, const Vector3 &max,
+                              float spacing, const BakeProgress &progress) {
+  Header lattice{};
+  if (count == 0 || count > kMaxPoints ||
+      !MakeLattice(min, max, spacing, lattice)) {
+    return {};
+  }
+  return Bake(tracer, positions, count, lattice, true, progress);
+}
+
+std::vector<uint8_t> AcousticProbeGrid::Bake(const AcousticRayTracer &tracer,
+                                             const Vector3 *positions,
+                                             size_t count,
+                                             const Header &lattice,
+                                             bool placed,
+                                             const BakeProgress &progress) {
+  Header header = lattice;
+  header.magic = kMagic;
+  header.version = kFormatVersion;
+  header.probeCount = static_cast<uint32_t>(count);
+  header.rayCount = static_cast<uint32_t>(tracer.GetRayCount());
+
+  // Header, probes, then for placed probes the table and positions
+  const size_t points = PointCount(header);
+  size_t size = sizeof(Header);
+  header.probeOffset = static_cast<uint32_t>(size);
+  size += count * sizeof(PackedAcousticProbe);
+  size = (size + 3) & ~size_t{3};
+  if (placed) {
+    header.indexOffset = static_cast<uint32_t>(size);
+    size += points * sizeof(uint32_t);
+    header.positionOffset = static_cast<uint32_t>(size);
+    size += count * 3 * sizeof(float);
+  }
+
+  std::vector<uint8_t> image(size);
+  std::memcpy(image.data(), &header, sizeof(Header));
+  auto *probes = reinterpret_cast<PackedAcousticProbe *>(image.data() +
+                                                         header.probeOffset);
+  for (size_t i = 0; i < count; ++i) {
+    probes[i] = Pack(TraceProbe(tracer, positions[i]));
+    if (progress) {
+      progress(i + 1, count);
+    }
+  }
+  if (!placed) {
+    return image;
+  }
+
+  // Nearest probe of every lattice point
+  auto *index =
+      reinterpret_cast<uint32_t *>(image.data() + header.indexOffset);
+  size_t point = 0;
+  for (uint32_t z = 0; z < header.dimZ; ++z) {
+    for (uint32_t y = 0; y < header.dimY; ++y) {
+      for (uint32_t x = 0; x < header.dimX; ++x, ++point) {
+        const Vector3 p = PointPosition(header, x, y, z);
+        float best = INFINITY;
+        for (size_t i = 0; i < count; ++i) {
+          const float dx = positions[i].x - p.x;
+          const float dy = positions[i].y - p.y;
+          const float dz = positions[i].z - p.z;
+          const float distance = dx * dx + dy * dy + dz * dz;
+          if (distance < best) {
+            best = distance;
+            index[point] = static_cast<uint32_t>(i);
+          }
+        }
+      }
+    }
+  }
+  auto *stored =
+      reinterpret_cast<float *>(image.data() + header.positionOffset);
+  for (size_t i = 0; i < count; ++i) {
+    stored[i * 3] = positions[i].x;
+    stored[i * 3 + 1] = positions[i].y;
+    stored[i * 3 + 2] = positions[i].z;
+  }
+  return image;
+}
+
+Status AcousticProbeGrid::Load(const std::string &path) {
+  Unload();
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return Error(ErrorCode::FileNotFound,
+                 "Failed to open probe file: " + path);
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+      fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+    CloseHandle(file);
+    return Error(ErrorCode::InvalidFormat, "Not a probe file: " + path);
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  void *view = mapping != nullptr
+                   ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                   : nullptr;
+  if (mapping != nullptr) {
+    CloseHandle(mapping); // The view keeps the mapping alive
+  }
+  if (view == nullptr) {
+    return Error(ErrorCode::Unknown, "Failed to map probe file: " + path);
+  }
+  const auto size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  const int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    return Error(ErrorCode::FileNotFound,
+                 "Failed to open probe file: " + path);
+  }
+  struct stat info;
+  if (fstat(file, &info) != 0 ||
+      info.st_size < static_cast<off_t>(sizeof(Header))) {
+    close(file);
+    return Error(ErrorCode::InvalidFormat, "Not a probe file: " + path);
+  }
+  const auto size = static_cast<size_t>(info.st_size);
+  void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file); // The mapping stays valid
+  if (view == MAP_FAILED) {
+    return Error(ErrorCode::Unknown, "Failed to map probe file: " + path);
+  }
+#endif
+  m_Mapping = view;
+  m_Data = static_cast<const uint8_t *>(view);
+  m_Size = size;
+  Status status = Validate();
+  if (status.IsError()) {
+    Unload();
+  }
+  return status;
+}
+
+Status AcousticProbeGrid::LoadFromMemory(std::vector<uint8_t> image) {
+  Unload();
+  m_Image = std::move(image);
+  m_Data = m_Image.empty() ? nullptr : m_Image.data();
+  m_Size = m_Image.size();
+  Status status = Validate();
+  if (status.IsError()) {
+    Unload();
+  }
+  return status;
+}
+
+Status AcousticProbeGrid::Save(const std::string &path) const {
+  if (!IsLoaded()) {
+    return Error(ErrorCode::InvalidParameter, "No probes to save");
+  }
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return Error(ErrorCode::InvalidPath,
+                 "Failed to create probe file: " + path);
+  }
+  file.write(reinterpret_cast<const char *>(m_Data),
+             static_cast<std::streamsize>(m_Size));
+  if (!file) {
+    return Error(ErrorCode::InvalidPath,
+                 "Failed to write probe file: " + path);
+  }
+  return Ok();
+}
+
+void AcousticProbeGrid::Unload() {
+  if (m_Mapping != nullptr) {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_Mapping);
+#else
+    munmap(m_Mapping, m_Size);
+#endif
+    m_Mapping = nullptr;
+  }
+  m_Image.clear();
+  m_Image.shrink_to_fit();
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Header = Header{};
+  m_Probes = nullptr;
+  m_Index = nullptr;
+  m_Positions = nullptr;
+}
+
+Status AcousticProbeGrid::Validate() {
+  if (m_Data == nullptr || m_Size < sizeof(Header)) {
+    return Error(ErrorCode::InvalidFormat, "Probe data too small");
+  }
+  std::memcpy(&m_Header, m_Data, sizeof(Header));
+  const Header &h = m_Header;
+  if (h.magic != kMagic || h.version != kFormatVersion) {
+    return Error(ErrorCode::InvalidFormat,
+                 "Not a probe file or unsupported version");
+  }
+
+  const uint64_t points = uint64_t{h.dimX} * h.dimY * h.dimZ;
+  const bool placed = h.indexOffset != 0;
+  if (!(h.spacing > 0.0f) || !std::isfinite(h.spacing) || points == 0 ||
+      points > kMaxPoints || h.probeCount == 0 ||
+      h.probeCount > kMaxPoints || (!placed && h.probeCount != points)) {
+    return Error(ErrorCode::InvalidFormat, "Invalid probe lattice");
+  }
+  if (h.probeOffset % alignof(PackedAcousticProbe) != 0 ||
+      h.indexOffset % alignof(uint32_t) != 0 ||
+      h.positionOffset % alignof(float) != 0 ||
+      !InImage(h.probeOffset,
+               uint64_t{h.probeCount} * sizeof(PackedAcousticProbe),
+               m_Size) ||
+      (placed && !InImage(h.indexOffset, points * sizeof(uint32_t),
+                          m_Size)) ||
+      (h.positionOffset != 0 &&
+       !InImage(h.positionOffset,
+                uint64_t{h.probeCount} * 3 * sizeof(float), m_Size))) {
+    return Error(ErrorCode::InvalidFormat, "Probe data out of range");
+  }
+
+  m_Probes =
+      reinterpret_cast<const PackedAcousticProbe *>(m_Data + h.probeOffset);
+  m_Index = placed ? reinterpret_cast<const uint32_t *>(m_Data + h.indexOffset)
+                   : nullptr;
+  m_Positions =
+      h.positionOffset != 0
+          ? reinterpret_cast<const float *>(m_Data + h.positionOffset)
+          : nullptr;
+  return Ok();
+}
+
+uint32_t AcousticProbeGrid::ProbeAt(uint32_t x, uint32_t y, uint32_t z) const {
+  const uint32_t point = (z * m_Header.dimY + y) * m_Header.dimX + x;
+  if (m_Index == nullptr) {
+    return point;
+  }
+  const uint32_t probe = m_Index[point];
+  return probe < m_Header.probeCount ? probe : kNoProbe;
+}
+
+AcousticProbeSample AcousticProbeGrid::GetProbe(uint32_t probe) const {
+  AcousticProbeSample sample;
+  if (probe >= m_Header.probeCount || m_Probes == nullptr) {
+    return sample;
+  }
+  constexpr float kUnorm = 1.0f / 65535.0f;
+  const PackedAcousticProbe &packed = m_Probes[probe];
+  sample.valid = true;
+  sample.reflectionGainLow = Dequantize(packed.gainLow, kUnorm);
+  sample.reflectionGainMid = Dequantize(packed.gainMid, kUnorm);
+  sample.reflectionGainHigh = Dequantize(packed.gainHigh, kUnorm);
+  sample.earlyReflectionGain = Dequantize(packed.earlyReflectionGain, kUnorm);
+  sample.earlyReflectionDelay =
+      Dequantize(packed.earlyReflectionDelay, kDelayUnit);
+  sample.lateReverbTime = Dequantize(packed.lateReverbTime, kReverbTimeUnit);
+  return sample;
+}
+
+Vector3 AcousticProbeGrid::GetProbePosition(uint32_t probe) const {
+  if (probe >= m_Header.probeCount) {
+    return {0.0f, 0.0f, 0.0f};
+  }
+  if (m_Positions != nullptr) {
+    return {m_Positions[probe * 3], m_Positions[probe * 3 + 1],
+            m_Positions[probe * 3 + 2]};
+  }
+  const uint32_t x = probe % m_Header.dimX;
+  const uint32_t y = probe / m_Header.dimX % m_Header.dimY;
+  const uint32_t z = probe / m_Header.dimX / m_Header.dimY;
+  return PointPosition(m_Header, x, y, z);
+}
+
+AcousticProbeSample AcousticProbeGrid::Sample(const Vector3 &position,
+                                              ProbeInterpolation mode) const {
+  AcousticProbeSample sample;
+  if (m_Probes == nullptr) {
+    return sample;
+  }
+  const Header &h = m_Header;
+  const float fx = (position.x - h.originX) / h.spacing;
+  const float fy = (position.y - h.originY) / h.spacing;
+  const float fz = (position.z - h.originZ) / h.spacing;
+  if (!(fx >= -0.5f && fx <= h.dimX - 0.5f && fy >= -0.5f &&
+        fy <= h.dimY - 0.5f && fz >= -0.5f && fz <= h.dimZ - 0.5f)) {
+    return sample;
+  }
+
+  if (mode == ProbeInterpolation::Nearest) {
+    auto nearest = [](float f, uint32_t dim) {
+      return std::min(static_cast<uint32_t>(std::max(f + 0.5f, 0.0f)),
+                      dim - 1);
+    };
+    return GetProbe(
+        ProbeAt(nearest(fx, h.dimX), nearest(fy, h.dimY), nearest(fz, h.dimZ)));
+  }
+
+  // Lower corner and fraction per axis; a single-point axis has t = 0
+  auto corner = [](float f, uint32_t dim, uint32_t &i, float &t) {
+    f = std::clamp(f, 0.0f, static_cast<float>(dim - 1));
+    i = std::min(static_cast<uint32_t>(f), dim > 1 ? dim - 2 : 0);
+    t = f - static_cast<float>(i);
+  };
+  uint32_t x, y, z;
+  float tx, ty, tz;
+  corner(fx, h.dimX, x, tx);
+  corner(fy, h.dimY, y, ty);
+  corner(fz, h.dimZ, z, tz);
+
+  float weight = 0.0f, delayWeight = 0.0f, reverbWeight = 0.0f;
+  for (uint32_t c = 0; c < 8; ++c) {
+    const float w = (c & 1 ? tx : 1.0f - tx) * (c & 2 ? ty : 1.0f - ty) *
+                    (c & 4 ? tz : 1.0f - tz);
+    if (w <= 0.0f) {
+      continue;
+    }
+    const uint32_t probe =
+        ProbeAt(x + (c & 1), y + ((c >> 1) & 1), z + (c >> 2));
+    if (probe == kNoProbe) {
+      continue;
+    }
+    const AcousticProbeSample p = GetProbe(probe);
+    sample.reflectionGainLow += p.reflectionGainLow * w;
+    sample.reflectionGainMid += p.reflectionGainMid * w;
+    sample.reflectionGainHigh += p.reflectionGainHigh * w;
+    sample.earlyReflectionGain += p.earlyReflectionGain * w;
+    weight += w;
+    // Probes without reflections have no delay or reverb time to blend
+    if (p.earlyReflectionDelay > 0.0f) {
+      sample.earlyReflectionDelay += p.earlyReflectionDelay * w;
+      delayWeight += w;
+    }
+    if (p.lateReverbTime > 0.0f) {
+      sample.lateReverbTime += p.lateReverbTime * w;
+      reverbWeight += w;
+    }
+  }
+  if (weight <= 0.0f) {
+    return AcousticProbeSample{};
+  }
+
+  sample.valid = true;
+  sample.reflectionGainLow /= weight;
+  sample.reflectionGainMid /= weight;
+  sample.reflectionGainHigh /= weight;
+  sample.earlyReflectionGain /= weight;
+  if (delayWeight > 0.0f) {
+    sample.earlyReflectionDelay /= delayWeight;
+  }
+  if (reverbWeight > 0.0f) {
+    sample.lateReverbTime /= reverbWeight;
+  }
+  return sample;
+}
+
+} // namespace Orpheus
@@ -0,0 +1,229 @@
+#include "../include/AcousticScene.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <set>
+#include <unordered_map>
+
+namespace Orpheus {
+
+AcousticMeshID AcousticScene::AddMesh(const Vector3 *vertices,
+                                      size_t vertexCount,
+                                      const uint32_t *indices,
+                                      size_t indexCount,
+                                      AcousticMaterialID material,
+                                      float detailSize) {
+  if (indexCount % 3 != 0 ||
+      std::any_of(indices, indices + indexCount,
+                  [vertexCount](uint32_t i) { return i >= vertexCount; })) {
+    return kInvalidMesh;
+  }
+
+  Mesh mesh;
+  mesh.vertices.assign(vertices, vertices + vertexCount);
+  if (detailSize > 0.0f) {
+    Simplify(mesh, indices, indexCount, detailSize);
+  } else {
+    mesh.indices.assign(indices, indices + indexCount);
+  }
+  mesh.firstVertex = 0;
+  mesh.material = material;
+  mesh.alive = true;
+  const std::unique_lock<std::shared_mutex> lock(m_Mutex);
+  m_Meshes.push_back(std::move(mesh));
+  m_NeedsRebuild = true;
+  return static_cast<AcousticMeshID>(m_Meshes.size() - 1);
+}
+
+bool AcousticScene::UpdateMesh(AcousticMeshID mesh, const Vector3 *vertices,
+                               size_t vertexCount) {
+  if (mesh >= m_Meshes.size() || !m_Meshes[mesh].alive ||
+      m_Meshes[mesh].vertices.size() != vertexCount) {
+    return false;
+  }
+  const std::unique_lock<std::shared_mutex> lock(m_Mutex);
+  Mesh &m = m_Meshes[mesh];
+  std::copy(vertices, vertices + vertexCount, m.vertices.begin());
+  if (!m_NeedsRebuild) {
+    WriteVertices(m);
+    m_NeedsRefit = true;
+  }
+  return true;
+}
+
+void AcousticScene::SetMeshMaterial(AcousticMeshID mesh,
+                                    AcousticMaterialID material) {
+  const std::unique_lock<std::shared_mutex> lock(m_Mutex);
+  if (mesh < m_Meshes.size() && m_Meshes[mesh].material != material) {
+    m_Meshes[mesh].material = material;
+    ++m_Version;
+  }
+}
+
+void AcousticScene::RemoveMesh(AcousticMeshID mesh) {
+  if (mesh >= m_Meshes.size() || !m_Meshes[mesh].alive) {
+    return;
+  }
+  const std::unique_lock<std::shared_mutex> lock(m_Mutex);
+  Mesh &m = m_Meshes[mesh];
+  m.alive = false;
+  m.vertices = {};
+  m.cluster = {};
+  m.clusterSize = {};
+  m.indices = {};
+  m_NeedsRebuild = true;
+}
+
+void AcousticScene::Commit() {
+  const std::unique_lock<std::shared_mutex> lock(m_Mutex);
+  if (m_NeedsRebuild) {
+    m_Vertices.clear();
+    m_Indices.clear();
+    m_TriangleMesh.clear();
+    for (size_t id = 0; id < m_Meshes.size(); ++id) {
+      Mesh &mesh = m_Meshes[id];
+      if (!mesh.alive) {
+        continue;
+      }
+      mesh.firstVertex = static_cast<uint32_t>(m_Vertices.size());
+      m_Vertices.resize(m_Vertices.size() + (mesh.cluster.empty()
+                                                 ? mesh.vertices.size()
+                                                 : mesh.clusterSize.size()));
+      WriteVertices(mesh);
+      for (uint32_t index : mesh.indices) {
+        m_Indices.push_back(mesh.firstVertex + index);
+      }
+      m_TriangleMesh.insert(m_TriangleMesh.end(), mesh.indices.size() / 3,
+                            static_cast<AcousticMeshID>(id));
+    }
+    m_BVH.Build(m_Vertices.data(), m_Indices.data(), m_TriangleMesh.size());
+  } else if (m_NeedsRefit) {
+    m_BVH.Refit(m_Vertices.data(), m_Indices.data());
+  } else {
+    return;
+  }
+  ComputeNormals();
+  m_NeedsRebuild = false;
+  m_NeedsRefit = false;
+  ++m_Version;
+}
+
+void AcousticScene::Intersect(const AcousticRayPacket &rays,
+                              AcousticHitPacket &hits) const {
+  const std::shared_lock<std::shared_mutex> lock(m_Mutex);
+  for (size_t lane = 0; lane < rays.count; ++lane) {
+    if (!(rays.maxDistance[lane] > 0.0f)) {
+      continue;
+    }
+    BVHHit hit;
+    if (!m_BVH.IntersectClosest(
+            {rays.originX[lane], rays.originY[lane], rays.originZ[lane]},
+            {rays.directionX[lane], rays.directionY[lane],
+             rays.directionZ[lane]},
+            rays.maxDistance[lane], hit)) {
+      continue;
+    }
+
+    // Face the normal towards the incoming ray
+    const Vector3 &normal = m_Normals[hit.triangle];
+    const float side = hit.frontFacing ? 1.0f : -1.0f;
+    hits.hitMask |= 1u << lane;
+    hits.distance[lane] = hit.t;
+    hits.normalX[lane] = normal.x * side;
+    hits.normalY[lane] = normal.y * side;
+    hits.normalZ[lane] = normal.z * side;
+    hits.material[lane] = m_Meshes[m_TriangleMesh[hit.triangle]].material;
+  }
+}
+
+GeometryPacketCallback
+AcousticScene::MakeCallback(std::shared_ptr<const AcousticScene> scene) {
+  return [scene = std::move(scene)](const AcousticRayPacket &rays,
+                                    AcousticHitPacket &hits) {
+    scene->Intersect(rays, hits);
+  };
+}
+
+size_t AcousticScene::GetMeshCount() const {
+  return static_cast<size_t>(
+      std::count_if(m_Meshes.begin(), m_Meshes.end(),
+                    [](const Mesh &mesh) { return mesh.alive; }));
+}
+
+void AcousticScene::Simplify(Mesh &mesh, const uint32_t *indices,
+                             size_t indexCount, float detailSize) {
+  // One cluster per occupied grid cell
+  std::unordered_map<uint64_t, uint32_t> cells;
+  mesh.cluster.resize(mesh.vertices.size());
+  for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+    const Vector3 &v = mesh.vertices[i];
+    const auto cell = [detailSize](float c) {
+      return static_cast<uint64_t>(
+                 static_cast<int64_t>(std::floor(c / detailSize))) &
+             0x1FFFFFu;
+    };
+    const uint64_t key = cell(v.x) << 42 | cell(v.y) << 21 | cell(v.z);
+    const auto inserted =
+        cells.emplace(key, static_cast<uint32_t>(cells.size()));
+    mesh.cluster[i] = inserted.first->second;
+  }
+  mesh.clusterSize.assign(cells.size(), 0);
+  for (uint32_t cluster : mesh.cluster) {
+    ++mesh.clusterSize[cluster];
+  }
+
+  // Drop triangles that collapsed, and duplicates of either winding
+  std::set<std::array<uint32_t, 3>> seen;
+  for (size_t i = 0; i < indexCount; i += 3) {
+    const std::array<uint32_t, 3> tri = {mesh.cluster[indices[i]],
+                                         mesh.cluster[indices[i + 1]],
+                                         mesh.cluster[indices[i + 2]]};
+    std::array<uint32_t, 3> key = tri;
+    std::sort(key.begin(), key.end());
+    if (key[0] != key[1] && key[1] != key[2] && seen.insert(key).second) {
+      mesh.indices.insert(mesh.indices.end(), tri.begin(), tri.end());
+    }
+  }
+}
+
+void AcousticScene::WriteVertices(const Mesh &mesh) {
+  Vector3 *out = m_Vertices.data() + mesh.firstVertex;
+  if (mesh.cluster.empty()) {
+    std::copy(mesh.vertices.begin(), mesh.vertices.end(), out);
+    return;
+  }
+
+  // Each cluster sits at the mean of its vertices
+  std::fill_n(out, mesh.clusterSize.size(), Vector3{0.0f, 0.0f, 0.0f});
+  for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+    Vector3 &sum = out[mesh.cluster[i]];
+    sum.x += mesh.vertices[i].x;
+    sum.y += mesh.vertices[i].y;
+    sum.z += mesh.vertices[i].z;
+  }
+  for (size_t c = 0; c < mesh.clusterSize.size(); ++c) {
+    const float scale = 1.0f / static_cast<float>(mesh.clusterSize[c]);
+    out[c] = {out[c].x * scale, out[c].y * scale, out[c].z * scale};
+  }
+}
+
+void AcousticScene::ComputeNormals() {
+  m_Normals.resize(m_TriangleMesh.size());
+  for (size_t tri = 0; tri < m_Normals.size(); ++tri) {
+    const Vector3 &a = m_Vertices[m_Indices[3 * tri]];
+    const Vector3 &b = m_Vertices[m_Indices[3 * tri + 1]];
+    const Vector3 &c = m_Vertices[m_Indices[3 * tri + 2]];
+    const Vector3 e1{b.x - a.x, b.y - a.y, b.z - a.z};
+    const Vector3 e2{c.x - a.x, c.y - a.y, c.z - a.z};
+    Vector3 n{e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z,
+              e1.x * e2.y - e1.y * e2.x};
+    const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+    if (length > 0.0f) {
+      n = {n.x / length, n.y / length, n.z / length};
+    }
+    m_Normals[tri] = n;
+  }
+}
+
+} // namespace Orpheus
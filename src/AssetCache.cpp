@@ -0,0 +1,172 @@
+#include "../include/AssetCache.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace Orpheus {
+
+namespace {
+
+enum class AssetState { Queued, Loading, Ready, Failed };
+
+struct AssetEntry {
+  std::shared_ptr<void> asset;
+  AssetState state = AssetState::Queued;
+  uint32_t refs = 0;
+  bool stream = false;
+};
+
+} // namespace
+
+struct AssetCacheImpl {
+  AssetLoadFunction load;
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  std::unordered_map<std::string, AssetEntry> entries;
+  std::deque<std::string> queue;
+  size_t loading = 0;
+  bool stop = false;
+  std::thread worker;
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return stop || !queue.empty(); });
+      if (stop) {
+        return;
+      }
+      std::string path = std::move(queue.front());
+      queue.pop_front();
+
+      // Skip assets released (or already loaded) while queued
+      auto it = entries.find(path);
+      if (it == entries.end() || it->second.state != AssetState::Queued) {
+        NotifyIfIdle();
+        continue;
+      }
+      it->second.state = AssetState::Loading;
+      const bool stream = it->second.stream;
+      ++loading;
+
+      lock.unlock();
+      std::shared_ptr<void> asset = load(path, stream);
+      lock.lock();
+
+      it = entries.find(path);
+      if (it != entries.end() && (it->second.state == AssetState::Loading ||
+                                  it->second.state == AssetState::Queued)) {
+        it->second.state = asset ? AssetState::Ready : AssetState::Failed;
+        it->second.asset = std::move(asset);
+      }
+
+      // Destroy a discarded asset outside the lock
+      if (asset) {
+        lock.unlock();
+        asset.reset();
+        lock.lock();
+      }
+      --loading;
+      NotifyIfIdle();
+    }
+  }
+
+  void NotifyIfIdle() {
+    if (queue.empty() && loading == 0) {
+      idle.notify_all();
+    }
+  }
+};
+
+AssetCache::AssetCache(AssetLoadFunction load)
+    : m_Impl(std::make_unique<AssetCacheImpl>()) {
+  m_Impl->load = std::move(load);
+}
+
+AssetCache::~AssetCache() {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    m_Impl->stop = true;
+  }
+  m_Impl->wake.notify_all();
+  if (m_Impl->worker.joinable()) {
+    m_Impl->worker.join();
+  }
+}
+
+void AssetCache::Prefetch(const std::string &path, bool stream) {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    AssetEntry &entry = m_Impl->entries[path];
+    if (entry.refs++ > 0) {
+      return;
+    }
+    entry.stream = stream;
+    entry.state = AssetState::Queued;
+    m_Impl->queue.push_back(path);
+
+    // The loader thread starts with the first prefetch
+    if (!m_Impl->worker.joinable()) {
+      m_Impl->worker = std::thread([impl = m_Impl.get()] { impl->Run(); });
+    }
+  }
+  m_Impl->wake.notify_one();
+}
+
+void AssetCache::Release(const std::string &path) {
+  std::shared_ptr<void> evicted;
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    auto it = m_Impl->entries.find(path);
+    if (it == m_Impl->entries.end() || --it->second.refs > 0) {
+      return;
+    }
+    evicted = std::move(it->second.asset);
+    m_Impl->entries.erase(it);
+  }
+  // evicted is destroyed here, outside the lock
+}
+
+std::shared_ptr<void> AssetCache::Find(const std::string &path) const {
+  std::lock_guard<std::mutex> lock(m_Impl->mutex);
+  auto it = m_Impl->entries.find(path);
+  if (it == m_Impl->entries.end() || it->second.state != AssetState::Ready) {
+    return nullptr;
+  }
+  return it->second.asset;
+}
+
+bool AssetCache::IsResident(const std::string &path) const {
+  return Find(path) != nullptr;
+}
+
+size_t AssetCache::GetResidentCount() const {
+  std::lock_guard<std::mutex> lock(m_Impl->mutex);
+  size_t count = 0;
+  for (const auto &[path, entry] : m_Impl->entries) {
+    count += entry.state == AssetState::Ready;
+  }
+  return count;
+}
+
+size_t AssetCache::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(m_Impl->mutex);
+  size_t count = 0;
+  for (const auto &[path, entry] : m_Impl->entries) {
+    count += entry.state == AssetState::Queued ||
+             entry.state == AssetState::Loading;
+  }
+  return count;
+}
+
+bool AssetCache::WaitIdle(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(m_Impl->mutex);
+  return m_Impl->idle.wait_for(lock, timeout, [this] {
+    return m_Impl->queue.empty() && m_Impl->loading == 0;
+  });
+}
+
+} // namespace Orpheus
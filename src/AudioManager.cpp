@@ -10,10 +10,14 @@
 #include "../include/Parameter.h"
 #include "../include/ReverbZone.h"
 #include "../include/Snapshot.h"
+#include "../include/SnapshotBlender.h"
 #include "../include/VoicePool.h"
+#include "../include/ZoneGrid.h"
+#include "../include/ZonePool.h"
 #include "HDRFilter_Internal.h"
 
 #include <algorithm>
+#include <cmath>
 #include <mutex>
 #include <random>
 #include <unordered_map>
@@ -23,6 +27,56 @@ namespace Orpheus {
 // Thread-local random engine for randomization
 static thread_local std::mt19937 s_RandomEngine{std::random_device{}()};
 
+namespace {
+
+// Sorted, unique indices of zones overlapping any point, plus the zones
+// that still held state after the previous update
+void GatherZones(const ZoneGrid &grid, ZoneLayer layer, const Vector3 *points,
+                 size_t pointCount, const std::vector<uint32_t> &live,
+                 std::vector<uint32_t> &out) {
+  out.assign(live.begin(), live.end());
+  for (size_t i = 0; i < pointCount; ++i) {
+    grid.QueryPoint(points[i], layer,
+                    [&out](uint32_t index) { out.push_back(index); });
+  }
+  std::sort(out.begin(), out.end());
+  out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// Remove zones by name, keeping broadphase data and live indices in step
+template <typename Zone>
+void RemoveNamedZones(std::vector<std::shared_ptr<Zone>> &zones,
+                      std::vector<uint32_t> &proxies,
+                      std::vector<uint32_t> &live, ZoneGrid &grid,
+                      const std::string &name) {
+  constexpr uint32_t kRemoved = UINT32_MAX;
+  std::vector<uint32_t> remap(zones.size(), kRemoved);
+  size_t kept = 0;
+  for (size_t i = 0; i < zones.size(); ++i) {
+    if (zones[i]->GetName() == name) {
+      grid.Remove(proxies[i]);
+      continue;
+    }
+    remap[i] = static_cast<uint32_t>(kept);
+    zones[kept] = std::move(zones[i]);
+    proxies[kept] = proxies[i];
+    grid.SetUserData(proxies[kept], static_cast<uint32_t>(kept));
+    ++kept;
+  }
+  zones.resize(kept);
+  proxies.resize(kept);
+
+  size_t liveKept = 0;
+  for (uint32_t index : live) {
+    if (remap[index] != kRemoved) {
+      live[liveKept++] = remap[index];
+    }
+  }
+  live.resize(liveKept);
+}
+
+} // namespace
+
 // =============================================================================
 // AudioManager::Impl - Private Implementation
 // =============================================================================
@@ -34,7 +88,7 @@ public:
   AudioEvent event;
   VoicePool voicePool;
   std::unordered_map<std::string, std::shared_ptr<Bus>> buses;
-  std::vector<std::shared_ptr<AudioZone>> zones;
+  ZonePool zones;
   std::unordered_map<ListenerID, Listener> listeners;
   ListenerID nextListenerID = 1;
   std::unordered_map<std::string, Parameter> parameters;
@@ -44,13 +98,40 @@ public:
 
   std::vector<std::shared_ptr<MixZone>> mixZones;
   std::string activeMixZone;
+  SnapshotBlender snapshotBlender; ///< One layer per active mix zone
+  std::unordered_map<std::string, std::shared_ptr<const CompiledSnapshot>>
+      compiledSnapshots; ///< Lazily compiled, dropped on edits
+  std::vector<Bus *> busByIndex;
   ZoneEnterCallback zoneEnterCallback;
   ZoneExitCallback zoneExitCallback;
 
   std::unordered_map<std::string, std::shared_ptr<ReverbBus>> reverbBuses;
+  std::vector<ReverbBus *> reverbByIndex;
+  std::vector<float> reverbZoneWet; ///< Wet level at full zone influence
+  std::vector<float> reverbIssuedWet; ///< Last wet fade sent per reverb bus
+  ReverbInfluence reverbInfluence;
   std::vector<std::shared_ptr<ReverbZone>> reverbZones;
 
+  // Broadphase shared by all zone types; proxies are parallel to the zone
+  // vectors. "live" zones were active (or just exited) last update and are
+  // re-evaluated even if the broadphase no longer reports them.
+  ZoneGrid zoneGrid;
+  std::vector<uint32_t> zoneProxies;
+  std::vector<uint32_t> mixZoneProxies;
+  std::vector<uint32_t> reverbZoneProxies;
+  std::vector<uint32_t> liveZones;
+  std::vector<uint32_t> liveMixZones;
+  std::vector<uint32_t> liveReverbZones;
+  std::vector<uint32_t> zoneCandidates;
+  std::vector<Vector3> listenerPositions;
+  float zonePrefetchRadius = ZonePool::kDefaultPrefetchRadius;
+
   OcclusionProcessor occlusionProcessor;
+  std::vector<Voice *> occlusionVoices;
+  std::shared_ptr<OcclusionScene> occlusionScene;
+  std::vector<OcclusionRayHit> occlusionSceneHits;
+  std::shared_ptr<PropagationField> occlusionField;
+  PortalGraph portalGraph;
 
   Ducker ducker;
 
@@ -71,6 +152,9 @@ public:
   // Convolution reverbs
   std::unordered_map<std::string, std::unique_ptr<ConvolutionReverb>>
       convolutionReverbs;
+  // Declared after the reverbs so they are destroyed first
+  std::unordered_map<std::string, std::unique_ptr<ImpulseResponseUpdater>>
+      impulseResponseUpdaters;
 
   // HDR Audio
   HDRMixer hdrMixer;
@@ -78,6 +162,10 @@ public:
 
   // Ray-traced Acoustics
   AcousticRayTracer rayTracer;
+  std::shared_ptr<AcousticScene> acousticScene;
+  std::shared_ptr<const AcousticProbeGrid> acousticProbes;
+  // Declared after the tracer and scene so its thread stops first
+  PropagationProcessor propagationProcessor;
 
   NativeEngineHandle GetEngineHandle() { return NativeEngineHandle{&engine}; }
 
@@ -91,6 +179,120 @@ public:
     musicManager = std::make_unique<MusicManager>(engineHandle, bank);
     hdrFilter = std::make_unique<HDRFilter>(&hdrMixer);
   }
+
+  // Resolve a snapshot's bus names once; applying and blending it then
+  // only touches dense arrays
+  std::shared_ptr<const CompiledSnapshot>
+  GetCompiledSnapshot(const std::string &name) {
+    auto cached = compiledSnapshots.find(name);
+    if (cached != compiledSnapshots.end()) {
+      return cached->second;
+    }
+    auto it = snapshots.find(name);
+    auto compiled = std::make_shared<const CompiledSnapshot>(
+        CompiledSnapshot::Compile(
+            it != snapshots.end() ? it->second : Snapshot(),
+            busByIndex.size(),
+            [this](const std::string &bus) {
+              auto b = buses.find(bus);
+              return b != buses.end() ? b->second->GetIndex()
+                                      : CompiledSnapshot::kInvalidID;
+            },
+            reverbByIndex.size(),
+            [this](const std::string &reverb) {
+              auto r = reverbBuses.find(reverb);
+              return r != reverbBuses.end() ? r->second->GetIndex()
+                                            : CompiledSnapshot::kInvalidID;
+            }));
+    compiledSnapshots[name] = compiled;
+    return compiled;
+  }
+
+  // Drop compiled snapshots after an edit (or all of them after a bus is
+  // created) and refresh the mix zone layers that use them
+  void InvalidateSnapshots(const std::string *name) {
+    if (name) {
+      compiledSnapshots.erase(*name);
+    } else {
+      compiledSnapshots.clear();
+    }
+    for (const auto &zone : mixZones) {
+      if ((!name || zone->GetSnapshotName() == *name) &&
+          snapshotBlender.HasLayer(zone.get())) {
+        snapshotBlender.SetLayer(
+            zone.get(), GetCompiledSnapshot(zone->GetSnapshotName()),
+            zone->GetPriority(), zone->GetFadeInTime(),
+            zone->GetFadeOutTime());
+      }
+    }
+  }
+
+  // Snapshot wet levels set the reverb zone ceiling; the other parameters
+  // go straight to the reverb
+  void ApplyReverbState(ReverbBusID id, const ReverbBusState &state,
+                        float fadeSeconds) {
+    reverbZoneWet[id] = state.wet;
+    ReverbBus *reverb = reverbByIndex[id];
+    reverb->SetRoomSize(state.roomSize, fadeSeconds);
+    reverb->SetDamp(state.damp, fadeSeconds);
+    reverb->SetWidth(state.width, fadeSeconds);
+  }
+
+  Status AddReverbBus(const std::shared_ptr<ReverbBus> &reverbBus) {
+    if (!reverbBus->Init(GetEngineHandle())) {
+      return Error(ErrorCode::ReverbBusInitFailed,
+                   "Failed to initialize reverb bus: " + reverbBus->GetName());
+    }
+    reverbBuses[reverbBus->GetName()] = reverbBus;
+    reverbByIndex.push_back(reverbBus.get());
+    reverbZoneWet.push_back(kReverbZoneWet);
+    reverbIssuedWet.push_back(reverbBus->GetWet());
+    for (const auto &zone : reverbZones) {
+      if (zone->GetReverbBusName() == reverbBus->GetName()) {
+        zone->SetReverbBusID(reverbBus->GetIndex());
+      }
+    }
+    snapshotBlender.SetReverbBase(
+        reverbBus->GetIndex(),
+        ReverbBusState{kReverbZoneWet, reverbBus->GetRoomSize(),
+                       reverbBus->GetDamp(), reverbBus->GetWidth()});
+    InvalidateSnapshots(nullptr);
+    return Ok();
+  }
+
+  // Reverb wet level when fully inside a reverb zone, unless a snapshot
+  // sets it
+  static constexpr float kReverbZoneWet = 0.8f;
+
+  // Smallest wet level change worth a fade command on the mixer
+  static constexpr float kReverbWetThreshold = 0.005f;
+};
+
+// Direct engine interface used by the zone pool (see ZonePool::Update)
+struct AudioManager::ZoneBackend {
+  AudioManager &manager;
+
+  AudioHandle Play(const std::string &eventName) {
+    return manager.PlayEventDirect(eventName).ValueOr(0);
+  }
+  bool IsValid(AudioHandle h) {
+    return manager.pImpl->engine.isValidVoiceHandle(h);
+  }
+  void SetVolume(AudioHandle h, float volume) {
+    manager.pImpl->engine.setVolume(h, volume);
+  }
+  void Stop(AudioHandle h) { manager.pImpl->engine.stop(h); }
+  void ApplySnapshot(const std::string &snapshotName, float fadeTime) {
+    manager.ApplySnapshot(snapshotName, fadeTime);
+  }
+  void RevertSnapshot(float fadeTime) { manager.ResetBusVolumes(fadeTime); }
+  void SetResident(const std::string &eventName, bool resident) {
+    if (resident) {
+      manager.pImpl->event.Prefetch(eventName);
+    } else {
+      manager.pImpl->event.ReleasePrefetch(eventName);
+    }
+  }
 };
 
 // =============================================================================
@@ -116,16 +318,24 @@ Status AudioManager::Init() {
   // Initialize subsystems with valid engine handle
   pImpl->InitSubsystems();
 
-  // Create default buses
-  CreateBus("Master");
-  CreateBus("SFX");
-  CreateBus("Music");
+  // Create default buses; Init fails if any of them is missing
+  Status status = CreateBus("Master", "");
+  if (status.IsOk()) {
+    status = CreateBus("SFX");
+  }
+  if (status.IsOk()) {
+    status = CreateBus("Music");
+  }
+  if (status.IsError()) {
+    ORPHEUS_ERROR("Default bus creation failed: "
+                  << status.GetError().Message());
+    return status;
+  }
 
-  // Set up bus router for AudioEvent
-  pImpl->event.SetBusRouter([this](AudioHandle h, const std::string &busName) {
-    if (pImpl->buses.count(busName)) {
-      pImpl->buses[busName]->AddHandle(pImpl->GetEngineHandle(), h);
-    }
+  // Voices are played straight into their bus's mixer
+  pImpl->event.SetBusResolver([this](const std::string &busName) -> Bus * {
+    auto it = pImpl->buses.find(busName);
+    return it != pImpl->buses.end() ? it->second.get() : nullptr;
   });
 
   // Attach HDR filter to engine for loudness metering
@@ -147,56 +357,26 @@ void AudioManager::Update(float dt) {
 
   // Get first listener position for voice pool and zones
   Vector3 listenerPos{0, 0, 0};
+  pImpl->listenerPositions.clear();
   for (auto &[id, listener] : pImpl->listeners) {
     if (!listener.active)
       continue;
     listenerPos = {listener.posX, listener.posY, listener.posZ};
+    pImpl->listenerPositions.push_back(listenerPos);
     pImpl->engine.set3dListenerParameters(
         listener.posX, listener.posY, listener.posZ, listener.velX,
         listener.velY, listener.velZ, listener.forwardX, listener.forwardY,
         listener.forwardZ, listener.upX, listener.upY, listener.upZ);
-    // Update zones with optional crossfading
-    if (pImpl->zoneCrossfadeEnabled) {
-      // Collect volumes for all zones
-      std::vector<std::pair<AudioZone *, float>> activeZones;
-      float totalVolume = 0.0f;
-
-      for (auto &zone : pImpl->zones) {
-        float vol = zone->GetComputedVolume(listenerPos);
-        if (vol > 0.0f) {
-          activeZones.push_back({zone.get(), vol});
-          totalVolume += vol;
-        }
-      }
-
-      // Normalize if total exceeds 1.0
-      float normalizer = (totalVolume > 1.0f) ? 1.0f / totalVolume : 1.0f;
-
-      // Apply normalized volumes
-      for (auto &[zone, vol] : activeZones) {
-        zone->EnsurePlaying();
-        zone->ApplyVolume(vol * normalizer);
-      }
-
-      // Stop zones that are no longer active
-      for (auto &zone : pImpl->zones) {
-        float vol = zone->GetComputedVolume(listenerPos);
-        if (vol <= 0.0f) {
-          zone->StopPlaying();
-        }
-      }
-    } else {
-      // Original behavior: independent zone volumes
-      for (auto &zone : pImpl->zones) {
-        zone->Update(listenerPos);
-      }
-    }
   }
 
+  // Update zones near any listener (optionally crossfaded)
+  UpdateAudioZones();
+
   // Update voice pool (virtualization/promotion)
   pImpl->voicePool.Update(dt, listenerPos);
 
   // Process voice state changes
+  pImpl->occlusionVoices.clear();
   for (size_t i = 0; i < pImpl->voicePool.GetVoiceCount(); ++i) {
     Voice *voice = pImpl->voicePool.GetVoiceAt(i);
     if (!voice || voice->IsStopped())
@@ -246,6 +426,8 @@ void AudioManager::Update(float dt) {
     else if (voice->IsVirtual() && voice->handle != 0) {
       pImpl->engine.stop(voice->handle);
       voice->handle = 0;
+      voice->occlusionAge = -1.0f; // Re-query as soon as it is real again
+      voice->propagationAge = -1.0f;
     }
     // Handle finished voices (Real, handle was valid, now invalid)
     else if (voice->IsReal() && voice->handle != 0 &&
@@ -305,10 +487,9 @@ void AudioManager::Update(float dt) {
       }
     }
 
-    // Update occlusion for real voices
     if (voice->IsReal() && voice->handle != 0) {
-      pImpl->occlusionProcessor.Update(*voice, listenerPos, dt);
-      pImpl->occlusionProcessor.ApplyDSP(pImpl->GetEngineHandle(), *voice);
+      // Occlusion is scheduled across all real voices after this loop
+      pImpl->occlusionVoices.push_back(voice);
 
       // Calculate and apply Doppler effect
       if (pImpl->dopplerEnabled) {
@@ -371,23 +552,47 @@ void AudioManager::Update(float dt) {
     }
   }
 
+  // Geometry edits wait while propagation is traced in the background
+  if (pImpl->acousticScene && !pImpl->propagationProcessor.IsBusy()) {
+    pImpl->acousticScene->Commit();
+  }
+
+  // Update occlusion for real voices within the per-frame query budget
+  if (pImpl->occlusionScene) {
+    pImpl->occlusionScene->Commit();
+    pImpl->occlusionProcessor.GetCache().SetGeometryVersion(
+        pImpl->occlusionScene->GetVersion());
+  }
+  if (pImpl->occlusionField) {
+    pImpl->occlusionField->Update(listenerPos);
+  }
+  if (pImpl->portalGraph.GetRoomCount() > 0) {
+    pImpl->portalGraph.Update(listenerPos);
+  }
+  pImpl->occlusionProcessor.Update(pImpl->occlusionVoices.data(),
+                                   pImpl->occlusionVoices.size(), listenerPos,
+                                   dt);
+
+  // Ray-traced propagation within the per-frame ray budget; results of the
+  // batch traced since the last update are staged with occlusion
+  pImpl->propagationProcessor.Update(
+      pImpl->occlusionVoices.data(), pImpl->occlusionVoices.size(),
+      listenerPos, pImpl->rayTracer, pImpl->acousticProbes.get(), dt);
+  for (Voice *voice : pImpl->occlusionVoices) {
+    pImpl->occlusionProcessor.ApplyDSP(pImpl->GetEngineHandle(), *voice);
+  }
+
   // Update mix zones and apply highest priority active snapshot
   UpdateMixZones(listenerPos);
 
   // Update reverb zones (calculate zone influence on reverb buses)
   UpdateReverbZones(listenerPos);
 
-  // Update ducking (sidechaining)
-  pImpl->ducker.Update(dt, pImpl->buses, [this](const std::string &busName) {
-    // Check if any voices are active on this bus
-    // For now, check if bus has any active handles
+  // Publish ducking rule changes; the gain itself is applied in the mixer
+  pImpl->ducker.Update([this](const std::string &busName) {
     auto it = pImpl->buses.find(busName);
-    if (it == pImpl->buses.end()) {
-      return false;
-    }
-    // Check if engine has any active voices for this bus
-    // This is a simplified check - in practice you'd track voice count per bus
-    return pImpl->engine.getActiveVoiceCount() > 0;
+    return it != pImpl->buses.end() ? it->second->GetIndex()
+                                    : Ducker::kInvalidBus;
   });
 
   // Update interactive music
@@ -557,86 +762,65 @@ Parameter *AudioManager::GetParam(const std::string &name) {
 
 void AudioManager::AddAudioZone(const std::string &eventName,
                                 const Vector3 &pos, float inner, float outer) {
-  pImpl->zones.emplace_back(std::make_shared<AudioZone>(
-      eventName, pos, inner, outer,
-      [this](const std::string &name) {
-        auto result = this->PlayEventDirect(name);
-        return result.ValueOr(0);
-      },
-      [this](AudioHandle h, float v) { pImpl->engine.setVolume(h, v); },
-      [this](AudioHandle h) { pImpl->engine.stop(h); },
-      [this](AudioHandle h) { return pImpl->engine.isValidVoiceHandle(h); }));
+  AddShapedZone(eventName, ZoneGeometry::Sphere(pos, inner, outer), "", 0.5f,
+                0.5f);
 }
 
 void AudioManager::AddAudioZone(const std::string &eventName,
                                 const Vector3 &pos, float inner, float outer,
                                 const std::string &snapshotName, float fadeIn,
                                 float fadeOut) {
-  pImpl->zones.emplace_back(std::make_shared<AudioZone>(
-      eventName, pos, inner, outer,
-      [this](const std::string &name) {
-        auto result = this->PlayEventDirect(name);
-        return result.ValueOr(0);
-      },
-      [this](AudioHandle h, float v) { pImpl->engine.setVolume(h, v); },
-      [this](AudioHandle h) { pImpl->engine.stop(h); },
-      [this](AudioHandle h) { return pImpl->engine.isValidVoiceHandle(h); },
-      snapshotName,
-      [this](const std::string &snap, float fade) {
-        this->ApplySnapshot(snap, fade);
-      },
-      [this](float fade) { this->ResetBusVolumes(fade); }, fadeIn, fadeOut));
+  AddShapedZone(eventName, ZoneGeometry::Sphere(pos, inner, outer),
+                snapshotName, fadeIn, fadeOut);
 }
 
 void AudioManager::AddBoxZone(const std::string &eventName, const Vector3 &min,
                               const Vector3 &max, float fadeDistance) {
-  // Create a sphere zone at the center with appropriate radii
-  // The center is the midpoint of the box
-  Vector3 center = {(min.x + max.x) / 2.0f, (min.y + max.y) / 2.0f,
-                    (min.z + max.z) / 2.0f};
-
-  // Calculate half-diagonal as the outer radius
-  float dx = (max.x - min.x) / 2.0f;
-  float dy = (max.y - min.y) / 2.0f;
-  float dz = (max.z - min.z) / 2.0f;
-  float innerRadius = std::sqrt(dx * dx + dy * dy + dz * dz);
-  float outerRadius = innerRadius + fadeDistance;
-
-  // For now, use sphere approximation
-  // TODO: Implement proper box zone with BoxShape
-  AddAudioZone(eventName, center, innerRadius, outerRadius);
+  AddShapedZone(eventName, ZoneGeometry::Box(min, max, fadeDistance), "",
+                0.5f, 0.5f);
 }
 
 void AudioManager::AddPolygonZone(const std::string &eventName,
                                   const std::vector<Vector2> &points,
                                   float minY, float maxY, float fadeDistance) {
-  // Calculate centroid of polygon
-  float cx = 0.0f, cz = 0.0f;
-  for (const auto &p : points) {
-    cx += p.x;
-    cz += p.y; // Note: Vector2.y is used for z-axis in 2D polygon
-  }
-  if (!points.empty()) {
-    cx /= static_cast<float>(points.size());
-    cz /= static_cast<float>(points.size());
-  }
-
-  // Calculate maximum distance from centroid to any vertex
-  float maxDist = 0.0f;
-  for (const auto &p : points) {
-    float dx = p.x - cx;
-    float dz = p.y - cz;
-    float dist = std::sqrt(dx * dx + dz * dz);
-    maxDist = (std::max)(maxDist, dist);
+  AddShapedZone(eventName,
+                ZoneGeometry::Polygon(points, minY, maxY, fadeDistance), "",
+                0.5f, 0.5f);
+}
+
+void AudioManager::AddShapedZone(const std::string &eventName,
+                                 const ZoneGeometry &geometry,
+                                 const std::string &snapshotName,
+                                 float fadeIn, float fadeOut) {
+  const uint32_t zone =
+      pImpl->zones.Add(eventName, geometry, pImpl->zonePrefetchRadius,
+                       snapshotName, fadeIn, fadeOut);
+  Vector3 min, max;
+  pImpl->zones.GetBounds(zone, min, max);
+  pImpl->zoneProxies.push_back(
+      pImpl->zoneGrid.Insert(min, max, ZoneLayer::Audio, zone));
+}
+
+void AudioManager::SetZonePrefetchRadius(const std::string &eventName,
+                                         float radius) {
+  const uint32_t zone = pImpl->zones.Find(eventName);
+  if (zone == ZonePool::kInvalidZone) {
+    return;
   }
+  // Drops any current residency; the next Update re-acquires it
+  ZoneBackend backend{*this};
+  pImpl->zones.SetPrefetchRadius(zone, radius, backend);
+  Vector3 min, max;
+  pImpl->zones.GetBounds(zone, min, max);
+  pImpl->zoneGrid.Update(pImpl->zoneProxies[zone], min, max);
+}
 
-  Vector3 center = {cx, (minY + maxY) / 2.0f, cz};
-  float innerRadius = maxDist;
-  float outerRadius = maxDist + fadeDistance;
+void AudioManager::SetDefaultZonePrefetchRadius(float radius) {
+  pImpl->zonePrefetchRadius = radius > 0.0f ? radius : 0.0f;
+}
 
-  // For now, use sphere approximation
-  // TODO: Implement proper polygon zone with PolygonShape
-  AddAudioZone(eventName, center, innerRadius, outerRadius);
+bool AudioManager::IsEventResident(const std::string &eventName) const {
+  return pImpl->event.IsResident(eventName);
 }
 
 ListenerID AudioManager::CreateListener() {
@@ -686,8 +870,34 @@ void AudioManager::SetListenerOrientation(ListenerID id, const Vector3 &forward,
   }
 }
 
-void AudioManager::CreateBus(const std::string &name) {
-  pImpl->buses[name] = std::make_shared<Bus>(name);
+Status AudioManager::CreateBus(const std::string &name,
+                               const std::string &parent) {
+  if (pImpl->buses.count(name) > 0) {
+    return Error(ErrorCode::BusAlreadyExists, "Bus already exists: " + name);
+  }
+
+  Bus *parentBus = nullptr;
+  if (!parent.empty()) {
+    auto it = pImpl->buses.find(parent);
+    if (it == pImpl->buses.end()) {
+      return Error(ErrorCode::BusNotFound, "Parent bus not found: " + parent);
+    }
+    parentBus = it->second.get();
+  }
+
+  // Buses past Ducker::kMaxBuses work but cannot take part in ducking
+  const auto index = static_cast<uint32_t>(pImpl->buses.size());
+  auto bus = std::make_shared<Bus>(name, index);
+  if (!bus->Init(pImpl->GetEngineHandle(), parentBus, &pImpl->ducker)) {
+    return Error(ErrorCode::NotInitialized,
+                 "Failed to start bus (is the engine initialized?): " + name);
+  }
+
+  pImpl->buses[name] = bus;
+  pImpl->busByIndex.push_back(bus.get());
+  pImpl->ducker.Invalidate();
+  pImpl->InvalidateSnapshots(nullptr);
+  return Ok();
 }
 
 Result<std::shared_ptr<Bus>> AudioManager::GetBus(const std::string &name) {
@@ -698,24 +908,43 @@ Result<std::shared_ptr<Bus>> AudioManager::GetBus(const std::string &name) {
   return it->second;
 }
 
+Result<BusID> AudioManager::GetBusID(const std::string &name) const {
+  auto it = pImpl->buses.find(name);
+  if (it == pImpl->buses.end()) {
+    return Error(ErrorCode::BusNotFound, "Bus not found: " + name);
+  }
+  return it->second->GetIndex();
+}
+
 void AudioManager::CreateSnapshot(const std::string &name) {
   pImpl->snapshots[name] = Snapshot();
+  pImpl->InvalidateSnapshots(&name);
 }
 
 void AudioManager::SetSnapshotBusVolume(const std::string &snap,
                                         const std::string &bus, float volume) {
   pImpl->snapshots[snap].SetBusState(bus, BusState{volume});
+  pImpl->InvalidateSnapshots(&snap);
 }
 
 Status AudioManager::ApplySnapshot(const std::string &name, float fadeSeconds) {
-  auto it = pImpl->snapshots.find(name);
-  if (it == pImpl->snapshots.end()) {
+  if (pImpl->snapshots.count(name) == 0) {
     return Error(ErrorCode::SnapshotNotFound, "Snapshot not found: " + name);
   }
-  const auto &states = it->second.GetStates();
-  for (const auto &[busName, state] : states) {
-    if (pImpl->buses.count(busName))
-      pImpl->buses[busName]->SetTargetVolume(state.volume, fadeSeconds);
+  const CompiledSnapshot &snap = *pImpl->GetCompiledSnapshot(name);
+  for (size_t i = 0; i < snap.volume.size(); ++i) {
+    if (snap.volumeMask[i] != 0.0f) {
+      pImpl->busByIndex[i]->SetTargetVolume(snap.volume[i], fadeSeconds);
+    }
+  }
+  for (size_t i = 0; i < snap.reverbMask.size(); ++i) {
+    if (snap.reverbMask[i] != 0.0f) {
+      pImpl->ApplyReverbState(
+          static_cast<ReverbBusID>(i),
+          ReverbBusState{snap.wet[i], snap.roomSize[i], snap.damp[i],
+                         snap.width[i]},
+          fadeSeconds);
+    }
   }
   return Ok();
 }
@@ -770,15 +999,32 @@ void AudioManager::AddMixZone(const std::string &name,
                               const std::string &snapshotName,
                               const Vector3 &pos, float inner, float outer,
                               uint8_t priority, float fadeIn, float fadeOut) {
+  AddMixZone(name, snapshotName, ZoneGeometry::Sphere(pos, inner, outer),
+             priority, fadeIn, fadeOut);
+}
+
+void AudioManager::AddMixZone(const std::string &name,
+                              const std::string &snapshotName,
+                              const ZoneGeometry &geometry, uint8_t priority,
+                              float fadeIn, float fadeOut) {
+  Vector3 min, max;
+  geometry.GetBounds(min, max);
+  pImpl->mixZoneProxies.push_back(
+      pImpl->zoneGrid.Insert(min, max, ZoneLayer::Mix,
+                             static_cast<uint32_t>(pImpl->mixZones.size())));
   pImpl->mixZones.emplace_back(std::make_shared<MixZone>(
-      name, snapshotName, pos, inner, outer, priority, fadeIn, fadeOut));
+      name, snapshotName, geometry, priority, fadeIn, fadeOut));
 }
 
 void AudioManager::RemoveMixZone(const std::string &name) {
-  pImpl->mixZones.erase(
-      std::remove_if(pImpl->mixZones.begin(), pImpl->mixZones.end(),
-                     [&name](const auto &z) { return z->GetName() == name; }),
-      pImpl->mixZones.end());
+  // Blended-in buses fade back on the next Update
+  for (const auto &zone : pImpl->mixZones) {
+    if (zone->GetName() == name) {
+      pImpl->snapshotBlender.RemoveLayer(zone.get());
+    }
+  }
+  RemoveNamedZones(pImpl->mixZones, pImpl->mixZoneProxies, pImpl->liveMixZones,
+                   pImpl->zoneGrid, name);
 }
 
 void AudioManager::SetZoneEnterCallback(ZoneEnterCallback cb) {
@@ -804,16 +1050,10 @@ Status AudioManager::CreateReverbBus(const std::string &name, float roomSize,
                  "Reverb bus already exists: " + name);
   }
 
-  auto reverbBus = std::make_shared<ReverbBus>(name);
+  auto reverbBus = std::make_shared<ReverbBus>(
+      name, static_cast<ReverbBusID>(pImpl->reverbByIndex.size()));
   reverbBus->SetParams(wet, roomSize, damp, width);
-
-  if (!reverbBus->Init(pImpl->GetEngineHandle())) {
-    return Error(ErrorCode::ReverbBusInitFailed,
-                 "Failed to initialize reverb bus: " + name);
-  }
-
-  pImpl->reverbBuses[name] = reverbBus;
-  return Ok();
+  return pImpl->AddReverbBus(reverbBus);
 }
 
 Status AudioManager::CreateReverbBus(const std::string &name,
@@ -823,16 +1063,10 @@ Status AudioManager::CreateReverbBus(const std::string &name,
                  "Reverb bus already exists: " + name);
   }
 
-  auto reverbBus = std::make_shared<ReverbBus>(name);
+  auto reverbBus = std::make_shared<ReverbBus>(
+      name, static_cast<ReverbBusID>(pImpl->reverbByIndex.size()));
   reverbBus->ApplyPreset(preset);
-
-  if (!reverbBus->Init(pImpl->GetEngineHandle())) {
-    return Error(ErrorCode::ReverbBusInitFailed,
-                 "Failed to initialize reverb bus: " + name);
-  }
-
-  pImpl->reverbBuses[name] = reverbBus;
-  return Ok();
+  return pImpl->AddReverbBus(reverbBus);
 }
 
 Result<std::shared_ptr<ReverbBus>>
@@ -844,6 +1078,15 @@ AudioManager::GetReverbBus(const std::string &name) {
   return it->second;
 }
 
+Result<ReverbBusID>
+AudioManager::GetReverbBusID(const std::string &name) const {
+  auto it = pImpl->reverbBuses.find(name);
+  if (it == pImpl->reverbBuses.end()) {
+    return Error(ErrorCode::ReverbBusNotFound, "Reverb bus not found: " + name);
+  }
+  return it->second->GetIndex();
+}
+
 void AudioManager::SetReverbParams(const std::string &name, float wet,
                                    float roomSize, float damp, float fadeTime) {
   auto busResult = GetReverbBus(name);
@@ -859,15 +1102,31 @@ void AudioManager::AddReverbZone(const std::string &name,
                                  const std::string &reverbBusName,
                                  const Vector3 &pos, float inner, float outer,
                                  uint8_t priority) {
-  pImpl->reverbZones.emplace_back(std::make_shared<ReverbZone>(
-      name, reverbBusName, pos, inner, outer, priority));
+  AddReverbZone(name, reverbBusName, ZoneGeometry::Sphere(pos, inner, outer),
+                priority);
+}
+
+void AudioManager::AddReverbZone(const std::string &name,
+                                 const std::string &reverbBusName,
+                                 const ZoneGeometry &geometry,
+                                 uint8_t priority) {
+  Vector3 min, max;
+  geometry.GetBounds(min, max);
+  pImpl->reverbZoneProxies.push_back(pImpl->zoneGrid.Insert(
+      min, max, ZoneLayer::Reverb,
+      static_cast<uint32_t>(pImpl->reverbZones.size())));
+  auto zone =
+      std::make_shared<ReverbZone>(name, reverbBusName, geometry, priority);
+  auto reverb = pImpl->reverbBuses.find(reverbBusName);
+  if (reverb != pImpl->reverbBuses.end()) {
+    zone->SetReverbBusID(reverb->second->GetIndex());
+  }
+  pImpl->reverbZones.push_back(std::move(zone));
 }
 
 void AudioManager::RemoveReverbZone(const std::string &name) {
-  pImpl->reverbZones.erase(
-      std::remove_if(pImpl->reverbZones.begin(), pImpl->reverbZones.end(),
-                     [&name](const auto &z) { return z->GetName() == name; }),
-      pImpl->reverbZones.end());
+  RemoveNamedZones(pImpl->reverbZones, pImpl->reverbZoneProxies,
+                   pImpl->liveReverbZones, pImpl->zoneGrid, name);
 }
 
 void AudioManager::SetSnapshotReverbParams(const std::string &snapshotName,
@@ -876,6 +1135,7 @@ void AudioManager::SetSnapshotReverbParams(const std::string &snapshotName,
                                            float damp, float width) {
   pImpl->snapshots[snapshotName].SetReverbState(
       reverbBusName, ReverbBusState{wet, roomSize, damp, width});
+  pImpl->InvalidateSnapshots(&snapshotName);
 }
 
 std::vector<std::string> AudioManager::GetActiveReverbZones() const {
@@ -892,8 +1152,95 @@ void AudioManager::SetOcclusionQueryCallback(OcclusionQueryCallback callback) {
   pImpl->occlusionProcessor.SetQueryCallback(std::move(callback));
 }
 
-void AudioManager::RegisterOcclusionMaterial(const OcclusionMaterial &mat) {
-  pImpl->occlusionProcessor.RegisterMaterial(mat);
+void AudioManager::SetOcclusionBatchCallback(OcclusionBatchCallback callback) {
+  pImpl->occlusionScene.reset();
+  pImpl->occlusionProcessor.SetBatchCallback(std::move(callback));
+}
+
+void AudioManager::SetOcclusionScene(std::shared_ptr<OcclusionScene> scene) {
+  pImpl->occlusionScene = std::move(scene);
+  if (!pImpl->occlusionScene) {
+    pImpl->occlusionProcessor.SetBatchCallback(nullptr);
+    return;
+  }
+
+  // Traced synchronously; the results apply in the same Update()
+  Impl *impl = pImpl.get();
+  pImpl->occlusionProcessor.SetBatchCallback(
+      [impl](OcclusionBatchID batch, const OcclusionRay *rays, size_t count) {
+        impl->occlusionScene->Commit();
+        impl->occlusionSceneHits.clear();
+        impl->occlusionScene->Raycast(rays, count, impl->occlusionSceneHits);
+        impl->occlusionProcessor.CompleteBatch(batch,
+                                               impl->occlusionSceneHits.data(),
+                                               impl->occlusionSceneHits.size());
+      });
+}
+
+std::shared_ptr<OcclusionScene> AudioManager::GetOcclusionScene() const {
+  return pImpl->occlusionScene;
+}
+
+void AudioManager::SetOcclusionField(std::shared_ptr<PropagationField> field) {
+  pImpl->occlusionField = std::move(field);
+  pImpl->occlusionProcessor.SetPropagationField(pImpl->occlusionField.get());
+}
+
+std::shared_ptr<PropagationField> AudioManager::GetOcclusionField() const {
+  return pImpl->occlusionField;
+}
+
+RoomID AudioManager::CreateRoom(const ZoneGeometry &shape) {
+  pImpl->occlusionProcessor.SetPortalGraph(&pImpl->portalGraph);
+  return pImpl->portalGraph.CreateRoom(shape);
+}
+
+Result<PortalID> AudioManager::AddPortal(RoomID a, RoomID b,
+                                         const Vector3 &position,
+                                         float openness) {
+  const PortalID portal =
+      pImpl->portalGraph.AddPortal(a, b, position, openness);
+  if (portal == PortalGraph::kInvalidPortal) {
+    return Error(ErrorCode::InvalidParameter,
+                 "Portal needs two different existing rooms");
+  }
+  return portal;
+}
+
+void AudioManager::SetPortalOpenness(PortalID portal, float openness) {
+  pImpl->portalGraph.SetPortalOpenness(portal, openness);
+}
+
+Result<Vector3> AudioManager::GetVoiceApparentPosition(VoiceID id) const {
+  for (size_t i = 0; i < pImpl->voicePool.GetVoiceCount(); ++i) {
+    const Voice *voice = pImpl->voicePool.GetVoiceAt(i);
+    if (voice && voice->id == id && !voice->IsStopped()) {
+      return voice->apparentPosition;
+    }
+  }
+  return Error(ErrorCode::InvalidHandle, "Voice not found");
+}
+
+void AudioManager::CompleteOcclusionBatch(OcclusionBatchID batch,
+                                          const OcclusionRayHit *hits,
+                                          size_t count) {
+  pImpl->occlusionProcessor.CompleteBatch(batch, hits, count);
+}
+
+OcclusionMaterialID
+AudioManager::RegisterOcclusionMaterial(const OcclusionMaterial &mat) {
+  return pImpl->occlusionProcessor.RegisterMaterial(mat);
+}
+
+Result<OcclusionMaterialID>
+AudioManager::GetOcclusionMaterialID(const std::string &name) const {
+  const OcclusionMaterialID id =
+      pImpl->occlusionProcessor.GetMaterialID(name);
+  if (id == OcclusionProcessor::kInvalidMaterial) {
+    return Error(ErrorCode::InvalidParameter,
+                 "Occlusion material not found: " + name);
+  }
+  return id;
 }
 
 void AudioManager::SetOcclusionEnabled(bool enabled) {
@@ -912,6 +1259,26 @@ void AudioManager::SetOcclusionUpdateRate(float hz) {
   pImpl->occlusionProcessor.SetUpdateRate(hz);
 }
 
+void AudioManager::SetOcclusionQueryBudget(uint32_t maxQueriesPerFrame) {
+  pImpl->occlusionProcessor.SetMaxQueriesPerFrame(maxQueriesPerFrame);
+}
+
+void AudioManager::SetOcclusionCacheCellSize(float size) {
+  pImpl->occlusionProcessor.GetCache().SetCellSize(size);
+}
+
+void AudioManager::SetOcclusionCacheLifetime(float seconds) {
+  pImpl->occlusionProcessor.GetCache().SetLifetime(seconds);
+}
+
+void AudioManager::SetOcclusionGeometryVersion(uint32_t version) {
+  pImpl->occlusionProcessor.GetCache().SetGeometryVersion(version);
+}
+
+void AudioManager::InvalidateOcclusionCache() {
+  pImpl->occlusionProcessor.GetCache().Clear();
+}
+
 void AudioManager::SetOcclusionLowPassRange(float minFreq, float maxFreq) {
   pImpl->occlusionProcessor.SetLowPassRange(minFreq, maxFreq);
 }
@@ -924,10 +1291,20 @@ bool AudioManager::IsOcclusionEnabled() const {
   return pImpl->occlusionProcessor.IsEnabled();
 }
 
-void AudioManager::AddDuckingRule(const std::string &targetBus,
-                                  const std::string &sidechainBus,
-                                  float duckLevel, float attackTime,
-                                  float releaseTime, float holdTime) {
+Status AudioManager::AddDuckingRule(const std::string &targetBus,
+                                    const std::string &sidechainBus,
+                                    float duckLevel, float attackTime,
+                                    float releaseTime, float holdTime,
+                                    float threshold) {
+  for (const std::string *name : {&targetBus, &sidechainBus}) {
+    auto it = pImpl->buses.find(*name);
+    if (it != pImpl->buses.end() &&
+        it->second->GetIndex() >= Ducker::kMaxBuses) {
+      return Error(ErrorCode::OutOfRange,
+                   "Bus cannot take part in ducking: " + *name);
+    }
+  }
+
   DuckingRule rule;
   rule.targetBus = targetBus;
   rule.sidechainBus = sidechainBus;
@@ -935,7 +1312,9 @@ void AudioManager::AddDuckingRule(const std::string &targetBus,
   rule.attackTime = attackTime;
   rule.releaseTime = releaseTime;
   rule.holdTime = holdTime;
+  rule.threshold = threshold;
   pImpl->ducker.AddRule(rule);
+  return Ok();
 }
 
 void AudioManager::RemoveDuckingRule(const std::string &targetBus,
@@ -947,17 +1326,48 @@ bool AudioManager::IsDucking(const std::string &targetBus) const {
   return pImpl->ducker.IsDucking(targetBus);
 }
 
-void AudioManager::UpdateMixZones(const Vector3 &listenerPos) {
-  // Update all mix zones
-  for (auto &zone : pImpl->mixZones) {
-    zone->Update(listenerPos);
+void AudioManager::UpdateAudioZones() {
+  const auto &listeners = pImpl->listenerPositions;
+  if (listeners.empty()) {
+    return;
   }
 
-  // Find highest priority active zone
+  auto &candidates = pImpl->zoneCandidates;
+  GatherZones(pImpl->zoneGrid, ZoneLayer::Audio, listeners.data(),
+              listeners.size(), pImpl->liveZones, candidates);
+
+  ZoneBackend backend{*this};
+  pImpl->zones.Update(candidates, listeners.data(), listeners.size(),
+                      pImpl->zoneCrossfadeEnabled, backend, pImpl->liveZones);
+}
+
+void AudioManager::UpdateMixZones(const Vector3 &listenerPos) {
+  auto &candidates = pImpl->zoneCandidates;
+  GatherZones(pImpl->zoneGrid, ZoneLayer::Mix, &listenerPos, 1,
+              pImpl->liveMixZones, candidates);
+  pImpl->liveMixZones.clear();
+
+  // Every active zone is a layer in the blender, weighted by its blend
+  // factor; the highest priority one is reported as the active zone
+  auto &blender = pImpl->snapshotBlender;
   MixZone *bestZone = nullptr;
-  for (auto &zone : pImpl->mixZones) {
-    if (!zone->IsActive())
+  for (uint32_t index : candidates) {
+    auto &zone = pImpl->mixZones[index];
+    zone->Update(listenerPos);
+    if (zone->IsActive() || zone->JustExited()) {
+      pImpl->liveMixZones.push_back(index);
+    }
+    if (!zone->IsActive()) {
+      blender.RemoveLayer(zone.get());
       continue;
+    }
+    if (!blender.HasLayer(zone.get())) {
+      blender.SetLayer(zone.get(),
+                       pImpl->GetCompiledSnapshot(zone->GetSnapshotName()),
+                       zone->GetPriority(), zone->GetFadeInTime(),
+                       zone->GetFadeOutTime());
+    }
+    blender.SetWeight(zone.get(), zone->GetBlendFactor());
     if (!bestZone || zone->GetPriority() > bestZone->GetPriority() ||
         (zone->GetPriority() == bestZone->GetPriority() &&
          zone->GetBlendFactor() > bestZone->GetBlendFactor())) {
@@ -968,57 +1378,62 @@ void AudioManager::UpdateMixZones(const Vector3 &listenerPos) {
   // Handle zone transitions
   std::string newActiveZone = bestZone ? bestZone->GetName() : "";
   if (newActiveZone != pImpl->activeMixZone) {
-    // Exit previous zone
-    if (!pImpl->activeMixZone.empty()) {
-      if (pImpl->zoneExitCallback) {
-        pImpl->zoneExitCallback(pImpl->activeMixZone);
-      }
-      // If exiting to no zone, reset volumes
-      if (newActiveZone.empty()) {
-        ResetBusVolumes(0.5f);
-      }
+    if (!pImpl->activeMixZone.empty() && pImpl->zoneExitCallback) {
+      pImpl->zoneExitCallback(pImpl->activeMixZone);
     }
-    // Enter new zone
     if (!newActiveZone.empty() && pImpl->zoneEnterCallback) {
       pImpl->zoneEnterCallback(newActiveZone);
     }
     pImpl->activeMixZone = newActiveZone;
   }
 
-  // Apply snapshot with blend factor
-  if (bestZone) {
-    float blend = bestZone->GetBlendFactor();
-    ApplySnapshot(bestZone->GetSnapshotName(),
-                  blend * bestZone->GetFadeInTime());
+  // Only buses whose blended target moved are touched
+  if (blender.Resolve()) {
+    for (const auto &change : blender.GetBusChanges()) {
+      pImpl->busByIndex[change.bus]->SetTargetVolume(change.volume,
+                                                     change.fadeSeconds);
+    }
+    for (const auto &change : blender.GetReverbChanges()) {
+      pImpl->ApplyReverbState(change.reverb, change.state, change.fadeSeconds);
+    }
   }
 }
 
 void AudioManager::UpdateReverbZones(const Vector3 &listenerPos) {
-  // Track total influence per reverb bus
-  std::unordered_map<std::string, float> busInfluence;
-
-  // Update all reverb zones and accumulate influence
-  for (auto &zone : pImpl->reverbZones) {
-    float influence = zone->Update(listenerPos);
-    if (influence > 0.0f) {
-      const std::string &busName = zone->GetReverbBusName();
-      // Use max influence (priority-based would be more complex)
-      if (busInfluence.count(busName) == 0 ||
-          influence > busInfluence[busName]) {
-        busInfluence[busName] = influence;
+  auto &influence = pImpl->reverbInfluence;
+  influence.Reset(pImpl->reverbByIndex.size());
+
+  auto &candidates = pImpl->zoneCandidates;
+  GatherZones(pImpl->zoneGrid, ZoneLayer::Reverb, &listenerPos, 1,
+              pImpl->liveReverbZones, candidates);
+  pImpl->liveReverbZones.clear();
+
+  // Update nearby reverb zones and accumulate influence
+  for (uint32_t index : candidates) {
+    auto &zone = pImpl->reverbZones[index];
+    float zoneInfluence = zone->Update(listenerPos);
+    if (zoneInfluence > 0.0f) {
+      pImpl->liveReverbZones.push_back(index);
+      if (zone->GetReverbBusID() != ReverbZone::kNoReverbBus) {
+        influence.Add(zone->GetReverbBusID(), zoneInfluence,
+                      zone->GetPriority());
       }
     }
   }
-
-  // Apply accumulated influence to reverb buses
-  for (auto &[busName, bus] : pImpl->reverbBuses) {
-    float influence = 0.0f;
-    if (busInfluence.count(busName) > 0) {
-      influence = busInfluence[busName];
+  influence.Resolve();
+
+  // Fade the wet level only when the target moved noticeably, or reached
+  // an end point, so a resting listener sends no mixer commands
+  for (ReverbBusID id = 0; id < pImpl->reverbByIndex.size(); ++id) {
+    const float ceiling = pImpl->reverbZoneWet[id];
+    const float targetWet = influence.Get(id) * ceiling;
+    float &issued = pImpl->reverbIssuedWet[id];
+    const bool endPoint = targetWet == 0.0f || targetWet == ceiling;
+    if (std::fabs(targetWet - issued) > Impl::kReverbWetThreshold ||
+        (endPoint && targetWet != issued)) {
+      pImpl->reverbByIndex[id]->SetWet(targetWet, 0.1f);
+      issued = targetWet;
     }
-    // Smooth fade the wet level based on zone influence
-    float targetWet = influence * 0.8f; // Max 80% wet when fully in zone
-    bus->SetWet(targetWet, 0.1f);       // Small fade time for smoothness
   }
 }
 
@@ -1186,27 +1601,37 @@ bool AudioManager::IsZoneCrossfadeEnabled() const {
 // Dynamic Zones API
 // =============================================================================
 
-AudioZone *AudioManager::GetZone(const std::string &eventName) {
-  for (auto &zone : pImpl->zones) {
-    if (zone->GetEventName() == eventName) {
-      return zone.get();
-    }
+std::optional<AudioZone>
+AudioManager::GetZone(const std::string &eventName) const {
+  const uint32_t zone = pImpl->zones.Find(eventName);
+  if (zone == ZonePool::kInvalidZone) {
+    return std::nullopt;
   }
-  return nullptr;
+  return AudioZone(pImpl->zones, zone);
 }
 
 void AudioManager::SetZonePosition(const std::string &eventName,
                                    const Vector3 &pos) {
-  if (AudioZone *zone = GetZone(eventName)) {
-    zone->SetPosition(pos);
+  const uint32_t zone = pImpl->zones.Find(eventName);
+  if (zone == ZonePool::kInvalidZone) {
+    return;
   }
+  pImpl->zones.SetPosition(zone, pos);
+  Vector3 min, max;
+  pImpl->zones.GetBounds(zone, min, max);
+  pImpl->zoneGrid.Update(pImpl->zoneProxies[zone], min, max);
 }
 
 void AudioManager::SetZoneRadii(const std::string &eventName, float inner,
                                 float outer) {
-  if (AudioZone *zone = GetZone(eventName)) {
-    zone->SetRadii(inner, outer);
+  const uint32_t zone = pImpl->zones.Find(eventName);
+  if (zone == ZonePool::kInvalidZone) {
+    return;
   }
+  pImpl->zones.SetRadii(zone, inner, outer);
+  Vector3 min, max;
+  pImpl->zones.GetBounds(zone, min, max);
+  pImpl->zoneGrid.Update(pImpl->zoneProxies[zone], min, max);
 }
 
 // =============================================================================
@@ -1236,13 +1661,33 @@ void AudioManager::SetBusLimiter(const std::string &busName,
     CompressorSettings settings;
     settings.threshold = thresholdDb;
     settings.limiterMode = true;
-    settings.attackMs = 1.0f;   // Fast attack for limiting
-    settings.releaseMs = 50.0f; // Moderate release
+    settings.attackMs = 1.0f;    // Fast attack for limiting
+    settings.releaseMs = 50.0f;  // Moderate release
+    settings.lookaheadMs = 5.0f; // Brickwall: gain lands before the peak
     busResult.Value()->SetCompressor(settings);
     busResult.Value()->SetCompressorEnabled(true);
   }
 }
 
+Status AudioManager::SetBusMeteringEnabled(const std::string &busName,
+                                           bool enabled) {
+  auto it = pImpl->buses.find(busName);
+  if (it == pImpl->buses.end()) {
+    return Error(ErrorCode::BusNotFound, "Bus not found: " + busName);
+  }
+  it->second->SetMeteringEnabled(enabled);
+  return Ok();
+}
+
+Result<BusMeterReading>
+AudioManager::GetBusMeter(const std::string &busName) const {
+  auto it = pImpl->buses.find(busName);
+  if (it == pImpl->buses.end()) {
+    return Error(ErrorCode::BusNotFound, "Bus not found: " + busName);
+  }
+  return it->second->GetMeter();
+}
+
 // =============================================================================
 // Convolution Reverb API
 // =============================================================================
@@ -1253,6 +1698,9 @@ bool AudioManager::CreateConvolutionReverb(const std::string &name,
   if (!reverb->LoadImpulseResponse(irPath)) {
     return false;
   }
+  // Drop a replaced reverb's updater before the reverb itself
+  pImpl->impulseResponseUpdaters[name] =
+      std::make_unique<ImpulseResponseUpdater>(*reverb);
   pImpl->convolutionReverbs[name] = std::move(reverb);
   return true;
 }
@@ -1280,6 +1728,24 @@ ConvolutionReverb *AudioManager::GetConvolutionReverb(const std::string &name) {
   return nullptr;
 }
 
+bool AudioManager::SubmitConvolutionReverbPropagation(
+    const std::string &name, const PropagationResult &result) {
+  auto it = pImpl->impulseResponseUpdaters.find(name);
+  if (it == pImpl->impulseResponseUpdaters.end()) {
+    return false;
+  }
+  return it->second->Submit(result);
+}
+
+ImpulseResponseUpdater *
+AudioManager::GetImpulseResponseUpdater(const std::string &name) {
+  auto it = pImpl->impulseResponseUpdaters.find(name);
+  if (it != pImpl->impulseResponseUpdaters.end()) {
+    return it->second.get();
+  }
+  return nullptr;
+}
+
 // =============================================================================
 // HDR Audio API
 // =============================================================================
@@ -1366,10 +1832,86 @@ void AudioManager::SetRayCount(int count) {
 }
 
 void AudioManager::SetGeometryCallback(GeometryCallback callback) {
+  // A running batch traces with its own copy of the old callback
+  pImpl->propagationProcessor.Wait();
   pImpl->rayTracer.SetGeometryCallback(std::move(callback));
 }
 
-AcousticRayTracer &AudioManager::GetRayTracer() { return pImpl->rayTracer; }
+void AudioManager::SetGeometryPacketCallback(GeometryPacketCallback callback) {
+  pImpl->propagationProcessor.Wait();
+  pImpl->acousticScene.reset();
+  pImpl->rayTracer.SetGeometryPacketCallback(std::move(callback));
+}
+
+AcousticRayTracer &AudioManager::GetRayTracer() {
+  // Batches trace with a copy, so callers may reconfigure the tracer
+  return pImpl->rayTracer;
+}
+
+void AudioManager::SetAcousticScene(std::shared_ptr<AcousticScene> scene) {
+  pImpl->propagationProcessor.Wait();
+  pImpl->acousticScene = std::move(scene);
+  if (!pImpl->acousticScene) {
+    pImpl->rayTracer.SetGeometryPacketCallback(nullptr);
+    return;
+  }
+  pImpl->acousticScene->Commit();
+  pImpl->rayTracer.SetGeometryPacketCallback(
+      AcousticScene::MakeCallback(pImpl->acousticScene));
+}
+
+std::shared_ptr<AcousticScene> AudioManager::GetAcousticScene() const {
+  return pImpl->acousticScene;
+}
+
+void AudioManager::SetAcousticProbes(
+    std::shared_ptr<const AcousticProbeGrid> probes) {
+  pImpl->acousticProbes = std::move(probes);
+}
+
+std::shared_ptr<const AcousticProbeGrid>
+AudioManager::GetAcousticProbes() const {
+  return pImpl->acousticProbes;
+}
+
+AcousticProbeSample
+AudioManager::SampleAcousticProbes(const Vector3 &position,
+                                   ProbeInterpolation mode) const {
+  if (!pImpl->acousticProbes) {
+    return AcousticProbeSample{};
+  }
+  return pImpl->acousticProbes->Sample(position, mode);
+}
+
+void AudioManager::SetPropagationRayBudget(uint32_t raysPerFrame) {
+  pImpl->propagationProcessor.SetRayBudget(raysPerFrame);
+}
+
+void AudioManager::SetPropagationUpdateRate(float hz) {
+  pImpl->propagationProcessor.SetUpdateRate(hz);
+}
+
+void AudioManager::SetPropagationSmoothingTime(float seconds) {
+  pImpl->propagationProcessor.SetSmoothingTime(seconds);
+}
+
+Result<PropagationEffect> AudioManager::GetVoicePropagation(VoiceID id) const {
+  for (size_t i = 0; i < pImpl->voicePool.GetVoiceCount(); ++i) {
+    const Voice *voice = pImpl->voicePool.GetVoiceAt(i);
+    if (voice && voice->id == id && !voice->IsStopped()) {
+      PropagationEffect effect;
+      effect.volume = voice->propagationVolumeSmoothed;
+      effect.lowPassCutoff = voice->propagationLowPassSmoothed;
+      effect.reverbSend = voice->propagationReverbSendSmoothed;
+      return effect;
+    }
+  }
+  return Error(ErrorCode::InvalidHandle, "Voice not found");
+}
+
+PropagationProcessor &AudioManager::GetPropagationProcessor() {
+  return pImpl->propagationProcessor;
+}
 
 // =============================================================================
 // Audio Codec API
@@ -1,36 +1,135 @@
 #include "../include/Bus.h"
+#include "../include/Ducker.h"
+#include "BusProcessor_Internal.h"
+#include "CompressorFilter_Internal.h"
 
 #include <soloud.h>
 #include <soloud_bus.h>
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 namespace Orpheus {
 
+// Filter slots on every bus's native mixer
+constexpr unsigned int kCompressorSlot = 0;
+constexpr unsigned int kProcessorSlot = 1;
+
 // PIMPL implementation struct
 struct BusImpl {
+  // Declared before the bus so it outlives the bus's filter instances
+  std::unique_ptr<CompressorFilter> compressorFilter;
+  std::unique_ptr<BusMeter> meter;
+  std::unique_ptr<BusProcessorFilter> processorFilter;
   std::unique_ptr<SoLoud::Bus> bus;
   std::vector<SoLoud::handle> handles;
   SoLoud::Soloud *engine = nullptr;
+  SoLoud::handle busHandle = 0;
+  Bus *parent = nullptr;
+  std::vector<Bus *> children;
+  Ducker *ducker = nullptr;
+  uint32_t index = 0;
+  uint32_t voiceCount = 0;
   float volume = 1.0f;
   float targetVolume = 1.0f;
   float startVolume = 1.0f;
   float fadeTime = 0.0f;
 
-  BusImpl() : bus(std::make_unique<SoLoud::Bus>()) {}
+  BusImpl()
+      : compressorFilter(std::make_unique<CompressorFilter>()),
+        meter(std::make_unique<BusMeter>()),
+        bus(std::make_unique<SoLoud::Bus>()) {}
+
+  // Voice count of this subtree, mirrored to the mixer's activity slot
+  void AddVoices(int32_t delta) {
+    voiceCount =
+        static_cast<uint32_t>(static_cast<int32_t>(voiceCount) + delta);
+    if (ducker) {
+      ducker->GetActivity(index).voiceCount.store(voiceCount,
+                                                  std::memory_order_relaxed);
+    }
+  }
+
+  void SetCompressorParams(const CompressorSettings &settings, bool enabled) {
+    compressorFilter->SetDefaults(settings, enabled);
+    if (!engine || busHandle == 0)
+      return;
+    for (unsigned int p = 0; p < CompressorFilter::PARAM_COUNT; ++p) {
+      engine->setFilterParameter(
+          busHandle, kCompressorSlot, p,
+          CompressorFilter::ParamValue(p, settings, enabled));
+    }
+  }
 };
 
-Bus::Bus(const std::string &name)
-    : m_Impl(std::make_unique<BusImpl>()), m_Name(name) {}
+Bus::Bus(const std::string &name, uint32_t index)
+    : m_Impl(std::make_unique<BusImpl>()), m_Name(name) {
+  m_Impl->index = index;
+}
 
 Bus::~Bus() = default;
 
 Bus::Bus(Bus &&) noexcept = default;
 Bus &Bus::operator=(Bus &&) noexcept = default;
 
+bool Bus::Init(NativeEngineHandle engine, Bus *parent, Ducker *ducker) {
+  auto *soloudEngine = static_cast<SoLoud::Soloud *>(engine.ptr);
+  if (!soloudEngine || m_Impl->busHandle != 0)
+    return false;
+
+  // Keep the bus ticking while silent so child voices stay in sync
+  m_Impl->bus->setInaudibleBehavior(true, false);
+
+  // Bus DSP runs on the mixed bus signal; it costs nothing while disabled
+  m_Impl->compressorFilter->SetDefaults(m_Compressor.GetSettings(),
+                                        m_Compressor.IsEnabled());
+  m_Impl->bus->setFilter(kCompressorSlot, m_Impl->compressorFilter.get());
+
+  // Sidechain detection, ducking gain and meters, after the compressor
+  if (ducker && m_Impl->index < Ducker::kMaxBuses) {
+    m_Impl->ducker = ducker;
+  }
+  m_Impl->processorFilter = std::make_unique<BusProcessorFilter>(
+      m_Impl->ducker, m_Impl->index, m_Impl->meter.get());
+  m_Impl->bus->setFilter(kProcessorSlot, m_Impl->processorFilter.get());
+
+  if (parent) {
+    auto *parentBus = static_cast<SoLoud::Bus *>(parent->Raw().ptr);
+    m_Impl->busHandle = parentBus->play(*m_Impl->bus, m_Impl->volume);
+  } else {
+    m_Impl->busHandle = soloudEngine->play(*m_Impl->bus, m_Impl->volume);
+  }
+  if (m_Impl->busHandle == 0) {
+    return false;
+  }
+
+  // A bus voice must never be stolen by the engine's voice limiter
+  soloudEngine->setProtectVoice(m_Impl->busHandle, true);
+
+  m_Impl->engine = soloudEngine;
+  m_Impl->parent = parent;
+  if (parent) {
+    parent->m_Impl->children.push_back(this);
+  }
+  return true;
+}
+
 void Bus::AddHandle(NativeEngineHandle engine, AudioHandle h) {
-  m_Impl->engine = static_cast<SoLoud::Soloud *>(engine.ptr);
+  if (!m_Impl->engine) {
+    m_Impl->engine = static_cast<SoLoud::Soloud *>(engine.ptr);
+  }
+  if (m_Impl->busHandle != 0) {
+    m_Impl->bus->annexSound(static_cast<SoLoud::handle>(h));
+  }
+  TrackHandle(h);
+}
+
+void Bus::TrackHandle(AudioHandle h) {
   m_Impl->handles.push_back(static_cast<SoLoud::handle>(h));
+  for (Bus *b = this; b; b = b->m_Impl->parent) {
+    b->m_Impl->AddVoices(1);
+  }
 }
 
 void Bus::Update(float dt) {
@@ -49,14 +148,20 @@ void Bus::Update(float dt) {
     }
   }
 
+  // Volume is applied by the engine on the bus voice; only drop finished
+  // voices here
   if (m_Impl->engine) {
-    for (auto it = m_Impl->handles.begin(); it != m_Impl->handles.end();) {
-      if (m_Impl->engine->isValidVoiceHandle(*it)) {
-        m_Impl->engine->setVolume(*it, m_Impl->volume);
-        ++it;
-      } else {
-        it = m_Impl->handles.erase(it);
-      }
+    auto *engine = m_Impl->engine;
+    auto finished =
+        std::remove_if(m_Impl->handles.begin(), m_Impl->handles.end(),
+                       [engine](SoLoud::handle h) {
+                         return !engine->isValidVoiceHandle(h);
+                       });
+    const auto count =
+        static_cast<int32_t>(std::distance(finished, m_Impl->handles.end()));
+    m_Impl->handles.erase(finished, m_Impl->handles.end());
+    for (Bus *b = this; b && count > 0; b = b->m_Impl->parent) {
+      b->m_Impl->AddVoices(-count);
     }
   }
 }
@@ -65,27 +170,51 @@ void Bus::SetVolume(float v) {
   m_Impl->volume = v;
   m_Impl->targetVolume = v;
   m_Impl->fadeTime = 0.0f;
+  if (m_Impl->engine && m_Impl->busHandle != 0) {
+    m_Impl->engine->setVolume(m_Impl->busHandle, v);
+  }
 }
 
 void Bus::SetTargetVolume(float v, float fadeSeconds) {
   m_Impl->startVolume = m_Impl->volume;
   m_Impl->targetVolume = v;
   m_Impl->fadeTime = fadeSeconds > 0.0f ? fadeSeconds : 0.001f;
+  if (m_Impl->engine && m_Impl->busHandle != 0) {
+    m_Impl->engine->fadeVolume(m_Impl->busHandle, v, m_Impl->fadeTime);
+  }
 }
 
 float Bus::GetVolume() const { return m_Impl->volume; }
 float Bus::GetTargetVolume() const { return m_Impl->targetVolume; }
+
+float Bus::GetEffectiveVolume() const {
+  float volume = m_Impl->volume;
+  for (const Bus *b = m_Impl->parent; b; b = b->m_Impl->parent) {
+    volume *= b->m_Impl->volume;
+  }
+  return volume;
+}
+
 const std::string &Bus::GetName() const { return m_Name; }
+BusID Bus::GetIndex() const { return m_Impl->index; }
+uint32_t Bus::GetActiveVoiceCount() const { return m_Impl->voiceCount; }
+Bus *Bus::GetParent() const { return m_Impl->parent; }
+const std::vector<Bus *> &Bus::GetChildren() const {
+  return m_Impl->children;
+}
+AudioHandle Bus::GetHandle() const { return m_Impl->busHandle; }
 
 NativeBusHandle Bus::Raw() { return NativeBusHandle{m_Impl->bus.get()}; }
 
 // Compressor methods
 void Bus::SetCompressor(const CompressorSettings &settings) {
   m_Compressor.SetSettings(settings);
+  m_Impl->SetCompressorParams(settings, m_Compressor.IsEnabled());
 }
 
 void Bus::SetCompressorEnabled(bool enabled) {
   m_Compressor.SetEnabled(enabled);
+  m_Impl->SetCompressorParams(m_Compressor.GetSettings(), enabled);
 }
 
 bool Bus::IsCompressorEnabled() const { return m_Compressor.IsEnabled(); }
@@ -95,7 +224,18 @@ const CompressorSettings &Bus::GetCompressorSettings() const {
 }
 
 float Bus::GetCompressorGainReduction() const {
-  return m_Compressor.GetGainReduction();
+  return m_Impl->compressorFilter->GetGainReduction();
+}
+
+// Metering methods
+void Bus::SetMeteringEnabled(bool enabled) {
+  m_Impl->meter->SetEnabled(enabled);
 }
 
+bool Bus::IsMeteringEnabled() const { return m_Impl->meter->IsEnabled(); }
+
+BusMeterReading Bus::GetMeter() const { return m_Impl->meter->Read(); }
+
+void Bus::ResetMeter() { m_Impl->meter->Reset(); }
+
 } // namespace Orpheus
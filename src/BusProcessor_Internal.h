@@ -0,0 +1,65 @@
+/**
+ * @file BusProcessor_Internal.h
+ * @brief Internal SoLoud filter for per-bus mixer work (ducking, meters).
+ *
+ * This header is used internally by Bus to run block-rate processing on
+ * the mixed bus signal. Do not include in user code.
+ */
+#pragma once
+
+#include "../include/BusMeter.h"
+#include "../include/Ducker.h"
+
+#include <soloud.h>
+#include <soloud_filter.h>
+
+namespace Orpheus {
+
+/**
+ * @brief SoLoud filter instance running a bus's ducking and metering.
+ */
+class BusProcessorInstance : public SoLoud::FilterInstance {
+public:
+  BusProcessorInstance(Ducker *ducker, uint32_t busIndex, BusMeter *meter)
+      : m_Ducker(ducker), m_BusIndex(busIndex), m_Meter(meter) {}
+
+  void filter(float *aBuffer, unsigned int aSamples, unsigned int aBufferSize,
+              unsigned int aChannels, float aSamplerate,
+              SoLoud::time aTime) override {
+    (void)aTime;
+    if (m_Ducker) {
+      m_Ducker->ProcessBlock(m_BusIndex, m_DuckState, aBuffer, aSamples,
+                             aChannels, aBufferSize, aSamplerate);
+    }
+    // Meter the bus as it leaves its DSP chain (before the bus fader)
+    if (m_Meter && m_Meter->IsEnabled()) {
+      m_Meter->Process(aBuffer, aSamples, aChannels, aBufferSize, aSamplerate);
+    }
+  }
+
+private:
+  Ducker *m_Ducker;
+  uint32_t m_BusIndex;
+  BusMeter *m_Meter;
+  DuckerBusState m_DuckState;
+};
+
+/**
+ * @brief SoLoud filter providing per-bus mixer processing.
+ */
+class BusProcessorFilter : public SoLoud::Filter {
+public:
+  BusProcessorFilter(Ducker *ducker, uint32_t busIndex, BusMeter *meter)
+      : m_Ducker(ducker), m_BusIndex(busIndex), m_Meter(meter) {}
+
+  SoLoud::FilterInstance *createInstance() override {
+    return new BusProcessorInstance(m_Ducker, m_BusIndex, m_Meter);
+  }
+
+private:
+  Ducker *m_Ducker;
+  uint32_t m_BusIndex;
+  BusMeter *m_Meter;
+};
+
+} // namespace Orpheus
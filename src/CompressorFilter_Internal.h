@@ -0,0 +1,207 @@
+/**
+ * @file CompressorFilter_Internal.h
+ * @brief Internal SoLoud filter that runs a bus Compressor in the mixer.
+ *
+ * This header is used internally by Bus to place its compressor/limiter
+ * in the audio path. Do not include in user code.
+ */
+#pragma once
+
+#include "../include/Compressor.h"
+
+#include <atomic>
+
+#include <soloud.h>
+#include <soloud_filter.h>
+
+namespace Orpheus {
+
+class CompressorFilter;
+
+/**
+ * @brief SoLoud filter instance processing a whole planar block at once.
+ *
+ * Settings arrive through SoLoud's filter parameters (set from the game
+ * thread with Soloud::setFilterParameter), so no locking is needed here.
+ */
+class CompressorFilterInstance : public SoLoud::FilterInstance {
+public:
+  explicit CompressorFilterInstance(CompressorFilter *parent);
+
+  void filter(float *aBuffer, unsigned int aSamples, unsigned int aBufferSize,
+              unsigned int aChannels, float aSamplerate,
+              SoLoud::time aTime) override;
+
+private:
+  void ApplyParams();
+
+  CompressorFilter *m_Parent;
+  Compressor m_Compressor;
+};
+
+/**
+ * @brief SoLoud filter wrapping Compressor for a bus.
+ */
+class CompressorFilter : public SoLoud::Filter {
+public:
+  enum Params {
+    ENABLED = 0,
+    THRESHOLD,
+    RATIO,
+    ATTACK,
+    RELEASE,
+    MAKEUP,
+    LIMITER,
+    LOOKAHEAD,
+    PARAM_COUNT
+  };
+
+  /**
+   * @brief Settings new instances start with (before any parameter change).
+   */
+  void SetDefaults(const CompressorSettings &settings, bool enabled) {
+    m_Settings = settings;
+    m_Enabled = enabled;
+  }
+
+  /**
+   * @brief Value of a parameter for the given settings.
+   */
+  static float ParamValue(unsigned int param,
+                          const CompressorSettings &settings, bool enabled) {
+    switch (param) {
+    case ENABLED:
+      return enabled ? 1.0f : 0.0f;
+    case THRESHOLD:
+      return settings.threshold;
+    case RATIO:
+      return settings.ratio;
+    case ATTACK:
+      return settings.attackMs;
+    case RELEASE:
+      return settings.releaseMs;
+    case MAKEUP:
+      return settings.makeupGain;
+    case LIMITER:
+      return settings.limiterMode ? 1.0f : 0.0f;
+    case LOOKAHEAD:
+      return settings.lookaheadMs;
+    default:
+      return 0.0f;
+    }
+  }
+
+  /**
+   * @brief Gain reduction published by the running instance, in dB.
+   */
+  [[nodiscard]] float GetGainReduction() const {
+    return m_GainReductionDb.load(std::memory_order_relaxed);
+  }
+
+  int getParamCount() override { return PARAM_COUNT; }
+
+  const char *getParamName(unsigned int aParamIndex) override {
+    static const char *names[PARAM_COUNT] = {
+        "Enabled", "Threshold", "Ratio",   "Attack",
+        "Release", "Makeup",    "Limiter", "Lookahead"};
+    return aParamIndex < PARAM_COUNT ? names[aParamIndex] : "";
+  }
+
+  unsigned int getParamType(unsigned int aParamIndex) override {
+    return (aParamIndex == ENABLED || aParamIndex == LIMITER) ? BOOL_PARAM
+                                                             : FLOAT_PARAM;
+  }
+
+  float getParamMax(unsigned int aParamIndex) override {
+    switch (aParamIndex) {
+    case THRESHOLD:
+    case MAKEUP:
+      return 24.0f;
+    case RATIO:
+      return 100.0f;
+    case ATTACK:
+    case RELEASE:
+      return 5000.0f;
+    case LOOKAHEAD:
+      return 40.0f;
+    default:
+      return 1.0f;
+    }
+  }
+
+  float getParamMin(unsigned int aParamIndex) override {
+    switch (aParamIndex) {
+    case THRESHOLD:
+      return -96.0f;
+    case MAKEUP:
+      return -24.0f;
+    case RATIO:
+      return 1.0f;
+    default:
+      return 0.0f;
+    }
+  }
+
+  SoLoud::FilterInstance *createInstance() override {
+    return new CompressorFilterInstance(this);
+  }
+
+private:
+  friend class CompressorFilterInstance;
+
+  CompressorSettings m_Settings;
+  bool m_Enabled = false;
+  std::atomic<float> m_GainReductionDb{0.0f};
+};
+
+inline CompressorFilterInstance::CompressorFilterInstance(
+    CompressorFilter *parent)
+    : m_Parent(parent) {
+  initParams(CompressorFilter::PARAM_COUNT);
+  for (unsigned int i = 0; i < CompressorFilter::PARAM_COUNT; ++i) {
+    mParam[i] = CompressorFilter::ParamValue(i, parent->m_Settings,
+                                             parent->m_Enabled);
+  }
+  m_Compressor.ReserveLookahead();
+  ApplyParams();
+}
+
+inline void CompressorFilterInstance::ApplyParams() {
+  CompressorSettings settings;
+  settings.threshold = mParam[CompressorFilter::THRESHOLD];
+  settings.ratio = mParam[CompressorFilter::RATIO];
+  settings.attackMs = mParam[CompressorFilter::ATTACK];
+  settings.releaseMs = mParam[CompressorFilter::RELEASE];
+  settings.makeupGain = mParam[CompressorFilter::MAKEUP];
+  settings.limiterMode = mParam[CompressorFilter::LIMITER] > 0.5f;
+  settings.lookaheadMs = mParam[CompressorFilter::LOOKAHEAD];
+  m_Compressor.SetSettings(settings);
+  m_Compressor.SetEnabled(mParam[CompressorFilter::ENABLED] > 0.5f);
+  if (!m_Compressor.IsEnabled()) {
+    m_Compressor.Reset();
+    m_Parent->m_GainReductionDb.store(0.0f, std::memory_order_relaxed);
+  }
+  mParamChanged = 0;
+}
+
+inline void CompressorFilterInstance::filter(float *aBuffer,
+                                             unsigned int aSamples,
+                                             unsigned int aBufferSize,
+                                             unsigned int aChannels,
+                                             float aSamplerate,
+                                             SoLoud::time aTime) {
+  updateParams(aTime);
+  if (mParamChanged) {
+    ApplyParams();
+  }
+  if (!m_Compressor.IsEnabled()) {
+    return;
+  }
+
+  m_Compressor.SetSampleRate(aSamplerate);
+  m_Compressor.ProcessBlock(aBuffer, aSamples, aChannels, aBufferSize);
+  m_Parent->m_GainReductionDb.store(m_Compressor.GetGainReduction(),
+                                    std::memory_order_relaxed);
+}
+
+} // namespace Orpheus
@@ -1,15 +1,15 @@
 #include "../include/Ducker.h"
-#include "../include/Bus.h"
+#include "../include/DSPMath.h"
 
 #include <algorithm>
 #include <cmath>
 
 namespace Orpheus {
 
-std::string Ducker::MakeKey(const std::string &target,
-                            const std::string &sidechain) {
-  return target + ":" + sidechain;
-}
+// Release time of the sidechain envelope follower
+constexpr float kEnvelopeReleaseSeconds = 0.1f;
+
+Ducker::~Ducker() = default;
 
 void Ducker::AddRule(const DuckingRule &rule) {
   // Check if rule already exists
@@ -21,7 +21,7 @@ void Ducker::AddRule(const DuckingRule &rule) {
   }
 
   m_Rules.push_back(rule);
-  m_States[MakeKey(rule.targetBus, rule.sidechainBus)] = DuckingState{};
+  m_Dirty = true;
 }
 
 void Ducker::RemoveRule(const std::string &targetBus,
@@ -32,99 +32,185 @@ void Ducker::RemoveRule(const std::string &targetBus,
                                         r.sidechainBus == sidechainBus;
                                }),
                 m_Rules.end());
-
-  m_States.erase(MakeKey(targetBus, sidechainBus));
+  m_Dirty = true;
 }
 
 void Ducker::ClearRules() {
   m_Rules.clear();
-  m_States.clear();
+  m_Dirty = true;
 }
 
-void Ducker::Update(
-    float dt, std::unordered_map<std::string, std::shared_ptr<Bus>> &buses,
-    std::function<bool(const std::string &)> getSidechainActive) {
+void Ducker::Update(const BusResolver &resolve) {
+  if (m_Dirty) {
+    Compile(resolve);
+    m_Dirty = false;
+  }
 
-  // Track cumulative duck level per target bus
-  std::unordered_map<std::string, float> targetLevels;
+  // Tables were replaced before this load; a block that loaded one of
+  // them is still counted until it leaves ProcessBlock()
+  if (!m_Retired.empty() && m_Readers.load(std::memory_order_seq_cst) == 0) {
+    m_Retired.clear();
+  }
+}
+
+void Ducker::Compile(const BusResolver &resolve) {
+  auto table = std::make_unique<DuckingTable>();
+  table->generation = ++m_Generation;
+  m_TargetIndices.clear();
+
+  for (const auto &rule : m_Rules) {
+    uint32_t target = resolve(rule.targetBus);
+    uint32_t sidechain = resolve(rule.sidechainBus);
+    if (target >= kMaxBuses || sidechain >= kMaxBuses) {
+      // Bus not created yet (recompiled when it is), or created past the
+      // ducking table
+      continue;
+    }
 
-  for (auto &rule : m_Rules) {
-    std::string key = MakeKey(rule.targetBus, rule.sidechainBus);
-    auto &state = m_States[key];
+    CompiledDuckingRule compiled;
+    compiled.targetBus = target;
+    compiled.sidechainBus = sidechain;
+    compiled.duckLevel = std::clamp(rule.duckLevel, 0.0f, 1.0f);
+    compiled.attackRate = 1.0f / (std::max)(rule.attackTime, 0.001f);
+    compiled.releaseRate = 1.0f / (std::max)(rule.releaseTime, 0.001f);
+    compiled.holdTime = (std::max)(rule.holdTime, 0.0f);
+    compiled.threshold = FastDbToLinear(rule.threshold);
+    table->rules.push_back(compiled);
+    table->sidechainMask |= uint64_t{1} << sidechain;
+    m_TargetIndices[rule.targetBus] = target;
+  }
 
-    // Check if sidechain bus has active audio
-    bool sidechainActive = getSidechainActive(rule.sidechainBus);
+  // Group by target bus (CSR offsets), capped per bus
+  std::stable_sort(table->rules.begin(), table->rules.end(),
+                   [](const CompiledDuckingRule &a,
+                      const CompiledDuckingRule &b) {
+                     return a.targetBus < b.targetBus;
+                   });
+  table->targetBegin.assign(kMaxBuses + 1, 0);
+  for (const auto &rule : table->rules) {
+    ++table->targetBegin[rule.targetBus + 1];
+  }
+  for (uint32_t b = 0; b < kMaxBuses; ++b) {
+    table->targetBegin[b + 1] += table->targetBegin[b];
+  }
 
-    if (sidechainActive) {
-      // Sidechain is active - duck the target
-      state.active = true;
-      state.holdTimer = rule.holdTime;
+  m_Table.store(table.get(), std::memory_order_seq_cst);
+  if (m_Current) {
+    m_Retired.push_back(std::move(m_Current));
+  }
+  m_Current = std::move(table);
+}
 
-      // Attack phase - fade down
-      float attackRate = 1.0f / std::max(rule.attackTime, 0.001f);
-      state.currentLevel -= attackRate * dt;
-      state.currentLevel = std::max(state.currentLevel, rule.duckLevel);
-    } else {
-      // Sidechain stopped
-      if (state.holdTimer > 0.0f) {
-        // Still in hold phase
-        state.holdTimer -= dt;
-      } else {
-        // Release phase - fade up
-        state.active = false;
-        float releaseRate = 1.0f / std::max(rule.releaseTime, 0.001f);
-        state.currentLevel += releaseRate * dt;
-        state.currentLevel = std::min(state.currentLevel, 1.0f);
+void Ducker::Rebind(DuckerBusState &state, const DuckingTable *table,
+                    uint32_t busIndex) {
+  const uint32_t begin = table->targetBegin[busIndex];
+  const size_t count = (std::min)(
+      static_cast<size_t>(table->targetBegin[busIndex + 1] - begin),
+      DuckerBusState::kMaxRulesPerBus);
+
+  // Keep the level of rules that survive the recompile
+  std::array<DuckingState, DuckerBusState::kMaxRulesPerBus> rules{};
+  std::array<uint32_t, DuckerBusState::kMaxRulesPerBus> sidechains{};
+  for (size_t i = 0; i < count; ++i) {
+    sidechains[i] = table->rules[begin + i].sidechainBus;
+    for (size_t j = 0; j < state.ruleCount; ++j) {
+      if (state.sidechains[j] == sidechains[i]) {
+        rules[i] = state.rules[j];
+        break;
       }
     }
+  }
 
-    // Accumulate the lowest duck level for this target
-    if (targetLevels.find(rule.targetBus) == targetLevels.end()) {
-      targetLevels[rule.targetBus] = state.currentLevel;
+  state.rules = rules;
+  state.sidechains = sidechains;
+  state.ruleCount = count;
+  state.generation = table->generation;
+}
+
+void Ducker::ProcessBlock(uint32_t busIndex, DuckerBusState &state,
+                          float *buffer, size_t samples, size_t channels,
+                          size_t stride, float sampleRate) {
+  const ReadScope scope(*this);
+  const DuckingTable *table = m_Table.load(std::memory_order_seq_cst);
+  if (!table || busIndex >= kMaxBuses || samples == 0 || sampleRate <= 0.0f) {
+    return;
+  }
+  if (state.generation != table->generation) {
+    Rebind(state, table, busIndex);
+  }
+
+  const float dt = static_cast<float>(samples) / sampleRate;
+  BusActivity &self = m_Activity[busIndex];
+
+  // Sidechain: peak follower with instant attack
+  if (table->sidechainMask & (uint64_t{1} << busIndex)) {
+    float peak = 0.0f;
+    for (size_t c = 0; c < channels; ++c) {
+      peak = (std::max)(peak, PeakAbs(buffer + c * stride, samples));
+    }
+    const float decay = FastExp2(-dt / kEnvelopeReleaseSeconds * 1.442695f);
+    const float envelope = self.envelope.load(std::memory_order_relaxed);
+    self.envelope.store((std::max)(peak, envelope * decay),
+                        std::memory_order_relaxed);
+  }
+
+  if (state.ruleCount == 0 && state.gain == 1.0f) {
+    return;
+  }
+
+  // Target: advance every rule by one block, duck to the deepest level
+  float target = 1.0f;
+  bool anyActive = false;
+  const uint32_t begin = table->targetBegin[busIndex];
+  for (size_t i = 0; i < state.ruleCount; ++i) {
+    const CompiledDuckingRule &rule = table->rules[begin + i];
+    DuckingState &rs = state.rules[i];
+    const BusActivity &sidechain = m_Activity[rule.sidechainBus];
+    const bool active =
+        sidechain.voiceCount.load(std::memory_order_relaxed) > 0 &&
+        sidechain.envelope.load(std::memory_order_relaxed) > rule.threshold;
+
+    if (active) {
+      rs.active = true;
+      rs.holdTimer = rule.holdTime;
+      rs.currentLevel =
+          (std::max)(rule.duckLevel, rs.currentLevel - rule.attackRate * dt);
+    } else if (rs.holdTimer > 0.0f) {
+      rs.holdTimer -= dt;
     } else {
-      targetLevels[rule.targetBus] =
-          std::min(targetLevels[rule.targetBus], state.currentLevel);
+      rs.active = false;
+      rs.currentLevel =
+          (std::min)(1.0f, rs.currentLevel + rule.releaseRate * dt);
     }
+    target = (std::min)(target, rs.currentLevel);
+    anyActive = anyActive || rs.active;
   }
 
-  // Apply duck levels to buses
-  for (const auto &[busName, level] : targetLevels) {
-    auto it = buses.find(busName);
-    if (it != buses.end() && it->second) {
-      // Only set volume if level has changed significantly
-      float currentVolume = it->second->GetVolume();
-      if (std::abs(currentVolume - level) > 0.001f) {
-        it->second->SetVolume(level);
-      }
+  if (state.gain != 1.0f || target != 1.0f) {
+    const float step = (target - state.gain) / static_cast<float>(samples);
+    for (size_t c = 0; c < channels; ++c) {
+      ApplyGainRamp(buffer + c * stride, samples, state.gain + step, step);
     }
   }
+  state.gain = target;
+  self.duckGain.store(target, std::memory_order_relaxed);
+  self.ducking.store(anyActive, std::memory_order_relaxed);
 }
 
 bool Ducker::IsDucking(const std::string &targetBus) const {
-  for (const auto &rule : m_Rules) {
-    if (rule.targetBus == targetBus) {
-      std::string key = MakeKey(rule.targetBus, rule.sidechainBus);
-      auto it = m_States.find(key);
-      if (it != m_States.end() && it->second.active) {
-        return true;
-      }
-    }
+  auto it = m_TargetIndices.find(targetBus);
+  if (it == m_TargetIndices.end()) {
+    return false;
   }
-  return false;
+  return m_Activity[it->second].ducking.load(std::memory_order_relaxed);
 }
 
 float Ducker::GetDuckLevel(const std::string &targetBus) const {
-  float minLevel = 1.0f;
-  for (const auto &rule : m_Rules) {
-    if (rule.targetBus == targetBus) {
-      std::string key = MakeKey(rule.targetBus, rule.sidechainBus);
-      auto it = m_States.find(key);
-      if (it != m_States.end()) {
-        minLevel = std::min(minLevel, it->second.currentLevel);
-      }
-    }
+  auto it = m_TargetIndices.find(targetBus);
+  if (it == m_TargetIndices.end()) {
+    return 1.0f;
   }
-  return minLevel;
+  return m_Activity[it->second].duckGain.load(std::memory_order_relaxed);
 }
 
 } // namespace Orpheus
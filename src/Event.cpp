@@ -1,11 +1,16 @@
 #include "../include/Event.h"
+#include "../include/AssetCache.h"
+#include "../include/Bus.h"
 #include "../include/Log.h"
 
+#include <algorithm>
+#include <fstream>
 #include <random>
 #include <vector>
 
 #include <soloud.h>
 #include <soloud_biquadresonantfilter.h>
+#include <soloud_bus.h>
 #include <soloud_wav.h>
 #include <soloud_wavstream.h>
 
@@ -22,18 +27,113 @@ static float RandomFloat(float min, float max) {
   return dist(s_RandomEngine);
 }
 
+// Bytes read ahead of a prefetched stream so its first decode hits the
+// OS file cache instead of the disk
+static constexpr size_t kStreamWarmBytes = 256 * 1024;
+
+// Runs on the asset cache's loader thread
+static std::shared_ptr<void> LoadSource(const std::string &path, bool stream) {
+  std::shared_ptr<SoLoud::AudioSource> source;
+  if (stream) {
+    auto wavstream = std::make_shared<SoLoud::WavStream>();
+    if (wavstream->load(path.c_str()) != SoLoud::SO_NO_ERROR) {
+      return nullptr;
+    }
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> scratch(kStreamWarmBytes);
+    file.read(scratch.data(), static_cast<std::streamsize>(scratch.size()));
+    source = wavstream;
+  } else {
+    auto wav = std::make_shared<SoLoud::Wav>();
+    if (wav->load(path.c_str()) != SoLoud::SO_NO_ERROR) {
+      return nullptr;
+    }
+    source = wav;
+  }
+  return source;
+}
+
+// Paths of every sound an event can play
+static std::vector<std::string> EventPaths(const EventDescriptor &ed) {
+  std::vector<std::string> paths = ed.sounds;
+  if (!ed.path.empty()) {
+    paths.push_back(ed.path);
+  }
+  return paths;
+}
+
 // PIMPL implementation struct
 struct AudioEventImpl {
   SoLoud::Soloud *engine = nullptr;
   SoundBank *bank = nullptr;
   std::vector<std::shared_ptr<SoLoud::AudioSource>> activeSounds;
+  size_t pruneThreshold = 64;
   SoLoud::BiquadResonantFilter occlusionFilter;
-  BusRouterCallback busRouter;
+  BusResolverCallback busResolver;
+  AssetCache cache{LoadSource};
 
   AudioEventImpl(SoLoud::Soloud *eng, SoundBank &bk) : engine(eng), bank(&bk) {
     occlusionFilter.setParams(SoLoud::BiquadResonantFilter::LOWPASS, 22000.0f,
                               0.5f);
   }
+
+  // Get a source for the descriptor and keep it alive while it plays.
+  // Prefetched sources are shared; anything else is loaded here.
+  SoLoud::AudioSource *Load(const std::string &path,
+                            const EventDescriptor &ed) {
+    auto source =
+        std::static_pointer_cast<SoLoud::AudioSource>(cache.Find(path));
+    if (!source) {
+      if (ed.stream) {
+        auto wavstream = std::make_shared<SoLoud::WavStream>();
+        wavstream->load(path.c_str());
+        source = wavstream;
+      } else {
+        auto wav = std::make_shared<SoLoud::Wav>();
+        wav->load(path.c_str());
+        source = wav;
+      }
+    }
+    source->setFilter(0, &occlusionFilter);
+    PruneFinished();
+    activeSounds.push_back(source);
+    return source.get();
+  }
+
+  // Drop sources no voice plays any more, so evicted assets are freed.
+  // Runs when the list doubles, keeping the cost amortized per play.
+  void PruneFinished() {
+    if (activeSounds.size() < pruneThreshold) {
+      return;
+    }
+    activeSounds.erase(
+        std::remove_if(activeSounds.begin(), activeSounds.end(),
+                       [this](const auto &source) {
+                         return engine->countAudioSource(*source) == 0;
+                       }),
+        activeSounds.end());
+    pruneThreshold = (std::max)(size_t{64}, activeSounds.size() * 2);
+  }
+
+  // Play a source into its bus's mixer so bus volume and DSP apply once
+  AudioHandle PlayRouted(SoLoud::AudioSource &source, const EventDescriptor &ed,
+                         const std::string &busName) {
+    float volume = RandomFloat(ed.volumeMin, ed.volumeMax);
+    float pitch = RandomFloat(ed.pitchMin, ed.pitchMax);
+
+    Bus *bus = busResolver ? busResolver(busName) : nullptr;
+    AudioHandle h = 0;
+    if (bus && bus->GetHandle() != 0) {
+      h = static_cast<SoLoud::Bus *>(bus->Raw().ptr)->play(source, volume);
+      if (h != 0) {
+        bus->TrackHandle(h);
+      }
+    } else {
+      h = engine->play(source, volume);
+    }
+    engine->setRelativePlaySpeed(h, pitch);
+    return h;
+  }
 };
 
 AudioEvent::AudioEvent(NativeEngineHandle engine, SoundBank &bank)
@@ -45,8 +145,8 @@ AudioEvent::~AudioEvent() = default;
 AudioEvent::AudioEvent(AudioEvent &&) noexcept = default;
 AudioEvent &AudioEvent::operator=(AudioEvent &&) noexcept = default;
 
-void AudioEvent::SetBusRouter(BusRouterCallback router) {
-  m_Impl->busRouter = std::move(router);
+void AudioEvent::SetBusResolver(BusResolverCallback resolver) {
+  m_Impl->busResolver = std::move(resolver);
 }
 
 AudioHandle AudioEvent::Play(const std::string &eventName,
@@ -57,70 +157,53 @@ AudioHandle AudioEvent::Play(const std::string &eventName,
     return 0;
   }
   const auto &ed = eventResult.Value();
+  const std::string &targetBus =
+      !busName.empty() ? busName : (ed.bus.empty() ? "Master" : ed.bus);
 
-  // Apply randomization within the specified ranges
-  float volume = RandomFloat(ed.volumeMin, ed.volumeMax);
-  float pitch = RandomFloat(ed.pitchMin, ed.pitchMax);
-
-  if (ed.stream) {
-    auto wavstream = std::make_shared<SoLoud::WavStream>();
-    wavstream->load(ed.path.c_str());
-    wavstream->setFilter(0, &m_Impl->occlusionFilter);
-    AudioHandle h = m_Impl->engine->play(*wavstream);
-    m_Impl->activeSounds.push_back(wavstream);
-    m_Impl->engine->setVolume(h, volume);
-    m_Impl->engine->setRelativePlaySpeed(h, pitch);
-    if (m_Impl->busRouter) {
-      m_Impl->busRouter(h, busName);
-    }
-    return h;
-  } else {
-    auto wav = std::make_shared<SoLoud::Wav>();
-    wav->load(ed.path.c_str());
-    wav->setFilter(0, &m_Impl->occlusionFilter);
-    AudioHandle h = m_Impl->engine->play(*wav);
-    m_Impl->activeSounds.push_back(wav);
-    m_Impl->engine->setVolume(h, volume);
-    m_Impl->engine->setRelativePlaySpeed(h, pitch);
-    if (m_Impl->busRouter) {
-      m_Impl->busRouter(h, busName);
-    }
-    return h;
-  }
+  SoLoud::AudioSource *source = m_Impl->Load(ed.path, ed);
+  return m_Impl->PlayRouted(*source, ed, targetBus);
 }
 
 AudioHandle AudioEvent::PlayFromEvent(const std::string &path,
                                       const EventDescriptor &ed) {
-  // Apply randomization within the specified ranges
-  float volume = RandomFloat(ed.volumeMin, ed.volumeMax);
-  float pitch = RandomFloat(ed.pitchMin, ed.pitchMax);
   const std::string &busName = ed.bus.empty() ? "Master" : ed.bus;
 
-  if (ed.stream) {
-    auto wavstream = std::make_shared<SoLoud::WavStream>();
-    wavstream->load(path.c_str());
-    wavstream->setFilter(0, &m_Impl->occlusionFilter);
-    AudioHandle h = m_Impl->engine->play(*wavstream);
-    m_Impl->activeSounds.push_back(wavstream);
-    m_Impl->engine->setVolume(h, volume);
-    m_Impl->engine->setRelativePlaySpeed(h, pitch);
-    if (m_Impl->busRouter) {
-      m_Impl->busRouter(h, busName);
-    }
-    return h;
-  } else {
-    auto wav = std::make_shared<SoLoud::Wav>();
-    wav->load(path.c_str());
-    wav->setFilter(0, &m_Impl->occlusionFilter);
-    AudioHandle h = m_Impl->engine->play(*wav);
-    m_Impl->activeSounds.push_back(wav);
-    m_Impl->engine->setVolume(h, volume);
-    m_Impl->engine->setRelativePlaySpeed(h, pitch);
-    if (m_Impl->busRouter) {
-      m_Impl->busRouter(h, busName);
+  SoLoud::AudioSource *source = m_Impl->Load(path, ed);
+  return m_Impl->PlayRouted(*source, ed, busName);
+}
+
+void AudioEvent::Prefetch(const std::string &eventName) {
+  auto eventResult = m_Impl->bank->FindEvent(eventName);
+  if (eventResult.IsError()) {
+    return;
+  }
+  const auto &ed = eventResult.Value();
+  for (const auto &path : EventPaths(ed)) {
+    m_Impl->cache.Prefetch(path, ed.stream);
+  }
+}
+
+void AudioEvent::ReleasePrefetch(const std::string &eventName) {
+  auto eventResult = m_Impl->bank->FindEvent(eventName);
+  if (eventResult.IsError()) {
+    return;
+  }
+  for (const auto &path : EventPaths(eventResult.Value())) {
+    m_Impl->cache.Release(path);
+  }
+}
+
+bool AudioEvent::IsResident(const std::string &eventName) const {
+  auto eventResult = m_Impl->bank->FindEvent(eventName);
+  if (eventResult.IsError()) {
+    return false;
+  }
+  for (const auto &path : EventPaths(eventResult.Value())) {
+    if (!m_Impl->cache.IsResident(path)) {
+      return false;
     }
-    return h;
   }
+  return true;
 }
 
 NativeFilterHandle AudioEvent::GetOcclusionFilter() {
@@ -0,0 +1,339 @@
+#include "../include/ImpulseResponseSynthesizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Orpheus {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+
+// Second-order Butterworth section (RBJ cookbook, Q = 1/sqrt(2))
+struct Biquad {
+  float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+  static Biquad Make(float frequency, float sampleRate, bool highpass) {
+    const float f = std::clamp(frequency, 1.0f, sampleRate * 0.45f);
+    const float w = 2.0f * kPi * f / sampleRate;
+    const float alpha = std::sin(w) / (2.0f * std::sqrt(0.5f));
+    const float cosw = std::cos(w);
+    const float a0 = 1.0f + alpha;
+    Biquad q;
+    q.b1 = (highpass ? -(1.0f + cosw) : 1.0f - cosw) / a0;
+    q.b0 = q.b2 = (highpass ? 1.0f + cosw : 1.0f - cosw) / 2.0f / a0;
+    q.a1 = -2.0f * cosw / a0;
+    q.a2 = (1.0f - alpha) / a0;
+    return q;
+  }
+
+  // Linkwitz-Riley: the section applied twice
+  void ApplyTwice(std::vector<float> &x) const {
+    for (int pass = 0; pass < 2; ++pass) {
+      float z1 = 0.0f, z2 = 0.0f;
+      for (float &sample : x) {
+        const float in = sample;
+        const float out = b0 * in + z1;
+        z1 = b1 * in - a1 * out + z2;
+        z2 = b2 * in - a2 * out;
+        sample = out;
+      }
+    }
+  }
+};
+
+float BandGain(const PropagationPath &path, int band) {
+  const float gain = band == 0   ? path.gainLow
+                     : band == 1 ? path.gainMid
+                                 : path.gainHigh;
+  return (std::max)(gain, 0.0f);
+}
+
+} // namespace
+
+// =============================================================================
+// ImpulseResponseSynthesizer
+// =============================================================================
+
+ImpulseResponseSynthesizer::ImpulseResponseSynthesizer(
+    ImpulseResponseSettings settings)
+    : m_Settings(settings) {
+  m_Settings.sampleRate = (std::max)(m_Settings.sampleRate, 1000.0f);
+  m_Settings.binWidth = (std::max)(m_Settings.binWidth, 0.0005f);
+  m_Settings.maxLength = (std::max)(m_Settings.maxLength, m_Settings.binWidth);
+}
+
+EnergyHistogram
+ImpulseResponseSynthesizer::BuildHistogram(const PropagationResult &result,
+                                           float startTime) const {
+  EnergyHistogram histogram;
+  histogram.binWidth = m_Settings.binWidth;
+  const auto maxBins =
+      static_cast<size_t>(m_Settings.maxLength / m_Settings.binWidth);
+  for (const PropagationPath &path : result.paths) {
+    if (path.isDirect || path.delay < startTime) {
+      continue;
+    }
+    const auto bin = static_cast<size_t>(path.delay / m_Settings.binWidth);
+    if (bin >= maxBins) {
+      continue;
+    }
+    if (bin >= histogram.mid.size()) {
+      histogram.low.resize(bin + 1, 0.0f);
+      histogram.mid.resize(bin + 1, 0.0f);
+      histogram.high.resize(bin + 1, 0.0f);
+    }
+    histogram.low[bin] += BandGain(path, 0);
+    histogram.mid[bin] += BandGain(path, 1);
+    histogram.high[bin] += BandGain(path, 2);
+  }
+  return histogram;
+}
+
+void ImpulseResponseSynthesizer::Synthesize(const PropagationResult &result,
+                                            std::vector<float> &ir) const {
+  ir.clear();
+  const ImpulseResponseSettings &s = m_Settings;
+  float lastDelay = -1.0f;
+  for (const PropagationPath &path : result.paths) {
+    if (!path.isDirect) {
+      lastDelay = (std::max)(lastDelay, path.delay);
+    }
+  }
+  if (lastDelay < 0.0f) {
+    return;
+  }
+  // Paths past the maximum length are dropped, not the whole response
+  lastDelay = (std::min)(lastDelay, s.maxLength);
+
+  // Traced span, then the decay tail
+  const EnergyHistogram late = BuildHistogram(result, s.earlyTime);
+  const float tracedEnd =
+      (std::max)(lastDelay, static_cast<float>(late.GetBinCount()) *
+                                late.binWidth);
+  const float reverbTime = result.lateReverbTime;
+  const float length =
+      (std::min)(s.maxLength, tracedEnd + (std::max)(reverbTime, 0.0f));
+  const auto count = static_cast<size_t>(std::ceil(length * s.sampleRate)) + 1;
+  const float binSamples = late.binWidth * s.sampleRate;
+  const auto earlyEnd = static_cast<size_t>(s.earlyTime * s.sampleRate);
+  const auto tailStart = static_cast<size_t>(tracedEnd * s.sampleRate);
+
+  // One noise sequence for all bands keeps the summed bands coherent;
+  // uniform noise scaled to unit variance
+  std::vector<float> noise(count);
+  uint32_t state = s.seed != 0 ? s.seed : 1u;
+  for (float &n : noise) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    n = (static_cast<float>(state) / 4294967296.0f * 2.0f - 1.0f) * 1.7320508f;
+  }
+
+  ir.assign(count, 0.0f);
+  std::vector<float> band(count);
+  for (int b = 0; b < 3; ++b) {
+    std::fill(band.begin(), band.end(), 0.0f);
+
+    // Early reflections as taps
+    float earlyEnergy = 0.0f;
+    for (const PropagationPath &path : result.paths) {
+      if (path.isDirect || path.delay >= s.earlyTime) {
+        continue;
+      }
+      const auto at = static_cast<size_t>(path.delay * s.sampleRate + 0.5f);
+      if (at < count) {
+        band[at] += std::sqrt(BandGain(path, b));
+        earlyEnergy += BandGain(path, b);
+      }
+    }
+
+    // Histogram bins as noise with the bin's energy
+    const std::vector<float> &bins =
+        b == 0 ? late.low : b == 1 ? late.mid : late.high;
+    for (size_t bin = 0; bin < bins.size(); ++bin) {
+      if (bins[bin] <= 0.0f) {
+        continue;
+      }
+      const auto first = (std::max)(
+          earlyEnd, static_cast<size_t>(static_cast<float>(bin) * binSamples));
+      const auto last = (std::min)(
+          count, static_cast<size_t>(static_cast<float>(bin + 1) * binSamples));
+      const float amplitude = std::sqrt(bins[bin] / binSamples);
+      for (size_t i = first; i < last; ++i) {
+        band[i] += noise[i] * amplitude;
+      }
+    }
+
+    // Decay tail from the energy level of the last tenth of the histogram,
+    // or of the early taps if no late paths were traced
+    if (reverbTime > 0.0f && tailStart < count) {
+      float reference = 0.0f;
+      const auto firstBin = static_cast<size_t>(s.earlyTime / late.binWidth);
+      if (bins.size() > firstBin) {
+        const size_t span =
+            (std::max)(size_t{1}, (bins.size() - firstBin) / 10);
+        for (size_t bin = bins.size() - span; bin < bins.size(); ++bin) {
+          reference += bins[bin];
+        }
+        reference /= static_cast<float>(span);
+      } else {
+        reference = earlyEnergy * late.binWidth / s.earlyTime;
+      }
+      const float amplitude = std::sqrt(reference / binSamples);
+      // 60 dB of amplitude decay (a factor of 1000) per reverb time
+      const float decay = std::log(1000.0f) / (reverbTime * s.sampleRate);
+      for (size_t i = tailStart; i < count; ++i) {
+        const auto t = static_cast<float>(i - tailStart);
+        band[i] += noise[i] * amplitude * std::exp(-decay * t);
+      }
+    }
+
+    // Band-limit and sum
+    if (b == 0) {
+      Biquad::Make(s.crossoverLow, s.sampleRate, false).ApplyTwice(band);
+    } else if (b == 1) {
+      Biquad::Make(s.crossoverLow, s.sampleRate, true).ApplyTwice(band);
+      Biquad::Make(s.crossoverHigh, s.sampleRate, false).ApplyTwice(band);
+    } else {
+      Biquad::Make(s.crossoverHigh, s.sampleRate, true).ApplyTwice(band);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      ir[i] += band[i];
+    }
+  }
+
+  if (s.normalize) {
+    double energy = 0.0;
+    for (float sample : ir) {
+      energy += static_cast<double>(sample) * sample;
+    }
+    if (energy > 0.0) {
+      const auto scale = static_cast<float>(1.0 / std::sqrt(energy));
+      for (float &sample : ir) {
+        sample *= scale;
+      }
+    }
+  }
+}
+
+// =============================================================================
+// ImpulseResponseUpdater
+// =============================================================================
+
+struct ImpulseResponseUpdaterImpl {
+  ImpulseResponseUpdaterImpl(ConvolutionReverb &target,
+                             const ImpulseResponseSettings &settings)
+      : reverb(target), synthesizer(settings) {}
+
+  ConvolutionReverb &reverb;
+  ImpulseResponseSynthesizer synthesizer;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  PropagationResult pending;
+  bool hasPending = false;
+  bool busy = false;
+  bool stop = false;
+  bool accepted = false; ///< A submission was accepted (lastAccepted valid)
+  std::chrono::steady_clock::time_point lastAccepted;
+  std::chrono::milliseconds minInterval{250};
+  float crossfade = 0.25f;
+  std::atomic<uint64_t> updates{0};
+  std::thread worker;
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return stop || hasPending; });
+      if (stop) {
+        return;
+      }
+      PropagationResult result = std::move(pending);
+      hasPending = false;
+      busy = true;
+      const float fade = crossfade;
+
+      lock.unlock();
+      std::vector<float> ir;
+      synthesizer.Synthesize(result, ir);
+      if (!ir.empty()) {
+        reverb.SetImpulseResponse(ir.data(), ir.size(), fade);
+        ++updates;
+      }
+      lock.lock();
+
+      busy = false;
+      if (!hasPending) {
+        idle.notify_all();
+      }
+    }
+  }
+};
+
+ImpulseResponseUpdater::ImpulseResponseUpdater(
+    ConvolutionReverb &reverb, ImpulseResponseSettings settings) {
+  settings.sampleRate = reverb.GetSampleRate();
+  m_Impl = std::make_unique<ImpulseResponseUpdaterImpl>(reverb, settings);
+}
+
+ImpulseResponseUpdater::~ImpulseResponseUpdater() {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    m_Impl->stop = true;
+  }
+  m_Impl->wake.notify_all();
+  if (m_Impl->worker.joinable()) {
+    m_Impl->worker.join();
+  }
+}
+
+bool ImpulseResponseUpdater::Submit(const PropagationResult &result) {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    const auto now = std::chrono::steady_clock::now();
+    if (m_Impl->accepted &&
+        now - m_Impl->lastAccepted < m_Impl->minInterval) {
+      return false;
+    }
+    m_Impl->accepted = true;
+    m_Impl->lastAccepted = now;
+    m_Impl->pending = result;
+    m_Impl->hasPending = true;
+
+    // The thread starts with the first accepted submission
+    if (!m_Impl->worker.joinable()) {
+      m_Impl->worker = std::thread([impl = m_Impl.get()] { impl->Run(); });
+    }
+  }
+  m_Impl->wake.notify_one();
+  return true;
+}
+
+void ImpulseResponseUpdater::SetMinInterval(
+    std::chrono::milliseconds interval) {
+  std::lock_guard<std::mutex> lock(m_Impl->mutex);
+  m_Impl->minInterval = interval;
+}
+
+void ImpulseResponseUpdater::SetCrossfadeTime(float seconds) {
+  std::lock_guard<std::mutex> lock(m_Impl->mutex);
+  m_Impl->crossfade = (std::max)(seconds, 0.0f);
+}
+
+uint64_t ImpulseResponseUpdater::GetUpdateCount() const {
+  return m_Impl->updates;
+}
+
+bool ImpulseResponseUpdater::WaitIdle(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(m_Impl->mutex);
+  return m_Impl->idle.wait_for(lock, timeout, [this] {
+    return !m_Impl->hasPending && !m_Impl->busy;
+  });
+}
+
+} // namespace Orpheus
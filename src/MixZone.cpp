@@ -5,14 +5,20 @@ namespace Orpheus {
 MixZone::MixZone(const std::string &name, const std::string &snapshotName,
                  const Vector3 &position, float innerRadius, float outerRadius,
                  uint8_t priority, float fadeInTime, float fadeOutTime)
-    : m_Name(name), m_SnapshotName(snapshotName), m_Position(position),
-      m_InnerRadius(innerRadius), m_OuterRadius(outerRadius),
+    : m_Name(name), m_SnapshotName(snapshotName),
+      m_Geometry(ZoneGeometry::Sphere(position, innerRadius, outerRadius)),
+      m_Priority(priority), m_FadeInTime(fadeInTime),
+      m_FadeOutTime(fadeOutTime) {}
+
+MixZone::MixZone(const std::string &name, const std::string &snapshotName,
+                 const ZoneGeometry &geometry, uint8_t priority,
+                 float fadeInTime, float fadeOutTime)
+    : m_Name(name), m_SnapshotName(snapshotName), m_Geometry(geometry),
       m_Priority(priority), m_FadeInTime(fadeInTime),
       m_FadeOutTime(fadeOutTime) {}
 
 float MixZone::Update(const Vector3 &listenerPos) {
-  float dist = Distance(listenerPos, m_Position);
-  float newBlend = ComputeBlend(dist);
+  float newBlend = m_Geometry.ComputeVolume(listenerPos);
 
   bool wasActive = m_BlendFactor > 0.0f;
   bool isNowActive = newBlend > 0.0f;
@@ -44,22 +50,13 @@ bool MixZone::JustEntered() const { return m_JustEntered; }
 bool MixZone::JustExited() const { return m_JustExited; }
 
 float MixZone::GetDistance(const Vector3 &listenerPos) const {
-  return Distance(listenerPos, m_Position);
-}
-
-float MixZone::Distance(const Vector3 &a, const Vector3 &b) const {
-  float dx = a.x - b.x;
-  float dy = a.y - b.y;
-  float dz = a.z - b.z;
+  const Vector3 &c = m_Geometry.GetCenter();
+  float dx = listenerPos.x - c.x;
+  float dy = listenerPos.y - c.y;
+  float dz = listenerPos.z - c.z;
   return sqrtf(dx * dx + dy * dy + dz * dz);
 }
 
-float MixZone::ComputeBlend(float dist) const {
-  if (dist < m_InnerRadius)
-    return 1.0f;
-  if (dist > m_OuterRadius)
-    return 0.0f;
-  return 1.0f - ((dist - m_InnerRadius) / (m_OuterRadius - m_InnerRadius));
-}
+const ZoneGeometry &MixZone::GetGeometry() const { return m_Geometry; }
 
 } // namespace Orpheus
@@ -0,0 +1,68 @@
+#include "../include/OcclusionCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Orpheus {
+
+void OcclusionCache::SetCellSize(float size) {
+  m_CellSize = std::max(size, 0.0f);
+  m_Entries.clear();
+}
+
+void OcclusionCache::SetLifetime(float seconds) {
+  m_Lifetime = std::max(seconds, 0.0f);
+}
+
+void OcclusionCache::SetGeometryVersion(uint32_t version) {
+  if (version != m_Version) {
+    m_Version = version;
+    m_Entries.clear();
+  }
+}
+
+void OcclusionCache::Clear() { m_Entries.clear(); }
+
+OcclusionCache::Key OcclusionCache::MakeKey(const Vector3 &source,
+                                            const Vector3 &listener) const {
+  const float scale = 1.0f / m_CellSize;
+  auto cell = [scale](float v) {
+    return static_cast<int32_t>(std::floor(v * scale));
+  };
+  return Key{{cell(source.x), cell(source.y), cell(source.z), cell(listener.x),
+              cell(listener.y), cell(listener.z)}};
+}
+
+const OcclusionCache::Entry *OcclusionCache::Find(const Key &key,
+                                                  float now) const {
+  if (!IsEnabled()) {
+    return nullptr;
+  }
+  auto it = m_Entries.find(key);
+  if (it == m_Entries.end() || Expired(it->second, now)) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void OcclusionCache::Store(const Key &key, float obstruction,
+                           float occlusionBias, float now) {
+  if (!IsEnabled()) {
+    return;
+  }
+  if (m_Entries.size() >= kMaxEntries && m_Entries.count(key) == 0) {
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+      it = Expired(it->second, now) ? m_Entries.erase(it) : std::next(it);
+    }
+    if (m_Entries.size() >= kMaxEntries) {
+      m_Entries.clear();
+    }
+  }
+  m_Entries[key] = Entry{obstruction, occlusionBias, now};
+}
+
+bool OcclusionCache::Expired(const Entry &entry, float now) const {
+  return m_Lifetime > 0.0f && now - entry.time >= m_Lifetime;
+}
+
+} // namespace Orpheus
@@ -1,5 +1,7 @@
 #include "../include/OcclusionProcessor.h"
 
+#include <limits>
+
 #include <soloud.h>
 #include <soloud_biquadresonantfilter.h>
 
@@ -11,8 +13,42 @@ void OcclusionProcessor::SetQueryCallback(OcclusionQueryCallback callback) {
   m_QueryCallback = std::move(callback);
 }
 
-void OcclusionProcessor::RegisterMaterial(const OcclusionMaterial &mat) {
-  m_Materials[mat.name] = mat;
+void OcclusionProcessor::SetBatchCallback(OcclusionBatchCallback callback) {
+  m_BatchCallback = std::move(callback);
+}
+
+void OcclusionProcessor::SetPropagationField(const PropagationField *field) {
+  m_Field = field;
+}
+
+void OcclusionProcessor::SetPortalGraph(const PortalGraph *graph) {
+  m_Portals = graph;
+}
+
+void OcclusionProcessor::CompleteBatch(OcclusionBatchID batch,
+                                       const OcclusionRayHit *hits,
+                                       size_t count) {
+  std::lock_guard<std::mutex> lock(m_CompletedMutex);
+  m_Completed.push_back(
+      {batch, std::vector<OcclusionRayHit>(hits, hits + count)});
+}
+
+OcclusionMaterialID
+OcclusionProcessor::RegisterMaterial(const OcclusionMaterial &mat) {
+  auto [it, inserted] = m_MaterialIDs.try_emplace(
+      mat.name, static_cast<OcclusionMaterialID>(m_Materials.size()));
+  if (inserted) {
+    m_Materials.push_back(mat);
+  } else {
+    m_Materials[it->second] = mat;
+  }
+  return it->second;
+}
+
+OcclusionMaterialID
+OcclusionProcessor::GetMaterialID(const std::string &name) const {
+  auto it = m_MaterialIDs.find(name);
+  return it != m_MaterialIDs.end() ? it->second : kInvalidMaterial;
 }
 
 void OcclusionProcessor::SetOcclusionThreshold(float threshold) {
@@ -38,70 +74,145 @@ void OcclusionProcessor::SetVolumeReduction(float maxReduction) {
   m_MaxVolumeReduction = std::clamp(maxReduction, 0.0f, 1.0f);
 }
 
-void OcclusionProcessor::Update(Voice &voice, const Vector3 &listenerPos,
-                                float dt) {
-  if (!m_Enabled || !m_QueryCallback) {
-    voice.obstruction = 0.0f;
-    voice.occlusion = 0.0f;
-    voice.targetLowPassFreq = m_MaxLowPassFreq;
-    voice.occlusionVolume = 1.0f;
-    SmoothValues(voice, dt);
-    return;
-  }
+void OcclusionProcessor::SetMaxQueriesPerFrame(uint32_t count) {
+  m_MaxQueriesPerFrame = std::max(count, 1u);
+}
 
-  m_TimeSinceLastUpdate += dt;
-  if (m_TimeSinceLastUpdate < 1.0f / m_UpdateRate) {
-    SmoothValues(voice, dt);
+void OcclusionProcessor::Update(Voice *const *voices, size_t count,
+                                const Vector3 &listenerPos, float dt) {
+  m_LastQueryCount = 0;
+  m_LastCacheHitCount = 0;
+  m_LastFieldSampleCount = 0;
+  m_LastPortalPathCount = 0;
+  m_Time += dt;
+  const bool canQuery = m_QueryCallback || m_BatchCallback;
+  const bool usePortals =
+      m_Portals && m_Portals->GetListenerRoom() != PortalGraph::kInvalidRoom;
+  if (!m_Enabled || (!canQuery && !m_Field && !usePortals)) {
+    for (size_t i = 0; i < count; ++i) {
+      voices[i]->apparentPosition = voices[i]->position;
+      ClearOcclusion(*voices[i]);
+      SmoothValues(*voices[i], dt);
+    }
     return;
   }
-  m_TimeSinceLastUpdate = 0.0f;
-
-  auto hits = m_QueryCallback(voice.position, listenerPos);
-
-  float totalObstruction = 0.0f;
-  float totalOcclusionBias = 0.0f;
 
-  for (const auto &hit : hits) {
-    const OcclusionMaterial &mat = GetMaterial(hit.materialName);
-    float thicknessFactor = std::min(hit.thickness, 3.0f) / 3.0f;
-    totalObstruction += mat.obstruction * (0.5f + 0.5f * thicknessFactor);
-    totalOcclusionBias += mat.occlusionBias;
+  // Staleness is age relative to the voice's own interval; voices never
+  // queried are the most urgent
+  m_Due.clear();
+  for (size_t i = 0; i < count; ++i) {
+    Voice &voice = *voices[i];
+    voice.apparentPosition = voice.position;
+    if (usePortals) {
+      voice.occlusionRoom =
+          m_Portals->FindRoom(voice.position, voice.occlusionRoom);
+      const PortalPath path =
+          m_Portals->FindPath(voice.position, listenerPos, voice.occlusionRoom);
+      if (path.valid) {
+        ApplyTotals(voice, path.obstruction, 0.0f);
+        voice.apparentPosition = path.virtualPosition;
+        voice.occlusionAge = 0.0f;
+        ++m_LastPortalPathCount;
+        continue;
+      }
+    }
+    if (m_Field) {
+      const PropagationSample sample = m_Field->Sample(voice.position,
+                                                       listenerPos);
+      if (sample.valid) {
+        ApplyTotals(voice, sample.obstruction, 0.0f);
+        voice.occlusionAge = 0.0f;
+        ++m_LastFieldSampleCount;
+        continue;
+      }
+    }
+    if (!canQuery) {
+      ClearOcclusion(voice);
+      continue;
+    }
+    float staleness = std::numeric_limits<float>::max();
+    if (voice.occlusionAge >= 0.0f) {
+      voice.occlusionAge += dt;
+      staleness = voice.occlusionAge / GetRefreshInterval(voice);
+    }
+    if (staleness >= 1.0f) {
+      m_Due.emplace_back(staleness, &voice);
+    }
   }
 
-  voice.obstruction = std::clamp(totalObstruction, 0.0f, 1.0f);
+  // Cache hits are answered without using the budget
+  if (m_Cache.IsEnabled()) {
+    size_t kept = 0;
+    for (const auto &due : m_Due) {
+      if (!ApplyCached(*due.second, listenerPos)) {
+        m_Due[kept++] = due;
+      }
+    }
+    m_Due.resize(kept);
+  }
 
-  float occlusionValue = voice.obstruction + totalOcclusionBias;
-  if (occlusionValue >= m_OcclusionThreshold) {
-    float t =
-        (occlusionValue - m_OcclusionThreshold) / (1.0f - m_OcclusionThreshold);
-    voice.occlusion = std::clamp(t, 0.0f, 1.0f);
+  auto byStaleness = [](const std::pair<float, Voice *> &a,
+                        const std::pair<float, Voice *> &b) {
+    return a.first > b.first;
+  };
+  if (m_Due.size() > m_MaxQueriesPerFrame) {
+    std::nth_element(m_Due.begin(), m_Due.begin() + m_MaxQueriesPerFrame,
+                     m_Due.end(), byStaleness);
+    m_Due.resize(m_MaxQueriesPerFrame);
+  }
+  if (m_BatchCallback) {
+    Submit(listenerPos);
   } else {
-    voice.occlusion = 0.0f;
+    for (const auto &[staleness, voice] : m_Due) {
+      // Voices sharing cells with one queried this frame reuse its result
+      if (!ApplyCached(*voice, listenerPos)) {
+        Query(*voice, listenerPos);
+        ++m_LastQueryCount;
+      }
+    }
+  }
+  for (const auto &[staleness, voice] : m_Due) {
+    voice->occlusionAge = 0.0f;
   }
 
-  float combined = std::max(voice.obstruction, voice.occlusion);
+  // Includes batches the callback completed synchronously
+  ApplyCompleted(voices, count);
 
-  float freqT = 1.0f - combined;
-  voice.targetLowPassFreq =
-      m_MinLowPassFreq * std::pow(m_MaxLowPassFreq / m_MinLowPassFreq, freqT);
-
-  voice.occlusionVolume = 1.0f - (combined * m_MaxVolumeReduction);
+  for (size_t i = 0; i < count; ++i) {
+    SmoothValues(*voices[i], dt);
+  }
+}
 
-  SmoothValues(voice, dt);
+void OcclusionProcessor::Update(Voice &voice, const Vector3 &listenerPos,
+                                float dt) {
+  Voice *one = &voice;
+  Update(&one, 1, listenerPos, dt);
 }
 
 void OcclusionProcessor::ApplyDSP(NativeEngineHandle engine, Voice &voice) {
   auto *soloudEngine = static_cast<SoLoud::Soloud *>(engine.ptr);
-  if (!m_Enabled || voice.handle == 0 || !soloudEngine) {
+  if ((!m_Enabled && !voice.hasPropagation) || voice.handle == 0 ||
+      !soloudEngine) {
     return;
   }
 
-  float occludedVolume = voice.volume * voice.occlusionVolume;
+  // Ray-traced propagation stacks on occlusion: volumes multiply and the
+  // lower cutoff wins
+  float occludedVolume = voice.volume;
+  float lowPassFreq = 22000.0f;
+  if (m_Enabled) {
+    occludedVolume *= voice.occlusionVolume;
+    lowPassFreq = voice.currentLowPassFreq;
+  }
+  if (voice.hasPropagation) {
+    occludedVolume *= voice.propagationVolumeSmoothed;
+    lowPassFreq = std::min(lowPassFreq, voice.propagationLowPassSmoothed);
+  }
   soloudEngine->setVolume(voice.handle, occludedVolume);
 
   soloudEngine->setFilterParameter(voice.handle, 0,
                                    SoLoud::BiquadResonantFilter::FREQUENCY,
-                                   voice.currentLowPassFreq);
+                                   lowPassFreq);
 }
 
 bool OcclusionProcessor::IsEnabled() const { return m_Enabled; }
@@ -110,6 +221,32 @@ float OcclusionProcessor::GetOcclusionThreshold() const {
   return m_OcclusionThreshold;
 }
 
+uint32_t OcclusionProcessor::GetLastQueryCount() const {
+  return m_LastQueryCount;
+}
+
+uint32_t OcclusionProcessor::GetLastCacheHitCount() const {
+  return m_LastCacheHitCount;
+}
+
+uint32_t OcclusionProcessor::GetLastFieldSampleCount() const {
+  return m_LastFieldSampleCount;
+}
+
+uint32_t OcclusionProcessor::GetLastPortalPathCount() const {
+  return m_LastPortalPathCount;
+}
+
+size_t OcclusionProcessor::GetPendingBatchCount() const {
+  return m_Pending.size();
+}
+
+float OcclusionProcessor::GetRefreshInterval(const Voice &voice) const {
+  const float audibility = std::clamp(voice.audibility, 0.0f, 1.0f);
+  return (1.0f + (kQuietIntervalScale - 1.0f) * (1.0f - audibility)) /
+         m_UpdateRate;
+}
+
 void OcclusionProcessor::RegisterDefaultMaterials() {
   RegisterMaterial(OcclusionMaterials::Glass);
   RegisterMaterial(OcclusionMaterials::Fabric);
@@ -127,14 +264,177 @@ void OcclusionProcessor::RegisterDefaultMaterials() {
 
 const OcclusionMaterial &
 OcclusionProcessor::GetMaterial(const std::string &name) const {
-  auto it = m_Materials.find(name);
-  if (it != m_Materials.end()) {
-    return it->second;
+  return GetMaterial(GetMaterialID(name));
+}
+
+const OcclusionMaterial &
+OcclusionProcessor::GetMaterial(OcclusionMaterialID id) const {
+  if (id < m_Materials.size()) {
+    return m_Materials[id];
   }
   static const OcclusionMaterial defaultMat = OcclusionMaterials::Default;
   return defaultMat;
 }
 
+void OcclusionProcessor::Query(Voice &voice, const Vector3 &listenerPos) {
+  auto hits = m_QueryCallback(voice.position, listenerPos);
+
+  float totalObstruction = 0.0f;
+  float totalOcclusionBias = 0.0f;
+
+  for (const auto &hit : hits) {
+    const OcclusionMaterial &mat = GetMaterial(hit.materialName);
+    float thicknessFactor = std::min(hit.thickness, 3.0f) / 3.0f;
+    totalObstruction += mat.obstruction * (0.5f + 0.5f * thicknessFactor);
+    totalOcclusionBias += mat.occlusionBias;
+  }
+
+  ApplyTotals(voice, totalObstruction, totalOcclusionBias);
+  if (m_Cache.IsEnabled()) {
+    m_Cache.Store(m_Cache.MakeKey(voice.position, listenerPos),
+                  totalObstruction, totalOcclusionBias, m_Time);
+  }
+}
+
+bool OcclusionProcessor::ApplyCached(Voice &voice,
+                                     const Vector3 &listenerPos) {
+  const OcclusionCache::Entry *entry =
+      m_Cache.Find(m_Cache.MakeKey(voice.position, listenerPos), m_Time);
+  if (!entry) {
+    return false;
+  }
+  ApplyTotals(voice, entry->obstruction, entry->occlusionBias);
+  voice.occlusionAge = 0.0f;
+  ++m_LastCacheHitCount;
+  return true;
+}
+
+void OcclusionProcessor::Submit(const Vector3 &listenerPos) {
+  if (m_Due.empty()) {
+    return;
+  }
+
+  PendingBatch batch{m_NextBatchID++, m_Cache.GetGeometryVersion(), {}, {}};
+  if (m_Pending.size() >= kMaxPendingBatches) {
+    // Recycle the oldest batch; its voices have been re-requested by now
+    batch.rays = std::move(m_Pending.front().rays);
+    batch.voices = std::move(m_Pending.front().voices);
+    m_Pending.erase(m_Pending.begin());
+  }
+  batch.rays.clear();
+  batch.voices.clear();
+
+  // Voices in the same pair of cache cells share one ray
+  m_BatchRays.clear();
+  for (const auto &[staleness, voice] : m_Due) {
+    auto ray = static_cast<uint32_t>(batch.rays.size());
+    if (m_Cache.IsEnabled()) {
+      auto [it, inserted] = m_BatchRays.try_emplace(
+          m_Cache.MakeKey(voice->position, listenerPos), ray);
+      ray = it->second;
+      if (inserted) {
+        batch.rays.push_back({voice->position, listenerPos});
+      }
+    } else {
+      batch.rays.push_back({voice->position, listenerPos});
+    }
+    batch.voices.emplace_back(ray, voice->id);
+  }
+  m_LastQueryCount = static_cast<uint32_t>(batch.rays.size());
+
+  const OcclusionBatchID id = batch.id;
+  m_Pending.push_back(std::move(batch));
+  const PendingBatch &submitted = m_Pending.back();
+  m_BatchCallback(id, submitted.rays.data(), submitted.rays.size());
+}
+
+void OcclusionProcessor::ApplyCompleted(Voice *const *voices, size_t count) {
+  {
+    std::lock_guard<std::mutex> lock(m_CompletedMutex);
+    if (m_Completed.empty()) {
+      return;
+    }
+    m_Applying.swap(m_Completed);
+  }
+
+  m_VoiceByID.clear();
+  for (size_t i = 0; i < count; ++i) {
+    m_VoiceByID.emplace(voices[i]->id, voices[i]);
+  }
+
+  for (const CompletedBatch &completed : m_Applying) {
+    auto pending = std::find_if(
+        m_Pending.begin(), m_Pending.end(),
+        [&](const PendingBatch &batch) { return batch.id == completed.id; });
+    if (pending == m_Pending.end()) {
+      continue; // Dropped or already completed
+    }
+
+    const size_t rayCount = pending->rays.size();
+    m_RayObstruction.assign(rayCount, 0.0f);
+    m_RayBias.assign(rayCount, 0.0f);
+    for (const OcclusionRayHit &hit : completed.hits) {
+      if (hit.ray >= rayCount) {
+        continue;
+      }
+      const OcclusionMaterial &mat = GetMaterial(hit.material);
+      float thicknessFactor = std::min(hit.thickness, 3.0f) / 3.0f;
+      m_RayObstruction[hit.ray] +=
+          mat.obstruction * (0.5f + 0.5f * thicknessFactor);
+      m_RayBias[hit.ray] += mat.occlusionBias;
+    }
+
+    // Results traced against older geometry are applied but not cached
+    if (m_Cache.IsEnabled() &&
+        pending->geometryVersion == m_Cache.GetGeometryVersion()) {
+      for (size_t ray = 0; ray < rayCount; ++ray) {
+        const OcclusionRay &r = pending->rays[ray];
+        m_Cache.Store(m_Cache.MakeKey(r.source, r.listener),
+                      m_RayObstruction[ray], m_RayBias[ray], m_Time);
+      }
+    }
+
+    // Voices that stopped or went virtual meanwhile are skipped
+    for (const auto &[ray, voiceID] : pending->voices) {
+      auto it = m_VoiceByID.find(voiceID);
+      if (it != m_VoiceByID.end()) {
+        ApplyTotals(*it->second, m_RayObstruction[ray], m_RayBias[ray]);
+      }
+    }
+    m_Pending.erase(pending);
+  }
+  m_Applying.clear();
+}
+
+void OcclusionProcessor::ApplyTotals(Voice &voice, float obstruction,
+                                     float occlusionBias) const {
+  voice.obstruction = std::clamp(obstruction, 0.0f, 1.0f);
+
+  float occlusionValue = voice.obstruction + occlusionBias;
+  if (occlusionValue >= m_OcclusionThreshold) {
+    float t =
+        (occlusionValue - m_OcclusionThreshold) / (1.0f - m_OcclusionThreshold);
+    voice.occlusion = std::clamp(t, 0.0f, 1.0f);
+  } else {
+    voice.occlusion = 0.0f;
+  }
+
+  float combined = std::max(voice.obstruction, voice.occlusion);
+
+  float freqT = 1.0f - combined;
+  voice.targetLowPassFreq =
+      m_MinLowPassFreq * std::pow(m_MaxLowPassFreq / m_MinLowPassFreq, freqT);
+
+  voice.occlusionVolume = 1.0f - (combined * m_MaxVolumeReduction);
+}
+
+void OcclusionProcessor::ClearOcclusion(Voice &voice) const {
+  voice.obstruction = 0.0f;
+  voice.occlusion = 0.0f;
+  voice.targetLowPassFreq = m_MaxLowPassFreq;
+  voice.occlusionVolume = 1.0f;
+}
+
 void OcclusionProcessor::SmoothValues(Voice &voice, float dt) {
   float alpha = 1.0f - std::exp(-dt / m_SmoothingTime);
   voice.currentLowPassFreq +=
@@ -0,0 +1,200 @@
+#include "../include/OcclusionScene.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Orpheus {
+
+namespace {
+
+/// Crossings of one mesh closer than this (in segment units) are merged.
+constexpr float kCoincidentT = 1e-5f;
+
+} // namespace
+
+OcclusionMeshID OcclusionScene::AddMesh(const Vector3 *vertices,
+                                        size_t vertexCount,
+                                        const uint32_t *indices,
+                                        size_t indexCount,
+                                        OcclusionMaterialID material,
+                                        float shellThickness) {
+  if (indexCount % 3 != 0 ||
+      std::any_of(indices, indices + indexCount,
+                  [vertexCount](uint32_t i) { return i >= vertexCount; })) {
+    return kInvalidMesh;
+  }
+
+  Mesh mesh;
+  mesh.vertices.assign(vertices, vertices + vertexCount);
+  mesh.indices.assign(indices, indices + indexCount);
+  mesh.firstVertex = 0;
+  mesh.material = material;
+  mesh.shellThickness = std::max(shellThickness, 0.0f);
+  mesh.alive = true;
+  m_Meshes.push_back(std::move(mesh));
+  m_NeedsRebuild = true;
+  return static_cast<OcclusionMeshID>(m_Meshes.size() - 1);
+}
+
+bool OcclusionScene::UpdateMesh(OcclusionMeshID mesh, const Vector3 *vertices,
+                                size_t vertexCount) {
+  if (mesh >= m_Meshes.size() || !m_Meshes[mesh].alive ||
+      m_Meshes[mesh].vertices.size() != vertexCount) {
+    return false;
+  }
+  Mesh &m = m_Meshes[mesh];
+  std::copy(vertices, vertices + vertexCount, m.vertices.begin());
+  if (!m_NeedsRebuild) {
+    std::copy(vertices, vertices + vertexCount,
+              m_Vertices.begin() + m.firstVertex);
+    m_NeedsRefit = true;
+  }
+  return true;
+}
+
+void OcclusionScene::SetMeshMaterial(OcclusionMeshID mesh,
+                                     OcclusionMaterialID material) {
+  if (mesh < m_Meshes.size() && m_Meshes[mesh].material != material) {
+    m_Meshes[mesh].material = material;
+    ++m_Version;
+  }
+}
+
+void OcclusionScene::RemoveMesh(OcclusionMeshID mesh) {
+  if (mesh >= m_Meshes.size() || !m_Meshes[mesh].alive) {
+    return;
+  }
+  Mesh &m = m_Meshes[mesh];
+  m.alive = false;
+  m.vertices = {};
+  m.indices = {};
+  m_NeedsRebuild = true;
+}
+
+void OcclusionScene::Commit() {
+  if (m_NeedsRebuild) {
+    m_Vertices.clear();
+    m_Indices.clear();
+    m_TriangleMesh.clear();
+    for (size_t id = 0; id < m_Meshes.size(); ++id) {
+      Mesh &mesh = m_Meshes[id];
+      if (!mesh.alive) {
+        continue;
+      }
+      mesh.firstVertex = static_cast<uint32_t>(m_Vertices.size());
+      m_Vertices.insert(m_Vertices.end(), mesh.vertices.begin(),
+                        mesh.vertices.end());
+      for (uint32_t index : mesh.indices) {
+        m_Indices.push_back(mesh.firstVertex + index);
+      }
+      m_TriangleMesh.insert(m_TriangleMesh.end(), mesh.indices.size() / 3,
+                            static_cast<OcclusionMeshID>(id));
+    }
+    m_BVH.Build(m_Vertices.data(), m_Indices.data(), m_TriangleMesh.size());
+  } else if (m_NeedsRefit) {
+    m_BVH.Refit(m_Vertices.data(), m_Indices.data());
+  } else {
+    return;
+  }
+  m_NeedsRebuild = false;
+  m_NeedsRefit = false;
+  ++m_Version;
+}
+
+size_t OcclusionScene::Raycast(const Vector3 &source, const Vector3 &listener,
+                               std::vector<OcclusionRayHit> &hits,
+                               uint32_t ray) const {
+  std::vector<BVHHit> scratch;
+  return Resolve(source, listener, ray, scratch, hits);
+}
+
+void OcclusionScene::Raycast(const OcclusionRay *rays, size_t count,
+                             std::vector<OcclusionRayHit> &hits) const {
+  std::vector<BVHHit> scratch;
+  for (size_t i = 0; i < count; ++i) {
+    Resolve(rays[i].source, rays[i].listener, static_cast<uint32_t>(i),
+            scratch, hits);
+  }
+}
+
+void OcclusionScene::GetTriangle(size_t triangle, Vector3 &a, Vector3 &b,
+                                 Vector3 &c,
+                                 OcclusionMaterialID &material) const {
+  a = m_Vertices[m_Indices[3 * triangle]];
+  b = m_Vertices[m_Indices[3 * triangle + 1]];
+  c = m_Vertices[m_Indices[3 * triangle + 2]];
+  material = m_Meshes[m_TriangleMesh[triangle]].material;
+}
+
+size_t OcclusionScene::GetMeshCount() const {
+  return static_cast<size_t>(
+      std::count_if(m_Meshes.begin(), m_Meshes.end(),
+                    [](const Mesh &mesh) { return mesh.alive; }));
+}
+
+size_t OcclusionScene::Resolve(const Vector3 &source, const Vector3 &listener,
+                               uint32_t ray, std::vector<BVHHit> &scratch,
+                               std::vector<OcclusionRayHit> &hits) const {
+  const Vector3 dir{listener.x - source.x, listener.y - source.y,
+                    listener.z - source.z};
+  scratch.clear();
+  m_BVH.IntersectAll(source, dir, 1.0f, scratch);
+  if (scratch.empty()) {
+    return 0;
+  }
+
+  // Group crossings by mesh, in order along the segment
+  std::sort(scratch.begin(), scratch.end(),
+            [this](const BVHHit &a, const BVHHit &b) {
+              const OcclusionMeshID ma = m_TriangleMesh[a.triangle];
+              const OcclusionMeshID mb = m_TriangleMesh[b.triangle];
+              return ma != mb ? ma < mb : a.t < b.t;
+            });
+
+  const float length = std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+  const size_t before = hits.size();
+  size_t i = 0;
+  while (i < scratch.size()) {
+    const OcclusionMeshID id = m_TriangleMesh[scratch[i].triangle];
+    const Mesh &mesh = m_Meshes[id];
+    size_t end = i;
+    while (end < scratch.size() &&
+           m_TriangleMesh[scratch[end].triangle] == id) {
+      ++end;
+    }
+
+    // Solid meshes pair entries with exits. A leading exit means the
+    // source is inside the mesh, a trailing entry that the listener is.
+    bool inside = false;
+    float entry = 0.0f;
+    const BVHHit *prev = nullptr;
+    for (; i < end; ++i) {
+      const BVHHit &hit = scratch[i];
+      // Rays through a shared edge hit both triangles; count it once
+      if (prev && prev->frontFacing == hit.frontFacing &&
+          hit.t - prev->t < kCoincidentT) {
+        continue;
+      }
+      prev = &hit;
+
+      if (mesh.shellThickness > 0.0f) {
+        hits.push_back({ray, mesh.material, mesh.shellThickness});
+      } else if (hit.frontFacing) {
+        if (!inside) {
+          inside = true;
+          entry = hit.t;
+        }
+      } else {
+        hits.push_back({ray, mesh.material, (hit.t - entry) * length});
+        inside = false;
+        entry = hit.t;
+      }
+    }
+    if (inside) {
+      hits.push_back({ray, mesh.material, (1.0f - entry) * length});
+    }
+  }
+  return hits.size() - before;
+}
+
+} // namespace Orpheus
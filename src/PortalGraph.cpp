@@ -0,0 +1,225 @@
+#include "../include/PortalGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace Orpheus {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+float Distance(const Vector3 &a, const Vector3 &b) {
+  const float dx = a.x - b.x;
+  const float dy = a.y - b.y;
+  const float dz = a.z - b.z;
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+RoomID PortalGraph::CreateRoom(const ZoneGeometry &shape) {
+  Room room{shape, {}, {}, {}};
+  shape.GetBounds(room.min, room.max);
+  m_Rooms.push_back(std::move(room));
+  m_Dirty = true;
+  return static_cast<RoomID>(m_Rooms.size() - 1);
+}
+
+PortalID PortalGraph::AddPortal(RoomID a, RoomID b, const Vector3 &position,
+                                float openness) {
+  if (a >= m_Rooms.size() || b >= m_Rooms.size() || a == b) {
+    return kInvalidPortal;
+  }
+  const auto id = static_cast<PortalID>(m_Portals.size());
+  m_Portals.push_back({{a, b}, position, std::clamp(openness, 0.0f, 1.0f)});
+  m_Rooms[a].portals.push_back(id);
+  m_Rooms[b].portals.push_back(id);
+  m_Dirty = true;
+  return id;
+}
+
+void PortalGraph::SetPortalOpenness(PortalID portal, float openness) {
+  if (portal >= m_Portals.size()) {
+    return;
+  }
+  openness = std::clamp(openness, 0.0f, 1.0f);
+  if (m_Portals[portal].openness != openness) {
+    m_Portals[portal].openness = openness;
+    m_Dirty = true;
+  }
+}
+
+float PortalGraph::GetPortalOpenness(PortalID portal) const {
+  return portal < m_Portals.size() ? m_Portals[portal].openness : 0.0f;
+}
+
+void PortalGraph::SetClosedPenalty(float metres) {
+  m_ClosedPenalty = std::max(metres, 0.0f);
+  m_Dirty = true;
+}
+
+void PortalGraph::SetDiffractionScale(float metres) {
+  m_DiffractionScale = std::max(metres, 1e-3f);
+}
+
+RoomID PortalGraph::FindRoom(const Vector3 &point, RoomID hint) const {
+  if (hint < m_Rooms.size() && Contains(m_Rooms[hint], point)) {
+    return hint;
+  }
+  for (RoomID r = 0; r < m_Rooms.size(); ++r) {
+    if (Contains(m_Rooms[r], point)) {
+      return r;
+    }
+  }
+  return kInvalidRoom;
+}
+
+void PortalGraph::Update(const Vector3 &listener) {
+  const RoomID room = FindRoom(listener, m_ListenerRoom);
+  if (room == m_ListenerRoom && !m_Dirty) {
+    return;
+  }
+  m_ListenerRoom = room;
+  m_Dirty = false;
+  m_Tables.clear();
+  if (room == kInvalidRoom) {
+    return;
+  }
+
+  const auto &starts = m_Rooms[room].portals;
+  m_Tables.resize(starts.size() * m_Portals.size());
+  for (size_t i = 0; i < starts.size(); ++i) {
+    Search(starts[i], &m_Tables[i * m_Portals.size()]);
+  }
+}
+
+PortalPath PortalGraph::FindPath(const Vector3 &source,
+                                 const Vector3 &listener,
+                                 RoomID sourceRoom) const {
+  PortalPath path;
+  if (m_ListenerRoom == kInvalidRoom || sourceRoom >= m_Rooms.size()) {
+    return path;
+  }
+  path.valid = true;
+  path.virtualPosition = source;
+  const float direct = Distance(source, listener);
+  if (sourceRoom == m_ListenerRoom) {
+    path.reachable = true;
+    path.pathLength = direct;
+    return path;
+  }
+
+  // Cheapest listener portal -> table -> source-room portal combination
+  const auto &starts = m_Rooms[m_ListenerRoom].portals;
+  const auto &ends = m_Rooms[sourceRoom].portals;
+  if (m_Tables.size() != starts.size() * m_Portals.size()) {
+    return PortalPath{}; // Portals added since the last Update()
+  }
+  float best = kInfinity;
+  const TableEntry *bestEntry = nullptr;
+  size_t bestStart = 0;
+  float bestLength = 0.0f;
+  for (size_t i = 0; i < starts.size(); ++i) {
+    const TableEntry *table = &m_Tables[i * m_Portals.size()];
+    const float toPortal = Distance(listener, m_Portals[starts[i]].position);
+    for (PortalID end : ends) {
+      const TableEntry &entry = table[end];
+      if (entry.cost == kInfinity) {
+        continue;
+      }
+      const float fromPortal = Distance(m_Portals[end].position, source);
+      const float cost = toPortal + entry.cost + fromPortal;
+      if (cost < best) {
+        best = cost;
+        bestEntry = &entry;
+        bestStart = i;
+        bestLength = toPortal + entry.length + fromPortal;
+      }
+    }
+  }
+
+  if (!bestEntry) {
+    path.obstruction = 1.0f;
+    path.pathLength = direct;
+    return path;
+  }
+
+  path.reachable = true;
+  path.pathLength = bestLength;
+  path.portalCount = bestEntry->hops;
+  const float detour = std::max(bestLength - direct, 0.0f);
+  path.obstruction = std::clamp(
+      bestEntry->closedness + detour / m_DiffractionScale, 0.0f, 1.0f);
+
+  // Heard from the direction of the first portal, at the path's distance
+  const Vector3 &first = m_Portals[starts[bestStart]].position;
+  Vector3 dir{first.x - listener.x, first.y - listener.y,
+              first.z - listener.z};
+  float dirLength = Distance(first, listener);
+  if (dirLength < 1e-4f) {
+    dir = {source.x - listener.x, source.y - listener.y,
+           source.z - listener.z};
+    dirLength = direct;
+  }
+  if (dirLength > 1e-4f) {
+    const float scale = bestLength / dirLength;
+    path.virtualPosition = {listener.x + dir.x * scale,
+                            listener.y + dir.y * scale,
+                            listener.z + dir.z * scale};
+  }
+  return path;
+}
+
+bool PortalGraph::Contains(const Room &room, const Vector3 &point) const {
+  if (point.x < room.min.x || point.y < room.min.y || point.z < room.min.z ||
+      point.x > room.max.x || point.y > room.max.y || point.z > room.max.z) {
+    return false;
+  }
+  return room.shape.GetDistance(point) <= 0.0f;
+}
+
+void PortalGraph::Search(PortalID start, TableEntry *table) {
+  ++m_SearchCount;
+  std::fill(table, table + m_Portals.size(),
+            TableEntry{kInfinity, 0.0f, 0.0f, 0});
+
+  const float startClosed = 1.0f - m_Portals[start].openness;
+  table[start] = {m_ClosedPenalty * startClosed, 0.0f, startClosed, 1};
+
+  using Entry = std::pair<float, PortalID>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push({table[start].cost, start});
+  while (!open.empty()) {
+    const auto [cost, portal] = open.top();
+    open.pop();
+    if (cost > table[portal].cost) {
+      continue;
+    }
+
+    const Portal &from = m_Portals[portal];
+    for (RoomID room : from.rooms) {
+      for (PortalID next : m_Rooms[room].portals) {
+        if (next == portal) {
+          continue;
+        }
+        const Portal &to = m_Portals[next];
+        const float length = Distance(from.position, to.position);
+        const float closed = 1.0f - to.openness;
+        const float nextCost = cost + length + m_ClosedPenalty * closed;
+        TableEntry &entry = table[next];
+        if (nextCost < entry.cost) {
+          entry = {nextCost, table[portal].length + length,
+                   table[portal].closedness + closed, table[portal].hops + 1};
+          open.push({nextCost, next});
+        }
+      }
+    }
+  }
+}
+
+} // namespace Orpheus
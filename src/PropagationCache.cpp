@@ -0,0 +1,200 @@
+#include "../include/PropagationCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Orpheus {
+
+namespace {
+
+float Distance(const AcousticVector &a, const AcousticVector &b) {
+  return (a - b).Length();
+}
+
+float MeanGain(const PropagationPath &path) {
+  return (path.gainLow + path.gainMid + path.gainHigh) / 3.0f;
+}
+
+} // namespace
+
+float PropagationEstimate::GetEarlyReflectionGain() const {
+  return std::min(reflectionGain, 1.0f);
+}
+
+PropagationEffect PropagationEstimate::ToEffect() const {
+  PropagationEffect effect;
+  const float paths = (hasDirectPath ? 1.0f : 0.0f) + indirectPaths;
+  if (paths <= 0.0f) {
+    effect.volume = 0.0f;
+    return effect;
+  }
+
+  float totalGain =
+      (indirectGainLow + indirectGainMid + indirectGainHigh) / 3.0f;
+  float highFreqRatio = indirectHighRatio;
+  if (hasDirectPath) {
+    const float directGain = MeanGain(directPath);
+    totalGain += directGain;
+    if (directGain > 0.0f) {
+      highFreqRatio += directPath.gainHigh / directGain;
+    }
+    effect.delay = directPath.delay;
+  }
+
+  effect.volume = std::min(totalGain, 1.0f);
+  effect.lowPassCutoff = 2000.0f + highFreqRatio / paths * 18000.0f;
+  effect.reverbSend = GetEarlyReflectionGain() * 0.5f;
+  return effect;
+}
+
+void PropagationCache::SetUpdateFractions(float converging, float converged) {
+  m_ConvergingFraction = std::clamp(converging, 0.0f, 1.0f);
+  m_ConvergedFraction = std::clamp(converged, 0.0f, 1.0f);
+}
+
+void PropagationCache::SetReconvergeDistance(float distance) {
+  m_ReconvergeDistance = std::max(distance, 0.0f);
+}
+
+void PropagationCache::Update(const VoiceID *voices,
+                              const AcousticVector *sources, size_t count,
+                              const AcousticVector &listener,
+                              const AcousticRayTracer &tracer) {
+  const int rayCount = tracer.GetRayCount();
+  const uint32_t chunks = tracer.GetChunkCount();
+  auto sliceChunks = [chunks](float fraction) {
+    const auto wanted = static_cast<uint32_t>(std::ceil(fraction * chunks));
+    return std::clamp<uint32_t>(wanted, 1, chunks);
+  };
+  const uint32_t convergingChunks = sliceChunks(m_ConvergingFraction);
+  const uint32_t convergedChunks = sliceChunks(m_ConvergedFraction);
+
+  m_Batch.clear();
+  m_Slices.clear();
+  for (size_t i = 0; i < count; ++i) {
+    auto inserted = m_Entries.try_emplace(voices[i]);
+    Entry &entry = inserted.first->second;
+
+    // Start over after a jump or with a different ray set
+    if (inserted.second || entry.rayCount != rayCount ||
+        Distance(entry.source, sources[i]) > m_ReconvergeDistance ||
+        Distance(entry.listener, listener) > m_ReconvergeDistance) {
+      entry.estimate = PropagationEstimate{};
+      entry.rayCount = rayCount;
+      entry.nextChunk %= chunks;
+    }
+    entry.source = sources[i];
+    entry.listener = listener;
+
+    AcousticRaySlice slice;
+    slice.firstChunk = entry.nextChunk;
+    slice.chunkCount = entry.estimate.IsConverged() ? convergedChunks
+                                                    : convergingChunks;
+    slice.pass = entry.pass;
+    entry.nextChunk += slice.chunkCount;
+    if (entry.nextChunk >= chunks) {
+      entry.nextChunk -= chunks;
+      ++entry.pass;
+    }
+    m_Batch.push_back(&entry);
+    m_Slices.push_back(slice);
+  }
+
+  m_Results.resize(count);
+  tracer.TraceBatch(sources, count, listener, m_Results.data(),
+                    m_Slices.data());
+  for (size_t i = 0; i < count; ++i) {
+    const int sliceRays = tracer.GetSliceRayCount(m_Slices[i]);
+    Blend(*m_Batch[i], m_Results[i], sliceRays, rayCount);
+    m_RaysTraced += static_cast<uint64_t>(sliceRays);
+  }
+}
+
+const PropagationEstimate &PropagationCache::Update(
+    VoiceID voice, const AcousticVector &source,
+    const AcousticVector &listener, const AcousticRayTracer &tracer) {
+  Update(&voice, &source, 1, listener, tracer);
+  return m_Entries.find(voice)->second.estimate;
+}
+
+int PropagationCache::GetNextSliceRays(VoiceID voice,
+                                       const AcousticRayTracer &tracer) const {
+  const uint32_t chunks = tracer.GetChunkCount();
+  const auto it = m_Entries.find(voice);
+  const bool converged = it != m_Entries.end() &&
+                         it->second.rayCount == tracer.GetRayCount() &&
+                         it->second.estimate.IsConverged();
+  const float fraction = converged ? m_ConvergedFraction : m_ConvergingFraction;
+  AcousticRaySlice slice;
+  slice.firstChunk = it != m_Entries.end() ? it->second.nextChunk % chunks : 0;
+  slice.chunkCount = std::clamp<uint32_t>(
+      static_cast<uint32_t>(std::ceil(fraction * chunks)), 1, chunks);
+  return tracer.GetSliceRayCount(slice);
+}
+
+const PropagationEstimate *PropagationCache::Find(VoiceID voice) const {
+  const auto it = m_Entries.find(voice);
+  return it != m_Entries.end() ? &it->second.estimate : nullptr;
+}
+
+void PropagationCache::Remove(VoiceID voice) { m_Entries.erase(voice); }
+
+void PropagationCache::Clear() { m_Entries.clear(); }
+
+void PropagationCache::Blend(Entry &entry, const PropagationResult &result,
+                             int sliceRays, int rayCount) {
+  PropagationEstimate &estimate = entry.estimate;
+  estimate.hasDirectPath = result.hasDirectPath;
+  estimate.directDistance = result.directDistance;
+  estimate.directPath = PropagationPath{};
+
+  // Sums of this slice; gains are already weighted to a full ray set.
+  // Image-source paths are complete in every slice, so they count once
+  const float sliceWeight = static_cast<float>(rayCount) / sliceRays;
+  float low = 0.0f, mid = 0.0f, high = 0.0f;
+  float paths = 0.0f, highRatio = 0.0f, reflectionGain = 0.0f;
+  float delay = 0.0f;
+  for (const PropagationPath &path : result.paths) {
+    if (path.isDirect) {
+      estimate.directPath = path;
+      continue;
+    }
+    const float weight = path.isImageSource ? 1.0f : sliceWeight;
+    low += path.gainLow;
+    mid += path.gainMid;
+    high += path.gainHigh;
+    paths += weight;
+    const float gain = MeanGain(path);
+    if (gain > 0.0f) {
+      highRatio += path.gainHigh / gain * weight;
+    }
+    if (path.reflections > 0) {
+      reflectionGain += gain;
+      delay = delay > 0.0f ? std::min(delay, path.delay) : path.delay;
+    }
+  }
+
+  // Plain mean until one ray set is covered, then exponential averaging
+  // over about one ray set
+  const float added = static_cast<float>(sliceRays) / rayCount;
+  const float alpha = added / std::min(estimate.coverage + added, 1.0f);
+  auto blend = [alpha](float &value, float sample) {
+    value += (sample - value) * alpha;
+  };
+  blend(estimate.indirectGainLow, low);
+  blend(estimate.indirectGainMid, mid);
+  blend(estimate.indirectGainHigh, high);
+  blend(estimate.indirectPaths, paths);
+  blend(estimate.indirectHighRatio, highRatio);
+  blend(estimate.reflectionGain, reflectionGain);
+  if (delay > 0.0f) {
+    if (estimate.earlyReflectionDelay > 0.0f) {
+      blend(estimate.earlyReflectionDelay, delay);
+    } else {
+      estimate.earlyReflectionDelay = delay;
+    }
+  }
+  estimate.coverage += added;
+}
+
+} // namespace Orpheus
@@ -0,0 +1,415 @@
+#include "../include/PropagationField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../include/OcclusionScene.h"
+
+namespace Orpheus {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+uint8_t Quantize(float obstruction) {
+  const float clamped = std::clamp(obstruction, 0.0f, 1.0f);
+  if (clamped <= 0.0f) {
+    return 0;
+  }
+  return static_cast<uint8_t>(
+      std::max(1.0f, std::round(clamped * 255.0f)));
+}
+
+float Distance(const Vector3 &a, const Vector3 &b) {
+  const float dx = a.x - b.x;
+  const float dy = a.y - b.y;
+  const float dz = a.z - b.z;
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+bool PropagationField::Configure(const Vector3 &min, const Vector3 &max,
+                                 float cellSize) {
+  if (!(cellSize > 0.0f)) {
+    return false;
+  }
+  auto dim = [cellSize](float lo, float hi) {
+    return static_cast<double>(std::ceil((hi - lo) / cellSize));
+  };
+  const double dx = dim(min.x, max.x);
+  const double dy = dim(min.y, max.y);
+  const double dz = dim(min.z, max.z);
+  if (dx < 1.0 || dy < 1.0 || dz < 1.0 ||
+      dx * dy * dz > static_cast<double>(kMaxCells)) {
+    return false;
+  }
+
+  m_Min = min;
+  m_CellSize = cellSize;
+  m_DimX = static_cast<int32_t>(dx);
+  m_DimY = static_cast<int32_t>(dy);
+  m_DimZ = static_cast<int32_t>(dz);
+  m_Obstruction.assign(static_cast<size_t>(dx * dy * dz), 0);
+
+  // 26-neighbourhood; diagonal steps list the cells whose corners they cut
+  const int32_t strideY = m_DimX;
+  const int32_t strideZ = m_DimX * m_DimY;
+  Step *step = m_Steps;
+  for (int32_t sz = -1; sz <= 1; ++sz) {
+    for (int32_t sy = -1; sy <= 1; ++sy) {
+      for (int32_t sx = -1; sx <= 1; ++sx) {
+        const int axes = (sx != 0) + (sy != 0) + (sz != 0);
+        if (axes == 0) {
+          continue;
+        }
+        step->dx = static_cast<int8_t>(sx);
+        step->dy = static_cast<int8_t>(sy);
+        step->dz = static_cast<int8_t>(sz);
+        step->offset = sx + sy * strideY + sz * strideZ;
+        step->length = std::sqrt(static_cast<float>(axes)) * cellSize;
+        step->cornerCount = 0;
+        if (axes > 1) {
+          for (int32_t mask = 1; mask < 7; ++mask) {
+            const int32_t ox = (mask & 1) ? sx : 0;
+            const int32_t oy = (mask & 2) ? sy : 0;
+            const int32_t oz = (mask & 4) ? sz : 0;
+            const int32_t offset = ox + oy * strideY + oz * strideZ;
+            if ((ox | oy | oz) != 0 && offset != step->offset &&
+                std::find(step->corners, step->corners + step->cornerCount,
+                          offset) == step->corners + step->cornerCount) {
+              step->corners[step->cornerCount++] = offset;
+            }
+          }
+        }
+        ++step;
+      }
+    }
+  }
+  m_PathLength.clear();
+  m_Transmission.clear();
+  m_HasField = false;
+  m_FieldOrigin = UINT32_MAX;
+  ClearQueue();
+  m_GridChanged = true;
+  return true;
+}
+
+void PropagationField::Voxelize(
+    const OcclusionScene &scene,
+    const std::function<float(OcclusionMaterialID)> &obstructionOf) {
+  const float spacing = 0.5f * m_CellSize;
+  for (size_t t = 0; t < scene.GetTriangleCount(); ++t) {
+    Vector3 a, b, c;
+    OcclusionMaterialID material;
+    scene.GetTriangle(t, a, b, c, material);
+    const uint8_t obstruction = Quantize(obstructionOf(material));
+    if (obstruction == 0) {
+      continue;
+    }
+
+    // Sample the triangle at half-cell spacing so no touched cell is
+    // skipped between samples.
+    const float edge = std::max({Distance(a, b), Distance(b, c),
+                                 Distance(c, a)});
+    const int n = std::max(1, static_cast<int>(std::ceil(edge / spacing)));
+    const float inv = 1.0f / static_cast<float>(n);
+    const Vector3 ab{b.x - a.x, b.y - a.y, b.z - a.z};
+    const Vector3 ac{c.x - a.x, c.y - a.y, c.z - a.z};
+    for (int i = 0; i <= n; ++i) {
+      for (int j = 0; i + j <= n; ++j) {
+        const float u = static_cast<float>(i) * inv;
+        const float v = static_cast<float>(j) * inv;
+        MarkPoint({a.x + ab.x * u + ac.x * v, a.y + ab.y * u + ac.y * v,
+                   a.z + ab.z * u + ac.z * v},
+                  obstruction);
+      }
+    }
+  }
+  m_GridChanged = true;
+}
+
+void PropagationField::FillBox(const Vector3 &min, const Vector3 &max,
+                               float obstruction) {
+  if (m_Obstruction.empty()) {
+    return;
+  }
+  const float inv = 1.0f / m_CellSize;
+  auto range = [inv](float lo, float hi, float origin, int32_t dim,
+                     int32_t &first, int32_t &last) {
+    first = std::max(0, static_cast<int32_t>(std::floor((lo - origin) * inv)));
+    last = std::min(dim - 1,
+                    static_cast<int32_t>(std::ceil((hi - origin) * inv)) - 1);
+  };
+  int32_t x0, x1, y0, y1, z0, z1;
+  range(min.x, max.x, m_Min.x, m_DimX, x0, x1);
+  range(min.y, max.y, m_Min.y, m_DimY, y0, y1);
+  range(min.z, max.z, m_Min.z, m_DimZ, z0, z1);
+
+  const uint8_t value = Quantize(obstruction);
+  for (int32_t z = z0; z <= z1; ++z) {
+    for (int32_t y = y0; y <= y1; ++y) {
+      for (int32_t x = x0; x <= x1; ++x) {
+        m_Obstruction[Index(x, y, z)] = value;
+      }
+    }
+  }
+  m_GridChanged = true;
+}
+
+void PropagationField::ClearCells() {
+  std::fill(m_Obstruction.begin(), m_Obstruction.end(), uint8_t{0});
+  m_GridChanged = true;
+}
+
+void PropagationField::SetWallPenalty(float metres) {
+  m_WallPenalty = std::max(metres, 0.0f);
+  m_GridChanged = true;
+}
+
+void PropagationField::SetDiffractionScale(float metres) {
+  m_DiffractionScale = std::max(metres, 1e-3f);
+}
+
+void PropagationField::SetMaxExpansions(uint32_t count) {
+  m_MaxExpansions = std::max(count, 1u);
+}
+
+void PropagationField::SetMaxListenerDrift(uint32_t cells) {
+  m_MaxListenerDrift = cells;
+}
+
+void PropagationField::Update(const Vector3 &listener) {
+  int32_t x, y, z;
+  if (!CellOf(listener, x, y, z)) {
+    // Sources cannot be resolved from outside the grid
+    m_HasField = false;
+    m_FieldOrigin = UINT32_MAX;
+    ClearQueue();
+    return;
+  }
+
+  // A running flood is only abandoned if the grid changed; restarting it
+  // on every cell change would starve a moving listener of fields
+  const uint32_t cell = Index(x, y, z);
+  if (m_GridChanged || (m_Queued == 0 && cell != m_FieldOrigin)) {
+    m_GridChanged = false;
+    StartFlood(cell);
+  }
+  if (m_Queued > 0) {
+    Expand(m_MaxExpansions);
+  }
+}
+
+PropagationSample PropagationField::Sample(const Vector3 &source,
+                                           const Vector3 &listener) const {
+  PropagationSample sample;
+  int32_t x, y, z;
+  int32_t lx, ly, lz;
+  if (!m_HasField || !CellOf(source, x, y, z) ||
+      !CellOf(listener, lx, ly, lz)) {
+    return sample;
+  }
+
+  // Path lengths are measured from the field's origin
+  const auto origin = static_cast<int32_t>(m_FieldOrigin);
+  const int32_t drift = std::max(
+      {std::abs(lx - origin % m_DimX),
+       std::abs(ly - (origin / m_DimX) % m_DimY),
+       std::abs(lz - origin / (m_DimX * m_DimY))});
+  if (drift > static_cast<int32_t>(m_MaxListenerDrift)) {
+    return sample;
+  }
+
+  uint32_t cell = Index(x, y, z);
+  if (m_Obstruction[cell] != 0) {
+    // Sources touching a wall would otherwise hear through it; take the
+    // cheapest open neighbour instead.
+    static constexpr int32_t kAxes[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                                            {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+    float best = m_PathLength[cell] + m_WallPenalty * m_Transmission[cell];
+    for (const auto &axis : kAxes) {
+      const int32_t nx = x + axis[0];
+      const int32_t ny = y + axis[1];
+      const int32_t nz = z + axis[2];
+      if (nx < 0 || ny < 0 || nz < 0 || nx >= m_DimX || ny >= m_DimY ||
+          nz >= m_DimZ) {
+        continue;
+      }
+      const uint32_t neighbour = Index(nx, ny, nz);
+      const float cost =
+          m_PathLength[neighbour] + m_WallPenalty * m_Transmission[neighbour];
+      if (m_Obstruction[neighbour] == 0 && cost < best) {
+        best = cost;
+        cell = neighbour;
+      }
+    }
+  }
+
+  const float direct = Distance(source, listener);
+  sample.valid = true;
+  if (!std::isfinite(m_PathLength[cell])) {
+    // Never reached: no path to the listener
+    sample.pathLength = direct;
+    sample.transmission = 1.0f;
+    sample.obstruction = 1.0f;
+    return sample;
+  }
+
+  // Cell-centre paths are up to about a cell longer than the true path
+  const float detour =
+      std::max(m_PathLength[cell] - direct - m_CellSize, 0.0f);
+  sample.pathLength = std::max(m_PathLength[cell], direct);
+  sample.transmission = m_Transmission[cell];
+  sample.obstruction = std::clamp(
+      sample.transmission + detour / m_DiffractionScale, 0.0f, 1.0f);
+  return sample;
+}
+
+float PropagationField::GetCellObstruction(const Vector3 &point) const {
+  int32_t x, y, z;
+  if (!CellOf(point, x, y, z)) {
+    return 0.0f;
+  }
+  return static_cast<float>(m_Obstruction[Index(x, y, z)]) / 255.0f;
+}
+
+bool PropagationField::CellOf(const Vector3 &point, int32_t &x, int32_t &y,
+                              int32_t &z) const {
+  if (m_Obstruction.empty()) {
+    return false;
+  }
+  const float inv = 1.0f / m_CellSize;
+  const float fx = std::floor((point.x - m_Min.x) * inv);
+  const float fy = std::floor((point.y - m_Min.y) * inv);
+  const float fz = std::floor((point.z - m_Min.z) * inv);
+  if (!(fx >= 0.0f && fy >= 0.0f && fz >= 0.0f &&
+        fx < static_cast<float>(m_DimX) && fy < static_cast<float>(m_DimY) &&
+        fz < static_cast<float>(m_DimZ))) {
+    return false;
+  }
+  x = static_cast<int32_t>(fx);
+  y = static_cast<int32_t>(fy);
+  z = static_cast<int32_t>(fz);
+  return true;
+}
+
+void PropagationField::MarkPoint(const Vector3 &point, uint8_t obstruction) {
+  int32_t x, y, z;
+  if (CellOf(point, x, y, z)) {
+    uint8_t &cell = m_Obstruction[Index(x, y, z)];
+    cell = std::max(cell, obstruction);
+  }
+}
+
+void PropagationField::StartFlood(uint32_t origin) {
+  const size_t count = m_Obstruction.size();
+  m_Cost.assign(count, kInfinity);
+  m_NextLength.assign(count, kInfinity);
+  m_NextTransmission.assign(count, 0.0f);
+  ClearQueue();
+
+  // Steps cost at most a cube diagonal plus the full wall penalty, so the
+  // ring only needs to span that many buckets
+  const float maxStep = 1.7320508f * m_CellSize + m_WallPenalty;
+  const size_t buckets =
+      static_cast<size_t>(std::ceil(maxStep / m_CellSize)) + 2;
+  if (m_Buckets.size() != buckets) {
+    m_Buckets.assign(buckets, {});
+  }
+  m_FloodOrigin = origin;
+  m_Cost[origin] = 0.0f;
+  m_NextLength[origin] = 0.0f;
+  Push(0.0f, origin);
+}
+
+void PropagationField::Push(float cost, uint32_t cell) {
+  // Never behind the bucket being expanded, even after float rounding
+  const size_t bucket =
+      std::max(static_cast<size_t>(cost / m_CellSize), m_Bucket + 1);
+  m_Buckets[bucket % m_Buckets.size()].push_back({cost, cell});
+  ++m_Queued;
+}
+
+void PropagationField::ClearQueue() {
+  for (auto &bucket : m_Buckets) {
+    bucket.clear();
+  }
+  m_Bucket = 0;
+  m_Queued = 0;
+}
+
+void PropagationField::Expand(uint32_t budget) {
+  const float penalty = m_WallPenalty / 255.0f;
+  const int32_t strideZ = m_DimX * m_DimY;
+
+  while (budget > 0 && m_Queued > 0) {
+    auto &bucket = m_Buckets[m_Bucket % m_Buckets.size()];
+    if (bucket.empty()) {
+      ++m_Bucket;
+      continue;
+    }
+    --budget;
+    --m_Queued;
+    const auto [cost, cell] = bucket.back();
+    bucket.pop_back();
+    if (cost > m_Cost[cell]) {
+      continue; // Stale entry
+    }
+
+    const int32_t x = static_cast<int32_t>(cell) % m_DimX;
+    const int32_t y = (static_cast<int32_t>(cell) / m_DimX) % m_DimY;
+    const int32_t z = static_cast<int32_t>(cell) / strideZ;
+    const bool interior = x > 0 && y > 0 && z > 0 && x < m_DimX - 1 &&
+                          y < m_DimY - 1 && z < m_DimZ - 1;
+    const bool open = m_Obstruction[cell] == 0;
+
+    for (const Step &step : m_Steps) {
+      if (!interior && (x + step.dx < 0 || y + step.dy < 0 ||
+                        z + step.dz < 0 || x + step.dx >= m_DimX ||
+                        y + step.dy >= m_DimY || z + step.dz >= m_DimZ)) {
+        continue;
+      }
+      const uint32_t next =
+          static_cast<uint32_t>(static_cast<int32_t>(cell) + step.offset);
+      const uint8_t obstruction = m_Obstruction[next];
+
+      if (step.cornerCount > 0) {
+        // Diagonal steps stay in air and never cut an obstructing cell's
+        // corner (which would leak through thin walls).
+        if (!open || obstruction != 0) {
+          continue;
+        }
+        bool blocked = false;
+        for (uint8_t c = 0; c < step.cornerCount && !blocked; ++c) {
+          blocked = m_Obstruction[static_cast<uint32_t>(
+                        static_cast<int32_t>(cell) + step.corners[c])] != 0;
+        }
+        if (blocked) {
+          continue;
+        }
+      }
+
+      const float nextCost =
+          cost + step.length + penalty * static_cast<float>(obstruction);
+      if (nextCost < m_Cost[next]) {
+        m_Cost[next] = nextCost;
+        m_NextLength[next] = m_NextLength[cell] + step.length;
+        m_NextTransmission[next] = m_NextTransmission[cell] +
+                                   static_cast<float>(obstruction) / 255.0f;
+        Push(nextCost, next);
+      }
+    }
+  }
+
+  if (m_Queued == 0) {
+    m_PathLength.swap(m_NextLength);
+    m_Transmission.swap(m_NextTransmission);
+    m_HasField = true;
+    m_FieldOrigin = m_FloodOrigin;
+    ++m_FloodCount;
+  }
+}
+
+} // namespace Orpheus
@@ -0,0 +1,313 @@
+#include "../include/PropagationProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../include/PropagationCache.h"
+
+namespace Orpheus {
+
+namespace {
+
+constexpr float kNeutralLowPass = 22000.0f;
+
+void SetTargets(Voice &voice, float volume, float lowPass, float send) {
+  voice.propagationVolume = std::clamp(volume, 0.0f, 1.0f);
+  voice.propagationLowPassFreq = std::clamp(lowPass, 100.0f, kNeutralLowPass);
+  voice.propagationReverbSend = std::clamp(send, 0.0f, 1.0f);
+}
+
+bool IsNeutral(const Voice &voice) {
+  return std::abs(voice.propagationVolumeSmoothed - 1.0f) < 1e-3f &&
+         voice.propagationLowPassSmoothed > kNeutralLowPass - 10.0f &&
+         voice.propagationReverbSendSmoothed < 1e-3f;
+}
+
+} // namespace
+
+struct PropagationProcessorImpl {
+  uint32_t rayBudget = PropagationProcessor::kDefaultRayBudget;
+  float updateRate = 4.0f;
+  float smoothingTime = 0.2f;
+
+  uint32_t lastTracedVoiceCount = 0;
+  uint32_t lastRayCount = 0;
+  uint32_t lastProbeSampleCount = 0;
+
+  // Owned by the worker while a batch is in flight
+  PropagationCache cache;
+  std::vector<VoiceID> batchVoices;
+  std::vector<AcousticVector> batchSources;
+  AcousticVector batchListener;
+  AcousticRayTracer batchTracer; ///< Copy taken when the batch starts
+  std::vector<std::pair<VoiceID, PropagationEffect>> back;
+
+  // Main thread only
+  bool inFlight = false;
+  std::vector<std::pair<VoiceID, PropagationEffect>> front;
+  std::vector<std::pair<float, Voice *>> due;
+  std::unordered_map<VoiceID, Voice *> voiceByID;
+  std::unordered_set<VoiceID> traced; ///< Voices with cache entries
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  bool hasJob = false;
+  bool done = false;
+  bool stop = false;
+  std::thread worker;
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return stop || hasJob; });
+      if (stop) {
+        return;
+      }
+      hasJob = false;
+
+      lock.unlock();
+      cache.Update(batchVoices.data(), batchSources.data(),
+                   batchVoices.size(), batchListener, batchTracer);
+      back.clear();
+      for (VoiceID id : batchVoices) {
+        back.emplace_back(id, cache.Find(id)->ToEffect());
+      }
+      lock.lock();
+
+      done = true;
+      idle.notify_all();
+    }
+  }
+
+  // Swap in a finished batch; false if none finished
+  bool TakeResults() {
+    if (!inFlight) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!done) {
+      return false;
+    }
+    done = false;
+    inFlight = false;
+    front.swap(back);
+    return true;
+  }
+
+  void Kick() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      hasJob = true;
+      // The thread starts with the first batch
+      if (!worker.joinable()) {
+        worker = std::thread([this] { Run(); });
+      }
+    }
+    inFlight = true;
+    wake.notify_one();
+  }
+};
+
+PropagationProcessor::PropagationProcessor()
+    : m_Impl(std::make_unique<PropagationProcessorImpl>()) {}
+
+PropagationProcessor::~PropagationProcessor() {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    m_Impl->stop = true;
+  }
+  m_Impl->wake.notify_all();
+  if (m_Impl->worker.joinable()) {
+    m_Impl->worker.join();
+  }
+}
+
+void PropagationProcessor::SetRayBudget(uint32_t raysPerFrame) {
+  m_Impl->rayBudget = std::max(raysPerFrame, 1u);
+}
+
+void PropagationProcessor::SetUpdateRate(float hz) {
+  m_Impl->updateRate = std::max(hz, 0.1f);
+}
+
+void PropagationProcessor::SetSmoothingTime(float seconds) {
+  m_Impl->smoothingTime = std::max(seconds, 0.01f);
+}
+
+void PropagationProcessor::Update(Voice *const *voices, size_t count,
+                                  const Vector3 &listenerPos,
+                                  const AcousticRayTracer &tracer,
+                                  const AcousticProbeGrid *probes, float dt) {
+  PropagationProcessorImpl &impl = *m_Impl;
+  impl.lastTracedVoiceCount = 0;
+  impl.lastRayCount = 0;
+  impl.lastProbeSampleCount = 0;
+
+  impl.voiceByID.clear();
+  for (size_t i = 0; i < count; ++i) {
+    impl.voiceByID.emplace(voices[i]->id, voices[i]);
+  }
+
+  // Voices that stopped or went virtual meanwhile are skipped
+  if (impl.TakeResults()) {
+    for (const auto &[id, effect] : impl.front) {
+      auto it = impl.voiceByID.find(id);
+      if (it != impl.voiceByID.end()) {
+        SetTargets(*it->second, effect.volume, effect.lowPassCutoff,
+                   effect.reverbSend);
+      }
+    }
+  }
+
+  const bool tracing = tracer.IsEnabled();
+  const bool useProbes = probes && probes->IsLoaded();
+  impl.due.clear();
+  for (size_t i = 0; i < count; ++i) {
+    Voice &voice = *voices[i];
+    if (!tracing) {
+      SetTargets(voice, 1.0f, kNeutralLowPass, 0.0f);
+      voice.propagationAge = -1.0f;
+      continue;
+    }
+    if (useProbes) {
+      const AcousticProbeSample sample = probes->Sample(voice.position);
+      if (sample.valid) {
+        SetTargets(voice, 1.0f, kNeutralLowPass,
+                   sample.earlyReflectionGain * 0.5f);
+        voice.propagationAge = 0.0f;
+        ++impl.lastProbeSampleCount;
+        continue;
+      }
+    }
+
+    // Staleness is age relative to the voice's own interval; voices never
+    // traced are the most urgent
+    float staleness = std::numeric_limits<float>::max();
+    if (voice.propagationAge >= 0.0f) {
+      voice.propagationAge += dt;
+      staleness = voice.propagationAge / GetRefreshInterval(voice);
+    }
+    if (staleness >= 1.0f) {
+      impl.due.emplace_back(staleness, &voice);
+    }
+  }
+
+  if (tracing && !impl.inFlight && !impl.due.empty()) {
+    // Estimates of voices that are gone would never be read again
+    for (auto it = impl.traced.begin(); it != impl.traced.end();) {
+      if (impl.voiceByID.count(*it) == 0) {
+        impl.cache.Remove(*it);
+        it = impl.traced.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    std::sort(impl.due.begin(), impl.due.end(),
+              [](const std::pair<float, Voice *> &a,
+                 const std::pair<float, Voice *> &b) {
+                if (a.second->priority != b.second->priority) {
+                  return a.second->priority > b.second->priority;
+                }
+                return a.first > b.first;
+              });
+
+    impl.batchVoices.clear();
+    impl.batchSources.clear();
+    uint32_t rays = 0;
+    for (const auto &[staleness, voice] : impl.due) {
+      const auto sliceRays =
+          static_cast<uint32_t>(impl.cache.GetNextSliceRays(voice->id, tracer));
+      if (!impl.batchVoices.empty() && rays + sliceRays > impl.rayBudget) {
+        break;
+      }
+      rays += sliceRays;
+      voice->propagationAge = 0.0f;
+      impl.traced.insert(voice->id);
+      impl.batchVoices.push_back(voice->id);
+      impl.batchSources.emplace_back(voice->position.x, voice->position.y,
+                                     voice->position.z);
+    }
+    impl.batchListener =
+        AcousticVector(listenerPos.x, listenerPos.y, listenerPos.z);
+    // The batch keeps its own settings, materials and callbacks, so the
+    // tracer can be changed while it runs
+    impl.batchTracer = tracer;
+    impl.lastTracedVoiceCount =
+        static_cast<uint32_t>(impl.batchVoices.size());
+    impl.lastRayCount = rays;
+    impl.Kick();
+  }
+
+  const float alpha = 1.0f - std::exp(-dt / impl.smoothingTime);
+  for (size_t i = 0; i < count; ++i) {
+    Voice &voice = *voices[i];
+    auto smooth = [alpha](float &value, float target) {
+      value += alpha * (target - value);
+    };
+    smooth(voice.propagationVolumeSmoothed, voice.propagationVolume);
+    smooth(voice.propagationLowPassSmoothed, voice.propagationLowPassFreq);
+    smooth(voice.propagationReverbSendSmoothed, voice.propagationReverbSend);
+
+    // Voices back at neutral stop touching the DSP
+    voice.hasPropagation = tracing || !IsNeutral(voice);
+    if (!voice.hasPropagation) {
+      voice.propagationVolumeSmoothed = 1.0f;
+      voice.propagationLowPassSmoothed = kNeutralLowPass;
+      voice.propagationReverbSendSmoothed = 0.0f;
+    }
+  }
+}
+
+void PropagationProcessor::Wait() {
+  if (!m_Impl->inFlight) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(m_Impl->mutex);
+  m_Impl->idle.wait(lock, [this] { return m_Impl->done; });
+}
+
+bool PropagationProcessor::IsBusy() const {
+  if (!m_Impl->inFlight) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_Impl->mutex);
+  return !m_Impl->done;
+}
+
+void PropagationProcessor::Reset() {
+  Wait();
+  m_Impl->TakeResults();
+  m_Impl->front.clear();
+  m_Impl->cache.Clear();
+  m_Impl->traced.clear();
+}
+
+float PropagationProcessor::GetRefreshInterval(const Voice &voice) const {
+  const float audibility = std::clamp(voice.audibility, 0.0f, 1.0f);
+  return (1.0f + (kQuietIntervalScale - 1.0f) * (1.0f - audibility)) /
+         m_Impl->updateRate;
+}
+
+uint32_t PropagationProcessor::GetLastTracedVoiceCount() const {
+  return m_Impl->lastTracedVoiceCount;
+}
+
+uint32_t PropagationProcessor::GetLastRayCount() const {
+  return m_Impl->lastRayCount;
+}
+
+uint32_t PropagationProcessor::GetLastProbeSampleCount() const {
+  return m_Impl->lastProbeSampleCount;
+}
+
+} // namespace Orpheus
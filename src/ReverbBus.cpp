@@ -11,6 +11,7 @@ namespace Orpheus {
 // PIMPL implementation struct
 struct ReverbBusImpl {
   std::string name;
+  uint32_t index = 0;
   SoLoud::Bus bus;
   SoLoud::FreeverbFilter reverb;
   SoLoud::Soloud *engine = nullptr;
@@ -24,9 +25,10 @@ struct ReverbBusImpl {
   bool active = false;
 };
 
-ReverbBus::ReverbBus(const std::string &name)
+ReverbBus::ReverbBus(const std::string &name, uint32_t index)
     : m_Impl(std::make_unique<ReverbBusImpl>()) {
   m_Impl->name = name;
+  m_Impl->index = index;
 }
 
 ReverbBus::~ReverbBus() = default;
@@ -171,6 +173,7 @@ float ReverbBus::GetWidth() const { return m_Impl->width; }
 bool ReverbBus::IsFreeze() const { return m_Impl->freeze; }
 bool ReverbBus::IsActive() const { return m_Impl->active; }
 const std::string &ReverbBus::GetName() const { return m_Impl->name; }
+ReverbBusID ReverbBus::GetIndex() const { return m_Impl->index; }
 
 NativeBusHandle ReverbBus::GetBus() { return NativeBusHandle{&m_Impl->bus}; }
 AudioHandle ReverbBus::GetBusHandle() const {
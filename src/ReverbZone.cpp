@@ -1,18 +1,25 @@
 #include "../include/ReverbZone.h"
 
+#include <algorithm>
+
 namespace Orpheus {
 
 ReverbZone::ReverbZone(const std::string &name,
                        const std::string &reverbBusName,
                        const Vector3 &position, float innerRadius,
                        float outerRadius, uint8_t priority)
-    : m_Name(name), m_ReverbBusName(reverbBusName), m_Position(position),
-      m_InnerRadius(innerRadius), m_OuterRadius(outerRadius),
+    : m_Name(name), m_ReverbBusName(reverbBusName),
+      m_Geometry(ZoneGeometry::Sphere(position, innerRadius, outerRadius)),
+      m_Priority(priority) {}
+
+ReverbZone::ReverbZone(const std::string &name,
+                       const std::string &reverbBusName,
+                       const ZoneGeometry &geometry, uint8_t priority)
+    : m_Name(name), m_ReverbBusName(reverbBusName), m_Geometry(geometry),
       m_Priority(priority) {}
 
 float ReverbZone::Update(const Vector3 &listenerPos) {
-  float dist = Distance(listenerPos, m_Position);
-  m_CurrentInfluence = ComputeInfluence(dist);
+  m_CurrentInfluence = m_Geometry.ComputeVolume(listenerPos);
   return m_CurrentInfluence;
 }
 
@@ -23,28 +30,64 @@ const std::string &ReverbZone::GetName() const { return m_Name; }
 const std::string &ReverbZone::GetReverbBusName() const {
   return m_ReverbBusName;
 }
-const Vector3 &ReverbZone::GetPosition() const { return m_Position; }
-float ReverbZone::GetInnerRadius() const { return m_InnerRadius; }
-float ReverbZone::GetOuterRadius() const { return m_OuterRadius; }
+const Vector3 &ReverbZone::GetPosition() const {
+  return m_Geometry.GetCenter();
+}
+float ReverbZone::GetInnerRadius() const {
+  return m_Geometry.GetInnerRadius();
+}
+float ReverbZone::GetOuterRadius() const {
+  return m_Geometry.GetOuterRadius();
+}
+uint32_t ReverbZone::GetReverbBusID() const { return m_ReverbBusID; }
+void ReverbZone::SetReverbBusID(uint32_t id) { m_ReverbBusID = id; }
 uint8_t ReverbZone::GetPriority() const { return m_Priority; }
 
 float ReverbZone::GetDistance(const Vector3 &listenerPos) const {
-  return Distance(listenerPos, m_Position);
+  const Vector3 &c = m_Geometry.GetCenter();
+  float dx = listenerPos.x - c.x;
+  float dy = listenerPos.y - c.y;
+  float dz = listenerPos.z - c.z;
+  return sqrtf(dx * dx + dy * dy + dz * dz);
 }
 
-float ReverbZone::Distance(const Vector3 &a, const Vector3 &b) const {
-  float dx = a.x - b.x;
-  float dy = a.y - b.y;
-  float dz = a.z - b.z;
-  return sqrtf(dx * dx + dy * dy + dz * dz);
+const ZoneGeometry &ReverbZone::GetGeometry() const { return m_Geometry; }
+
+void ReverbInfluence::Reset(size_t busCount) {
+  m_Entries.clear();
+  m_Influence.assign(busCount, 0.0f);
+  m_Level.assign(busCount, 0.0f);
 }
 
-float ReverbZone::ComputeInfluence(float dist) const {
-  if (dist < m_InnerRadius)
-    return 1.0f;
-  if (dist > m_OuterRadius)
-    return 0.0f;
-  return 1.0f - ((dist - m_InnerRadius) / (m_OuterRadius - m_InnerRadius));
+void ReverbInfluence::Add(uint32_t bus, float influence, uint8_t priority) {
+  m_Entries.push_back({priority, bus, influence});
+}
+
+void ReverbInfluence::Resolve() {
+  std::sort(m_Entries.begin(), m_Entries.end(),
+            [](const Entry &a, const Entry &b) {
+              return a.priority > b.priority;
+            });
+
+  float remaining = 1.0f;
+  for (size_t begin = 0; begin < m_Entries.size() && remaining > 0.0f;) {
+    size_t end = begin;
+    float coverage = 0.0f;
+    for (; end < m_Entries.size() &&
+           m_Entries[end].priority == m_Entries[begin].priority;
+         ++end) {
+      const Entry &e = m_Entries[end];
+      m_Level[e.bus] = std::max(m_Level[e.bus], e.influence);
+      coverage = std::max(coverage, e.influence);
+    }
+    for (size_t i = begin; i < end; ++i) {
+      const uint32_t bus = m_Entries[i].bus;
+      m_Influence[bus] += remaining * m_Level[bus];
+      m_Level[bus] = 0.0f; // count each bus once per level
+    }
+    remaining *= 1.0f - coverage;
+    begin = end;
+  }
 }
 
 } // namespace Orpheus
@@ -0,0 +1,187 @@
+#include "../include/SnapshotBlender.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Orpheus {
+
+namespace {
+
+// value += (target - value) * weight * mask, over one dense array
+void BlendInto(float *value, const std::vector<float> &target,
+               const std::vector<float> &mask, float weight) {
+  const size_t count = target.size();
+  for (size_t i = 0; i < count; ++i) {
+    value[i] += (target[i] - value[i]) * (weight * mask[i]);
+  }
+}
+
+bool Moved(float a, float b) {
+  return std::fabs(a - b) > SnapshotBlender::kChangeThreshold;
+}
+
+} // namespace
+
+void SnapshotBlender::SetLayer(LayerKey key,
+                               std::shared_ptr<const CompiledSnapshot> snapshot,
+                               uint8_t priority, float fadeIn, float fadeOut) {
+  Reserve(snapshot->GetBusCount(), snapshot->GetReverbCount());
+  if (Layer *layer = FindLayer(key)) {
+    // Values dropped from the snapshot fall back to the layers below
+    if (layer->weight > 0.0f) {
+      Touch(*layer->snapshot, fadeIn);
+      Touch(*snapshot, fadeIn);
+    }
+    layer->snapshot = std::move(snapshot);
+    layer->fadeIn = fadeIn;
+    layer->fadeOut = fadeOut;
+    return;
+  }
+
+  auto pos = std::upper_bound(
+      m_Layers.begin(), m_Layers.end(), priority,
+      [](uint8_t p, const Layer &layer) { return p < layer.priority; });
+  m_Layers.insert(pos, Layer{key, std::move(snapshot), priority, 0.0f, fadeIn,
+                             fadeOut});
+}
+
+void SnapshotBlender::SetWeight(LayerKey key, float weight) {
+  Layer *layer = FindLayer(key);
+  if (!layer) {
+    return;
+  }
+  weight = std::clamp(weight, 0.0f, 1.0f);
+  if (weight == layer->weight) {
+    return;
+  }
+  Touch(*layer->snapshot,
+        weight > layer->weight ? layer->fadeIn : layer->fadeOut);
+  layer->weight = weight;
+}
+
+void SnapshotBlender::RemoveLayer(LayerKey key) {
+  auto it = std::find_if(m_Layers.begin(), m_Layers.end(),
+                         [key](const Layer &layer) { return layer.key == key; });
+  if (it == m_Layers.end()) {
+    return;
+  }
+  if (it->weight > 0.0f) {
+    Touch(*it->snapshot, it->fadeOut);
+  }
+  m_Layers.erase(it);
+}
+
+bool SnapshotBlender::HasLayer(LayerKey key) const {
+  return std::any_of(m_Layers.begin(), m_Layers.end(),
+                     [key](const Layer &layer) { return layer.key == key; });
+}
+
+void SnapshotBlender::SetReverbBase(uint32_t reverb,
+                                   const ReverbBusState &state) {
+  Reserve(0, reverb + 1);
+  m_ReverbBase[reverb] = state;
+  m_IssuedReverb[reverb] = state;
+  m_Dirty = true;
+}
+
+float SnapshotBlender::GetTarget(uint32_t bus) const {
+  return bus < m_IssuedVolume.size() ? m_IssuedVolume[bus] : kDefaultVolume;
+}
+
+ReverbBusState SnapshotBlender::GetReverbTarget(uint32_t reverb) const {
+  return reverb < m_IssuedReverb.size() ? m_IssuedReverb[reverb]
+                                        : ReverbBusState{};
+}
+
+bool SnapshotBlender::Resolve() {
+  m_BusChanges.clear();
+  m_ReverbChanges.clear();
+  if (!m_Dirty) {
+    return false;
+  }
+  m_Dirty = false;
+
+  std::fill(m_Volume.begin(), m_Volume.end(), kDefaultVolume);
+  for (size_t i = 0; i < m_ReverbBase.size(); ++i) {
+    m_Wet[i] = m_ReverbBase[i].wet;
+    m_RoomSize[i] = m_ReverbBase[i].roomSize;
+    m_Damp[i] = m_ReverbBase[i].damp;
+    m_Width[i] = m_ReverbBase[i].width;
+  }
+
+  for (const auto &layer : m_Layers) {
+    if (layer.weight <= 0.0f) {
+      continue;
+    }
+    const CompiledSnapshot &snap = *layer.snapshot;
+    BlendInto(m_Volume.data(), snap.volume, snap.volumeMask, layer.weight);
+    BlendInto(m_Wet.data(), snap.wet, snap.reverbMask, layer.weight);
+    BlendInto(m_RoomSize.data(), snap.roomSize, snap.reverbMask, layer.weight);
+    BlendInto(m_Damp.data(), snap.damp, snap.reverbMask, layer.weight);
+    BlendInto(m_Width.data(), snap.width, snap.reverbMask, layer.weight);
+  }
+
+  for (size_t i = 0; i < m_Volume.size(); ++i) {
+    if (Moved(m_Volume[i], m_IssuedVolume[i])) {
+      m_IssuedVolume[i] = m_Volume[i];
+      m_BusChanges.push_back(
+          {static_cast<uint32_t>(i), m_Volume[i], m_BusFade[i]});
+    }
+  }
+  std::fill(m_BusFade.begin(), m_BusFade.end(), 0.0f);
+
+  for (size_t i = 0; i < m_ReverbBase.size(); ++i) {
+    const ReverbBusState state{m_Wet[i], m_RoomSize[i], m_Damp[i], m_Width[i]};
+    const ReverbBusState &issued = m_IssuedReverb[i];
+    if (Moved(state.wet, issued.wet) ||
+        Moved(state.roomSize, issued.roomSize) ||
+        Moved(state.damp, issued.damp) || Moved(state.width, issued.width)) {
+      m_IssuedReverb[i] = state;
+      m_ReverbChanges.push_back(
+          {static_cast<uint32_t>(i), state, m_ReverbFade[i]});
+    }
+  }
+  std::fill(m_ReverbFade.begin(), m_ReverbFade.end(), 0.0f);
+
+  return !m_BusChanges.empty() || !m_ReverbChanges.empty();
+}
+
+SnapshotBlender::Layer *SnapshotBlender::FindLayer(LayerKey key) {
+  for (auto &layer : m_Layers) {
+    if (layer.key == key) {
+      return &layer;
+    }
+  }
+  return nullptr;
+}
+
+void SnapshotBlender::Reserve(size_t busCount, size_t reverbCount) {
+  if (busCount > m_Volume.size()) {
+    m_Volume.resize(busCount, kDefaultVolume);
+    m_IssuedVolume.resize(busCount, kDefaultVolume);
+    m_BusFade.resize(busCount, 0.0f);
+  }
+  if (reverbCount > m_ReverbBase.size()) {
+    m_Wet.resize(reverbCount);
+    m_RoomSize.resize(reverbCount);
+    m_Damp.resize(reverbCount);
+    m_Width.resize(reverbCount);
+    m_ReverbBase.resize(reverbCount);
+    m_IssuedReverb.resize(reverbCount);
+    m_ReverbFade.resize(reverbCount, 0.0f);
+  }
+}
+
+void SnapshotBlender::Touch(const CompiledSnapshot &snapshot,
+                            float fadeSeconds) {
+  for (size_t i = 0; i < snapshot.volumeMask.size(); ++i) {
+    m_BusFade[i] = std::max(m_BusFade[i], fadeSeconds * snapshot.volumeMask[i]);
+  }
+  for (size_t i = 0; i < snapshot.reverbMask.size(); ++i) {
+    m_ReverbFade[i] =
+        std::max(m_ReverbFade[i], fadeSeconds * snapshot.reverbMask[i]);
+  }
+  m_Dirty = true;
+}
+
+} // namespace Orpheus
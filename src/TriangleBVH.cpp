@@ -0,0 +1,540 @@
+#include "../include/TriangleBVH.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../include/DSPMath.h"
+
+namespace Orpheus {
+
+namespace {
+
+constexpr int kBinCount = 16;
+constexpr int kStackSize = 96;
+constexpr int kMaxSahDepth = 48; ///< Median splits below this depth
+constexpr float kMinT = 1e-6f;
+constexpr float kMinDet = 1e-12f;
+constexpr uint32_t kPaddingTriangle = UINT32_MAX;
+
+struct BuildTriangle {
+  float min[3];
+  float max[3];
+  float centroid[3];
+  uint32_t index;
+};
+
+struct Bounds {
+  float min[3] = {std::numeric_limits<float>::max(),
+                  std::numeric_limits<float>::max(),
+                  std::numeric_limits<float>::max()};
+  float max[3] = {std::numeric_limits<float>::lowest(),
+                  std::numeric_limits<float>::lowest(),
+                  std::numeric_limits<float>::lowest()};
+
+  void Grow(const float *lo, const float *hi) {
+    for (int a = 0; a < 3; ++a) {
+      min[a] = std::min(min[a], lo[a]);
+      max[a] = std::max(max[a], hi[a]);
+    }
+  }
+
+  void Grow(const float *point) { Grow(point, point); }
+
+  [[nodiscard]] float HalfArea() const {
+    const float dx = max[0] - min[0];
+    const float dy = max[1] - min[1];
+    const float dz = max[2] - min[2];
+    return dx < 0.0f ? 0.0f : dx * dy + dy * dz + dz * dx;
+  }
+};
+
+struct BuildTask {
+  uint32_t node;
+  uint32_t begin;
+  uint32_t end;
+  int depth;
+};
+
+const float *Components(const Vector3 &v) { return &v.x; }
+
+} // namespace
+
+struct TriangleBVH::Ray {
+  float origin[3];
+  float dir[3];
+  float invDir[3];
+
+  Ray(const Vector3 &o, const Vector3 &d)
+      : origin{o.x, o.y, o.z}, dir{d.x, d.y, d.z} {
+    for (int a = 0; a < 3; ++a) {
+      invDir[a] = 1.0f / dir[a]; // +-inf for axis-parallel rays
+    }
+  }
+
+  // Slab test; tEntry is the clipped entry distance
+  bool HitsBox(const float *min, const float *max, float tMax,
+               float &tEntry) const {
+    float t0 = 0.0f;
+    float t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+      float tNear = (min[a] - origin[a]) * invDir[a];
+      float tFar = (max[a] - origin[a]) * invDir[a];
+      if (tNear > tFar) {
+        std::swap(tNear, tFar);
+      }
+      // NaN (0 * inf on a slab plane) leaves the interval unchanged
+      t0 = tNear > t0 ? tNear : t0;
+      t1 = tFar < t1 ? tFar : t1;
+    }
+    tEntry = t0;
+    return t0 <= t1;
+  }
+};
+
+namespace {
+
+// Möller-Trumbore against the four triangles of a block. Returns a lane
+// mask of hits with t in (kMinT, tMax); t and det (sign = facing) are
+// written per lane.
+template <typename Block, typename Ray>
+int IntersectBlock(const Block &b, const Ray &ray, float tMax, float *tOut,
+                   float *detOut) {
+#if defined(ORPHEUS_SIMD_SSE2)
+  const __m128 dx = _mm_set1_ps(ray.dir[0]);
+  const __m128 dy = _mm_set1_ps(ray.dir[1]);
+  const __m128 dz = _mm_set1_ps(ray.dir[2]);
+  const __m128 e1x = _mm_load_ps(b.e1x);
+  const __m128 e1y = _mm_load_ps(b.e1y);
+  const __m128 e1z = _mm_load_ps(b.e1z);
+  const __m128 e2x = _mm_load_ps(b.e2x);
+  const __m128 e2y = _mm_load_ps(b.e2y);
+  const __m128 e2z = _mm_load_ps(b.e2z);
+
+  const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+  const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+  const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+  const __m128 det = _mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)),
+      _mm_mul_ps(e1z, pz));
+  const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+  const __m128 tx = _mm_sub_ps(_mm_set1_ps(ray.origin[0]), _mm_load_ps(b.v0x));
+  const __m128 ty = _mm_sub_ps(_mm_set1_ps(ray.origin[1]), _mm_load_ps(b.v0y));
+  const __m128 tz = _mm_sub_ps(_mm_set1_ps(ray.origin[2]), _mm_load_ps(b.v0z));
+  const __m128 u = _mm_mul_ps(
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)),
+                 _mm_mul_ps(tz, pz)),
+      inv);
+
+  const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+  const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+  const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+  const __m128 v = _mm_mul_ps(
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)),
+                 _mm_mul_ps(dz, qz)),
+      inv);
+  const __m128 t = _mm_mul_ps(
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)),
+                 _mm_mul_ps(e2z, qz)),
+      inv);
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 absDet =
+      _mm_and_ps(det, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+  __m128 mask = _mm_cmpgt_ps(absDet, _mm_set1_ps(kMinDet));
+  mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+  mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+  mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+  mask = _mm_and_ps(mask, _mm_cmpgt_ps(t, _mm_set1_ps(kMinT)));
+  mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(tMax)));
+  _mm_storeu_ps(tOut, t);
+  _mm_storeu_ps(detOut, det);
+  return _mm_movemask_ps(mask);
+#elif defined(ORPHEUS_SIMD_NEON)
+  const float32x4_t dx = vdupq_n_f32(ray.dir[0]);
+  const float32x4_t dy = vdupq_n_f32(ray.dir[1]);
+  const float32x4_t dz = vdupq_n_f32(ray.dir[2]);
+  const float32x4_t e1x = vld1q_f32(b.e1x);
+  const float32x4_t e1y = vld1q_f32(b.e1y);
+  const float32x4_t e1z = vld1q_f32(b.e1z);
+  const float32x4_t e2x = vld1q_f32(b.e2x);
+  const float32x4_t e2y = vld1q_f32(b.e2y);
+  const float32x4_t e2z = vld1q_f32(b.e2z);
+
+  const float32x4_t px = vmlsq_f32(vmulq_f32(dy, e2z), dz, e2y);
+  const float32x4_t py = vmlsq_f32(vmulq_f32(dz, e2x), dx, e2z);
+  const float32x4_t pz = vmlsq_f32(vmulq_f32(dx, e2y), dy, e2x);
+  const float32x4_t det =
+      vmlaq_f32(vmlaq_f32(vmulq_f32(e1x, px), e1y, py), e1z, pz);
+  float32x4_t inv = vrecpeq_f32(det);
+  inv = vmulq_f32(inv, vrecpsq_f32(det, inv));
+  inv = vmulq_f32(inv, vrecpsq_f32(det, inv));
+
+  const float32x4_t tx =
+      vsubq_f32(vdupq_n_f32(ray.origin[0]), vld1q_f32(b.v0x));
+  const float32x4_t ty =
+      vsubq_f32(vdupq_n_f32(ray.origin[1]), vld1q_f32(b.v0y));
+  const float32x4_t tz =
+      vsubq_f32(vdupq_n_f32(ray.origin[2]), vld1q_f32(b.v0z));
+  const float32x4_t u =
+      vmulq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(tx, px), ty, py), tz, pz), inv);
+
+  const float32x4_t qx = vmlsq_f32(vmulq_f32(ty, e1z), tz, e1y);
+  const float32x4_t qy = vmlsq_f32(vmulq_f32(tz, e1x), tx, e1z);
+  const float32x4_t qz = vmlsq_f32(vmulq_f32(tx, e1y), ty, e1x);
+  const float32x4_t v =
+      vmulq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(dx, qx), dy, qy), dz, qz), inv);
+  const float32x4_t t = vmulq_f32(
+      vmlaq_f32(vmlaq_f32(vmulq_f32(e2x, qx), e2y, qy), e2z, qz), inv);
+
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  uint32x4_t mask = vcgtq_f32(vabsq_f32(det), vdupq_n_f32(kMinDet));
+  mask = vandq_u32(mask, vcgeq_f32(u, zero));
+  mask = vandq_u32(mask, vcgeq_f32(v, zero));
+  mask = vandq_u32(mask, vcleq_f32(vaddq_f32(u, v), vdupq_n_f32(1.0f)));
+  mask = vandq_u32(mask, vcgtq_f32(t, vdupq_n_f32(kMinT)));
+  mask = vandq_u32(mask, vcltq_f32(t, vdupq_n_f32(tMax)));
+  vst1q_f32(tOut, t);
+  vst1q_f32(detOut, det);
+  uint32_t lanes[4];
+  vst1q_u32(lanes, mask);
+  return (lanes[0] & 1) | (lanes[1] & 2) | (lanes[2] & 4) | (lanes[3] & 8);
+#else
+  int mask = 0;
+  for (int i = 0; i < 4; ++i) {
+    const float px = ray.dir[1] * b.e2z[i] - ray.dir[2] * b.e2y[i];
+    const float py = ray.dir[2] * b.e2x[i] - ray.dir[0] * b.e2z[i];
+    const float pz = ray.dir[0] * b.e2y[i] - ray.dir[1] * b.e2x[i];
+    const float det = b.e1x[i] * px + b.e1y[i] * py + b.e1z[i] * pz;
+    detOut[i] = det;
+    tOut[i] = 0.0f;
+    if (std::fabs(det) <= kMinDet) {
+      continue;
+    }
+    const float inv = 1.0f / det;
+    const float tx = ray.origin[0] - b.v0x[i];
+    const float ty = ray.origin[1] - b.v0y[i];
+    const float tz = ray.origin[2] - b.v0z[i];
+    const float u = (tx * px + ty * py + tz * pz) * inv;
+    const float qx = ty * b.e1z[i] - tz * b.e1y[i];
+    const float qy = tz * b.e1x[i] - tx * b.e1z[i];
+    const float qz = tx * b.e1y[i] - ty * b.e1x[i];
+    const float v = (ray.dir[0] * qx + ray.dir[1] * qy + ray.dir[2] * qz) * inv;
+    const float t = (b.e2x[i] * qx + b.e2y[i] * qy + b.e2z[i] * qz) * inv;
+    tOut[i] = t;
+    if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > kMinT && t < tMax) {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+} // namespace
+
+void TriangleBVH::Build(const Vector3 *vertices, const uint32_t *indices,
+                        size_t triangleCount) {
+  Clear();
+  if (triangleCount == 0) {
+    return;
+  }
+  m_TriangleCount = triangleCount;
+
+  std::vector<BuildTriangle> tris(triangleCount);
+  for (size_t i = 0; i < triangleCount; ++i) {
+    BuildTriangle &tri = tris[i];
+    const float *a = Components(vertices[indices[3 * i]]);
+    const float *b = Components(vertices[indices[3 * i + 1]]);
+    const float *c = Components(vertices[indices[3 * i + 2]]);
+    for (int axis = 0; axis < 3; ++axis) {
+      tri.min[axis] = std::min({a[axis], b[axis], c[axis]});
+      tri.max[axis] = std::max({a[axis], b[axis], c[axis]});
+      tri.centroid[axis] = 0.5f * (tri.min[axis] + tri.max[axis]);
+    }
+    tri.index = static_cast<uint32_t>(i);
+  }
+
+  m_Nodes.reserve(2 * (triangleCount / kLeafSize + 1));
+  m_Blocks.reserve(triangleCount / 2 + 1);
+  m_Nodes.emplace_back();
+  std::vector<BuildTask> tasks;
+  tasks.push_back({0, 0, static_cast<uint32_t>(triangleCount), 0});
+
+  while (!tasks.empty()) {
+    const BuildTask task = tasks.back();
+    tasks.pop_back();
+
+    Bounds bounds;
+    Bounds centroids;
+    for (uint32_t i = task.begin; i < task.end; ++i) {
+      bounds.Grow(tris[i].min, tris[i].max);
+      centroids.Grow(tris[i].centroid);
+    }
+    Node &node = m_Nodes[task.node];
+    std::copy(bounds.min, bounds.min + 3, node.min);
+    std::copy(bounds.max, bounds.max + 3, node.max);
+
+    const uint32_t count = task.end - task.begin;
+    if (count <= kLeafSize) {
+      node.first = static_cast<uint32_t>(m_Blocks.size());
+      node.count = count;
+      Block &block = m_Blocks.emplace_back();
+      for (uint32_t lane = 0; lane < kLeafSize; ++lane) {
+        block.triangle[lane] =
+            lane < count ? tris[task.begin + lane].index : kPaddingTriangle;
+      }
+      FillBlock(block, vertices, indices);
+      continue;
+    }
+
+    // Binned SAH over centroids on the axis with the cheapest split
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    if (task.depth < kMaxSahDepth) {
+      for (int axis = 0; axis < 3; ++axis) {
+        const float lo = centroids.min[axis];
+        const float extent = centroids.max[axis] - lo;
+        if (extent <= 0.0f) {
+          continue;
+        }
+        const float scale = kBinCount / extent;
+        Bounds bins[kBinCount];
+        uint32_t binCounts[kBinCount] = {};
+        for (uint32_t i = task.begin; i < task.end; ++i) {
+          const int bin = std::min(
+              kBinCount - 1,
+              static_cast<int>((tris[i].centroid[axis] - lo) * scale));
+          bins[bin].Grow(tris[i].min, tris[i].max);
+          ++binCounts[bin];
+        }
+
+        // Right-to-left sweep of areas, then left-to-right evaluation
+        float rightArea[kBinCount];
+        uint32_t rightCount[kBinCount];
+        Bounds right;
+        uint32_t rightSum = 0;
+        for (int bin = kBinCount - 1; bin > 0; --bin) {
+          right.Grow(bins[bin].min, bins[bin].max);
+          rightSum += binCounts[bin];
+          rightArea[bin] = right.HalfArea();
+          rightCount[bin] = rightSum;
+        }
+        Bounds left;
+        uint32_t leftSum = 0;
+        for (int split = 1; split < kBinCount; ++split) {
+          left.Grow(bins[split - 1].min, bins[split - 1].max);
+          leftSum += binCounts[split - 1];
+          if (leftSum == 0 || rightCount[split] == 0) {
+            continue;
+          }
+          const float cost = left.HalfArea() * static_cast<float>(leftSum) +
+                             rightArea[split] *
+                                 static_cast<float>(rightCount[split]);
+          if (cost < bestCost) {
+            bestCost = cost;
+            bestAxis = axis;
+            bestSplit = split;
+          }
+        }
+      }
+    }
+
+    uint32_t mid;
+    if (bestAxis >= 0) {
+      const float lo = centroids.min[bestAxis];
+      const float scale =
+          kBinCount / (centroids.max[bestAxis] - centroids.min[bestAxis]);
+      auto it = std::partition(
+          tris.begin() + task.begin, tris.begin() + task.end,
+          [&](const BuildTriangle &tri) {
+            const int bin = std::min(
+                kBinCount - 1,
+                static_cast<int>((tri.centroid[bestAxis] - lo) * scale));
+            return bin < bestSplit;
+          });
+      mid = static_cast<uint32_t>(it - tris.begin());
+    } else {
+      // Coincident centroids or too deep: median split on the widest axis
+      int axis = 0;
+      for (int a = 1; a < 3; ++a) {
+        if (centroids.max[a] - centroids.min[a] >
+            centroids.max[axis] - centroids.min[axis]) {
+          axis = a;
+        }
+      }
+      mid = task.begin + count / 2;
+      std::nth_element(tris.begin() + task.begin, tris.begin() + mid,
+                       tris.begin() + task.end,
+                       [axis](const BuildTriangle &a, const BuildTriangle &b) {
+                         return a.centroid[axis] < b.centroid[axis];
+                       });
+    }
+
+    const auto left = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes[task.node].first = left;
+    m_Nodes[task.node].count = 0;
+    m_Nodes.emplace_back();
+    m_Nodes.emplace_back();
+    tasks.push_back({left + 1, mid, task.end, task.depth + 1});
+    tasks.push_back({left, task.begin, mid, task.depth + 1});
+  }
+}
+
+void TriangleBVH::Refit(const Vector3 *vertices, const uint32_t *indices) {
+  for (Block &block : m_Blocks) {
+    FillBlock(block, vertices, indices);
+  }
+
+  // Children always follow their parent, so a reverse sweep is bottom-up
+  for (size_t i = m_Nodes.size(); i-- > 0;) {
+    Node &node = m_Nodes[i];
+    Bounds bounds;
+    if (node.count > 0) {
+      const Block &block = m_Blocks[node.first];
+      for (uint32_t lane = 0; lane < node.count; ++lane) {
+        const float v0[3] = {block.v0x[lane], block.v0y[lane],
+                             block.v0z[lane]};
+        const float v1[3] = {v0[0] + block.e1x[lane], v0[1] + block.e1y[lane],
+                             v0[2] + block.e1z[lane]};
+        const float v2[3] = {v0[0] + block.e2x[lane], v0[1] + block.e2y[lane],
+                             v0[2] + block.e2z[lane]};
+        bounds.Grow(v0);
+        bounds.Grow(v1);
+        bounds.Grow(v2);
+      }
+    } else {
+      const Node &left = m_Nodes[node.first];
+      const Node &right = m_Nodes[node.first + 1];
+      bounds.Grow(left.min, left.max);
+      bounds.Grow(right.min, right.max);
+    }
+    std::copy(bounds.min, bounds.min + 3, node.min);
+    std::copy(bounds.max, bounds.max + 3, node.max);
+  }
+}
+
+void TriangleBVH::Clear() {
+  m_Nodes.clear();
+  m_Blocks.clear();
+  m_TriangleCount = 0;
+}
+
+void TriangleBVH::FillBlock(Block &block, const Vector3 *vertices,
+                            const uint32_t *indices) const {
+  for (uint32_t lane = 0; lane < kLeafSize; ++lane) {
+    const uint32_t tri = block.triangle[lane];
+    if (tri == kPaddingTriangle) {
+      // Degenerate triangle at the origin never passes the det test
+      block.v0x[lane] = block.v0y[lane] = block.v0z[lane] = 0.0f;
+      block.e1x[lane] = block.e1y[lane] = block.e1z[lane] = 0.0f;
+      block.e2x[lane] = block.e2y[lane] = block.e2z[lane] = 0.0f;
+      continue;
+    }
+    const Vector3 &a = vertices[indices[3 * tri]];
+    const Vector3 &b = vertices[indices[3 * tri + 1]];
+    const Vector3 &c = vertices[indices[3 * tri + 2]];
+    block.v0x[lane] = a.x;
+    block.v0y[lane] = a.y;
+    block.v0z[lane] = a.z;
+    block.e1x[lane] = b.x - a.x;
+    block.e1y[lane] = b.y - a.y;
+    block.e1z[lane] = b.z - a.z;
+    block.e2x[lane] = c.x - a.x;
+    block.e2y[lane] = c.y - a.y;
+    block.e2z[lane] = c.z - a.z;
+  }
+}
+
+template <typename OnHit>
+void TriangleBVH::Traverse(const Ray &ray, float &tMax, bool ordered,
+                           OnHit &&onHit) const {
+  float tEntry;
+  if (m_Nodes.empty() ||
+      !ray.HitsBox(m_Nodes[0].min, m_Nodes[0].max, tMax, tEntry)) {
+    return;
+  }
+
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const Node &node = m_Nodes[stack[--top]];
+    if (node.count > 0) {
+      const Block &block = m_Blocks[node.first];
+      alignas(16) float t[4];
+      alignas(16) float det[4];
+      const int mask = IntersectBlock(block, ray, tMax, t, det);
+      for (uint32_t lane = 0; mask != 0 && lane < kLeafSize; ++lane) {
+        if (!(mask & (1 << lane)) || t[lane] >= tMax) {
+          continue; // Missed, or tMax shrank for an earlier lane
+        }
+        if (onHit(BVHHit{t[lane], block.triangle[lane], det[lane] > 0.0f})) {
+          return;
+        }
+      }
+      continue;
+    }
+
+    const Node &left = m_Nodes[node.first];
+    const Node &right = m_Nodes[node.first + 1];
+    float tLeft, tRight;
+    const bool hitLeft = ray.HitsBox(left.min, left.max, tMax, tLeft);
+    const bool hitRight = ray.HitsBox(right.min, right.max, tMax, tRight);
+    if (hitLeft && hitRight) {
+      // The nearer child is popped first
+      const bool rightFirst = ordered && tRight < tLeft;
+      stack[top++] = rightFirst ? node.first : node.first + 1;
+      stack[top++] = rightFirst ? node.first + 1 : node.first;
+    } else if (hitLeft) {
+      stack[top++] = node.first;
+    } else if (hitRight) {
+      stack[top++] = node.first + 1;
+    }
+  }
+}
+
+void TriangleBVH::IntersectAll(const Vector3 &origin, const Vector3 &dir,
+                               float tMax, std::vector<BVHHit> &hits) const {
+  const Ray ray(origin, dir);
+  Traverse(ray, tMax, false, [&](const BVHHit &hit) {
+    hits.push_back(hit);
+    return false;
+  });
+}
+
+bool TriangleBVH::IntersectClosest(const Vector3 &origin, const Vector3 &dir,
+                                   float tMax, BVHHit &hit) const {
+  const Ray ray(origin, dir);
+  bool found = false;
+  Traverse(ray, tMax, true, [&](const BVHHit &candidate) {
+    hit = candidate;
+    tMax = candidate.t;
+    found = true;
+    return false;
+  });
+  return found;
+}
+
+bool TriangleBVH::IntersectAny(const Vector3 &origin, const Vector3 &dir,
+                               float tMax) const {
+  const Ray ray(origin, dir);
+  bool found = false;
+  Traverse(ray, tMax, false, [&](const BVHHit &) {
+    found = true;
+    return true;
+  });
+  return found;
+}
+
+void TriangleBVH::GetBounds(Vector3 &min, Vector3 &max) const {
+  if (m_Nodes.empty()) {
+    min = max = {0.0f, 0.0f, 0.0f};
+    return;
+  }
+  min = {m_Nodes[0].min[0], m_Nodes[0].min[1], m_Nodes[0].min[2]};
+  max = {m_Nodes[0].max[0], m_Nodes[0].max[1], m_Nodes[0].max[2]};
+}
+
+} // namespace Orpheus
@@ -24,10 +24,17 @@ Voice *VoicePool::AllocateVoice(const std::string &eventName, uint8_t priority,
   voice->eventName = eventName;
   voice->priority = priority;
   voice->position = position;
+  voice->apparentPosition = position;
   voice->distanceSettings = distanceSettings;
   voice->playbackTime = 0.0f;
   voice->startTime = m_CurrentTime;
   voice->state = VoiceState::Virtual;
+  voice->occlusionAge = -1.0f;
+  voice->hasPropagation = false;
+  voice->propagationVolume = voice->propagationVolumeSmoothed = 1.0f;
+  voice->propagationLowPassFreq = voice->propagationLowPassSmoothed = 22000.0f;
+  voice->propagationReverbSend = voice->propagationReverbSendSmoothed = 0.0f;
+  voice->propagationAge = -1.0f;
 
   return voice;
 }
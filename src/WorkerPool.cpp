@@ -0,0 +1,113 @@
+#include "../include/WorkerPool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Orpheus {
+
+namespace {
+
+/// One ParallelFor() call; lives on the caller's stack.
+struct Loop {
+  const std::function<void(size_t)> *fn;
+  size_t count;
+  size_t next = 0;     ///< Next unclaimed index
+  size_t finished = 0; ///< Indices run
+  uint32_t users = 0;  ///< Workers currently inside the loop
+};
+
+} // namespace
+
+struct WorkerPoolImpl {
+  std::mutex mutex;
+  std::condition_variable wake; ///< Loops queued or stopping
+  std::condition_variable done; ///< An index or a worker finished
+  std::deque<Loop *> loops;     ///< Loops with unclaimed indices
+  std::vector<std::thread> workers;
+  bool stop = false;
+
+  // Claim and run indices until none are left. Called with the lock held;
+  // the lock is released while running.
+  void Work(Loop &loop, std::unique_lock<std::mutex> &lock) {
+    while (loop.next < loop.count) {
+      const size_t index = loop.next++;
+      if (loop.next == loop.count) {
+        loops.erase(std::find(loops.begin(), loops.end(), &loop));
+      }
+      lock.unlock();
+      (*loop.fn)(index);
+      lock.lock();
+      ++loop.finished;
+    }
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [this] { return stop || !loops.empty(); });
+      if (stop) {
+        return;
+      }
+      Loop &loop = *loops.front();
+      ++loop.users;
+      Work(loop, lock);
+      --loop.users;
+      done.notify_all();
+    }
+  }
+};
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+    : m_Impl(std::make_unique<WorkerPoolImpl>()) {
+  if (threadCount == 0) {
+    const uint32_t hardware = std::thread::hardware_concurrency();
+    threadCount = hardware > 1 ? hardware - 1 : 1;
+  }
+  m_Impl->workers.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; ++i) {
+    m_Impl->workers.emplace_back([impl = m_Impl.get()] { impl->Run(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->mutex);
+    m_Impl->stop = true;
+  }
+  m_Impl->wake.notify_all();
+  for (auto &worker : m_Impl->workers) {
+    worker.join();
+  }
+}
+
+void WorkerPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1) {
+    fn(0);
+    return;
+  }
+
+  Loop loop{&fn, count};
+  std::unique_lock<std::mutex> lock(m_Impl->mutex);
+  m_Impl->loops.push_back(&loop);
+  m_Impl->wake.notify_all();
+  m_Impl->Work(loop, lock);
+
+  // Workers may still be running claimed indices or leaving the loop
+  m_Impl->done.wait(lock, [&loop] {
+    return loop.finished == loop.count && loop.users == 0;
+  });
+}
+
+uint32_t WorkerPool::GetThreadCount() const {
+  return static_cast<uint32_t>(m_Impl->workers.size());
+}
+
+} // namespace Orpheus
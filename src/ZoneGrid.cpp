@@ -0,0 +1,122 @@
+#include "../include/ZoneGrid.h"
+
+#include <algorithm>
+
+namespace Orpheus {
+
+ZoneGrid::ZoneGrid(float cellSize)
+    : m_InvCellSize(1.0f / (std::max)(cellSize, 0.001f)) {}
+
+uint32_t ZoneGrid::Insert(const Vector3 &min, const Vector3 &max,
+                          ZoneLayer layer, uint32_t userData) {
+  uint32_t id;
+  if (!m_FreeList.empty()) {
+    id = m_FreeList.back();
+    m_FreeList.pop_back();
+  } else {
+    id = static_cast<uint32_t>(m_Proxies.size());
+    m_Proxies.emplace_back();
+  }
+
+  Proxy &p = m_Proxies[id];
+  p = Proxy{};
+  p.min = min;
+  p.max = max;
+  p.layer = layer;
+  p.userData = userData;
+  p.alive = true;
+  Link(id);
+  return id;
+}
+
+void ZoneGrid::Update(uint32_t proxy, const Vector3 &min, const Vector3 &max) {
+  if (proxy >= m_Proxies.size() || !m_Proxies[proxy].alive) {
+    return;
+  }
+  Proxy &p = m_Proxies[proxy];
+  p.min = min;
+  p.max = max;
+
+  // Most moves stay inside the same cells
+  if (!p.oversized && CellCoord(min.x) == p.x0 && CellCoord(min.z) == p.z0 &&
+      CellCoord(max.x) == p.x1 && CellCoord(max.z) == p.z1) {
+    return;
+  }
+  Unlink(proxy);
+  Link(proxy);
+}
+
+void ZoneGrid::Remove(uint32_t proxy) {
+  if (proxy >= m_Proxies.size() || !m_Proxies[proxy].alive) {
+    return;
+  }
+  Unlink(proxy);
+  m_Proxies[proxy].alive = false;
+  m_FreeList.push_back(proxy);
+}
+
+void ZoneGrid::SetUserData(uint32_t proxy, uint32_t userData) {
+  if (proxy < m_Proxies.size()) {
+    m_Proxies[proxy].userData = userData;
+  }
+}
+
+void ZoneGrid::Clear() {
+  m_Proxies.clear();
+  m_FreeList.clear();
+  m_Cells.clear();
+  m_Oversized.clear();
+}
+
+void ZoneGrid::Link(uint32_t id) {
+  Proxy &p = m_Proxies[id];
+  p.x0 = CellCoord(p.min.x);
+  p.z0 = CellCoord(p.min.z);
+  p.x1 = CellCoord(p.max.x);
+  p.z1 = CellCoord(p.max.z);
+
+  const int64_t cells = (static_cast<int64_t>(p.x1) - p.x0 + 1) *
+                        (static_cast<int64_t>(p.z1) - p.z0 + 1);
+  p.oversized = cells > kMaxCellsPerProxy || cells <= 0;
+  if (p.oversized) {
+    m_Oversized.push_back(id);
+    return;
+  }
+
+  for (int32_t x = p.x0; x <= p.x1; ++x) {
+    for (int32_t z = p.z0; z <= p.z1; ++z) {
+      m_Cells[Key(x, z)].push_back(id);
+    }
+  }
+}
+
+void ZoneGrid::Unlink(uint32_t id) {
+  const Proxy &p = m_Proxies[id];
+  auto erase = [id](std::vector<uint32_t> &list) {
+    auto it = std::find(list.begin(), list.end(), id);
+    if (it != list.end()) {
+      *it = list.back();
+      list.pop_back();
+    }
+  };
+
+  if (p.oversized) {
+    erase(m_Oversized);
+    return;
+  }
+
+  for (int32_t x = p.x0; x <= p.x1; ++x) {
+    for (int32_t z = p.z0; z <= p.z1; ++z) {
+      auto it = m_Cells.find(Key(x, z));
+      if (it == m_Cells.end()) {
+        continue;
+      }
+      erase(it->second);
+      if (it->second.empty()) {
+        m_Cells.erase(it);
+      }
+    }
+  }
+}
+
+} // namespace Orpheus
@@ -0,0 +1,69 @@
+#include "../include/ZonePool.h"
+
+namespace Orpheus {
+
+uint32_t ZonePool::Add(const std::string &eventName,
+                       const ZoneGeometry &geometry, float prefetchRadius,
+                       const std::string &snapshotName, float fadeIn,
+                       float fadeOut) {
+  const auto zone = static_cast<uint32_t>(m_Geometry.size());
+  m_Geometry.push_back(geometry);
+  m_Handle.push_back(0);
+  m_Flags.push_back(0);
+  m_PrefetchRadius.push_back(prefetchRadius > 0.0f ? prefetchRadius : 0.0f);
+  m_Event.push_back(Intern(eventName));
+  m_Snapshot.push_back(snapshotName.empty() ? kNoName : Intern(snapshotName));
+  m_FadeIn.push_back(fadeIn);
+  m_FadeOut.push_back(fadeOut);
+  return zone;
+}
+
+uint32_t ZonePool::Find(const std::string &eventName) const {
+  auto it = m_NameIndex.find(eventName);
+  if (it == m_NameIndex.end()) {
+    return kInvalidZone;
+  }
+  for (uint32_t zone = 0; zone < m_Event.size(); ++zone) {
+    if (m_Event[zone] == it->second) {
+      return zone;
+    }
+  }
+  return kInvalidZone;
+}
+
+const std::string &ZonePool::GetSnapshotName(uint32_t zone) const {
+  static const std::string kEmpty;
+  return HasSnapshot(zone) ? m_Names[m_Snapshot[zone]] : kEmpty;
+}
+
+void ZonePool::GetBounds(uint32_t zone, Vector3 &min, Vector3 &max) const {
+  m_Geometry[zone].GetBounds(min, max);
+  const float pad = GetPrefetchReleaseRadius(zone);
+  min = {min.x - pad, min.y - pad, min.z - pad};
+  max = {max.x + pad, max.y + pad, max.z + pad};
+}
+
+uint32_t ZonePool::Intern(const std::string &name) {
+  auto [it, inserted] =
+      m_NameIndex.try_emplace(name, static_cast<uint32_t>(m_Names.size()));
+  if (inserted) {
+    m_Names.push_back(name);
+  }
+  return it->second;
+}
+
+bool ZonePool::InPrefetchRange(uint32_t zone, const Vector3 *listeners,
+                               size_t listenerCount) const {
+  // Acquire at the prefetch radius, release a little further out
+  const float margin =
+      IsPrefetched(zone) ? GetPrefetchReleaseRadius(zone)
+                         : m_PrefetchRadius[zone];
+  for (size_t i = 0; i < listenerCount; ++i) {
+    if (m_Geometry[zone].IsWithin(listeners[i], margin)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace Orpheus
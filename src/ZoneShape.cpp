@@ -0,0 +1,343 @@
+#include "../include/ZoneShape.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Orpheus {
+
+// --- PolygonData ---
+
+PolygonData::PolygonData(const std::vector<Vector2> &points) {
+  if (points.empty()) {
+    m_BandBegin.assign(2, 0);
+    return;
+  }
+
+  m_Min = m_Max = points[0];
+  for (const auto &p : points) {
+    m_Min.x = (std::min)(m_Min.x, p.x);
+    m_Min.y = (std::min)(m_Min.y, p.y);
+    m_Max.x = (std::max)(m_Max.x, p.x);
+    m_Max.y = (std::max)(m_Max.y, p.y);
+  }
+
+  const size_t n = points.size();
+  m_Edges.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const Vector2 &a = points[i];
+    const Vector2 &b = points[(i + 1) % n];
+    Edge e;
+    e.x0 = a.x;
+    e.z0 = a.y;
+    e.x1 = b.x;
+    e.z1 = b.y;
+    e.dx = b.x - a.x;
+    e.dz = b.y - a.y;
+    const float lengthSq = e.dx * e.dx + e.dz * e.dz;
+    e.invLengthSq = lengthSq > 0.0f ? 1.0f / lengthSq : 0.0f;
+    e.xPerZ = e.dz != 0.0f ? e.dx / e.dz : 0.0f;
+    e.minX = (std::min)(a.x, b.x);
+    e.maxX = (std::max)(a.x, b.x);
+    e.minZ = (std::min)(a.y, b.y);
+    e.maxZ = (std::max)(a.y, b.y);
+    m_Edges.push_back(e);
+  }
+
+  // About sqrt(n) bands keeps both the band count and edges per band small
+  const float height = m_Max.y - m_Min.y;
+  m_BandCount = static_cast<uint32_t>(
+      std::clamp(std::sqrt(static_cast<float>(n)), 1.0f, 256.0f));
+  if (height <= 0.0f) {
+    m_BandCount = 1;
+  }
+  m_InvBandHeight =
+      height > 0.0f ? static_cast<float>(m_BandCount) / height : 0.0f;
+
+  // Counting pass, then fill (CSR)
+  m_BandBegin.assign(m_BandCount + 1, 0);
+  for (const auto &e : m_Edges) {
+    for (uint32_t b = Band(e.minZ), end = Band(e.maxZ); b <= end; ++b) {
+      ++m_BandBegin[b + 1];
+    }
+  }
+  for (uint32_t b = 0; b < m_BandCount; ++b) {
+    m_BandBegin[b + 1] += m_BandBegin[b];
+  }
+  m_BandEdges.resize(m_BandBegin[m_BandCount]);
+  std::vector<uint32_t> cursor(m_BandBegin.begin(), m_BandBegin.end() - 1);
+  for (uint32_t i = 0; i < m_Edges.size(); ++i) {
+    const Edge &e = m_Edges[i];
+    for (uint32_t b = Band(e.minZ), end = Band(e.maxZ); b <= end; ++b) {
+      m_BandEdges[cursor[b]++] = i;
+    }
+  }
+}
+
+uint32_t PolygonData::Band(float z) const {
+  const float band = (z - m_Min.y) * m_InvBandHeight;
+  if (!(band > 0.0f)) {
+    return 0;
+  }
+  return (std::min)(static_cast<uint32_t>(band), m_BandCount - 1);
+}
+
+bool PolygonData::Contains(float x, float z) const {
+  if (m_Edges.size() < 3 || x < m_Min.x || x > m_Max.x || z < m_Min.y ||
+      z > m_Max.y) {
+    return false;
+  }
+
+  // Ray cast along +x; only edges spanning z can cross, and all of those
+  // are in z's band
+  bool inside = false;
+  const uint32_t band = Band(z);
+  for (uint32_t i = m_BandBegin[band]; i < m_BandBegin[band + 1]; ++i) {
+    const Edge &e = m_Edges[m_BandEdges[i]];
+    if ((e.z0 > z) != (e.z1 > z) && x < e.x0 + (z - e.z0) * e.xPerZ) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+float PolygonData::Distance(float x, float z, float maxDistance) const {
+  if (m_Edges.empty() || x < m_Min.x - maxDistance ||
+      x > m_Max.x + maxDistance || z < m_Min.y - maxDistance ||
+      z > m_Max.y + maxDistance) {
+    return FLT_MAX;
+  }
+  if (Contains(x, z)) {
+    return 0.0f;
+  }
+
+  // Nearest edge within maxDistance; shrink the search as hits come in
+  float best = maxDistance;
+  float bestSq = maxDistance * maxDistance;
+  bool found = false;
+  const uint32_t first = Band(z - maxDistance);
+  const uint32_t last = Band(z + maxDistance);
+  for (uint32_t band = first; band <= last; ++band) {
+    for (uint32_t i = m_BandBegin[band]; i < m_BandBegin[band + 1]; ++i) {
+      const Edge &e = m_Edges[m_BandEdges[i]];
+      if (x < e.minX - best || x > e.maxX + best || z < e.minZ - best ||
+          z > e.maxZ + best) {
+        continue;
+      }
+      const float px = x - e.x0;
+      const float pz = z - e.z0;
+      const float t =
+          std::clamp((px * e.dx + pz * e.dz) * e.invLengthSq, 0.0f, 1.0f);
+      const float ex = px - t * e.dx;
+      const float ez = pz - t * e.dz;
+      const float distSq = ex * ex + ez * ez;
+      if (distSq <= bestSq) {
+        bestSq = distSq;
+        best = std::sqrt(distSq);
+        found = true;
+      }
+    }
+  }
+  return found ? best : FLT_MAX;
+}
+
+// --- ZoneGeometry ---
+
+ZoneGeometry ZoneGeometry::Sphere(const Vector3 &center, float inner,
+                                  float outer) {
+  ZoneGeometry g;
+  g.m_Type = ZoneShapeType::Sphere;
+  g.m_Center = center;
+  g.m_Inner = inner;
+  g.m_Outer = outer;
+  g.m_HalfExtents = {outer, outer, outer};
+  return g;
+}
+
+ZoneGeometry ZoneGeometry::Box(const Vector3 &min, const Vector3 &max,
+                               float fadeDistance) {
+  ZoneGeometry g;
+  g.m_Type = ZoneShapeType::Box;
+  g.m_Center = {(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f,
+                (min.z + max.z) * 0.5f};
+  g.m_HalfExtents = {std::abs(max.x - min.x) * 0.5f,
+                     std::abs(max.y - min.y) * 0.5f,
+                     std::abs(max.z - min.z) * 0.5f};
+  g.m_Outer = (std::max)(fadeDistance, 0.0f);
+  return g;
+}
+
+ZoneGeometry ZoneGeometry::Polygon(const std::vector<Vector2> &points,
+                                   float minY, float maxY, float fadeDistance) {
+  Vector2 lo;
+  Vector2 hi;
+  if (!points.empty()) {
+    lo = hi = points[0];
+    for (const auto &p : points) {
+      lo.x = (std::min)(lo.x, p.x);
+      lo.y = (std::min)(lo.y, p.y);
+      hi.x = (std::max)(hi.x, p.x);
+      hi.y = (std::max)(hi.y, p.y);
+    }
+  }
+
+  // Store vertices relative to the bounds center so SetCenter is a move
+  const float cx = (lo.x + hi.x) * 0.5f;
+  const float cz = (lo.y + hi.y) * 0.5f;
+  std::vector<Vector2> local;
+  local.reserve(points.size());
+  for (const auto &p : points) {
+    local.push_back({p.x - cx, p.y - cz});
+  }
+
+  ZoneGeometry g;
+  g.m_Type = ZoneShapeType::Polygon;
+  g.m_Center = {cx, (minY + maxY) * 0.5f, cz};
+  g.m_HalfExtents = {(hi.x - lo.x) * 0.5f, std::abs(maxY - minY) * 0.5f,
+                     (hi.y - lo.y) * 0.5f};
+  g.m_Outer = (std::max)(fadeDistance, 0.0f);
+  g.m_Polygon = std::make_shared<const PolygonData>(local);
+  return g;
+}
+
+float ZoneGeometry::Fade(float distance) const {
+  if (distance <= 0.0f) {
+    return 1.0f;
+  }
+  if (distance >= m_Outer) {
+    return 0.0f;
+  }
+  return 1.0f - distance / m_Outer;
+}
+
+float ZoneGeometry::ComputeVolume(const Vector3 &point) const {
+  switch (m_Type) {
+  case ZoneShapeType::Sphere: {
+    const float dx = point.x - m_Center.x;
+    const float dy = point.y - m_Center.y;
+    const float dz = point.z - m_Center.z;
+    const float distSq = dx * dx + dy * dy + dz * dz;
+    if (distSq > m_Outer * m_Outer) {
+      return 0.0f;
+    }
+    const float dist = std::sqrt(distSq);
+    if (dist < m_Inner || m_Outer <= m_Inner) {
+      return 1.0f;
+    }
+    return 1.0f - (dist - m_Inner) / (m_Outer - m_Inner);
+  }
+  case ZoneShapeType::Box: {
+    const float dx = (std::max)(
+        0.0f, std::abs(point.x - m_Center.x) - m_HalfExtents.x);
+    const float dy = (std::max)(
+        0.0f, std::abs(point.y - m_Center.y) - m_HalfExtents.y);
+    const float dz = (std::max)(
+        0.0f, std::abs(point.z - m_Center.z) - m_HalfExtents.z);
+    const float distSq = dx * dx + dy * dy + dz * dz;
+    if (distSq == 0.0f) {
+      return 1.0f;
+    }
+    if (distSq >= m_Outer * m_Outer) {
+      return 0.0f;
+    }
+    return Fade(std::sqrt(distSq));
+  }
+  case ZoneShapeType::Polygon: {
+    const float dy = (std::max)(
+        0.0f, std::abs(point.y - m_Center.y) - m_HalfExtents.y);
+    if (dy > 0.0f && dy >= m_Outer) {
+      return 0.0f;
+    }
+    const float dxz = m_Polygon->Distance(point.x - m_Center.x,
+                                          point.z - m_Center.z, m_Outer);
+    if (dxz == FLT_MAX) {
+      return 0.0f;
+    }
+    return Fade(std::sqrt(dy * dy + dxz * dxz));
+  }
+  }
+  return 0.0f;
+}
+
+float ZoneGeometry::GetDistance(const Vector3 &point) const {
+  switch (m_Type) {
+  case ZoneShapeType::Sphere: {
+    const float dx = point.x - m_Center.x;
+    const float dy = point.y - m_Center.y;
+    const float dz = point.z - m_Center.z;
+    return (std::max)(0.0f, std::sqrt(dx * dx + dy * dy + dz * dz) - m_Inner);
+  }
+  case ZoneShapeType::Box: {
+    const float dx = (std::max)(
+        0.0f, std::abs(point.x - m_Center.x) - m_HalfExtents.x);
+    const float dy = (std::max)(
+        0.0f, std::abs(point.y - m_Center.y) - m_HalfExtents.y);
+    const float dz = (std::max)(
+        0.0f, std::abs(point.z - m_Center.z) - m_HalfExtents.z);
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+  }
+  case ZoneShapeType::Polygon: {
+    const float dy = (std::max)(
+        0.0f, std::abs(point.y - m_Center.y) - m_HalfExtents.y);
+    const float dxz = m_Polygon->Distance(point.x - m_Center.x,
+                                          point.z - m_Center.z, m_Outer);
+    if (dxz == FLT_MAX) {
+      return FLT_MAX;
+    }
+    return std::sqrt(dy * dy + dxz * dxz);
+  }
+  }
+  return FLT_MAX;
+}
+
+bool ZoneGeometry::IsWithin(const Vector3 &point, float margin) const {
+  const float reach = m_Outer + (std::max)(margin, 0.0f);
+  switch (m_Type) {
+  case ZoneShapeType::Sphere: {
+    const float dx = point.x - m_Center.x;
+    const float dy = point.y - m_Center.y;
+    const float dz = point.z - m_Center.z;
+    return dx * dx + dy * dy + dz * dz <= reach * reach;
+  }
+  case ZoneShapeType::Box: {
+    const float dx = (std::max)(
+        0.0f, std::abs(point.x - m_Center.x) - m_HalfExtents.x);
+    const float dy = (std::max)(
+        0.0f, std::abs(point.y - m_Center.y) - m_HalfExtents.y);
+    const float dz = (std::max)(
+        0.0f, std::abs(point.z - m_Center.z) - m_HalfExtents.z);
+    return dx * dx + dy * dy + dz * dz <= reach * reach;
+  }
+  case ZoneShapeType::Polygon: {
+    const float dy = (std::max)(
+        0.0f, std::abs(point.y - m_Center.y) - m_HalfExtents.y);
+    if (dy > reach) {
+      return false;
+    }
+    const float dxz = m_Polygon->Distance(point.x - m_Center.x,
+                                          point.z - m_Center.z, reach);
+    return dxz != FLT_MAX && dy * dy + dxz * dxz <= reach * reach;
+  }
+  }
+  return false;
+}
+
+void ZoneGeometry::GetBounds(Vector3 &min, Vector3 &max) const {
+  // Sphere half extents are the outer radius; other shapes add the fade
+  const float pad = m_Type == ZoneShapeType::Sphere ? 0.0f : m_Outer;
+  min = {m_Center.x - m_HalfExtents.x - pad, m_Center.y - m_HalfExtents.y - pad,
+         m_Center.z - m_HalfExtents.z - pad};
+  max = {m_Center.x + m_HalfExtents.x + pad, m_Center.y + m_HalfExtents.y + pad,
+         m_Center.z + m_HalfExtents.z + pad};
+}
+
+void ZoneGeometry::SetRadii(float inner, float outer) {
+  if (m_Type == ZoneShapeType::Sphere) {
+    m_Inner = inner;
+    m_Outer = outer;
+    m_HalfExtents = {outer, outer, outer};
+  } else {
+    m_Outer = (std::max)(outer - inner, 0.0f);
+  }
+}
+
+} // namespace Orpheus
@@ -0,0 +1,151 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/AcousticProbeGrid.h"
+#include "include/AcousticScene.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// Tracer inside a 20 x 10 x 15 m concrete box
+struct Room {
+  std::shared_ptr<AcousticScene> scene = std::make_shared<AcousticScene>();
+  AcousticRayTracer tracer;
+
+  Room() {
+    std::vector<Vector3> vertices;
+    for (int i = 0; i < 8; ++i) {
+      vertices.push_back(
+          {i & 1 ? 20.0f : 0.0f, i & 2 ? 10.0f : 0.0f, i & 4 ? 15.0f : 0.0f});
+    }
+    const std::vector<uint32_t> indices = {
+        0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+        2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+    scene->AddMesh(vertices.data(), vertices.size(), indices.data(),
+                   indices.size(), 0);
+    scene->Commit();
+    tracer.SetGeometryPacketCallback(AcousticScene::MakeCallback(scene));
+    tracer.SetRayCount(256);
+  }
+};
+
+std::string TempPath(const char *name) {
+  return std::string(P_tmpdir) + "/" + name;
+}
+
+} // namespace
+
+TEST_CASE("AcousticProbeGrid bakes a grid and interpolates probes",
+          "[AcousticProbeGrid]") {
+  Room room;
+  size_t progressCalls = 0;
+  AcousticProbeGrid grid;
+  REQUIRE(grid
+              .LoadFromMemory(AcousticProbeGrid::BakeGrid(
+                  room.tracer, {2, 2, 2}, {18, 8, 13}, 4.0f,
+                  [&](size_t, size_t) { ++progressCalls; }))
+              .IsOk());
+  REQUIRE(grid.GetHeader().dimX == 5);
+  REQUIRE(grid.GetHeader().dimY == 2);
+  REQUIRE(grid.GetHeader().dimZ == 3);
+  REQUIRE(grid.GetProbeCount() == 30);
+  REQUIRE(progressCalls == 30);
+  REQUIRE_FALSE(grid.IsMapped());
+
+  // A probe stores what a trace at its position finds, quantized
+  const PropagationResult traced = room.tracer.Trace({6, 2, 6}, {6, 2, 6});
+  const AcousticProbeSample probe =
+      grid.Sample({6.4f, 2.3f, 5.8f}, ProbeInterpolation::Nearest);
+  REQUIRE(probe.valid);
+  REQUIRE(probe.earlyReflectionGain ==
+          Catch::Approx(traced.earlyReflectionGain).margin(1e-4));
+  REQUIRE(probe.earlyReflectionDelay ==
+          Catch::Approx(traced.earlyReflectionDelay).margin(1e-5));
+  REQUIRE(probe.lateReverbTime ==
+          Catch::Approx(traced.lateReverbTime).margin(1e-3));
+  REQUIRE(probe.reflectionGainMid > 0.0f);
+  REQUIRE(probe.earlyReflectionDelay > 0.0f);
+
+  // Trilinear lookups hit lattice points exactly and blend between them
+  const AcousticProbeSample a = grid.Sample({6, 2, 6});
+  const AcousticProbeSample b = grid.Sample({10, 2, 6});
+  const AcousticProbeSample mid = grid.Sample({8, 2, 6});
+  REQUIRE(a.earlyReflectionGain == Catch::Approx(probe.earlyReflectionGain));
+  REQUIRE(mid.valid);
+  REQUIRE(mid.earlyReflectionGain ==
+          Catch::Approx((a.earlyReflectionGain + b.earlyReflectionGain) / 2));
+  REQUIRE(mid.lateReverbTime ==
+          Catch::Approx((a.lateReverbTime + b.lateReverbTime) / 2));
+
+  // Half a spacing of slack around the lattice, nothing beyond
+  REQUIRE(grid.Sample({0.5f, 2, 2}).valid);
+  REQUIRE_FALSE(grid.Sample({-0.5f, 2, 2}).valid);
+  REQUIRE_FALSE(grid.Sample({10, 2, 40}, ProbeInterpolation::Nearest).valid);
+
+  // Lattices that are empty or too large are not baked
+  REQUIRE(AcousticProbeGrid::BakeGrid(room.tracer, {0, 0, 0}, {1, 1, 1}, 0.0f)
+              .empty());
+  REQUIRE(AcousticProbeGrid::BakeGrid(room.tracer, {0, 0, 0},
+                                      {1000, 1000, 1000}, 0.1f)
+              .empty());
+}
+
+TEST_CASE("AcousticProbeGrid maps files and bakes placed probes",
+          "[AcousticProbeGrid]") {
+  Room room;
+  const Vector3 placed[] = {{4, 2, 7}, {16, 5, 7}};
+  AcousticProbeGrid baked;
+  REQUIRE(baked
+              .LoadFromMemory(AcousticProbeGrid::BakeProbes(
+                  room.tracer, placed, 2, {0, 0, 0}, {20, 10, 15}, 2.0f))
+              .IsOk());
+  REQUIRE(baked.GetProbeCount() == 2);
+
+  const std::string path = TempPath("orpheus_test.probes");
+  REQUIRE(baked.Save(path).IsOk());
+
+  AcousticProbeGrid grid;
+  REQUIRE(grid.Load(path).IsOk());
+  REQUIRE(grid.IsMapped());
+  REQUIRE(grid.GetProbeCount() == 2);
+  REQUIRE(grid.GetProbePosition(1).x == 16.0f);
+
+  // Each point reads its nearest probe
+  const AcousticProbeSample first = grid.GetProbe(0);
+  const AcousticProbeSample second = grid.GetProbe(1);
+  REQUIRE(first.lateReverbTime > 0.0f);
+  AcousticProbeSample s = grid.Sample({3, 1, 6}, ProbeInterpolation::Nearest);
+  REQUIRE(s.earlyReflectionDelay == first.earlyReflectionDelay);
+  s = grid.Sample({17, 6, 9}, ProbeInterpolation::Nearest);
+  REQUIRE(s.earlyReflectionDelay == second.earlyReflectionDelay);
+  s = grid.Sample({3, 1, 6});
+  REQUIRE(s.valid);
+  REQUIRE(s.earlyReflectionGain == Catch::Approx(first.earlyReflectionGain));
+  grid.Unload();
+  REQUIRE_FALSE(grid.IsLoaded());
+  REQUIRE_FALSE(grid.Sample({3, 1, 6}).valid);
+
+  // Missing, foreign and truncated files are rejected
+  REQUIRE(grid.Load(TempPath("orpheus_missing.probes")).GetError().Code() ==
+          ErrorCode::FileNotFound);
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << std::string(128, 'x');
+  }
+  REQUIRE(grid.Load(path).GetError().Code() == ErrorCode::InvalidFormat);
+  REQUIRE_FALSE(grid.IsLoaded());
+  std::remove(path.c_str());
+
+  std::vector<uint8_t> truncated = AcousticProbeGrid::BakeProbes(
+      room.tracer, placed, 2, {0, 0, 0}, {20, 10, 15}, 2.0f);
+  truncated.resize(truncated.size() - 4);
+  REQUIRE(grid.LoadFromMemory(truncated).GetError().Code() ==
+          ErrorCode::InvalidFormat);
+}
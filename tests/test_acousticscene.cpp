@@ -0,0 +1,204 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/AcousticScene.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// Closed box with outward-facing (CCW) triangles
+struct Box {
+  std::vector<Vector3> vertices;
+  std::vector<uint32_t> indices;
+
+  Box(const Vector3 &min, const Vector3 &max) {
+    for (int i = 0; i < 8; ++i) {
+      vertices.push_back({i & 1 ? max.x : min.x, i & 2 ? max.y : min.y,
+                          i & 4 ? max.z : min.z});
+    }
+    indices = {0, 2, 1, 1, 2, 3, // -z
+               4, 5, 6, 5, 7, 6, // +z
+               0, 1, 4, 1, 5, 4, // -y
+               2, 6, 3, 3, 6, 7, // +y
+               0, 4, 2, 2, 4, 6, // -x
+               1, 3, 5, 3, 7, 5}; // +x
+  }
+};
+
+// Floor at y = 0 from (0, 0) to (size, size) split into n x n quads
+struct Floor {
+  std::vector<Vector3> vertices;
+  std::vector<uint32_t> indices;
+
+  Floor(float size, uint32_t n) {
+    for (uint32_t z = 0; z <= n; ++z) {
+      for (uint32_t x = 0; x <= n; ++x) {
+        vertices.push_back({size * x / n, 0.0f, size * z / n});
+      }
+    }
+    for (uint32_t z = 0; z < n; ++z) {
+      for (uint32_t x = 0; x < n; ++x) {
+        const uint32_t i = z * (n + 1) + x;
+        indices.insert(indices.end(),
+                       {i, i + n + 1, i + 1, i + 1, i + n + 1, i + n + 2});
+      }
+    }
+  }
+};
+
+// One ray in a packet
+AcousticHitPacket Cast(const AcousticScene &scene, const AcousticVector &o,
+                       const AcousticVector &d, float maxDistance = 100.0f) {
+  AcousticRayPacket rays;
+  rays.count = 1;
+  rays.originX[0] = o.x;
+  rays.originY[0] = o.y;
+  rays.originZ[0] = o.z;
+  rays.directionX[0] = d.x;
+  rays.directionY[0] = d.y;
+  rays.directionZ[0] = d.z;
+  rays.maxDistance[0] = maxDistance;
+  AcousticHitPacket hits;
+  scene.Intersect(rays, hits);
+  return hits;
+}
+
+} // namespace
+
+TEST_CASE("AcousticScene reports distance, facing normal and material",
+          "[AcousticScene]") {
+  AcousticScene scene;
+  const Box room({0, 0, 0}, {20, 10, 15});
+  const AcousticMeshID walls =
+      scene.AddMesh(room.vertices.data(), room.vertices.size(),
+                    room.indices.data(), room.indices.size(), 2);
+  REQUIRE(scene.AddMesh(room.vertices.data(), 4, room.indices.data(),
+                        room.indices.size(), 2) ==
+          AcousticScene::kInvalidMesh);
+  scene.Commit();
+  REQUIRE(scene.GetTriangleCount() == 12);
+
+  // From inside the room the back faces are hit; the normal faces the ray
+  AcousticHitPacket hits = Cast(scene, {5, 5, 5}, {1, 0, 0});
+  REQUIRE(hits.hitMask == 1u);
+  REQUIRE(hits.distance[0] == Catch::Approx(15.0f));
+  REQUIRE(hits.normalX[0] == Catch::Approx(-1.0f));
+  REQUIRE(hits.material[0] == 2);
+
+  hits = Cast(scene, {-5, 5, 5}, {1, 0, 0});
+  REQUIRE(hits.distance[0] == Catch::Approx(5.0f));
+  REQUIRE(hits.normalX[0] == Catch::Approx(-1.0f));
+  REQUIRE(Cast(scene, {5, 5, 5}, {1, 0, 0}, 10.0f).hitMask == 0);
+
+  // Moving the room refits; changing the material bumps the version
+  std::vector<Vector3> moved = room.vertices;
+  for (auto &v : moved) {
+    v.x += 2.0f;
+  }
+  REQUIRE(scene.UpdateMesh(walls, moved.data(), moved.size()));
+  scene.Commit();
+  REQUIRE(Cast(scene, {5, 5, 5}, {1, 0, 0}).distance[0] ==
+          Catch::Approx(17.0f));
+  const uint32_t version = scene.GetVersion();
+  scene.SetMeshMaterial(walls, 4);
+  REQUIRE(scene.GetVersion() != version);
+  REQUIRE(Cast(scene, {5, 5, 5}, {1, 0, 0}).material[0] == 4);
+
+  scene.RemoveMesh(walls);
+  scene.Commit();
+  REQUIRE(scene.GetMeshCount() == 0);
+  REQUIRE(Cast(scene, {5, 5, 5}, {1, 0, 0}).hitMask == 0);
+}
+
+TEST_CASE("AcousticScene simplifies meshes below the detail size",
+          "[AcousticScene]") {
+  AcousticScene scene;
+  const Floor floor(16.0f, 32);
+  scene.AddMesh(floor.vertices.data(), floor.vertices.size(),
+                floor.indices.data(), floor.indices.size(), 0, 4.1f);
+  // Clutter smaller than the detail size disappears
+  const Box crate({3.0f, 0.0f, 3.0f}, {3.4f, 0.4f, 3.4f});
+  scene.AddMesh(crate.vertices.data(), crate.vertices.size(),
+                crate.indices.data(), crate.indices.size(), 1, 1.0f);
+  scene.Commit();
+
+  REQUIRE(scene.GetTriangleCount() > 0);
+  REQUIRE(scene.GetTriangleCount() < floor.indices.size() / 3 / 8);
+  AcousticHitPacket hits = Cast(scene, {8, 5, 8}, {0, -1, 0});
+  REQUIRE(hits.hitMask == 1u);
+  REQUIRE(hits.material[0] == 0);
+  REQUIRE(hits.normalY[0] == Catch::Approx(1.0f));
+  REQUIRE(Cast(scene, {3.2f, 5, 3.2f}, {0, -1, 0}).material[0] == 0);
+}
+
+TEST_CASE("AcousticScene drives the ray tracer", "[AcousticScene]") {
+  auto scene = std::make_shared<AcousticScene>();
+  const Box room({0, 0, 0}, {20, 10, 15});
+  scene->AddMesh(room.vertices.data(), room.vertices.size(),
+                 room.indices.data(), room.indices.size(), 0);
+  scene->Commit();
+
+  AcousticRayTracer tracer;
+  tracer.SetGeometryPacketCallback(AcousticScene::MakeCallback(scene));
+  tracer.SetRayCount(256);
+  const PropagationResult serial = tracer.Trace({5, 2, 5}, {15, 2, 10});
+  REQUIRE(serial.hasDirectPath);
+  REQUIRE(serial.paths.size() > 1);
+  REQUIRE(serial.earlyReflectionGain > 0.0f);
+
+  tracer.SetThreadCount(2);
+  const PropagationResult parallel = tracer.Trace({5, 2, 5}, {15, 2, 10});
+  REQUIRE(parallel.paths.size() == serial.paths.size());
+  REQUIRE(parallel.earlyReflectionGain == serial.earlyReflectionGain);
+
+  // A wall between source and listener blocks the direct path
+  const Box wall({9, 0, 0}, {11, 10, 15});
+  scene->AddMesh(wall.vertices.data(), wall.vertices.size(),
+                 wall.indices.data(), wall.indices.size(), 0);
+  scene->Commit();
+  REQUIRE_FALSE(tracer.Trace({5, 2, 5}, {15, 2, 10}).hasDirectPath);
+}
+
+TEST_CASE("AcousticScene can be edited while another thread queries",
+          "[AcousticScene]") {
+  AcousticScene scene;
+  const Floor floor(16.0f, 4);
+  scene.AddMesh(floor.vertices.data(), floor.vertices.size(),
+                floor.indices.data(), floor.indices.size(), 0);
+  scene.Commit();
+
+  // The floor stays put, so every query must keep hitting it
+  std::atomic<bool> stop{false};
+  std::atomic<int> misses{0};
+  std::atomic<int> queries{0};
+  std::thread reader([&] {
+    while (!stop.load()) {
+      if (Cast(scene, {8, 5, 8}, {0, -1, 0}).hitMask != 1u) {
+        ++misses;
+      }
+      ++queries;
+    }
+  });
+
+  const Box crate({1.0f, 0.0f, 1.0f}, {2.0f, 1.0f, 2.0f});
+  for (int i = 0; i < 200 || queries.load() == 0; ++i) {
+    const AcousticMeshID id =
+        scene.AddMesh(crate.vertices.data(), crate.vertices.size(),
+                      crate.indices.data(), crate.indices.size(), 1);
+    scene.SetMeshMaterial(id, 2);
+    if (i % 2 == 0) {
+      scene.RemoveMesh(id);
+    }
+    scene.Commit();
+  }
+  stop = true;
+  reader.join();
+  REQUIRE(misses.load() == 0);
+  REQUIRE(scene.GetMeshCount() == 101);
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/AssetCache.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Orpheus;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Loader that counts calls and how many assets are alive
+struct FakeLoader {
+  std::shared_ptr<std::atomic<int>> loads = std::make_shared<std::atomic<int>>();
+  std::shared_ptr<std::atomic<int>> alive = std::make_shared<std::atomic<int>>();
+  std::chrono::milliseconds delay{0};
+
+  std::shared_ptr<void> operator()(const std::string &path, bool) const {
+    std::this_thread::sleep_for(delay);
+    ++*loads;
+    if (path == "missing.wav") {
+      return nullptr;
+    }
+    ++*alive;
+    auto counter = alive;
+    return std::shared_ptr<int>(new int(0), [counter](int *p) {
+      --*counter;
+      delete p;
+    });
+  }
+};
+
+} // namespace
+
+TEST_CASE("AssetCache loads in the background and evicts at zero refs",
+          "[AssetCache]") {
+  FakeLoader loader;
+  AssetCache cache(loader);
+
+  REQUIRE(cache.Find("rain.ogg") == nullptr);
+  cache.Prefetch("rain.ogg", true);
+  cache.Prefetch("rain.ogg", true);
+  REQUIRE(cache.WaitIdle(2000ms));
+  REQUIRE(*loader.loads == 1);
+  REQUIRE(cache.IsResident("rain.ogg"));
+  REQUIRE(cache.GetResidentCount() == 1);
+
+  // A caller holding the asset keeps it alive past eviction
+  auto held = cache.Find("rain.ogg");
+  cache.Release("rain.ogg");
+  REQUIRE(cache.IsResident("rain.ogg"));
+  cache.Release("rain.ogg");
+  REQUIRE_FALSE(cache.IsResident("rain.ogg"));
+  REQUIRE(*loader.alive == 1);
+  held.reset();
+  REQUIRE(*loader.alive == 0);
+}
+
+TEST_CASE("AssetCache handles failures and releases during a load",
+          "[AssetCache]") {
+  FakeLoader loader;
+  loader.delay = 20ms;
+  AssetCache cache(loader);
+
+  cache.Prefetch("missing.wav", false);
+  cache.Prefetch("wind.wav", false);
+  cache.Release("wind.wav");
+  REQUIRE(cache.WaitIdle(2000ms));
+  REQUIRE_FALSE(cache.IsResident("missing.wav"));
+  REQUIRE_FALSE(cache.IsResident("wind.wav"));
+  REQUIRE(cache.GetPendingCount() == 0);
+  REQUIRE(*loader.alive == 0);
+}
@@ -0,0 +1,107 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/BusMeter.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+constexpr float kSampleRate = 48000.0f;
+constexpr float kTwoPi = 6.28318530718f;
+
+// Feeds `seconds` of a sine in 512-sample mixer blocks
+void FeedSine(BusMeter &meter, float amplitude, float hz, float seconds,
+              size_t channels) {
+  const size_t block = 512;
+  const size_t total = static_cast<size_t>(seconds * kSampleRate);
+  std::vector<float> buffer(block * channels);
+  for (size_t pos = 0; pos < total; pos += block) {
+    for (size_t i = 0; i < block; ++i) {
+      const float s =
+          amplitude * std::sin(kTwoPi * hz * static_cast<float>(pos + i) /
+                               kSampleRate);
+      for (size_t c = 0; c < channels; ++c) {
+        buffer[c * block + i] = s;
+      }
+    }
+    meter.Process(buffer.data(), block, channels, block, kSampleRate);
+  }
+}
+
+} // namespace
+
+TEST_CASE("BusMeter reads silence before any block", "[BusMeter]") {
+  BusMeter meter;
+  BusMeterReading reading = meter.Read();
+  REQUIRE(reading.blocks == 0);
+  REQUIRE(reading.momentaryLUFS == -70.0f);
+  REQUIRE(reading.peakDb == kMinDb);
+}
+
+TEST_CASE("BusMeter matches BS.1770 calibration tone", "[BusMeter]") {
+  // A full-scale 997 Hz sine on one channel reads -3.01 LUFS
+  BusMeter meter;
+  meter.SetEnabled(true);
+  FeedSine(meter, 1.0f, 997.0f, 3.5f, 1);
+
+  BusMeterReading reading = meter.Read();
+  REQUIRE(reading.blocks >= 30);
+  REQUIRE(reading.peakDb == Catch::Approx(0.0f).margin(0.05));
+  REQUIRE(reading.rmsDb == Catch::Approx(-3.01f).margin(0.05));
+  REQUIRE(reading.momentaryLUFS == Catch::Approx(-3.01f).margin(0.1));
+  REQUIRE(reading.shortTermLUFS == Catch::Approx(-3.01f).margin(0.1));
+}
+
+TEST_CASE("BusMeter sums channel loudness", "[BusMeter]") {
+  // The same tone on both channels is 3 dB louder
+  BusMeter meter;
+  meter.SetEnabled(true);
+  FeedSine(meter, 0.5f, 997.0f, 1.0f, 2);
+
+  BusMeterReading reading = meter.Read();
+  REQUIRE(reading.momentaryLUFS == Catch::Approx(-6.02f).margin(0.1));
+  REQUIRE(reading.rmsDb == Catch::Approx(-9.03f).margin(0.05));
+}
+
+TEST_CASE("BusMeter reset restarts the measurement", "[BusMeter]") {
+  BusMeter meter;
+  meter.SetEnabled(true);
+  FeedSine(meter, 1.0f, 997.0f, 1.0f, 1);
+  REQUIRE(meter.Read().blocks > 0);
+
+  meter.Reset();
+  FeedSine(meter, 0.0f, 997.0f, 0.05f, 1);
+  REQUIRE(meter.Read().blocks == 0);
+}
+
+TEST_CASE("BusMeter readings are never torn", "[BusMeter]") {
+  BusMeter meter;
+  meter.SetEnabled(true);
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+
+  // Every published reading is either the reset state or the tone
+  std::thread reader([&] {
+    while (!done.load()) {
+      BusMeterReading r = meter.Read();
+      const bool consistent =
+          r.blocks == 0 ? r.peakDb == kMinDb : r.peakDb > -1.0f;
+      if (!consistent) {
+        ++torn;
+      }
+    }
+  });
+  for (int i = 0; i < 20; ++i) {
+    FeedSine(meter, 1.0f, 997.0f, 0.2f, 2);
+    meter.Reset();
+  }
+  done = true;
+  reader.join();
+  REQUIRE(torn.load() == 0);
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/Compressor.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Orpheus;
+
+// ============================================================================
+// Fast Math Tests
+// ============================================================================
+
+TEST_CASE("FastLog2 tracks std::log2", "[DSPMath]") {
+  for (float x : {1e-4f, 0.01f, 0.3f, 1.0f, 1.5f, 7.0f, 1000.0f}) {
+    REQUIRE(FastLog2(x) == Catch::Approx(std::log2(x)).margin(0.01));
+  }
+}
+
+TEST_CASE("FastExp2 tracks std::exp2", "[DSPMath]") {
+  for (float x : {-20.0f, -3.3f, -0.5f, 0.0f, 0.25f, 4.7f}) {
+    REQUIRE(FastExp2(x) == Catch::Approx(std::exp2(x)).epsilon(0.001));
+  }
+}
+
+TEST_CASE("Fast dB conversions round-trip", "[DSPMath]") {
+  REQUIRE(FastLinearToDb(1.0f) == Catch::Approx(0.0f).margin(0.05));
+  REQUIRE(FastLinearToDb(0.5f) == Catch::Approx(-6.02f).margin(0.05));
+  REQUIRE(FastDbToLinear(-6.0206f) == Catch::Approx(0.5f).epsilon(0.001));
+  REQUIRE(FastLinearToDb(0.0f) == kMinDb);
+}
+
+TEST_CASE("ApplyGainRamp scales each sample", "[DSPMath]") {
+  std::vector<float> data(11, 1.0f);
+  ApplyGainRamp(data.data(), data.size(), 1.0f, -0.1f);
+  for (size_t i = 0; i < data.size(); ++i) {
+    REQUIRE(data[i] == Catch::Approx(1.0f - 0.1f * i).margin(1e-5));
+  }
+}
+
+TEST_CASE("PeakAbs finds negative peaks", "[DSPMath]") {
+  std::vector<float> data{0.1f, -0.2f, 0.3f, -0.9f, 0.4f, 0.5f, -0.6f};
+  REQUIRE(PeakAbs(data.data(), data.size()) == Catch::Approx(0.9f));
+}
+
+// ============================================================================
+// Compressor Tests
+// ============================================================================
+
+TEST_CASE("Compressor disabled leaves audio untouched", "[Compressor]") {
+  Compressor comp(48000.0f);
+  std::vector<float> data(256, 0.9f);
+  comp.Process(data.data(), data.size());
+  REQUIRE(data[100] == 0.9f);
+}
+
+TEST_CASE("Compressor reduces loud stereo signal", "[Compressor]") {
+  Compressor comp(48000.0f);
+  CompressorSettings settings;
+  settings.threshold = -20.0f;
+  settings.ratio = 4.0f;
+  settings.attackMs = 1.0f;
+  settings.releaseMs = 50.0f;
+  comp.SetSettings(settings);
+  comp.SetEnabled(true);
+
+  // Left is loud, right is quiet: linked detection ducks both
+  const size_t n = 4800;
+  std::vector<float> planar(n * 2);
+  for (size_t i = 0; i < n; ++i) {
+    planar[i] = (i % 2 ? 1.0f : -1.0f);
+    planar[n + i] = 0.01f;
+  }
+  comp.ProcessBlock(planar.data(), n, 2, n);
+
+  // 20 dB over threshold at 4:1 settles near 15 dB of reduction
+  REQUIRE(comp.GetGainReduction() == Catch::Approx(15.0f).margin(0.5));
+  REQUIRE(std::fabs(planar[n - 1]) < 0.2f);
+  REQUIRE(planar[2 * n - 1] < 0.01f * 0.2f);
+}
+
+TEST_CASE("Lookahead limiter never exceeds ceiling", "[Compressor]") {
+  Compressor comp(48000.0f);
+  CompressorSettings settings;
+  settings.threshold = -6.0f;
+  settings.limiterMode = true;
+  settings.releaseMs = 20.0f;
+  settings.lookaheadMs = 2.0f;
+  comp.SetSettings(settings);
+  comp.SetEnabled(true);
+  REQUIRE(comp.GetLatency() > 0);
+
+  const float ceiling = FastDbToLinear(-6.0f) * 1.0001f;
+  std::vector<float> input(9000);
+  for (size_t i = 0; i < input.size(); ++i) {
+    // Quiet bed with sudden full-scale transients
+    input[i] = (i % 1500 == 700) ? 1.0f : 0.05f * std::sin(0.01f * i);
+  }
+
+  // Odd host block sizes must not break alignment
+  std::vector<float> output;
+  size_t pos = 0;
+  const size_t blocks[] = {100, 37, 512, 1, 250};
+  size_t b = 0;
+  while (pos < input.size()) {
+    size_t count = (std::min)(blocks[b++ % 5], input.size() - pos);
+    std::vector<float> block(input.begin() + pos, input.begin() + pos + count);
+    comp.ProcessBlock(block.data(), count, 1, count);
+    output.insert(output.end(), block.begin(), block.end());
+    pos += count;
+  }
+
+  float peak = 0.0f;
+  for (float s : output) {
+    peak = (std::max)(peak, std::fabs(s));
+  }
+  REQUIRE(peak <= ceiling);
+
+  // Transients are delayed by the latency, not dropped
+  const size_t latency = comp.GetLatency();
+  REQUIRE(std::fabs(output[700 + latency]) == Catch::Approx(ceiling).epsilon(0.01));
+}
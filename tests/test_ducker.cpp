@@ -0,0 +1,141 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/Ducker.h"
+
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kBlock = 480; // 10 ms
+
+// Music = 0, Dialogue = 1, Ambience = 2
+uint32_t ResolveTestBus(const std::string &name) {
+  if (name == "Music")
+    return 0;
+  if (name == "Dialogue")
+    return 1;
+  if (name == "Ambience")
+    return 2;
+  return Ducker::kInvalidBus;
+}
+
+// Runs one 10 ms mixer block on each bus; returns the last Music sample
+float MixBlock(Ducker &ducker, std::vector<DuckerBusState> &states,
+               float dialogueLevel, float ambienceLevel) {
+  std::vector<float> music(kBlock * 2, 1.0f);
+  std::vector<float> dialogue(kBlock * 2, dialogueLevel);
+  std::vector<float> ambience(kBlock * 2, ambienceLevel);
+  ducker.ProcessBlock(1, states[1], dialogue.data(), kBlock, 2, kBlock,
+                      kSampleRate);
+  ducker.ProcessBlock(2, states[2], ambience.data(), kBlock, 2, kBlock,
+                      kSampleRate);
+  ducker.ProcessBlock(0, states[0], music.data(), kBlock, 2, kBlock,
+                      kSampleRate);
+  return music[kBlock * 2 - 1];
+}
+
+} // namespace
+
+TEST_CASE("Ducker ducks target while sidechain is audible", "[Ducker]") {
+  Ducker ducker;
+  DuckingRule rule;
+  rule.targetBus = "Music";
+  rule.sidechainBus = "Dialogue";
+  rule.duckLevel = 0.25f;
+  rule.attackTime = 0.05f;
+  rule.releaseTime = 0.1f;
+  rule.holdTime = 0.05f;
+  ducker.AddRule(rule);
+  ducker.Update(ResolveTestBus);
+
+  std::vector<DuckerBusState> states(3);
+  ducker.GetActivity(1).voiceCount = 1;
+  float last = 1.0f;
+  for (int i = 0; i < 10; ++i) {
+    last = MixBlock(ducker, states, 0.5f, 0.0f);
+  }
+  REQUIRE(ducker.IsDucking("Music"));
+  REQUIRE(ducker.GetDuckLevel("Music") == Catch::Approx(0.25f));
+  REQUIRE(last == Catch::Approx(0.25f));
+
+  // Sidechain stops: hold, then release back to unity
+  ducker.GetActivity(1).voiceCount = 0;
+  MixBlock(ducker, states, 0.0f, 0.0f);
+  REQUIRE(ducker.GetDuckLevel("Music") == Catch::Approx(0.25f));
+  for (int i = 0; i < 30; ++i) {
+    last = MixBlock(ducker, states, 0.0f, 0.0f);
+  }
+  REQUIRE_FALSE(ducker.IsDucking("Music"));
+  REQUIRE(last == Catch::Approx(1.0f));
+}
+
+TEST_CASE("Ducker ignores unrelated and silent buses", "[Ducker]") {
+  Ducker ducker;
+  DuckingRule rule;
+  rule.targetBus = "Music";
+  rule.sidechainBus = "Dialogue";
+  ducker.AddRule(rule);
+  ducker.Update(ResolveTestBus);
+
+  std::vector<DuckerBusState> states(3);
+
+  // Loud ambience does not trigger a Dialogue rule
+  ducker.GetActivity(2).voiceCount = 3;
+  REQUIRE(MixBlock(ducker, states, 0.0f, 1.0f) == 1.0f);
+
+  // Dialogue voices below the threshold do not duck either
+  ducker.GetActivity(1).voiceCount = 1;
+  REQUIRE(MixBlock(ducker, states, 0.0001f, 1.0f) == 1.0f);
+  REQUIRE_FALSE(ducker.IsDucking("Music"));
+}
+
+TEST_CASE("Ducker rules bind once their buses exist", "[Ducker]") {
+  Ducker ducker;
+  DuckingRule rule;
+  rule.targetBus = "Music";
+  rule.sidechainBus = "Voice";
+  ducker.AddRule(rule);
+  ducker.Update(ResolveTestBus);
+  REQUIRE_FALSE(ducker.IsDucking("Music"));
+  REQUIRE(ducker.GetDuckLevel("Music") == 1.0f);
+
+  // "Voice" now resolves to the Dialogue slot
+  ducker.Invalidate();
+  ducker.Update([](const std::string &name) {
+    return name == "Voice" ? 1u : ResolveTestBus(name);
+  });
+
+  std::vector<DuckerBusState> states(3);
+  ducker.GetActivity(1).voiceCount = 1;
+  for (int i = 0; i < 20; ++i) {
+    MixBlock(ducker, states, 0.5f, 0.0f);
+  }
+  REQUIRE(ducker.IsDucking("Music"));
+  REQUIRE(ducker.GetDuckLevel("Music") == Catch::Approx(0.3f));
+}
+
+TEST_CASE("Ducker frees replaced tables only when no block reads them",
+          "[Ducker]") {
+  Ducker ducker;
+  DuckingRule rule;
+  rule.targetBus = "Music";
+  rule.sidechainBus = "Dialogue";
+  ducker.AddRule(rule);
+  ducker.Update(ResolveTestBus);
+
+  {
+    // A mixer block holding the table across many game frames
+    const Ducker::ReadScope block(ducker);
+    ducker.ClearRules();
+    for (int i = 0; i < 100; ++i) {
+      ducker.Update(ResolveTestBus);
+    }
+    REQUIRE(ducker.GetRetiredTableCount() == 1);
+  }
+  ducker.Update(ResolveTestBus);
+  REQUIRE(ducker.GetRetiredTableCount() == 0);
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/ImpulseResponseSynthesizer.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+PropagationPath Path(float delay, float gain, int reflections) {
+  PropagationPath path;
+  path.delay = delay;
+  path.distance = delay * 343.0f;
+  path.gainLow = path.gainMid = path.gainHigh = gain;
+  path.reflections = reflections;
+  return path;
+}
+
+// Direct path, two early reflections and a sparse late tail
+PropagationResult MakeResult() {
+  PropagationResult result;
+  PropagationPath direct = Path(0.01f, 1.0f, 0);
+  direct.isDirect = true;
+  result.paths.push_back(direct);
+  result.paths.push_back(Path(0.021f, 0.25f, 1));
+  result.paths.push_back(Path(0.03f, 0.16f, 1));
+  for (int i = 0; i < 40; ++i) {
+    result.paths.push_back(Path(0.1f + 0.005f * i, 0.05f, 3));
+  }
+  result.lateReverbTime = 0.5f;
+  return result;
+}
+
+float Energy(const std::vector<float> &x, size_t first, size_t last) {
+  float sum = 0.0f;
+  for (size_t i = first; i < last && i < x.size(); ++i) {
+    sum += x[i] * x[i];
+  }
+  return sum;
+}
+
+// Energy of the first difference, which weights high frequencies
+float DifferenceEnergy(const std::vector<float> &x) {
+  float sum = 0.0f;
+  for (size_t i = 1; i < x.size(); ++i) {
+    sum += (x[i] - x[i - 1]) * (x[i] - x[i - 1]);
+  }
+  return sum;
+}
+
+} // namespace
+
+TEST_CASE("ImpulseResponseSynthesizer bins and shapes traced energy",
+          "[ImpulseResponse]") {
+  ImpulseResponseSynthesizer synthesizer;
+  const PropagationResult result = MakeResult();
+
+  // The histogram holds reflected energy only, by arrival time
+  const EnergyHistogram histogram = synthesizer.BuildHistogram(result);
+  REQUIRE(histogram.binWidth == Catch::Approx(0.002f));
+  REQUIRE(histogram.GetBinCount() == 148);
+  REQUIRE(histogram.mid[5] == 0.0f); // Direct path at 10 ms
+  REQUIRE(histogram.mid[10] == Catch::Approx(0.25f));
+  REQUIRE(synthesizer.BuildHistogram(result, 0.08f).mid[10] == 0.0f);
+
+  std::vector<float> ir;
+  synthesizer.Synthesize(result, ir);
+
+  // Traced span plus one reverb time
+  const float length = static_cast<float>(ir.size()) / 44100.0f;
+  REQUIRE(length == Catch::Approx(0.296f + 0.5f).margin(0.01f));
+  REQUIRE(Energy(ir, 0, ir.size()) == Catch::Approx(1.0f).margin(1e-3));
+
+  // Nothing before the first reflection, the taps after it, and a tail
+  // that decays
+  REQUIRE(Energy(ir, 0, 800) < 1e-6f);
+  REQUIRE(Energy(ir, 870, 1000) > 0.01f);
+  const size_t tail = static_cast<size_t>(0.3f * 44100.0f);
+  const size_t step = static_cast<size_t>(0.1f * 44100.0f);
+  REQUIRE(Energy(ir, tail, tail + step) >
+          Energy(ir, tail + 3 * step, tail + 4 * step) * 10.0f);
+
+  // Deterministic for a seed
+  std::vector<float> again;
+  synthesizer.Synthesize(result, again);
+  REQUIRE(again == ir);
+
+  // Absorbed highs leave a duller IR
+  PropagationResult dull = result;
+  for (PropagationPath &path : dull.paths) {
+    path.gainHigh *= 0.01f;
+  }
+  std::vector<float> dullIr;
+  synthesizer.Synthesize(dull, dullIr);
+  REQUIRE(DifferenceEnergy(dullIr) < DifferenceEnergy(ir) * 0.5f);
+
+  // A path past the maximum length is dropped, not the whole IR
+  PropagationResult overlong = result;
+  overlong.paths.push_back(Path(5.0f, 0.05f, 12));
+  std::vector<float> clipped;
+  synthesizer.Synthesize(overlong, clipped);
+  REQUIRE_FALSE(clipped.empty());
+  REQUIRE(clipped.size() <= static_cast<size_t>(3.0f * 44100.0f) + 1);
+  REQUIRE(Energy(clipped, 870, 1000) > 0.01f);
+  REQUIRE(Energy(clipped, 0, clipped.size()) ==
+          Catch::Approx(1.0f).margin(1e-3));
+
+  // No reflections, no IR
+  PropagationResult direct;
+  direct.paths.push_back(result.paths[0]);
+  synthesizer.Synthesize(direct, ir);
+  REQUIRE(ir.empty());
+}
+
+TEST_CASE("ConvolutionReverb crossfades to a new impulse response",
+          "[ImpulseResponse]") {
+  ConvolutionReverb reverb;
+  reverb.SetWet(1.0f);
+  reverb.SetEnabled(true);
+  REQUIRE_FALSE(reverb.IsLoaded());
+
+  const float positive[] = {1.0f};
+  const float negative[] = {-1.0f};
+  reverb.SetImpulseResponse(positive, 1, 0.0f);
+  REQUIRE(reverb.IsLoaded());
+
+  // A unit impulse IR passes the input through with one block of latency
+  std::vector<float> block(ConvolutionReverb::BLOCK_SIZE, 1.0f);
+  reverb.Process(block.data(), block.size());
+  REQUIRE(reverb.GetSwapCount() == 1);
+  block.assign(block.size(), 1.0f);
+  reverb.Process(block.data(), block.size());
+  REQUIRE(block.back() == Catch::Approx(1.0f).margin(1e-4));
+
+  // The inverted IR fades in over 4 blocks at the next block boundary
+  const float fade = 4.0f * ConvolutionReverb::BLOCK_SIZE / 44100.0f;
+  reverb.SetImpulseResponse(negative, 1, fade);
+  std::vector<float> output;
+  for (int i = 0; i < 6; ++i) {
+    block.assign(block.size(), 1.0f);
+    reverb.Process(block.data(), block.size());
+    output.insert(output.end(), block.begin(), block.end());
+    if (i == 1) {
+      REQUIRE(reverb.IsCrossfading());
+    }
+  }
+  REQUIRE(reverb.GetSwapCount() == 2);
+  REQUIRE_FALSE(reverb.IsCrossfading());
+  REQUIRE(output.front() == Catch::Approx(1.0f).margin(1e-4));
+  REQUIRE(output.back() == Catch::Approx(-1.0f).margin(1e-4));
+  for (size_t i = 1; i < output.size(); ++i) {
+    REQUIRE(output[i] <= output[i - 1] + 1e-4f);
+    REQUIRE(output[i - 1] - output[i] < 0.01f); // No jumps
+  }
+}
+
+TEST_CASE("ImpulseResponseUpdater synthesizes in the background",
+          "[ImpulseResponse]") {
+  ConvolutionReverb reverb;
+  reverb.SetEnabled(true);
+  {
+    ImpulseResponseUpdater updater(reverb);
+    updater.SetMinInterval(std::chrono::milliseconds(10000));
+
+    // The second submission comes too soon
+    REQUIRE(updater.Submit(MakeResult()));
+    REQUIRE_FALSE(updater.Submit(MakeResult()));
+    REQUIRE(updater.WaitIdle(std::chrono::milliseconds(5000)));
+    REQUIRE(updater.GetUpdateCount() == 1);
+    REQUIRE(reverb.IsLoaded());
+
+    updater.SetMinInterval(std::chrono::milliseconds(0));
+    REQUIRE(updater.Submit(MakeResult()));
+    REQUIRE(updater.WaitIdle(std::chrono::milliseconds(5000)));
+    REQUIRE(updater.GetUpdateCount() == 2);
+  }
+
+  // The newest IR is swapped in on the audio thread
+  std::vector<float> block(ConvolutionReverb::BLOCK_SIZE, 0.5f);
+  reverb.Process(block.data(), block.size());
+  REQUIRE(reverb.GetSwapCount() == 1);
+}
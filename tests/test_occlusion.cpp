@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/OcclusionProcessor.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+struct Scene {
+  std::vector<std::unique_ptr<Voice>> storage;
+  std::vector<Voice *> voices;
+  int queries = 0;
+
+  explicit Scene(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      storage.push_back(std::make_unique<Voice>());
+      storage.back()->position = {static_cast<float>(i), 0.0f, 0.0f};
+      voices.push_back(storage.back().get());
+    }
+  }
+
+  void Attach(OcclusionProcessor &processor) {
+    processor.SetQueryCallback([this](const Vector3 &, const Vector3 &) {
+      ++queries;
+      return std::vector<OcclusionHit>{{"Concrete", 1.0f}};
+    });
+  }
+};
+
+} // namespace
+
+TEST_CASE("OcclusionProcessor staggers queries within the frame budget",
+          "[Occlusion]") {
+  OcclusionProcessor processor;
+  Scene scene(200);
+  scene.Attach(processor);
+  processor.SetUpdateRate(10.0f);
+  processor.SetMaxQueriesPerFrame(32);
+
+  const float dt = 1.0f / 60.0f;
+  std::vector<float> lastQueried(200, -1.0f);
+  float maxGap = 0.0f;
+  for (int frame = 0; frame < 120; ++frame) {
+    const int before = scene.queries;
+    processor.Update(scene.voices.data(), scene.voices.size(), {0, 0, 0}, dt);
+    REQUIRE(scene.queries - before <= 32);
+    REQUIRE(processor.GetLastQueryCount() ==
+            static_cast<uint32_t>(scene.queries - before));
+
+    for (size_t i = 0; i < scene.voices.size(); ++i) {
+      if (scene.voices[i]->occlusionAge == 0.0f) {
+        if (lastQueried[i] >= 0.0f) {
+          maxGap = std::max(maxGap, frame * dt - lastQueried[i]);
+        }
+        lastQueried[i] = frame * dt;
+      }
+    }
+  }
+
+  // Every voice was queried and none waited far beyond its interval
+  REQUIRE(std::none_of(lastQueried.begin(), lastQueried.end(),
+                       [](float t) { return t < 0.0f; }));
+  REQUIRE(maxGap < 0.2f);
+  REQUIRE(scene.voices[0]->occlusion > 0.0f);
+}
+
+TEST_CASE("OcclusionProcessor refreshes audible voices more often",
+          "[Occlusion]") {
+  OcclusionProcessor processor;
+  Scene scene(2);
+  scene.Attach(processor);
+  scene.voices[0]->audibility = 1.0f;
+  scene.voices[1]->audibility = 0.0f;
+  REQUIRE(processor.GetRefreshInterval(*scene.voices[1]) ==
+          OcclusionProcessor::kQuietIntervalScale *
+              processor.GetRefreshInterval(*scene.voices[0]));
+
+  std::vector<int> counts(2, 0);
+  for (int frame = 0; frame < 240; ++frame) {
+    processor.Update(scene.voices.data(), scene.voices.size(), {0, 0, 0},
+                     1.0f / 60.0f);
+    for (size_t i = 0; i < 2; ++i) {
+      counts[i] += scene.voices[i]->occlusionAge == 0.0f;
+    }
+  }
+  REQUIRE(counts[0] >= 3 * counts[1]);
+
+  // Disabled processing clears occlusion without querying
+  processor.SetEnabled(false);
+  const int before = scene.queries;
+  processor.Update(*scene.voices[0], {0, 0, 0}, 1.0f / 60.0f);
+  REQUIRE(scene.queries == before);
+  REQUIRE(scene.voices[0]->occlusion == 0.0f);
+}
+
+TEST_CASE("OcclusionProcessor applies batched results on a later frame",
+          "[Occlusion]") {
+  OcclusionProcessor processor;
+  Scene scene(3);
+  for (size_t i = 0; i < scene.voices.size(); ++i) {
+    scene.voices[i]->id = static_cast<VoiceID>(i + 1);
+  }
+  const OcclusionMaterialID stone = processor.GetMaterialID("Stone");
+  REQUIRE(stone != OcclusionProcessor::kInvalidMaterial);
+  REQUIRE(processor.RegisterMaterial({"Stone", 0.9f, 0.4f}) == stone);
+  REQUIRE(processor.GetMaterialID("Unknown") ==
+          OcclusionProcessor::kInvalidMaterial);
+
+  std::vector<std::pair<OcclusionBatchID, size_t>> submitted;
+  processor.SetBatchCallback(
+      [&](OcclusionBatchID batch, const OcclusionRay *, size_t count) {
+        submitted.emplace_back(batch, count);
+      });
+
+  const float dt = 1.0f / 60.0f;
+  processor.Update(scene.voices.data(), scene.voices.size(), {0, 0, 0}, dt);
+  REQUIRE(submitted.size() == 1);
+  REQUIRE(submitted[0].second == 3);
+  REQUIRE(processor.GetPendingBatchCount() == 1);
+
+  // Nothing due until the results arrive; voices stay unoccluded meanwhile
+  processor.Update(scene.voices.data(), scene.voices.size(), {0, 0, 0}, dt);
+  REQUIRE(submitted.size() == 1);
+  REQUIRE(scene.voices[1]->occlusion == 0.0f);
+
+  // Ray 1 is blocked; voice 3 stopped before the batch completed
+  const OcclusionRayHit hits[] = {{1, stone, 2.0f}, {1, stone, 2.0f}};
+  processor.CompleteBatch(submitted[0].first, hits, 2);
+  processor.Update(scene.voices.data(), 2, {0, 0, 0}, dt);
+  REQUIRE(processor.GetPendingBatchCount() == 0);
+  REQUIRE(scene.voices[0]->obstruction == 0.0f);
+  REQUIRE(scene.voices[1]->obstruction == 1.0f);
+  REQUIRE(scene.voices[1]->occlusion > 0.0f);
+
+  // Late or repeated completions are ignored
+  processor.CompleteBatch(submitted[0].first, hits, 2);
+  processor.Update(scene.voices.data(), 2, {0, 0, 0}, dt);
+  REQUIRE(scene.voices[1]->obstruction == 1.0f);
+}
+
+TEST_CASE("OcclusionProcessor answers repeated segments from the cache",
+          "[Occlusion]") {
+  OcclusionProcessor processor;
+  Scene scene(10); // Emitters on one prop, within one cache cell
+  for (size_t i = 0; i < scene.voices.size(); ++i) {
+    scene.voices[i]->id = static_cast<VoiceID>(i + 1);
+    scene.voices[i]->position = {10.1f + 0.01f * static_cast<float>(i), 0.1f,
+                                 0.1f};
+  }
+  scene.Attach(processor);
+  processor.GetCache().SetLifetime(0.0f);
+
+  const float dt = 1.0f / 60.0f;
+  auto frame = [&](const Vector3 &listener) {
+    processor.Update(scene.voices.data(), scene.voices.size(), listener, dt);
+  };
+  frame({0, 0, 0});
+  REQUIRE(scene.queries == 1);
+  REQUIRE(processor.GetLastCacheHitCount() == 9);
+  REQUIRE(scene.voices[9]->occlusion == scene.voices[0]->occlusion);
+
+  // Static emitters and a still listener never query again
+  for (int i = 0; i < 600; ++i) {
+    frame({0, 0, 0});
+  }
+  REQUIRE(scene.queries == 1);
+
+  // Geometry changes and listener moves invalidate
+  processor.GetCache().SetGeometryVersion(1);
+  for (int i = 0; i < 60; ++i) {
+    frame({0, 0, 0});
+  }
+  REQUIRE(scene.queries == 2);
+  for (int i = 0; i < 60; ++i) {
+    frame({3, 0, 0});
+  }
+  REQUIRE(scene.queries == 3);
+
+  // Batches send one ray per cell pair
+  std::vector<size_t> rayCounts;
+  processor.SetBatchCallback(
+      [&](OcclusionBatchID, const OcclusionRay *, size_t count) {
+        rayCounts.push_back(count);
+      });
+  processor.GetCache().Clear();
+  for (int i = 0; i < 6 && rayCounts.empty(); ++i) {
+    frame({3, 0, 0});
+  }
+  REQUIRE(rayCounts == std::vector<size_t>{1});
+  REQUIRE(processor.GetLastQueryCount() == 1);
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/OcclusionScene.h"
+
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// Closed box with outward-facing (CCW) triangles
+struct Box {
+  std::vector<Vector3> vertices;
+  std::vector<uint32_t> indices;
+
+  Box(const Vector3 &min, const Vector3 &max) {
+    for (int i = 0; i < 8; ++i) {
+      vertices.push_back({i & 1 ? max.x : min.x, i & 2 ? max.y : min.y,
+                          i & 4 ? max.z : min.z});
+    }
+    indices = {0, 2, 1, 1, 2, 3, // -z
+               4, 5, 6, 5, 7, 6, // +z
+               0, 1, 4, 1, 5, 4, // -y
+               2, 6, 3, 3, 6, 7, // +y
+               0, 4, 2, 2, 4, 6, // -x
+               1, 3, 5, 3, 7, 5}; // +x
+  }
+};
+
+} // namespace
+
+TEST_CASE("OcclusionScene measures solid thickness and shell crossings",
+          "[OcclusionScene]") {
+  OcclusionScene scene;
+  const Box wall({-1, -5, -5}, {1, 5, 5});
+  const OcclusionMeshID wallMesh =
+      scene.AddMesh(wall.vertices.data(), wall.vertices.size(),
+                    wall.indices.data(), wall.indices.size(), 7);
+  const std::vector<Vector3> door{{5, -1, -1}, {5, 1, -1}, {5, 1, 1},
+                                  {5, -1, 1}};
+  const std::vector<uint32_t> quad{0, 1, 2, 0, 2, 3};
+  const OcclusionMeshID doorMesh =
+      scene.AddMesh(door.data(), door.size(), quad.data(), quad.size(), 3,
+                    0.1f);
+  REQUIRE(scene.AddMesh(door.data(), 2, quad.data(), quad.size(), 3) ==
+          OcclusionScene::kInvalidMesh);
+  scene.Commit();
+  REQUIRE(scene.GetTriangleCount() == 14);
+  const uint32_t version = scene.GetVersion();
+
+  std::vector<OcclusionRayHit> hits;
+  REQUIRE(scene.Raycast({-10, 0, 0}, {10, 0, 0}, hits, 4) == 2);
+  REQUIRE(hits[0].ray == 4);
+  REQUIRE(hits[0].material == 7);
+  REQUIRE(hits[0].thickness == Catch::Approx(2.0f));
+  REQUIRE(hits[1].material == 3);
+  REQUIRE(hits[1].thickness == Catch::Approx(0.1f));
+
+  // Source inside the wall: thickness up to the exit
+  hits.clear();
+  REQUIRE(scene.Raycast({0.5f, 0, 0}, {-10, 0, 0}, hits) == 1);
+  REQUIRE(hits[0].thickness == Catch::Approx(1.5f));
+
+  // Swing the door out of the way: refit only
+  std::vector<Vector3> open = door;
+  for (auto &v : open) {
+    v.z += 10.0f;
+  }
+  REQUIRE(scene.UpdateMesh(doorMesh, open.data(), open.size()));
+  scene.Commit();
+  REQUIRE(scene.GetVersion() != version);
+  hits.clear();
+  REQUIRE(scene.Raycast({-10, 0, 0}, {10, 0, 0}, hits) == 1);
+
+  scene.RemoveMesh(wallMesh);
+  scene.Commit();
+  REQUIRE(scene.GetMeshCount() == 1);
+  const OcclusionRay rays[] = {{{-10, 0, 0}, {10, 0, 0}},
+                               {{0, 0, 10}, {10, 0, 10}}};
+  hits.clear();
+  scene.Raycast(rays, 2, hits);
+  REQUIRE(hits.size() == 1);
+  REQUIRE(hits[0].ray == 1);
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/OcclusionProcessor.h"
+#include "include/PortalGraph.h"
+
+#include <cmath>
+
+using namespace Orpheus;
+
+namespace {
+
+// Three 10 m rooms in a row along x (hall, corridor, kitchen) and a
+// closet north of the hall
+struct House {
+  PortalGraph graph;
+  RoomID hall, corridor, kitchen, closet;
+  PortalID hallDoor, kitchenDoor, closetDoor;
+
+  House() {
+    hall = graph.CreateRoom(ZoneGeometry::Box({0, 0, 0}, {10, 3, 10}, 0));
+    corridor =
+        graph.CreateRoom(ZoneGeometry::Box({10, 0, 0}, {20, 3, 10}, 0));
+    kitchen =
+        graph.CreateRoom(ZoneGeometry::Box({20, 0, 0}, {30, 3, 10}, 0));
+    closet = graph.CreateRoom(ZoneGeometry::Box({0, 0, 10}, {10, 3, 20}, 0));
+    hallDoor = graph.AddPortal(hall, corridor, {10, 1.5f, 5});
+    kitchenDoor = graph.AddPortal(corridor, kitchen, {20, 1.5f, 5});
+    closetDoor = graph.AddPortal(hall, closet, {5, 1.5f, 10});
+  }
+};
+
+float Distance(const Vector3 &a, const Vector3 &b) {
+  return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) +
+                   (a.z - b.z) * (a.z - b.z));
+}
+
+} // namespace
+
+TEST_CASE("PortalGraph routes sources through portals", "[PortalGraph]") {
+  House house;
+  PortalGraph &graph = house.graph;
+  REQUIRE(graph.AddPortal(house.hall, house.hall, {0, 0, 0}) ==
+          PortalGraph::kInvalidPortal);
+  REQUIRE(graph.AddPortal(house.hall, 17, {0, 0, 0}) ==
+          PortalGraph::kInvalidPortal);
+
+  const Vector3 listener{5, 1.5f, 5};
+  graph.Update(listener);
+  REQUIRE(graph.GetListenerRoom() == house.hall);
+
+  // Same room: direct
+  const Vector3 inHall{2, 1.5f, 2};
+  PortalPath path = graph.FindPath(inHall, listener, graph.FindRoom(inHall));
+  REQUIRE(path.reachable);
+  REQUIRE(path.portalCount == 0);
+  REQUIRE(path.obstruction == 0.0f);
+  REQUIRE(path.virtualPosition.x == inHall.x);
+
+  // Next room: around the door, heard from the door's direction
+  const Vector3 inCorridor{15, 1.5f, 8};
+  path = graph.FindPath(inCorridor, listener, house.corridor);
+  REQUIRE(path.portalCount == 1);
+  const float length = 5.0f + Distance({10, 1.5f, 5}, inCorridor);
+  REQUIRE(path.pathLength == Catch::Approx(length));
+  REQUIRE(path.virtualPosition.x == Catch::Approx(5.0f + length));
+  REQUIRE(path.virtualPosition.z == Catch::Approx(5.0f));
+  REQUIRE(path.obstruction < 0.1f);
+
+  // Two rooms away through both doors
+  const Vector3 inKitchen{25, 1.5f, 5};
+  path = graph.FindPath(inKitchen, listener, house.kitchen);
+  REQUIRE(path.portalCount == 2);
+  REQUIRE(path.pathLength == Catch::Approx(20.0f));
+  REQUIRE(path.obstruction == 0.0f);
+
+  REQUIRE_FALSE(graph.FindPath({50, 0, 0}, listener,
+                               graph.FindRoom({50, 0, 0}))
+                    .valid);
+}
+
+TEST_CASE("PortalGraph occludes through closed portals", "[PortalGraph]") {
+  House house;
+  PortalGraph &graph = house.graph;
+  const Vector3 listener{5, 1.5f, 5};
+  const Vector3 inKitchen{25, 1.5f, 5};
+
+  graph.SetPortalOpenness(house.kitchenDoor, 0.5f);
+  graph.Update(listener);
+  PortalPath path = graph.FindPath(inKitchen, listener, house.kitchen);
+  REQUIRE(path.obstruction == Catch::Approx(0.5f));
+
+  graph.SetPortalOpenness(house.kitchenDoor, 0.0f);
+  graph.Update(listener);
+  path = graph.FindPath(inKitchen, listener, house.kitchen);
+  REQUIRE(path.reachable);
+  REQUIRE(path.obstruction == 1.0f);
+
+  // A room with no portals is unreachable
+  const RoomID attic =
+      graph.CreateRoom(ZoneGeometry::Box({0, 3, 0}, {10, 6, 10}, 0));
+  graph.Update(listener);
+  path = graph.FindPath({5, 4, 5}, listener, attic);
+  REQUIRE(path.valid);
+  REQUIRE_FALSE(path.reachable);
+  REQUIRE(path.obstruction == 1.0f);
+}
+
+TEST_CASE("PortalGraph searches only when the listener room or a portal "
+          "changes",
+          "[PortalGraph]") {
+  House house;
+  PortalGraph &graph = house.graph;
+  graph.Update({5, 1.5f, 5});
+  const uint32_t searches = graph.GetSearchCount();
+  REQUIRE(searches == 2); // One per hall portal
+
+  graph.Update({2, 1.5f, 8});
+  graph.SetPortalOpenness(house.hallDoor, 1.0f); // Unchanged
+  graph.Update({3, 1.5f, 3});
+  REQUIRE(graph.GetSearchCount() == searches);
+
+  graph.Update({15, 1.5f, 5}); // Corridor has two portals
+  REQUIRE(graph.GetListenerRoom() == house.corridor);
+  REQUIRE(graph.GetSearchCount() == searches + 2);
+
+  graph.SetPortalOpenness(house.closetDoor, 0.2f);
+  graph.Update({15, 1.5f, 5});
+  REQUIRE(graph.GetSearchCount() == searches + 4);
+
+  // Outside every room: no paths
+  graph.Update({50, 0, 0});
+  REQUIRE(graph.GetListenerRoom() == PortalGraph::kInvalidRoom);
+  REQUIRE_FALSE(graph.FindPath({5, 1, 5}, {50, 0, 0}, house.hall).valid);
+}
+
+TEST_CASE("OcclusionProcessor answers voices from the portal graph",
+          "[PortalGraph]") {
+  House house;
+  house.graph.SetPortalOpenness(house.kitchenDoor, 0.0f);
+  const Vector3 listener{5, 1.5f, 5};
+  house.graph.Update(listener);
+
+  OcclusionProcessor processor;
+  processor.SetPortalGraph(&house.graph);
+  Voice kitchen;
+  kitchen.position = {25, 1.5f, 5};
+  Voice corridor;
+  corridor.position = {15, 1.5f, 8};
+  Voice outside;
+  outside.position = {50, 0, 0};
+  Voice *voices[] = {&kitchen, &corridor, &outside};
+
+  processor.Update(voices, 3, listener, 1.0f / 60.0f);
+  REQUIRE(processor.GetLastPortalPathCount() == 2);
+  REQUIRE(kitchen.occlusionRoom == house.kitchen);
+  REQUIRE(kitchen.obstruction == 1.0f);
+  REQUIRE(corridor.obstruction < 0.1f);
+  REQUIRE(corridor.apparentPosition.z == Catch::Approx(5.0f));
+  REQUIRE(outside.obstruction == 0.0f);
+  REQUIRE(outside.apparentPosition.x == 50.0f);
+}
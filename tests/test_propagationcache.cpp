@@ -0,0 +1,163 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/PropagationCache.h"
+
+#include <cmath>
+
+using namespace Orpheus;
+
+namespace {
+
+// 20 x 10 x 15 m shoebox room with scattering walls
+RayHit ShoeboxHit(const AcousticVector &origin, const AcousticVector &dir,
+                  float maxDistance) {
+  static const float kMin[3] = {0.0f, 0.0f, 0.0f};
+  static const float kMax[3] = {20.0f, 10.0f, 15.0f};
+  const float o[3] = {origin.x, origin.y, origin.z};
+  const float d[3] = {dir.x, dir.y, dir.z};
+
+  RayHit hit;
+  float best = maxDistance;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (d[axis] == 0.0f) {
+      continue;
+    }
+    const float plane = d[axis] > 0.0f ? kMax[axis] : kMin[axis];
+    const float t = (plane - o[axis]) / d[axis];
+    if (t > 0.0f && t < best) {
+      best = t;
+      hit.hit = true;
+      hit.distance = t;
+      hit.normal = {0.0f, 0.0f, 0.0f};
+      (axis == 0 ? hit.normal.x : axis == 1 ? hit.normal.y : hit.normal.z) =
+          d[axis] > 0.0f ? -1.0f : 1.0f;
+    }
+  }
+  hit.material = AcousticMaterial::Wood();
+  hit.material.scattering = 0.5f;
+  return hit;
+}
+
+AcousticRayTracer MakeTracer() {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryCallback(ShoeboxHit);
+  tracer.SetRayCount(256);
+  return tracer;
+}
+
+} // namespace
+
+TEST_CASE("PropagationCache with full slices matches a full trace",
+          "[PropagationCache]") {
+  const AcousticRayTracer tracer = MakeTracer();
+  const AcousticVector source{5, 2, 5};
+  const AcousticVector listener{15, 2, 10};
+  const PropagationResult full = tracer.Trace(source, listener);
+  const PropagationEffect expected = PropagationEffect::FromResult(full);
+
+  PropagationCache cache;
+  cache.SetUpdateFractions(1.0f, 1.0f);
+  const PropagationEstimate &estimate = cache.Update(1, source, listener,
+                                                     tracer);
+  REQUIRE(estimate.IsConverged());
+  REQUIRE(cache.GetRaysTraced() == 256);
+  REQUIRE(estimate.hasDirectPath);
+  REQUIRE(estimate.GetEarlyReflectionGain() ==
+          Catch::Approx(full.earlyReflectionGain));
+  REQUIRE(estimate.earlyReflectionDelay ==
+          Catch::Approx(full.earlyReflectionDelay));
+
+  const PropagationEffect effect = estimate.ToEffect();
+  REQUIRE(effect.volume == Catch::Approx(expected.volume));
+  REQUIRE(effect.lowPassCutoff == Catch::Approx(expected.lowPassCutoff));
+  REQUIRE(effect.reverbSend == Catch::Approx(expected.reverbSend));
+  REQUIRE(effect.delay == Catch::Approx(expected.delay));
+}
+
+TEST_CASE("PropagationCache converges at a fraction of the rays",
+          "[PropagationCache]") {
+  const AcousticRayTracer tracer = MakeTracer();
+  const AcousticVector listener{15, 2, 10};
+  const VoiceID voices[] = {1, 2};
+  const AcousticVector sources[] = {{5, 2, 5}, {3, 6, 12}};
+
+  PropagationCache cache;
+  // Converging: two updates of half the ray set, then 1/8 per update
+  cache.Update(voices, sources, 2, listener, tracer);
+  REQUIRE_FALSE(cache.Find(1)->IsConverged());
+  REQUIRE(cache.GetRaysTraced() == 2 * 128);
+  cache.Update(voices, sources, 2, listener, tracer);
+  REQUIRE(cache.Find(1)->IsConverged());
+  const uint64_t before = cache.GetRaysTraced();
+  for (int i = 0; i < 40; ++i) {
+    cache.Update(voices, sources, 2, listener, tracer);
+  }
+  REQUIRE(cache.GetRaysTraced() - before == 40 * 2 * 32);
+
+  for (size_t i = 0; i < 2; ++i) {
+    const PropagationEffect expected =
+        PropagationEffect::FromResult(tracer.Trace(sources[i], listener));
+    const PropagationEffect effect = cache.Find(voices[i])->ToEffect();
+    REQUIRE(effect.volume == Catch::Approx(expected.volume).epsilon(0.15));
+    REQUIRE(effect.lowPassCutoff ==
+            Catch::Approx(expected.lowPassCutoff).epsilon(0.1));
+    REQUIRE(effect.reverbSend ==
+            Catch::Approx(expected.reverbSend).epsilon(0.25));
+  }
+
+  // Small moves keep the estimate; a jump starts over at the higher rate
+  AcousticVector moved = sources[0];
+  moved.x += 0.2f;
+  cache.Update(1, moved, listener, tracer);
+  REQUIRE(cache.Find(1)->IsConverged());
+  moved.x += 5.0f;
+  const uint64_t beforeJump = cache.GetRaysTraced();
+  cache.Update(1, moved, listener, tracer);
+  REQUIRE_FALSE(cache.Find(1)->IsConverged());
+  REQUIRE(cache.GetRaysTraced() - beforeJump == 128);
+
+  cache.Remove(1);
+  REQUIRE(cache.Find(1) == nullptr);
+  REQUIRE(cache.GetEntryCount() == 1);
+  cache.Clear();
+  REQUIRE(cache.GetEntryCount() == 0);
+}
+
+TEST_CASE("PropagationCache counts image-source paths once per slice",
+          "[PropagationCache]") {
+  AcousticRayTracer tracer = MakeTracer();
+  const AcousticMaterialID wood = tracer.GetMaterialID("Wood");
+  tracer.SetImageSourceModel(ImageSourceModel::Box(
+      {0, 0, 0}, {20, 10, 15}, {wood, wood, wood, wood, wood, wood}));
+  const AcousticVector source{5, 2, 5};
+  const AcousticVector listener{15, 2, 10};
+  const PropagationResult full = tracer.Trace(source, listener);
+  float fullPaths = 0.0f;
+  for (const PropagationPath &path : full.paths) {
+    fullPaths += path.isDirect ? 0.0f : 1.0f;
+  }
+  REQUIRE(fullPaths > 0.0f);
+
+  PropagationCache whole;
+  whole.SetUpdateFractions(1.0f, 1.0f);
+  REQUIRE(whole.Update(1, source, listener, tracer).indirectPaths ==
+          Catch::Approx(fullPaths));
+
+  // Slices of an eighth still estimate the full path count
+  PropagationCache sliced;
+  sliced.SetUpdateFractions(0.125f, 0.125f);
+  for (int i = 0; i < 8; ++i) {
+    sliced.Update(1, source, listener, tracer);
+  }
+  const PropagationEstimate &estimate = *sliced.Find(1);
+  REQUIRE(estimate.IsConverged());
+  REQUIRE(estimate.indirectPaths ==
+          Catch::Approx(fullPaths).epsilon(0.15));
+
+  const PropagationEffect expected = PropagationEffect::FromResult(full);
+  const PropagationEffect effect = estimate.ToEffect();
+  REQUIRE(effect.volume == Catch::Approx(expected.volume).epsilon(0.15));
+  REQUIRE(effect.lowPassCutoff ==
+          Catch::Approx(expected.lowPassCutoff).epsilon(0.1));
+}
@@ -0,0 +1,211 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/OcclusionProcessor.h"
+#include "include/OcclusionScene.h"
+#include "include/PropagationField.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// 40 x 4 x 40 cells of 1 m around the origin
+PropagationField MakeField() {
+  PropagationField field;
+  REQUIRE(field.Configure({-20, -2, -20}, {20, 2, 20}, 1.0f));
+  return field;
+}
+
+} // namespace
+
+TEST_CASE("PropagationField measures paths in open space",
+          "[PropagationField]") {
+  PropagationField field = MakeField();
+  REQUIRE(field.GetCellCount() == 40 * 4 * 40);
+  const Vector3 listener{0.5f, 0.5f, 0.5f};
+  REQUIRE_FALSE(field.Sample({10.5f, 0.5f, 0.5f}, listener).valid);
+
+  field.Update(listener);
+  REQUIRE_FALSE(field.IsComputing());
+  REQUIRE(field.GetFloodCount() == 1);
+
+  const PropagationSample straight = field.Sample({10.5f, 0.5f, 0.5f},
+                                                  listener);
+  REQUIRE(straight.valid);
+  REQUIRE(straight.pathLength == Catch::Approx(10.0f));
+  REQUIRE(straight.transmission == 0.0f);
+  REQUIRE(straight.obstruction == 0.0f);
+
+  const PropagationSample diagonal = field.Sample({7.5f, 0.5f, 7.5f},
+                                                  listener);
+  REQUIRE(diagonal.pathLength == Catch::Approx(7.0f * 1.41421356f));
+  REQUIRE(diagonal.obstruction == 0.0f);
+
+  REQUIRE_FALSE(field.Sample({30, 0, 0}, listener).valid);
+}
+
+TEST_CASE("PropagationField diffracts around walls and through closed ones",
+          "[PropagationField]") {
+  PropagationField field = MakeField();
+  field.SetDiffractionScale(20.0f);
+  // Wall at x = 5 with a gap for z >= 10
+  field.FillBox({5, -2, -20}, {6, 2, 10}, 1.0f);
+  REQUIRE(field.GetCellObstruction({5.5f, 0, 0}) == 1.0f);
+  REQUIRE(field.GetCellObstruction({5.5f, 0, 12}) == 0.0f);
+
+  const Vector3 listener{0.5f, 0.5f, 0.5f};
+  field.Update(listener);
+  const PropagationSample around = field.Sample({10.5f, 0.5f, 0.5f},
+                                                listener);
+  REQUIRE(around.valid);
+  REQUIRE(around.transmission == 0.0f);
+  REQUIRE(around.pathLength > 20.0f);
+  REQUIRE(around.obstruction > 0.3f);
+  REQUIRE(around.obstruction < 0.8f);
+
+  // A source touching the wall hears from its open side
+  const PropagationSample touching = field.Sample({5.5f, 0.5f, 0.5f},
+                                                  listener);
+  REQUIRE(touching.transmission == 0.0f);
+  REQUIRE(touching.pathLength == Catch::Approx(5.0f));
+
+  // Closing the gap forces the path through the wall
+  field.FillBox({5, -2, 10}, {6, 2, 20}, 1.0f);
+  field.Update(listener);
+  REQUIRE(field.GetFloodCount() == 2);
+  const PropagationSample through = field.Sample({10.5f, 0.5f, 0.5f},
+                                                 listener);
+  REQUIRE(through.transmission == Catch::Approx(1.0f));
+  REQUIRE(through.pathLength == Catch::Approx(10.0f));
+  REQUIRE(through.obstruction == 1.0f);
+}
+
+TEST_CASE("PropagationField floods only when the listener changes cell",
+          "[PropagationField]") {
+  PropagationField field = MakeField();
+  field.Update({0.5f, 0.5f, 0.5f});
+  REQUIRE(field.GetFloodCount() == 1);
+
+  // Moving within the cell keeps the field
+  field.Update({0.9f, 0.1f, 0.2f});
+  REQUIRE(field.GetFloodCount() == 1);
+  REQUIRE_FALSE(field.IsComputing());
+
+  // A new cell restarts the flood, spread over several updates while the
+  // previous field stays readable
+  field.SetMaxExpansions(500);
+  const Vector3 moved{2.5f, 0.5f, 0.5f};
+  field.Update(moved);
+  REQUIRE(field.IsComputing());
+  REQUIRE(field.GetFloodCount() == 1);
+  REQUIRE(field.Sample({10.5f, 0.5f, 0.5f}, moved).pathLength ==
+          Catch::Approx(10.0f));
+
+  int updates = 1;
+  while (field.IsComputing()) {
+    field.Update(moved);
+    ++updates;
+  }
+  REQUIRE(updates > 2);
+  REQUIRE(field.GetFloodCount() == 2);
+  REQUIRE(field.Sample({10.5f, 0.5f, 0.5f}, moved).pathLength ==
+          Catch::Approx(8.0f));
+
+  // Too far from the field's origin, samples defer to direct queries
+  REQUIRE_FALSE(field.Sample({10.5f, 0.5f, 0.5f}, {5.5f, 0.5f, 0.5f}).valid);
+}
+
+TEST_CASE("PropagationField keeps up with a moving listener",
+          "[PropagationField]") {
+  PropagationField field = MakeField();
+  field.SetMaxExpansions(1500); // 8 updates per flood
+  const Vector3 source{0.5f, 0.5f, 15.5f};
+
+  // One cell per update: floods still complete, and samples are either
+  // close to the true path or invalid, never from a far-away origin
+  int invalid = 0;
+  for (int step = 0; step < 36; ++step) {
+    const Vector3 listener{-17.5f + static_cast<float>(step), 0.5f, 0.5f};
+    field.Update(listener);
+    const PropagationSample sample = field.Sample(source, listener);
+    if (!sample.valid) {
+      ++invalid;
+      continue;
+    }
+    const float dx = source.x - listener.x;
+    const float dz = source.z - listener.z;
+    REQUIRE(std::abs(sample.pathLength - std::sqrt(dx * dx + dz * dz)) <
+            3.0f);
+  }
+  REQUIRE(field.GetFloodCount() >= 4);
+  REQUIRE(invalid > 0);
+
+  // Once the listener stops, the field catches up with it
+  const Vector3 stopped{18.5f, 0.5f, 0.5f};
+  for (int i = 0; i < 40; ++i) {
+    field.Update(stopped);
+  }
+  REQUIRE_FALSE(field.IsComputing());
+  REQUIRE(field.Sample({18.5f, 0.5f, 10.5f}, stopped).pathLength ==
+          Catch::Approx(10.0f));
+}
+
+TEST_CASE("PropagationField voxelizes occlusion scenes by material",
+          "[PropagationField]") {
+  OcclusionScene scene;
+  const std::vector<Vector3> wall{{5.5f, -2, -20}, {5.5f, 2, -20},
+                                  {5.5f, 2, 20},   {5.5f, -2, 20}};
+  const std::vector<uint32_t> quad{0, 1, 2, 0, 2, 3};
+  scene.AddMesh(wall.data(), wall.size(), quad.data(), quad.size(), 2, 0.1f);
+  scene.Commit();
+
+  PropagationField field = MakeField();
+  field.Voxelize(scene, [](OcclusionMaterialID id) {
+    return id == 2 ? 0.6f : 0.0f;
+  });
+  REQUIRE(field.GetCellObstruction({5.5f, 0, 0}) ==
+          Catch::Approx(0.6f).margin(0.01f));
+  REQUIRE(field.GetCellObstruction({5.5f, 1.5f, -19.5f}) > 0.0f);
+  REQUIRE(field.GetCellObstruction({4.5f, 0, 0}) == 0.0f);
+
+  const Vector3 listener{0.5f, 0.5f, 0.5f};
+  field.Update(listener);
+  REQUIRE(field.Sample({10.5f, 0.5f, 0.5f}, listener).transmission ==
+          Catch::Approx(0.6f).margin(0.01f));
+}
+
+TEST_CASE("OcclusionProcessor answers voices from a propagation field",
+          "[PropagationField]") {
+  PropagationField field = MakeField();
+  field.FillBox({5, -2, -20}, {6, 2, 20}, 1.0f);
+  const Vector3 listener{0.5f, 0.5f, 0.5f};
+  field.Update(listener);
+
+  OcclusionProcessor processor;
+  processor.SetPropagationField(&field);
+  Voice behind;
+  behind.position = {10.5f, 0.5f, 0.5f};
+  Voice outside;
+  outside.position = {50, 0, 0};
+  Voice *voices[] = {&behind, &outside};
+
+  processor.Update(voices, 2, listener, 1.0f / 60.0f);
+  REQUIRE(processor.GetLastFieldSampleCount() == 1);
+  REQUIRE(processor.GetLastQueryCount() == 0);
+  REQUIRE(behind.obstruction == 1.0f);
+  REQUIRE(behind.occlusion == 1.0f);
+  REQUIRE(outside.obstruction == 0.0f);
+
+  // Voices outside the field fall back to the callback
+  int queries = 0;
+  processor.SetQueryCallback([&queries](const Vector3 &, const Vector3 &) {
+    ++queries;
+    return std::vector<OcclusionHit>{};
+  });
+  processor.Update(voices, 2, listener, 1.0f / 60.0f);
+  REQUIRE(processor.GetLastFieldSampleCount() == 1);
+  REQUIRE(queries == 1);
+}
@@ -0,0 +1,219 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/PropagationProcessor.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// 20 x 10 x 15 m shoebox room with scattering walls
+RayHit ShoeboxHit(const AcousticVector &origin, const AcousticVector &dir,
+                  float maxDistance) {
+  static const float kMin[3] = {0.0f, 0.0f, 0.0f};
+  static const float kMax[3] = {20.0f, 10.0f, 15.0f};
+  const float o[3] = {origin.x, origin.y, origin.z};
+  const float d[3] = {dir.x, dir.y, dir.z};
+
+  RayHit hit;
+  float best = maxDistance;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (d[axis] == 0.0f) {
+      continue;
+    }
+    const float plane = d[axis] > 0.0f ? kMax[axis] : kMin[axis];
+    const float t = (plane - o[axis]) / d[axis];
+    if (t > 0.0f && t < best) {
+      best = t;
+      hit.hit = true;
+      hit.distance = t;
+      hit.normal = {0.0f, 0.0f, 0.0f};
+      (axis == 0 ? hit.normal.x : axis == 1 ? hit.normal.y : hit.normal.z) =
+          d[axis] > 0.0f ? -1.0f : 1.0f;
+    }
+  }
+  hit.material = AcousticMaterial::Wood();
+  hit.material.scattering = 0.5f;
+  return hit;
+}
+
+// 256 rays in 8 chunks: a converging voice traces 128 rays
+AcousticRayTracer MakeTracer() {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryCallback(ShoeboxHit);
+  tracer.SetRayCount(256);
+  tracer.SetEnabled(true);
+  return tracer;
+}
+
+std::vector<Voice> MakeVoices(const std::vector<uint8_t> &priorities) {
+  std::vector<Voice> voices(priorities.size());
+  for (size_t i = 0; i < voices.size(); ++i) {
+    voices[i].id = static_cast<VoiceID>(i + 1);
+    voices[i].priority = priorities[i];
+    voices[i].position = {3.0f + 3.0f * static_cast<float>(i), 2.0f, 5.0f};
+    voices[i].audibility = 1.0f;
+  }
+  return voices;
+}
+
+std::vector<Voice *> Pointers(std::vector<Voice> &voices) {
+  std::vector<Voice *> pointers;
+  for (Voice &voice : voices) {
+    pointers.push_back(&voice);
+  }
+  return pointers;
+}
+
+bool IsTraced(const Voice &voice) {
+  return voice.propagationLowPassFreq < 22000.0f;
+}
+
+} // namespace
+
+TEST_CASE("PropagationProcessor traces by priority within the ray budget",
+          "[PropagationProcessor]") {
+  const AcousticRayTracer tracer = MakeTracer();
+  const Vector3 listener{15.0f, 2.0f, 10.0f};
+  std::vector<Voice> voices = MakeVoices({10, 200, 50, 200});
+  std::vector<Voice *> pointers = Pointers(voices);
+
+  PropagationProcessor propagation;
+  propagation.SetRayBudget(300);
+  propagation.Update(pointers.data(), pointers.size(), listener, tracer,
+                     nullptr, 0.01f);
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 2);
+  REQUIRE(propagation.GetLastRayCount() == 256);
+
+  // Results are staged only by the update after the batch finished
+  propagation.Wait();
+  REQUIRE_FALSE(propagation.IsBusy());
+  for (const Voice &voice : voices) {
+    REQUIRE_FALSE(IsTraced(voice));
+    REQUIRE(voice.hasPropagation);
+  }
+  propagation.Update(pointers.data(), pointers.size(), listener, tracer,
+                     nullptr, 0.01f);
+  REQUIRE(IsTraced(voices[1]));
+  REQUIRE(IsTraced(voices[3]));
+  REQUIRE_FALSE(IsTraced(voices[0]));
+  REQUIRE_FALSE(IsTraced(voices[2]));
+
+  // The rest follow in the next batch
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 2);
+  propagation.Wait();
+  propagation.Update(pointers.data(), pointers.size(), listener, tracer,
+                     nullptr, 0.01f);
+  REQUIRE(IsTraced(voices[0]));
+  REQUIRE(IsTraced(voices[2]));
+
+  // Nobody is due again before the refresh interval
+  propagation.Update(pointers.data(), pointers.size(), listener, tracer,
+                     nullptr, 0.01f);
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 0);
+  REQUIRE(propagation.GetRefreshInterval(voices[0]) == Catch::Approx(0.25f));
+}
+
+TEST_CASE("PropagationProcessor smooths staged parameters",
+          "[PropagationProcessor]") {
+  const AcousticRayTracer tracer = MakeTracer();
+  const Vector3 listener{15.0f, 2.0f, 10.0f};
+  std::vector<Voice> voices = MakeVoices({128});
+  std::vector<Voice *> pointers = Pointers(voices);
+  Voice &voice = voices[0];
+
+  PropagationProcessor propagation;
+  propagation.SetSmoothingTime(0.2f);
+  propagation.Update(pointers.data(), 1, listener, tracer, nullptr, 0.01f);
+  propagation.Wait();
+  propagation.Update(pointers.data(), 1, listener, tracer, nullptr, 0.01f);
+  REQUIRE(IsTraced(voice));
+
+  // One small step moves part of the way towards the target
+  const float target = voice.propagationLowPassFreq;
+  REQUIRE(voice.propagationLowPassSmoothed < 22000.0f);
+  REQUIRE(voice.propagationLowPassSmoothed > target);
+  for (int i = 0; i < 200; ++i) {
+    propagation.Update(pointers.data(), 1, listener, tracer, nullptr, 0.01f);
+  }
+  propagation.Wait();
+  REQUIRE(voice.propagationLowPassSmoothed ==
+          Catch::Approx(voice.propagationLowPassFreq).margin(50.0f));
+
+  // Disabling tracing glides back to neutral, then stops touching the DSP
+  AcousticRayTracer disabled = MakeTracer();
+  disabled.SetEnabled(false);
+  propagation.Update(pointers.data(), 1, listener, disabled, nullptr, 0.01f);
+  REQUIRE(voice.propagationLowPassFreq == 22000.0f);
+  REQUIRE(voice.hasPropagation);
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 0);
+  for (int i = 0; i < 300; ++i) {
+    propagation.Update(pointers.data(), 1, listener, disabled, nullptr,
+                       0.01f);
+  }
+  REQUIRE_FALSE(voice.hasPropagation);
+  REQUIRE(voice.propagationVolumeSmoothed == 1.0f);
+  REQUIRE(voice.propagationReverbSendSmoothed == 0.0f);
+}
+
+TEST_CASE("PropagationProcessor answers voices from baked probes",
+          "[PropagationProcessor]") {
+  const AcousticRayTracer tracer = MakeTracer();
+  AcousticProbeGrid probes;
+  REQUIRE(probes
+              .LoadFromMemory(AcousticProbeGrid::BakeGrid(
+                  tracer, {2, 2, 2}, {10, 8, 13}, 4.0f))
+              .IsOk());
+
+  // Inside the baked volume, then outside it
+  std::vector<Voice> voices = MakeVoices({128, 128});
+  voices[1].position = {18.0f, 2.0f, 5.0f};
+  std::vector<Voice *> pointers = Pointers(voices);
+
+  PropagationProcessor propagation;
+  propagation.Update(pointers.data(), pointers.size(), {15, 2, 10}, tracer,
+                     &probes, 0.01f);
+  REQUIRE(propagation.GetLastProbeSampleCount() == 1);
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 1);
+  REQUIRE(propagation.GetLastRayCount() == 128);
+  REQUIRE(voices[0].propagationReverbSend ==
+          Catch::Approx(probes.Sample(voices[0].position).earlyReflectionGain *
+                        0.5f));
+  REQUIRE(voices[0].propagationReverbSend > 0.0f);
+  REQUIRE(voices[0].propagationVolume == 1.0f);
+}
+
+TEST_CASE("PropagationProcessor traces a copy of the tracer",
+          "[PropagationProcessor]") {
+  AcousticRayTracer tracer = MakeTracer();
+  const Vector3 listener{15.0f, 2.0f, 10.0f};
+  std::vector<Voice> voices = MakeVoices({128});
+  std::vector<Voice *> pointers = Pointers(voices);
+
+  PropagationProcessor propagation;
+  propagation.Update(pointers.data(), 1, listener, tracer, nullptr, 0.01f);
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 1);
+
+  // Changes while the batch may still run apply from the next batch
+  std::atomic<int> calls{0};
+  tracer.SetGeometryCallback([&calls](const AcousticVector &origin,
+                                      const AcousticVector &dir,
+                                      float maxDistance) {
+    ++calls;
+    return ShoeboxHit(origin, dir, maxDistance);
+  });
+  tracer.SetRayCount(64);
+  propagation.Wait();
+  REQUIRE(calls.load() == 0);
+  propagation.Update(pointers.data(), 1, listener, tracer, nullptr, 0.01f);
+  REQUIRE(IsTraced(voices[0]));
+
+  voices[0].propagationAge = 10.0f;
+  propagation.Update(pointers.data(), 1, listener, tracer, nullptr, 0.01f);
+  REQUIRE(propagation.GetLastTracedVoiceCount() == 1);
+  propagation.Wait();
+  REQUIRE(calls.load() > 0);
+}
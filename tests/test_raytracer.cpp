@@ -0,0 +1,341 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/RaytracedAcoustics.h"
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// 20 x 10 x 15 m shoebox room with scattering walls (thread-safe)
+RayHit ShoeboxHit(const AcousticVector &origin, const AcousticVector &dir,
+                  float maxDistance) {
+  static const float kMin[3] = {0.0f, 0.0f, 0.0f};
+  static const float kMax[3] = {20.0f, 10.0f, 15.0f};
+  const float o[3] = {origin.x, origin.y, origin.z};
+  const float d[3] = {dir.x, dir.y, dir.z};
+
+  RayHit hit;
+  float best = maxDistance;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (d[axis] == 0.0f) {
+      continue;
+    }
+    const float plane = d[axis] > 0.0f ? kMax[axis] : kMin[axis];
+    const float t = (plane - o[axis]) / d[axis];
+    if (t > 0.0f && t < best) {
+      best = t;
+      hit.hit = true;
+      hit.distance = t;
+      hit.normal = {0.0f, 0.0f, 0.0f};
+      (axis == 0 ? hit.normal.x : axis == 1 ? hit.normal.y : hit.normal.z) =
+          d[axis] > 0.0f ? -1.0f : 1.0f;
+    }
+  }
+  hit.point = origin + dir * hit.distance;
+  hit.material = AcousticMaterial::Wood();
+  hit.material.scattering = 0.5f;
+  return hit;
+}
+
+// The same room as a packet callback; walls use material id `material`
+GeometryPacketCallback ShoeboxPacket(AcousticMaterialID material) {
+  return [material](const AcousticRayPacket &rays, AcousticHitPacket &hits) {
+    static const float kMin[3] = {0.0f, 0.0f, 0.0f};
+    static const float kMax[3] = {20.0f, 10.0f, 15.0f};
+    for (size_t lane = 0; lane < rays.count; ++lane) {
+      const float o[3] = {rays.originX[lane], rays.originY[lane],
+                          rays.originZ[lane]};
+      const float d[3] = {rays.directionX[lane], rays.directionY[lane],
+                          rays.directionZ[lane]};
+      float best = rays.maxDistance[lane];
+      for (int axis = 0; axis < 3; ++axis) {
+        if (d[axis] == 0.0f) {
+          continue;
+        }
+        const float plane = d[axis] > 0.0f ? kMax[axis] : kMin[axis];
+        const float t = (plane - o[axis]) / d[axis];
+        if (t > 0.0f && t < best) {
+          best = t;
+          const float side = d[axis] > 0.0f ? -1.0f : 1.0f;
+          hits.hitMask |= 1u << lane;
+          hits.distance[lane] = t;
+          hits.normalX[lane] = axis == 0 ? side : 0.0f;
+          hits.normalY[lane] = axis == 1 ? side : 0.0f;
+          hits.normalZ[lane] = axis == 2 ? side : 0.0f;
+          hits.material[lane] = material;
+        }
+      }
+    }
+  };
+}
+
+AcousticRayTracer MakeTracer() {
+  AcousticRayTracer tracer;
+  tracer.SetGeometryCallback(ShoeboxHit);
+  tracer.SetRayCount(256);
+  tracer.SetSeed(7);
+  return tracer;
+}
+
+bool SamePaths(const PropagationResult &a, const PropagationResult &b) {
+  if (a.paths.size() != b.paths.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.paths.size(); ++i) {
+    if (a.paths[i].distance != b.paths[i].distance ||
+        a.paths[i].gainMid != b.paths[i].gainMid ||
+        a.paths[i].reflections != b.paths[i].reflections) {
+      return false;
+    }
+  }
+  return a.earlyReflectionGain == b.earlyReflectionGain;
+}
+
+} // namespace
+
+TEST_CASE("AcousticRayTracer is deterministic for any thread count",
+          "[RayTracer]") {
+  const AcousticVector source{5, 2, 5};
+  const AcousticVector listener{15, 2, 10};
+
+  AcousticRayTracer serial = MakeTracer();
+  const PropagationResult expected = serial.Trace(source, listener);
+  REQUIRE(expected.hasDirectPath);
+  REQUIRE(expected.paths.size() > 1);
+  REQUIRE(SamePaths(serial.Trace(source, listener), expected));
+
+  AcousticRayTracer parallel = MakeTracer();
+  parallel.SetThreadCount(4);
+  REQUIRE(parallel.GetWorkerPool()->GetThreadCount() == 4);
+  REQUIRE(SamePaths(parallel.Trace(source, listener), expected));
+
+  // A different seed scatters differently
+  parallel.SetSeed(8);
+  REQUIRE_FALSE(SamePaths(parallel.Trace(source, listener), expected));
+}
+
+TEST_CASE("AcousticRayTracer traces batches and concurrent callers",
+          "[RayTracer]") {
+  AcousticRayTracer tracer = MakeTracer();
+  tracer.SetWorkerPool(std::make_shared<WorkerPool>(3));
+  const AcousticVector listener{10, 2, 7};
+  std::vector<AcousticVector> sources;
+  for (int i = 0; i < 8; ++i) {
+    sources.push_back({1.0f + 2.0f * i, 3.0f, 2.0f + i});
+  }
+
+  AcousticRayTracer serial = MakeTracer();
+  std::vector<PropagationResult> expected;
+  for (const auto &source : sources) {
+    expected.push_back(serial.Trace(source, listener));
+  }
+
+  std::vector<PropagationResult> batch(sources.size());
+  tracer.TraceBatch(sources.data(), sources.size(), listener, batch.data());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    REQUIRE(SamePaths(batch[i], expected[i]));
+  }
+
+  // Several threads tracing different voices through one tracer and pool
+  std::vector<PropagationResult> concurrent(sources.size());
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = t; i < sources.size(); i += 4) {
+        concurrent[i] = tracer.Trace(sources[i], listener);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < sources.size(); ++i) {
+    REQUIRE(SamePaths(concurrent[i], expected[i]));
+  }
+}
+
+TEST_CASE("WorkerPool runs every index once", "[RayTracer]") {
+  WorkerPool pool(3);
+  std::vector<std::atomic<int>> counts(1000);
+  pool.ParallelFor(counts.size(), [&](size_t i) { ++counts[i]; });
+  for (const auto &count : counts) {
+    REQUIRE(count == 1);
+  }
+  pool.ParallelFor(0, [](size_t) { FAIL(); });
+}
+
+TEST_CASE("AcousticRayTracer packet callback matches per-ray callback",
+          "[RayTracer]") {
+  const AcousticVector listener{15, 2, 10};
+  const AcousticVector sources[] = {{5, 2, 5}, {1, 1, 1}, {18, 8, 3}};
+  AcousticRayTracer scalar = MakeTracer();
+  PropagationResult expected[3];
+  scalar.TraceBatch(sources, 3, listener, expected);
+
+  AcousticMaterial walls = AcousticMaterial::Wood();
+  walls.name = "ScatteringWood";
+  walls.scattering = 0.5f;
+  AcousticRayTracer packet = MakeTracer();
+  packet.SetGeometryPacketCallback(
+      ShoeboxPacket(packet.RegisterMaterial(walls)));
+
+  for (size_t size : {16, 8, 3}) {
+    packet.SetPacketSize(size);
+    PropagationResult results[3];
+    packet.TraceBatch(sources, 3, listener, results);
+    for (size_t i = 0; i < 3; ++i) {
+      REQUIRE(SamePaths(results[i], expected[i]));
+    }
+  }
+
+  // Packets are padded to the packet size with the last ray
+  size_t calls = 0;
+  packet.SetPacketSize(8);
+  packet.SetGeometryPacketCallback(
+      [&calls](const AcousticRayPacket &rays, AcousticHitPacket &) {
+        ++calls;
+        REQUIRE(rays.count >= 1);
+        REQUIRE(rays.count <= 8);
+        for (size_t lane = rays.count; lane < 8; ++lane) {
+          REQUIRE(rays.originX[lane] == rays.originX[rays.count - 1]);
+          REQUIRE(rays.maxDistance[lane] == rays.maxDistance[rays.count - 1]);
+        }
+      });
+  const PropagationResult open = packet.Trace(sources[0], listener);
+  REQUIRE(open.hasDirectPath);
+  REQUIRE(open.paths.size() == 1);
+  REQUIRE(calls == 1 + 256 / 8); // Direct path, then one pass of misses
+}
+
+TEST_CASE("AcousticRayTracer material table", "[RayTracer]") {
+  AcousticRayTracer tracer;
+  REQUIRE(tracer.GetMaterialID("Concrete") == 0);
+  REQUIRE(tracer.GetMaterialID("Curtain") == 4);
+  REQUIRE(tracer.GetMaterialID("Moss") == AcousticRayTracer::kInvalidMaterial);
+
+  AcousticMaterial moss{"Moss", 0.2f, 0.5f, 0.7f, 0.6f, 0.0f};
+  const AcousticMaterialID id = tracer.RegisterMaterial(moss);
+  REQUIRE(id == 5);
+  moss.absorptionMid = 0.4f;
+  REQUIRE(tracer.RegisterMaterial(moss) == id);
+  REQUIRE(tracer.GetMaterial(id).absorptionMid == 0.4f);
+
+  // Unknown ids fall back to the default material
+  REQUIRE(tracer.GetMaterial(99).absorptionMid ==
+          AcousticMaterial{}.absorptionMid);
+
+  tracer.SetPacketSize(64);
+  REQUIRE(tracer.GetPacketSize() == AcousticRayPacket::kMaxRays);
+}
+
+TEST_CASE("AcousticRayTracer estimates late reverb time from energy decay",
+          "[RayTracer]") {
+  AcousticRayTracer tracer = MakeTracer();
+  tracer.SetGeometryPacketCallback(
+      ShoeboxPacket(tracer.GetMaterialID("Concrete")));
+  const float concrete = tracer.Trace({5, 2, 5}, {15, 2, 10}).lateReverbTime;
+  tracer.SetGeometryPacketCallback(
+      ShoeboxPacket(tracer.GetMaterialID("Carpet")));
+  const float carpet = tracer.Trace({5, 2, 5}, {15, 2, 10}).lateReverbTime;
+
+  // Absorbent walls decay faster
+  REQUIRE(carpet > 0.0f);
+  REQUIRE(concrete > carpet * 2.0f);
+}
+
+TEST_CASE("AcousticRayTracer adds image-source early reflections",
+          "[RayTracer]") {
+  AcousticRayTracer tracer;
+  tracer.SetRayCount(64);
+  const AcousticMaterialID concrete = tracer.GetMaterialID("Concrete");
+  const std::array<AcousticMaterialID, 6> walls = {
+      concrete, concrete, concrete, concrete, concrete, concrete};
+  auto model = ImageSourceModel::Box({0, 0, 0}, {20, 10, 15}, walls);
+  tracer.SetImageSourceModel(model);
+  REQUIRE(tracer.GetImageSourceModel() == model);
+
+  auto countOrders = [](const PropagationResult &result) {
+    std::array<int, 4> orders = {0, 0, 0, 0};
+    for (const PropagationPath &path : result.paths) {
+      if (!path.isDirect && path.reflections <= 3) {
+        ++orders[path.reflections];
+      }
+    }
+    return orders;
+  };
+
+  // Without geometry the planes are the room; every box image is audible
+  const AcousticVector source{5, 2, 5};
+  const AcousticVector listener{15, 2, 10};
+  PropagationResult result = tracer.Trace(source, listener);
+  std::array<int, 4> orders = countOrders(result);
+  REQUIRE(orders[1] == 6);
+  REQUIRE(orders[2] == 18);
+  REQUIRE(orders[3] == 38);
+
+  // The floor reflection mirrors the source to y = -2
+  bool foundFloor = false;
+  for (const PropagationPath &path : result.paths) {
+    if (path.reflections == 1 &&
+        std::abs(path.distance - std::sqrt(141.0f)) < 1e-3f) {
+      foundFloor = true;
+      REQUIRE(path.delay == Catch::Approx(path.distance / 343.0f));
+      REQUIRE(path.gainMid < 1.0f);
+    }
+  }
+  REQUIRE(foundFloor);
+  REQUIRE(result.earlyReflectionGain > 0.0f);
+
+  // The walls themselves do not block the paths that reflect off them,
+  // and low-order ray paths are replaced rather than added to
+  tracer.SetGeometryPacketCallback(ShoeboxPacket(concrete));
+  orders = countOrders(tracer.Trace(source, listener));
+  REQUIRE(orders[1] == 6);
+  REQUIRE(orders[2] == 18);
+  REQUIRE(orders[3] == 38);
+
+  // Geometry in the way removes them
+  tracer.SetGeometryPacketCallback(
+      [](const AcousticRayPacket &rays, AcousticHitPacket &hits) {
+        for (size_t lane = 0; lane < rays.count; ++lane) {
+          hits.hitMask |= 1u << lane;
+          hits.distance[lane] = rays.maxDistance[lane] * 0.5f;
+          hits.normalX[lane] = 1.0f;
+          hits.normalY[lane] = hits.normalZ[lane] = 0.0f;
+          hits.material[lane] = 0;
+        }
+      });
+  orders = countOrders(tracer.Trace(source, listener));
+  REQUIRE(orders[1] == 0);
+  REQUIRE(orders[2] == 0);
+  REQUIRE(orders[3] == 0);
+}
+
+TEST_CASE("ImageSourceModel caches images per source position",
+          "[RayTracer]") {
+  auto model = ImageSourceModel::Box({0, 0, 0}, {20, 10, 15},
+                                     {0, 0, 0, 0, 0, 0}, 2);
+  REQUIRE(model->GetMaxOrder() == 2);
+  REQUIRE(model->GetPlanes().size() == 6);
+
+  const auto first = model->GetImages({5, 2, 5});
+  REQUIRE(first->size() == 6 + 30);
+  REQUIRE(model->GetCacheMisses() == 1);
+  REQUIRE(model->GetImages({5, 2, 5}) == first);
+  REQUIRE(model->GetCacheHits() == 1);
+
+  // A moved source is recomputed
+  const auto moved = model->GetImages({5, 2, 5.5f});
+  REQUIRE(moved != first);
+  REQUIRE(model->GetCacheMisses() == 2);
+  REQUIRE((*moved)[0].order == 1);
+  REQUIRE((*moved)[0].parent == -1);
+}
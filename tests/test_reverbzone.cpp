@@ -0,0 +1,46 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/ReverbZone.h"
+
+using namespace Orpheus;
+
+TEST_CASE("ReverbInfluence takes the max within a priority", "[ReverbZone]") {
+  ReverbInfluence influence;
+  influence.Reset(2);
+  influence.Add(0, 0.3f, 128);
+  influence.Add(0, 0.7f, 128);
+  influence.Add(1, 0.5f, 128);
+  influence.Resolve();
+  REQUIRE(influence.Get(0) == Catch::Approx(0.7f));
+  REQUIRE(influence.Get(1) == Catch::Approx(0.5f));
+}
+
+TEST_CASE("ReverbInfluence lets higher priority zones cover lower ones",
+          "[ReverbZone]") {
+  constexpr uint32_t kCave = 0;
+  constexpr uint32_t kRoom = 1;
+  ReverbInfluence influence;
+
+  // Fully inside the room: the surrounding cave is silenced
+  influence.Reset(2);
+  influence.Add(kCave, 1.0f, 100);
+  influence.Add(kRoom, 1.0f, 200);
+  influence.Resolve();
+  REQUIRE(influence.Get(kRoom) == Catch::Approx(1.0f));
+  REQUIRE(influence.Get(kCave) == Catch::Approx(0.0f));
+
+  // In the room's fade band the two crossfade
+  influence.Reset(2);
+  influence.Add(kRoom, 0.25f, 200);
+  influence.Add(kCave, 1.0f, 100);
+  influence.Resolve();
+  REQUIRE(influence.Get(kRoom) == Catch::Approx(0.25f));
+  REQUIRE(influence.Get(kCave) == Catch::Approx(0.75f));
+
+  // Zones added before their bus exists stay unbound
+  ReverbZone zone("hall", "Hall", {0, 0, 0}, 1.0f, 2.0f);
+  REQUIRE(zone.GetReverbBusID() == ReverbZone::kNoReverbBus);
+  zone.SetReverbBusID(kRoom);
+  REQUIRE(zone.GetReverbBusID() == kRoom);
+}
@@ -65,3 +65,31 @@ TEST_CASE("Snapshot empty initially", "[Snapshot]") {
   REQUIRE(snap.GetStates().empty());
   REQUIRE(snap.GetReverbStates().empty());
 }
+
+// ============================================================================
+// CompiledSnapshot Tests
+// ============================================================================
+
+TEST_CASE("CompiledSnapshot fills dense slots and masks", "[Snapshot]") {
+  Snapshot snap;
+  snap.SetBusState("Music", BusState{0.3f});
+  snap.SetBusState("Missing", BusState{0.1f});
+  snap.SetReverbState("Cave", ReverbBusState{0.7f, 0.8f, 0.3f, 1.0f});
+
+  auto compiled = CompiledSnapshot::Compile(
+      snap, 3,
+      [](const std::string &name) {
+        return name == "Music" ? 2u : CompiledSnapshot::kInvalidID;
+      },
+      2,
+      [](const std::string &name) {
+        return name == "Cave" ? 1u : CompiledSnapshot::kInvalidID;
+      });
+
+  REQUIRE(compiled.GetBusCount() == 3);
+  REQUIRE(compiled.volume == std::vector<float>{1.0f, 1.0f, 0.3f});
+  REQUIRE(compiled.volumeMask == std::vector<float>{0.0f, 0.0f, 1.0f});
+  REQUIRE(compiled.GetReverbCount() == 2);
+  REQUIRE(compiled.reverbMask == std::vector<float>{0.0f, 1.0f});
+  REQUIRE(compiled.roomSize[1] == 0.8f);
+}
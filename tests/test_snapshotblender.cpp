@@ -0,0 +1,121 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/SnapshotBlender.h"
+
+#include <memory>
+#include <string>
+
+using namespace Orpheus;
+
+namespace {
+
+constexpr uint32_t kMusic = 1;
+constexpr uint32_t kSfx = 2;
+constexpr uint32_t kHall = 0;
+
+std::shared_ptr<const CompiledSnapshot> Compile(const Snapshot &snapshot) {
+  auto busID = [](const std::string &name) {
+    return name == "Music" ? kMusic
+           : name == "SFX" ? kSfx
+                           : CompiledSnapshot::kInvalidID;
+  };
+  auto reverbID = [](const std::string &name) {
+    return name == "Hall" ? kHall : CompiledSnapshot::kInvalidID;
+  };
+  return std::make_shared<const CompiledSnapshot>(
+      CompiledSnapshot::Compile(snapshot, 3, busID, 1, reverbID));
+}
+
+std::shared_ptr<const CompiledSnapshot> Volumes(float music, float sfx = -1) {
+  Snapshot snapshot;
+  snapshot.SetBusState("Music", BusState{music});
+  if (sfx >= 0.0f) {
+    snapshot.SetBusState("SFX", BusState{sfx});
+  }
+  return Compile(snapshot);
+}
+
+} // namespace
+
+TEST_CASE("SnapshotBlender blends overlapping layers by weight",
+          "[SnapshotBlender]") {
+  SnapshotBlender blender;
+  int indoor = 0, cave = 0;
+  blender.SetLayer(&indoor, Volumes(0.5f), 128, 0.5f, 1.0f);
+  blender.SetLayer(&cave, Volumes(0.0f, 0.2f), 128, 0.25f, 2.0f);
+  REQUIRE_FALSE(blender.Resolve()); // weight 0 layers do nothing
+
+  blender.SetWeight(&indoor, 1.0f);
+  blender.SetWeight(&cave, 0.5f);
+  REQUIRE(blender.Resolve());
+  const auto &changes = blender.GetBusChanges();
+  REQUIRE(changes.size() == 2);
+  REQUIRE(blender.GetTarget(kMusic) == Catch::Approx(0.25f));
+  REQUIRE(blender.GetTarget(kSfx) == Catch::Approx(0.6f));
+  // Each bus fades with the slowest layer that moved it
+  for (const auto &change : changes) {
+    REQUIRE(change.fadeSeconds == (change.bus == kMusic ? 0.5f : 0.25f));
+  }
+
+  // Steady state issues nothing
+  blender.SetWeight(&indoor, 1.0f);
+  blender.SetWeight(&cave, 0.5f);
+  REQUIRE_FALSE(blender.Resolve());
+
+  // Removing a layer fades its buses back with its fade-out time
+  blender.RemoveLayer(&cave);
+  REQUIRE(blender.Resolve());
+  const auto &back = blender.GetBusChanges();
+  REQUIRE(back.size() == 2);
+  REQUIRE(blender.GetTarget(kMusic) == Catch::Approx(0.5f));
+  REQUIRE(blender.GetTarget(kSfx) == Catch::Approx(1.0f));
+  for (const auto &change : back) {
+    REQUIRE(change.fadeSeconds == 2.0f);
+  }
+}
+
+TEST_CASE("SnapshotBlender applies higher priority layers on top",
+          "[SnapshotBlender]") {
+  SnapshotBlender blender;
+  int combat = 0, ambient = 0;
+  blender.SetLayer(&combat, Volumes(1.0f), 200);
+  blender.SetLayer(&ambient, Volumes(0.2f), 50);
+  blender.SetWeight(&ambient, 1.0f);
+  blender.SetWeight(&combat, 1.0f);
+  blender.Resolve();
+  REQUIRE(blender.GetTarget(kMusic) == Catch::Approx(1.0f));
+
+  // Updated snapshot contents apply without a weight change
+  blender.SetLayer(&combat, Volumes(0.8f), 200);
+  REQUIRE(blender.Resolve());
+  REQUIRE(blender.GetBusChanges().size() == 1);
+  REQUIRE(blender.GetTarget(kMusic) == Catch::Approx(0.8f));
+  REQUIRE(blender.GetLayerCount() == 2);
+}
+
+TEST_CASE("SnapshotBlender interpolates reverb parameters from the base",
+          "[SnapshotBlender]") {
+  SnapshotBlender blender;
+  blender.SetReverbBase(kHall, ReverbBusState{0.8f, 0.5f, 0.5f, 1.0f});
+  REQUIRE_FALSE(blender.Resolve());
+
+  Snapshot snapshot;
+  snapshot.SetReverbState("Hall", ReverbBusState{0.4f, 0.9f, 0.1f, 1.0f});
+  int zone = 0;
+  blender.SetLayer(&zone, Compile(snapshot), 128, 1.0f, 1.0f);
+  blender.SetWeight(&zone, 0.5f);
+  REQUIRE(blender.Resolve());
+  REQUIRE(blender.GetBusChanges().empty());
+  REQUIRE(blender.GetReverbChanges().size() == 1);
+
+  const ReverbBusState state = blender.GetReverbTarget(kHall);
+  REQUIRE(state.wet == Catch::Approx(0.6f));
+  REQUIRE(state.roomSize == Catch::Approx(0.7f));
+  REQUIRE(state.damp == Catch::Approx(0.3f));
+  REQUIRE(state.width == Catch::Approx(1.0f));
+
+  blender.RemoveLayer(&zone);
+  REQUIRE(blender.Resolve());
+  REQUIRE(blender.GetReverbTarget(kHall).roomSize == Catch::Approx(0.5f));
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/TriangleBVH.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// Reference Möller-Trumbore over every triangle
+std::vector<uint32_t> BruteForce(const std::vector<Vector3> &vertices,
+                                 const std::vector<uint32_t> &indices,
+                                 const Vector3 &o, const Vector3 &d) {
+  std::vector<uint32_t> hit;
+  for (size_t tri = 0; tri < indices.size() / 3; ++tri) {
+    const Vector3 &a = vertices[indices[3 * tri]];
+    const Vector3 &b = vertices[indices[3 * tri + 1]];
+    const Vector3 &c = vertices[indices[3 * tri + 2]];
+    const float e1[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+    const float e2[3] = {c.x - a.x, c.y - a.y, c.z - a.z};
+    const float p[3] = {d.y * e2[2] - d.z * e2[1], d.z * e2[0] - d.x * e2[2],
+                        d.x * e2[1] - d.y * e2[0]};
+    const float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (det > -1e-12f && det < 1e-12f) {
+      continue;
+    }
+    const float s[3] = {o.x - a.x, o.y - a.y, o.z - a.z};
+    const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+    const float q[3] = {s[1] * e1[2] - s[2] * e1[1],
+                        s[2] * e1[0] - s[0] * e1[2],
+                        s[0] * e1[1] - s[1] * e1[0]};
+    const float v = (d.x * q[0] + d.y * q[1] + d.z * q[2]) / det;
+    const float t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+    if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 1e-6f && t < 1.0f) {
+      hit.push_back(static_cast<uint32_t>(tri));
+    }
+  }
+  return hit;
+}
+
+} // namespace
+
+TEST_CASE("TriangleBVH matches brute force on random triangles",
+          "[TriangleBVH]") {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+
+  std::vector<Vector3> vertices;
+  std::vector<uint32_t> indices;
+  for (uint32_t tri = 0; tri < 2000; ++tri) {
+    const Vector3 c{pos(rng), pos(rng), pos(rng)};
+    for (int k = 0; k < 3; ++k) {
+      indices.push_back(static_cast<uint32_t>(vertices.size()));
+      vertices.push_back({c.x + offset(rng), c.y + offset(rng),
+                          c.z + offset(rng)});
+    }
+  }
+
+  TriangleBVH bvh;
+  bvh.Build(vertices.data(), indices.data(), indices.size() / 3);
+  REQUIRE(bvh.GetTriangleCount() == 2000);
+
+  auto check = [&] {
+    std::vector<BVHHit> hits;
+    for (int ray = 0; ray < 200; ++ray) {
+      const Vector3 o{pos(rng), pos(rng), pos(rng)};
+      const Vector3 e{pos(rng), pos(rng), pos(rng)};
+      const Vector3 d{e.x - o.x, e.y - o.y, e.z - o.z};
+      std::vector<uint32_t> expected = BruteForce(vertices, indices, o, d);
+
+      hits.clear();
+      bvh.IntersectAll(o, d, 1.0f, hits);
+      std::vector<uint32_t> found;
+      for (const auto &hit : hits) {
+        found.push_back(hit.triangle);
+      }
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+      REQUIRE(bvh.IntersectAny(o, d, 1.0f) == !expected.empty());
+
+      BVHHit closest;
+      REQUIRE(bvh.IntersectClosest(o, d, 1.0f, closest) == !expected.empty());
+      for (const auto &hit : hits) {
+        REQUIRE(closest.t <= hit.t);
+      }
+    }
+  };
+  check();
+
+  // Refit after moving everything keeps queries exact
+  for (auto &v : vertices) {
+    v.x += 10.0f;
+    v.y *= 0.5f;
+  }
+  bvh.Refit(vertices.data(), indices.data());
+  check();
+}
+
+TEST_CASE("TriangleBVH reports facing", "[TriangleBVH]") {
+  // Quad in the z = 0 plane, front face towards +z
+  const std::vector<Vector3> vertices{{-1, -1, 0}, {1, -1, 0}, {1, 1, 0},
+                                      {-1, 1, 0}};
+  const std::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+  TriangleBVH bvh;
+  bvh.Build(vertices.data(), indices.data(), 2);
+
+  BVHHit hit;
+  REQUIRE(bvh.IntersectClosest({0.2f, 0.1f, 5}, {0, 0, -10}, 1.0f, hit));
+  REQUIRE(hit.frontFacing);
+  REQUIRE(hit.t == 0.5f);
+  REQUIRE(bvh.IntersectClosest({0.2f, 0.1f, -5}, {0, 0, 10}, 1.0f, hit));
+  REQUIRE_FALSE(hit.frontFacing);
+  REQUIRE_FALSE(bvh.IntersectAny({0.2f, 0.1f, 5}, {0, 0, -10}, 0.4f));
+  REQUIRE_FALSE(bvh.IntersectAny({3, 0, 5}, {0, 0, -10}, 1.0f));
+
+  bvh.Clear();
+  REQUIRE_FALSE(bvh.IntersectAny({0, 0, 5}, {0, 0, -10}, 1.0f));
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/ZoneGrid.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+std::vector<uint32_t> Query(const ZoneGrid &grid, const Vector3 &p,
+                            ZoneLayer layer) {
+  std::vector<uint32_t> hits;
+  grid.QueryPoint(p, layer, [&](uint32_t data) { hits.push_back(data); });
+  std::sort(hits.begin(), hits.end());
+  return hits;
+}
+
+} // namespace
+
+TEST_CASE("ZoneGrid reports zones containing the point", "[ZoneGrid]") {
+  ZoneGrid grid(10.0f);
+  grid.Insert({-5, -5, -5}, {5, 5, 5}, ZoneLayer::Audio, 1);
+  grid.Insert({20, 0, 20}, {40, 10, 40}, ZoneLayer::Audio, 2);
+  grid.Insert({-5, -5, -5}, {5, 5, 5}, ZoneLayer::Mix, 3);
+
+  REQUIRE(Query(grid, {0, 0, 0}, ZoneLayer::Audio) == std::vector<uint32_t>{1});
+  REQUIRE(Query(grid, {0, 0, 0}, ZoneLayer::Mix) == std::vector<uint32_t>{3});
+  REQUIRE(Query(grid, {30, 5, 30}, ZoneLayer::Audio) ==
+          std::vector<uint32_t>{2});
+  REQUIRE(Query(grid, {30, 50, 30}, ZoneLayer::Audio).empty());
+  REQUIRE(Query(grid, {100, 0, 100}, ZoneLayer::Audio).empty());
+}
+
+TEST_CASE("ZoneGrid follows moved and removed zones", "[ZoneGrid]") {
+  ZoneGrid grid(10.0f);
+  uint32_t a = grid.Insert({0, 0, 0}, {4, 4, 4}, ZoneLayer::Reverb, 7);
+  uint32_t b = grid.Insert({0, 0, 0}, {4, 4, 4}, ZoneLayer::Reverb, 8);
+
+  grid.Update(a, {100, 0, -100}, {104, 4, -96});
+  REQUIRE(Query(grid, {2, 2, 2}, ZoneLayer::Reverb) ==
+          std::vector<uint32_t>{8});
+  REQUIRE(Query(grid, {102, 2, -98}, ZoneLayer::Reverb) ==
+          std::vector<uint32_t>{7});
+
+  grid.Remove(b);
+  REQUIRE(Query(grid, {2, 2, 2}, ZoneLayer::Reverb).empty());
+  REQUIRE(grid.GetProxyCount() == 1);
+
+  // Freed IDs are reused
+  REQUIRE(grid.Insert({0, 0, 0}, {1, 1, 1}, ZoneLayer::Audio, 9) == b);
+}
+
+TEST_CASE("ZoneGrid handles huge zones", "[ZoneGrid]") {
+  ZoneGrid grid(1.0f);
+  grid.Insert({-1000, -10, -1000}, {1000, 10, 1000}, ZoneLayer::Audio, 5);
+  REQUIRE(Query(grid, {-999, 0, 999}, ZoneLayer::Audio) ==
+          std::vector<uint32_t>{5});
+  REQUIRE(Query(grid, {0, 50, 0}, ZoneLayer::Audio).empty());
+}
+
+TEST_CASE("ZoneGrid matches a brute-force scan", "[ZoneGrid]") {
+  struct Box {
+    Vector3 min, max;
+  };
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+  std::uniform_real_distribution<float> size(1.0f, 80.0f);
+
+  ZoneGrid grid(32.0f);
+  std::vector<Box> boxes;
+  std::vector<uint32_t> proxies;
+  for (uint32_t i = 0; i < 2000; ++i) {
+    Vector3 c{pos(rng), pos(rng) * 0.05f, pos(rng)};
+    float r = size(rng);
+    boxes.push_back({{c.x - r, c.y - r, c.z - r}, {c.x + r, c.y + r, c.z + r}});
+    proxies.push_back(
+        grid.Insert(boxes.back().min, boxes.back().max, ZoneLayer::Audio, i));
+  }
+  // Move a quarter of them
+  for (uint32_t i = 0; i < 2000; i += 4) {
+    float dx = pos(rng) * 0.1f;
+    boxes[i].min.x += dx;
+    boxes[i].max.x += dx;
+    grid.Update(proxies[i], boxes[i].min, boxes[i].max);
+  }
+
+  for (int q = 0; q < 200; ++q) {
+    Vector3 p{pos(rng), 0.0f, pos(rng)};
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+      const Box &b = boxes[i];
+      if (p.x >= b.min.x && p.x <= b.max.x && p.y >= b.min.y &&
+          p.y <= b.max.y && p.z >= b.min.z && p.z <= b.max.z) {
+        expected.push_back(i);
+      }
+    }
+    REQUIRE(Query(grid, p, ZoneLayer::Audio) == expected);
+  }
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/AudioZone.h"
+#include "include/ZonePool.h"
+
+#include <string>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// Backend that records engine calls in order
+struct FakeBackend {
+  std::vector<std::string> calls;
+  std::vector<bool> resident;
+  AudioHandle next = 1;
+  float lastVolume = 0.0f;
+
+  AudioHandle Play(const std::string &name) {
+    calls.push_back("play " + name);
+    return next++;
+  }
+  bool IsValid(AudioHandle) { return true; }
+  void SetVolume(AudioHandle, float volume) { lastVolume = volume; }
+  void Stop(AudioHandle) { calls.push_back("stop"); }
+  void ApplySnapshot(const std::string &name, float) {
+    calls.push_back("apply " + name);
+  }
+  void RevertSnapshot(float) { calls.push_back("revert"); }
+  void SetResident(const std::string &name, bool value) {
+    REQUIRE(name == "forest");
+    resident.push_back(value);
+  }
+};
+
+} // namespace
+
+TEST_CASE("ZonePool prefetches ahead of the outer radius with hysteresis",
+          "[ZonePool]") {
+  ZonePool pool;
+  FakeBackend backend;
+  const uint32_t zone =
+      pool.Add("forest", ZoneGeometry::Sphere({0, 0, 0}, 10.0f, 50.0f), 20.0f);
+  std::vector<uint32_t> candidates{zone};
+  std::vector<uint32_t> live;
+
+  auto at = [&](float x) {
+    Vector3 listener{x, 0.0f, 0.0f};
+    pool.Update(candidates, &listener, 1, true, backend, live);
+  };
+
+  at(100.0f);
+  REQUIRE(backend.resident.empty());
+  REQUIRE(live.empty());
+  at(69.0f); // within 50 + 20
+  REQUIRE(backend.resident == std::vector<bool>{true});
+  REQUIRE(live == std::vector<uint32_t>{zone});
+  at(74.0f); // between acquire (70) and release (75) distance
+  REQUIRE(pool.IsPrefetched(zone));
+  at(76.0f);
+  REQUIRE(backend.resident == std::vector<bool>{true, false});
+  at(72.0f);
+  REQUIRE_FALSE(pool.IsPrefetched(zone));
+
+  at(30.0f);
+  pool.SetPrefetchRadius(zone, 0.0f, backend);
+  REQUIRE(backend.resident == std::vector<bool>{true, false, true, false});
+  REQUIRE(backend.calls == std::vector<std::string>{"play forest"});
+}
+
+TEST_CASE("ZonePool stops exiting zones before starting entering ones",
+          "[ZonePool]") {
+  ZonePool pool;
+  FakeBackend backend;
+  const uint32_t a = pool.Add(
+      "a", ZoneGeometry::Sphere({0, 0, 0}, 1.0f, 5.0f), 0.0f, "Cave");
+  const uint32_t b = pool.Add(
+      "b", ZoneGeometry::Sphere({20, 0, 0}, 1.0f, 5.0f), 0.0f, "Hall");
+  std::vector<uint32_t> candidates{a, b};
+  std::vector<uint32_t> live;
+
+  Vector3 listener{0, 0, 0};
+  pool.Update(candidates, &listener, 1, true, backend, live);
+  REQUIRE(backend.calls == std::vector<std::string>{"play a", "apply Cave"});
+  REQUIRE(backend.lastVolume == 1.0f);
+  REQUIRE(live == std::vector<uint32_t>{a});
+
+  backend.calls.clear();
+  listener = {20, 0, 0};
+  pool.Update(candidates, &listener, 1, true, backend, live);
+  REQUIRE(backend.calls ==
+          std::vector<std::string>{"stop", "revert", "play b", "apply Hall"});
+  REQUIRE(live == std::vector<uint32_t>{b});
+
+  AudioZone view(pool, b);
+  REQUIRE(view.IsActive());
+  REQUIRE(view.GetSnapshotName() == "Hall");
+  REQUIRE(view.GetHandle() == 2);
+  REQUIRE_FALSE(AudioZone(pool, a).IsActive());
+  REQUIRE(pool.Find("b") == b);
+  REQUIRE(pool.Find("c") == ZonePool::kInvalidZone);
+}
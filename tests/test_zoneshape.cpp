@@ -0,0 +1,136 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "include/ZoneShape.h"
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+// Reference even-odd test over every edge
+bool NaiveContains(const std::vector<Vector2> &poly, float x, float z) {
+  bool inside = false;
+  for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+    if ((poly[i].y > z) != (poly[j].y > z) &&
+        x < (poly[j].x - poly[i].x) * (z - poly[i].y) /
+                    (poly[j].y - poly[i].y) +
+                poly[i].x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+float NaiveEdgeDistance(const std::vector<Vector2> &poly, float x, float z) {
+  float best = FLT_MAX;
+  for (size_t i = 0; i < poly.size(); ++i) {
+    const Vector2 &a = poly[i];
+    const Vector2 &b = poly[(i + 1) % poly.size()];
+    float dx = b.x - a.x, dz = b.y - a.y;
+    float t = ((x - a.x) * dx + (z - a.y) * dz) / (dx * dx + dz * dz);
+    t = std::fmax(0.0f, std::fmin(1.0f, t));
+    float ex = x - (a.x + t * dx), ez = z - (a.y + t * dz);
+    best = std::fmin(best, std::sqrt(ex * ex + ez * ez));
+  }
+  return best;
+}
+
+// Star-shaped outline with many concave notches, like a navmesh border
+std::vector<Vector2> MakeJaggedPolygon(size_t vertices) {
+  std::vector<Vector2> poly;
+  for (size_t i = 0; i < vertices; ++i) {
+    float a = 6.2831853f * static_cast<float>(i) / static_cast<float>(vertices);
+    float r = (i % 2 == 0) ? 100.0f : 80.0f + 10.0f * std::sin(a * 7.0f);
+    poly.push_back({r * std::cos(a), r * std::sin(a)});
+  }
+  return poly;
+}
+
+} // namespace
+
+TEST_CASE("Box geometry has full volume inside and fades outside",
+          "[ZoneShape]") {
+  auto box = ZoneGeometry::Box({0, 0, 0}, {100, 10, 4}, 2.0f);
+
+  REQUIRE(box.ComputeVolume({50, 5, 2}) == 1.0f);
+  REQUIRE(box.ComputeVolume({99, 1, 3}) == 1.0f);
+  REQUIRE(box.ComputeVolume({50, 5, 5}) == Catch::Approx(0.5f));
+  REQUIRE(box.ComputeVolume({50, 5, 7}) == 0.0f);
+
+  // A bounding sphere would still cover this point; the box does not
+  REQUIRE(box.ComputeVolume({50, 5, 30}) == 0.0f);
+
+  Vector3 min, max;
+  box.GetBounds(min, max);
+  REQUIRE(min.x == Catch::Approx(-2.0f));
+  REQUIRE(max.z == Catch::Approx(6.0f));
+
+  box.SetCenter({0, 5, 0});
+  REQUIRE(box.ComputeVolume({-49, 5, 0}) == 1.0f);
+  REQUIRE(box.ComputeVolume({60, 5, 0}) == 0.0f);
+}
+
+TEST_CASE("Polygon geometry follows concave outlines", "[ZoneShape]") {
+  // L-shaped corridor
+  std::vector<Vector2> poly = {{0, 0}, {100, 0}, {100, 10},
+                               {10, 10}, {10, 100}, {0, 100}};
+  auto zone = ZoneGeometry::Polygon(poly, 0.0f, 5.0f, 4.0f);
+
+  REQUIRE(zone.GetType() == ZoneShapeType::Polygon);
+  REQUIRE(zone.ComputeVolume({50, 1, 5}) == 1.0f);
+  REQUIRE(zone.ComputeVolume({5, 1, 50}) == 1.0f);
+  REQUIRE(zone.ComputeVolume({50, 1, 50}) == 0.0f); // inside the notch
+  REQUIRE(zone.ComputeVolume({50, 1, 12}) == Catch::Approx(0.5f));
+  REQUIRE(zone.ComputeVolume({50, 8, 5}) == Catch::Approx(0.25f));
+  REQUIRE(zone.ComputeVolume({50, 20, 5}) == 0.0f);
+
+  // Moving the zone moves the outline with it
+  const Vector3 c = zone.GetCenter();
+  zone.SetCenter({c.x + 1000.0f, c.y, c.z});
+  REQUIRE(zone.ComputeVolume({50, 1, 5}) == 0.0f);
+  REQUIRE(zone.ComputeVolume({1050, 1, 5}) == 1.0f);
+}
+
+TEST_CASE("Banded polygon queries match a brute-force reference",
+          "[ZoneShape]") {
+  const auto poly = MakeJaggedPolygon(2000);
+  PolygonData data(poly);
+  REQUIRE(data.GetEdgeCount() == 2000);
+  REQUIRE(data.GetBandCount() > 1);
+
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> coord(-120.0f, 120.0f);
+  for (int i = 0; i < 2000; ++i) {
+    float x = coord(rng), z = coord(rng);
+    const bool inside = NaiveContains(poly, x, z);
+    REQUIRE(data.Contains(x, z) == inside);
+
+    const float dist = data.Distance(x, z, 10.0f);
+    if (inside) {
+      REQUIRE(dist == 0.0f);
+      continue;
+    }
+    const float expected = NaiveEdgeDistance(poly, x, z);
+    if (expected <= 9.99f) {
+      REQUIRE(dist == Catch::Approx(expected).margin(1e-3));
+    } else if (expected > 10.01f) {
+      REQUIRE(dist == FLT_MAX);
+    }
+  }
+}
+
+TEST_CASE("Sphere geometry matches radial falloff", "[ZoneShape]") {
+  auto sphere = ZoneGeometry::Sphere({0, 0, 0}, 10.0f, 20.0f);
+  REQUIRE(sphere.ComputeVolume({5, 0, 0}) == 1.0f);
+  REQUIRE(sphere.ComputeVolume({15, 0, 0}) == Catch::Approx(0.5f));
+  REQUIRE(sphere.ComputeVolume({0, 25, 0}) == 0.0f);
+  REQUIRE(sphere.GetInnerRadius() == 10.0f);
+
+  sphere.SetRadii(0.0f, 40.0f);
+  REQUIRE(sphere.ComputeVolume({20, 0, 0}) == Catch::Approx(0.5f));
+}
@@ -0,0 +1,297 @@
+// orpheus_bake: trace acoustic probes offline and write a probe file for
+// AcousticProbeGrid::Load().
+//
+// Usage: orpheus_bake <scene.obj> <output.probes> [options]
+//
+// The scene is a Wavefront OBJ file; each "usemtl" name selects the
+// acoustic material of the faces that follow (Concrete, Wood, Carpet,
+// Glass or Curtain; anything else is baked as Concrete).
+
+#include "../include/AcousticProbeGrid.h"
+#include "../include/AcousticScene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Orpheus;
+
+namespace {
+
+struct Options {
+  std::string scenePath;
+  std::string outputPath;
+  std::string probesPath; // Placed probes; empty for a grid
+  float spacing = 2.0f;
+  bool hasBounds = false;
+  Vector3 min{0.0f, 0.0f, 0.0f};
+  Vector3 max{0.0f, 0.0f, 0.0f};
+  int rays = 1024;
+  float maxDistance = 200.0f;
+  float detail = 0.0f;
+  uint32_t threads = 0;
+  uint32_t seed = 12345;
+};
+
+struct ObjScene {
+  std::vector<Vector3> vertices;
+  std::map<std::string, std::vector<uint32_t>> indices; // By material
+};
+
+void PrintUsage() {
+  std::cerr
+      << "Usage: orpheus_bake <scene.obj> <output.probes> [options]\n"
+         "  --spacing <m>          Lattice spacing (default: 2)\n"
+         "  --bounds <x0 y0 z0 x1 y1 z1>\n"
+         "                         Lattice box (default: scene bounds)\n"
+         "  --probes <file>        Bake placed probes (\"x y z\" per line)\n"
+         "                         instead of one per lattice point\n"
+         "  --rays <n>             Rays per probe, 8-1024 (default: 1024)\n"
+         "  --max-distance <m>     Ray path length limit (default: 200)\n"
+         "  --detail <m>           Mesh simplification size (default: 0)\n"
+         "  --threads <n>          Tracing threads (default: all cores)\n"
+         "  --seed <n>             Scattering seed (default: 12345)\n";
+}
+
+bool ParseOptions(int argc, char **argv, Options &options) {
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::vector<std::string> positional;
+  for (size_t i = 0; i < args.size(); ++i) {
+    const std::string &arg = args[i];
+    auto value = [&](size_t count) {
+      if (i + count >= args.size()) {
+        std::cerr << "Missing value for " << arg << "\n";
+        return false;
+      }
+      return true;
+    };
+    if (arg == "--spacing" && value(1)) {
+      options.spacing = std::stof(args[++i]);
+    } else if (arg == "--bounds" && value(6)) {
+      options.hasBounds = true;
+      options.min = {std::stof(args[i + 1]), std::stof(args[i + 2]),
+                     std::stof(args[i + 3])};
+      options.max = {std::stof(args[i + 4]), std::stof(args[i + 5]),
+                     std::stof(args[i + 6])};
+      i += 6;
+    } else if (arg == "--probes" && value(1)) {
+      options.probesPath = args[++i];
+    } else if (arg == "--rays" && value(1)) {
+      options.rays = std::stoi(args[++i]);
+    } else if (arg == "--max-distance" && value(1)) {
+      options.maxDistance = std::stof(args[++i]);
+    } else if (arg == "--detail" && value(1)) {
+      options.detail = std::stof(args[++i]);
+    } else if (arg == "--threads" && value(1)) {
+      options.threads = static_cast<uint32_t>(std::stoul(args[++i]));
+    } else if (arg == "--seed" && value(1)) {
+      options.seed = static_cast<uint32_t>(std::stoul(args[++i]));
+    } else if (arg.rfind("--", 0) == 0) {
+      std::cerr << "Unknown or incomplete option: " << arg << "\n";
+      return false;
+    } else {
+      positional.push_back(arg);
+    }
+  }
+  if (positional.size() != 2) {
+    return false;
+  }
+  options.scenePath = positional[0];
+  options.outputPath = positional[1];
+  return true;
+}
+
+// Vertex index of an OBJ face corner ("v", "v/vt", "v//vn" or "v/vt/vn")
+bool ParseCorner(const std::string &token, size_t vertexCount,
+                 uint32_t &index) {
+  const long value = std::strtol(token.c_str(), nullptr, 10);
+  const long resolved =
+      value < 0 ? static_cast<long>(vertexCount) + value : value - 1;
+  if (value == 0 || resolved < 0 ||
+      resolved >= static_cast<long>(vertexCount)) {
+    return false;
+  }
+  index = static_cast<uint32_t>(resolved);
+  return true;
+}
+
+bool LoadObj(const std::string &path, ObjScene &scene) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open scene: " << path << "\n";
+    return false;
+  }
+  std::string material = "Concrete";
+  std::string line;
+  size_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    std::istringstream in(line);
+    std::string keyword;
+    in >> keyword;
+    if (keyword == "v") {
+      Vector3 v{0.0f, 0.0f, 0.0f};
+      in >> v.x >> v.y >> v.z;
+      scene.vertices.push_back(v);
+    } else if (keyword == "usemtl") {
+      in >> material;
+    } else if (keyword == "f") {
+      // Triangulate polygons as fans
+      std::vector<uint32_t> corners;
+      std::string token;
+      while (in >> token) {
+        uint32_t index;
+        if (!ParseCorner(token, scene.vertices.size(), index)) {
+          std::cerr << path << ":" << lineNumber << ": bad face index\n";
+          return false;
+        }
+        corners.push_back(index);
+      }
+      std::vector<uint32_t> &indices = scene.indices[material];
+      for (size_t i = 2; i < corners.size(); ++i) {
+        indices.insert(indices.end(),
+                       {corners[0], corners[i - 1], corners[i]});
+      }
+    }
+  }
+  return true;
+}
+
+bool LoadProbePositions(const std::string &path,
+                        std::vector<Vector3> &positions) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open probe list: " << path << "\n";
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream in(line);
+    Vector3 p{0.0f, 0.0f, 0.0f};
+    if (in >> p.x >> p.y >> p.z) {
+      positions.push_back(p);
+    }
+  }
+  return true;
+}
+
+void Bounds(const std::vector<Vector3> &points, Vector3 &min, Vector3 &max) {
+  min = max = points.front();
+  for (const Vector3 &p : points) {
+    min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+    max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  try {
+    if (!ParseOptions(argc, argv, options)) {
+      PrintUsage();
+      return 1;
+    }
+  } catch (const std::exception &) {
+    std::cerr << "Invalid number in options\n";
+    PrintUsage();
+    return 1;
+  }
+
+  ObjScene obj;
+  if (!LoadObj(options.scenePath, obj)) {
+    return 1;
+  }
+  if (obj.vertices.empty() || obj.indices.empty()) {
+    std::cerr << "Scene has no faces: " << options.scenePath << "\n";
+    return 1;
+  }
+
+  AcousticRayTracer tracer;
+  tracer.SetRayCount(options.rays);
+  tracer.SetMaxDistance(options.maxDistance);
+  tracer.SetSeed(options.seed);
+  const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+  tracer.SetThreadCount(options.threads > 0 ? options.threads : cores);
+
+  auto scene = std::make_shared<AcousticScene>();
+  std::set<std::string> unknown;
+  for (const auto &group : obj.indices) {
+    AcousticMaterialID material = tracer.GetMaterialID(group.first);
+    if (material == AcousticRayTracer::kInvalidMaterial) {
+      unknown.insert(group.first);
+      material = tracer.GetMaterialID("Concrete");
+    }
+    scene->AddMesh(obj.vertices.data(), obj.vertices.size(),
+                   group.second.data(), group.second.size(), material,
+                   options.detail);
+  }
+  for (const std::string &name : unknown) {
+    std::cerr << "Unknown material \"" << name << "\", using Concrete\n";
+  }
+  scene->Commit();
+  tracer.SetGeometryPacketCallback(AcousticScene::MakeCallback(scene));
+
+  std::vector<Vector3> probes;
+  if (!options.probesPath.empty() &&
+      (!LoadProbePositions(options.probesPath, probes) || probes.empty())) {
+    std::cerr << "No probe positions in " << options.probesPath << "\n";
+    return 1;
+  }
+  if (!options.hasBounds) {
+    Bounds(obj.vertices, options.min, options.max);
+  }
+
+  std::cout << "Scene: " << scene->GetTriangleCount() << " triangles\n";
+  const auto start = std::chrono::steady_clock::now();
+  size_t reported = 0;
+  auto progress = [&reported](size_t done, size_t total) {
+    const size_t percent = done * 100 / total;
+    if (percent != reported || done == total) {
+      reported = percent;
+      std::cout << "\rBaking " << done << "/" << total << " probes ("
+                << percent << "%)" << std::flush;
+    }
+  };
+  std::vector<uint8_t> image =
+      probes.empty()
+          ? AcousticProbeGrid::BakeGrid(tracer, options.min, options.max,
+                                        options.spacing, progress)
+          : AcousticProbeGrid::BakeProbes(tracer, probes.data(),
+                                          probes.size(), options.min,
+                                          options.max, options.spacing,
+                                          progress);
+  std::cout << "\n";
+
+  AcousticProbeGrid grid;
+  Status status = grid.LoadFromMemory(std::move(image));
+  if (status.IsError()) {
+    std::cerr << "Bake failed (empty or oversized lattice): "
+              << status.GetError().What() << "\n";
+    return 1;
+  }
+  status = grid.Save(options.outputPath);
+  if (status.IsError()) {
+    std::cerr << status.GetError().What() << "\n";
+    return 1;
+  }
+
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  const AcousticProbeGrid::Header &header = grid.GetHeader();
+  std::cout << "Wrote " << grid.GetProbeCount() << " probes on a "
+            << header.dimX << " x " << header.dimY << " x " << header.dimZ
+            << " lattice to " << options.outputPath << " in " << seconds
+            << " s\n";
+  return 0;
+}